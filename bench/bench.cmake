@@ -0,0 +1,218 @@
+# Benchmark driver, run by the `bench` target or directly with
+#
+#   cmake -DBENCH_BIN_DIR=<build dir> [options] -P bench/bench.cmake
+#
+# Each instance is solved BENCH_RUNS times with a fixed seed, and the
+# %%%mzn-stat counters of the fastest run are written to results.csv and
+# results.json in BENCH_OUTPUT_DIR. Options:
+#
+#   BENCH_INSTANCES   instance list (default: instances.txt next to this file)
+#   BENCH_FZN_DIRS    directories searched recursively for more .fzn instances,
+#                     separated by ';' or '|'
+#   BENCH_SEED        random seed passed to every run (default 1)
+#   BENCH_RUNS        runs per instance (default 1)
+#   BENCH_TIME_LIMIT  solver time limit per run in milliseconds (default 60000)
+#   BENCH_ARGS        extra solver options for every run
+#   BENCH_BASELINE    results.csv of an earlier build to compare against
+
+cmake_minimum_required(VERSION 3.1.0)
+
+if(NOT BENCH_BIN_DIR)
+  message(FATAL_ERROR "BENCH_BIN_DIR must name the directory holding fzn-chuffed and the examples")
+endif()
+if(NOT BENCH_INSTANCES)
+  set(BENCH_INSTANCES ${CMAKE_CURRENT_LIST_DIR}/instances.txt)
+endif()
+if(NOT BENCH_OUTPUT_DIR)
+  set(BENCH_OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/bench)
+endif()
+if(NOT BENCH_SEED)
+  set(BENCH_SEED 1)
+endif()
+if(NOT BENCH_RUNS)
+  set(BENCH_RUNS 1)
+endif()
+if(NOT BENCH_TIME_LIMIT)
+  set(BENCH_TIME_LIMIT 60000)
+endif()
+separate_arguments(bench_args UNIX_COMMAND "${BENCH_ARGS}")
+
+set(counters nodes failures propagations solveTime peakMem objective)
+
+# ------------- Instance list -------------
+
+get_filename_component(instance_dir ${BENCH_INSTANCES} DIRECTORY)
+file(STRINGS ${BENCH_INSTANCES} lines)
+set(instances)
+foreach(line ${lines})
+  string(STRIP "${line}" line)
+  if(line AND NOT line MATCHES "^#")
+    list(APPEND instances "${line}")
+  endif()
+endforeach()
+
+string(REPLACE "|" ";" fzn_dirs "${BENCH_FZN_DIRS}")
+foreach(dir ${fzn_dirs})
+  file(GLOB_RECURSE files ${dir}/*.fzn)
+  list(SORT files)
+  list(APPEND instances ${files})
+endforeach()
+
+# ------------- Runs -------------
+
+# Solve the instance once and set the counters in the parent scope, with
+# status ok, timeout, missing or the exit code of a crash
+function(run_instance line)
+  separate_arguments(words UNIX_COMMAND "${line}")
+  list(GET words 0 prog)
+  list(REMOVE_AT words 0)
+  set(opts --rnd-seed ${BENCH_SEED} -s ${bench_args} -t ${BENCH_TIME_LIMIT})
+  if(prog MATCHES "\\.fzn$")
+    if(NOT IS_ABSOLUTE ${prog})
+      set(prog ${instance_dir}/${prog})
+    endif()
+    set(cmd ${BENCH_BIN_DIR}/fzn-chuffed ${words} ${opts} ${prog})
+    set(exe ${BENCH_BIN_DIR}/fzn-chuffed)
+  else()
+    set(exe ${BENCH_BIN_DIR}/${prog}${CMAKE_EXECUTABLE_SUFFIX})
+    set(cmd ${exe} ${words} ${opts})
+  endif()
+  foreach(c ${counters})
+    set(${c} "" PARENT_SCOPE)
+  endforeach()
+  if(NOT EXISTS ${exe} OR (prog MATCHES "\\.fzn$" AND NOT EXISTS ${prog}))
+    set(status missing PARENT_SCOPE)
+    return()
+  endif()
+
+  # The solver stops itself at the time limit; the process timeout only
+  # catches runs that hang
+  math(EXPR timeout "${BENCH_TIME_LIMIT} / 1000 + 60")
+  execute_process(COMMAND ${cmd}
+    OUTPUT_VARIABLE out ERROR_VARIABLE err
+    RESULT_VARIABLE rc TIMEOUT ${timeout})
+  foreach(c ${counters})
+    if(out MATCHES "%%%mzn-stat: ${c}=([-0-9.e+]+)")
+      set(${c} ${CMAKE_MATCH_1} PARENT_SCOPE)
+    endif()
+  endforeach()
+  if(NOT rc STREQUAL "0")
+    set(status "${rc}" PARENT_SCOPE)
+  elseif(out MATCHES "Time limit exceeded")
+    set(status timeout PARENT_SCOPE)
+  else()
+    set(status ok PARENT_SCOPE)
+  endif()
+endfunction()
+
+file(MAKE_DIRECTORY ${BENCH_OUTPUT_DIR})
+set(csv "instance,status")
+foreach(c ${counters})
+  set(csv "${csv},${c}")
+endforeach()
+set(csv "${csv}\n")
+set(json "{\n  \"seed\": ${BENCH_SEED},\n  \"runs\": ${BENCH_RUNS},\n  \"timeLimit\": ${BENCH_TIME_LIMIT},\n  \"instances\": [")
+set(sep "")
+
+foreach(inst ${instances})
+  # Keep the fastest run; the counters do not depend on timing
+  set(best "")
+  foreach(run RANGE 1 ${BENCH_RUNS})
+    run_instance("${inst}")
+    if(best STREQUAL "" OR (solveTime AND solveTime LESS best))
+      set(best "${solveTime}")
+      set(best_status "${status}")
+      foreach(c ${counters})
+        set(best_${c} "${${c}}")
+      endforeach()
+    endif()
+    if(NOT status STREQUAL "ok" AND NOT status STREQUAL "timeout")
+      break()
+    endif()
+  endforeach()
+
+  set(row "\"${inst}\",${best_status}")
+  string(REPLACE "\\" "\\\\" name "${inst}")
+  string(REPLACE "\"" "\\\"" name "${name}")
+  set(obj "\n    {\"instance\": \"${name}\", \"status\": \"${best_status}\"")
+  set(summary "")
+  foreach(c ${counters})
+    set(row "${row},${best_${c}}")
+    if(NOT "${best_${c}}" STREQUAL "")
+      set(obj "${obj}, \"${c}\": ${best_${c}}")
+      set(summary "${summary} ${c}=${best_${c}}")
+    endif()
+  endforeach()
+  set(csv "${csv}${row}\n")
+  set(json "${json}${sep}${obj}}")
+  set(sep ",")
+  message(STATUS "${inst}: ${best_status}${summary}")
+endforeach()
+
+set(json "${json}\n  ]\n}\n")
+file(WRITE ${BENCH_OUTPUT_DIR}/results.csv "${csv}")
+file(WRITE ${BENCH_OUTPUT_DIR}/results.json "${json}")
+message(STATUS "Results written to ${BENCH_OUTPUT_DIR}/results.csv and results.json")
+
+# ------------- Comparison -------------
+
+# Report instances whose search changed, or whose solve time moved by more
+# than 10% and 0.05s, relative to the baseline
+if(BENCH_BASELINE)
+  file(STRINGS ${BENCH_BASELINE} base_lines)
+  file(STRINGS ${BENCH_OUTPUT_DIR}/results.csv new_lines)
+  foreach(line ${base_lines})
+    if(line MATCHES "^\"(.*)\",([^,]*),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*)$")
+      set(key "${CMAKE_MATCH_1}")
+      string(MD5 key "${key}")
+      set(base_${key} "${CMAKE_MATCH_2};${CMAKE_MATCH_3};${CMAKE_MATCH_4};${CMAKE_MATCH_5};${CMAKE_MATCH_6}")
+    endif()
+  endforeach()
+  set(changed 0)
+  foreach(line ${new_lines})
+    if(NOT line MATCHES "^\"(.*)\",([^,]*),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*)$")
+      continue()
+    endif()
+    set(inst "${CMAKE_MATCH_1}")
+    set(status ${CMAKE_MATCH_2})
+    set(nodes ${CMAKE_MATCH_3})
+    set(failures ${CMAKE_MATCH_4})
+    set(time ${CMAKE_MATCH_6})
+    string(MD5 key "${inst}")
+    if(NOT DEFINED base_${key})
+      message(STATUS "${inst}: not in baseline")
+      continue()
+    endif()
+    list(GET base_${key} 0 b_status)
+    list(GET base_${key} 1 b_nodes)
+    list(GET base_${key} 2 b_failures)
+    list(GET base_${key} 4 b_time)
+    set(diff "")
+    if(NOT status STREQUAL b_status)
+      set(diff "${diff} status ${b_status} -> ${status}")
+    endif()
+    if(NOT nodes STREQUAL b_nodes OR NOT failures STREQUAL b_failures)
+      set(diff "${diff} nodes ${b_nodes} -> ${nodes}, failures ${b_failures} -> ${failures}")
+    endif()
+    if(time AND b_time)
+      # Times are in seconds with millisecond resolution
+      string(REPLACE "." "" t_ms "${time}")
+      string(REPLACE "." "" b_ms "${b_time}")
+      math(EXPR t_ms "${t_ms} + 0")
+      math(EXPR b_ms "${b_ms} + 0")
+      math(EXPR delta "${t_ms} - ${b_ms}")
+      if(delta LESS 0)
+        math(EXPR delta "-${delta}")
+      endif()
+      math(EXPR rel "${delta} * 10")
+      if(delta GREATER 50 AND rel GREATER b_ms)
+        set(diff "${diff} solveTime ${b_time} -> ${time}")
+      endif()
+    endif()
+    if(diff)
+      message(STATUS "${inst}:${diff}")
+      math(EXPR changed "${changed} + 1")
+    endif()
+  endforeach()
+  message(STATUS "${changed} instance(s) differ from ${BENCH_BASELINE}")
+endif()
@@ -1,13 +1,29 @@
+#include <algorithm>
 #include <chuffed/branching/branching.h>
 #include <chuffed/vars/vars.h>
+#include <chuffed/vars/int-var.h>
+#include <chuffed/vars/bool-view.h>
 #include <chuffed/core/engine.h>
 #include <chuffed/core/options.h>
 
 BranchGroup::BranchGroup(VarBranch vb, bool t) :
-	var_branch(vb), terminal(t), fin(0), cur(-1) {}
+	var_branch(vb), terminal(t), fin(0), cur(-1), use_order(false), order(ScoreLt(score)) {}
 
 BranchGroup::BranchGroup(vec<Branching*>& _x, VarBranch vb, bool t) :
-	x(_x), var_branch(vb), terminal(t), fin(0), cur(-1) {}
+	x(_x), var_branch(vb), terminal(t), fin(0), cur(-1), use_order(false), order(ScoreLt(score)) {}
+
+BranchGroup::~BranchGroup() {
+	deleteBranchings(x);
+}
+
+// The groups and bool views given to a group or as outputs are allocated for
+// it alone, while int vars belong to the engine and sat to the solver
+void deleteBranchings(vec<Branching*>& x) {
+	for (int i = 0; i < x.size(); i++) {
+		if (dynamic_cast<BranchGroup*>(x[i]) || dynamic_cast<BoolView*>(x[i])) delete x[i];
+	}
+	x.clear();
+}
 
 bool BranchGroup::finished() {
 	if (fin) return true;
@@ -26,7 +42,7 @@ double BranchGroup::getScore(VarBranch vb) {
 	return sum / x.size();
 }
 
-DecInfo* BranchGroup::branch() {
+DecInfo BranchGroup::branch() {
     // Check whether current branching group has finished,
     // if not yet then continue search on this group
 	if (cur >= 0 && !x[cur]->finished()) 
@@ -39,7 +55,7 @@ DecInfo* BranchGroup::branch() {
 		int i = 0;
 		while (i < x.size() && x[i]->finished()) i++;
 		if (i == x.size()) {
-			return NULL;
+			return DecInfo();
 		}
 		if (!terminal) cur = i;
 		return x[i]->branch();
@@ -52,14 +68,20 @@ DecInfo* BranchGroup::branch() {
                 moves.push(i);
         }
         if (moves.size() == 0)
-            return NULL;
-        int best_i = moves[ rand() % moves.size() ];
+            return DecInfo();
+        int best_i = moves[engine().randInt(moves.size())];
         if (!terminal)
             cur = best_i;
         return x[best_i]->branch();
     }
 
     // All other selection criteria
+	if (use_order) {
+		int best_i = bestChild();
+		if (best_i < 0) return DecInfo();
+		if (!terminal) cur = best_i;
+		return x[best_i]->branch();
+	}
 	double best = -1e100;
 	moves.clear();
 	for (int i = 0; i < x.size(); i++) {
@@ -74,19 +96,131 @@ DecInfo* BranchGroup::branch() {
 		}
 	}
 	if (moves.size() == 0) {
-		return NULL;
+		return DecInfo();
 	}
 	int best_i = moves[0];
     // Random selection of best move
-	if (so.branch_random) best_i = moves[rand()%moves.size()];
+	if (so().branch_random) best_i = moves[engine().randInt(moves.size())];
 
 	if (!terminal) cur = best_i;
 	return x[best_i]->branch();
 }
 
+// Incremental selection
+//
+// Rather than scoring every child at each decision, the children are kept in
+// a heap by the score they had when last computed. A child is rescored when
+// its domain changes, which it reports as it wakes its propagators, or when
+// its activity or degree changes. Domain changes are undone by backtracking
+// without a report, so the children changed at each decision level are
+// listed, and the engine has them rescored as it backtracks above that level. Ties are
+// broken as by the scan: input order, or with so.branch_random a random
+// child of the best.
+
+static bool heapBranch(VarBranch vb) {
+	switch (vb) {
+		case VAR_SIZE_MIN: case VAR_SIZE_MAX:
+		case VAR_MIN_MIN: case VAR_MIN_MAX: case VAR_MAX_MIN: case VAR_MAX_MAX:
+		case VAR_DEGREE_MIN: case VAR_DEGREE_MAX:
+		case VAR_REGRET_MIN_MAX: case VAR_ACTIVITY:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Set up the incremental selection of this group and the groups under it,
+// at the root before search
+void BranchGroup::initOrder() {
+	for (int i = 0; i < x.size(); i++) {
+		if (BranchGroup *g = dynamic_cast<BranchGroup*>(x[i])) g->initOrder();
+	}
+	if (!heapBranch(var_branch) || x.size() == 0) return;
+	for (int i = 0; i < x.size(); i++) {
+		if (!dynamic_cast<IntVar*>(x[i])) return;
+	}
+	use_order = true;
+	engine().ordered_groups.push(this);
+	score.growTo(x.size());
+	is_dirty.growTo(x.size(), 0);
+	changed_at.growTo(x.size(), -1);
+	for (int i = 0; i < x.size(); i++) {
+		IntVar *v = (IntVar*) x[i];
+		v->attachBranch(this, i);
+		score[i] = v->getScore(var_branch);
+		if (!v->finished()) order.insert(i);
+	}
+}
+
+// Forget the changes made at levels search has gone back above, and rescore
+// the children they were made to
+void BranchGroup::untrailChanged() {
+	int level = engine().decisionLevel();
+	while (changed.size() && changed_level.last() > level) {
+		int i = changed.last();
+		changed.pop();
+		changed_level.pop();
+		changed_at[i] = -1;
+		scoreChanged(i);
+	}
+}
+
+void BranchGroup::domainChanged(int i) {
+	markChanged(i);
+	scoreChanged(i);
+}
+
+// List child i as changed at the current level, so that it is rescored when
+// search goes back above it
+void BranchGroup::markChanged(int i) {
+	int level = engine().decisionLevel();
+	if (level > 0 && changed_at[i] != level) {
+		changed.push(i);
+		changed_level.push(level);
+		changed_at[i] = level;
+	}
+}
+
+void BranchGroup::scoreChanged(int i) {
+	if (is_dirty[i]) return;
+	is_dirty[i] = 1;
+	dirty.push(i);
+}
+
+// The unfinished child with the best score, or -1 if there is none
+int BranchGroup::bestChild() {
+	for (int k = 0; k < dirty.size(); k++) {
+		int i = dirty[k];
+		is_dirty[i] = 0;
+		score[i] = x[i]->getScore(var_branch);
+		if (order.inHeap(i) || !x[i]->finished()) order.update(i);
+	}
+	dirty.clear();
+	// A finished child leaves the heap until search goes back above this level
+	while (!order.empty() && x[order[0]]->finished()) markChanged(order.removeMin());
+	if (order.empty()) return -1;
+	if (!so().branch_random) return order[0];
+
+	// The children tied with the best are at the top of the heap, found with
+	// dirty as the stack of heap positions to visit
+	double best = score[order[0]];
+	moves.clear();
+	dirty.push(0);
+	while (dirty.size()) {
+		int k = dirty.last();
+		dirty.pop();
+		if (k >= order.size() || score[order[k]] != best) continue;
+		if (!x[order[k]]->finished()) moves.push(order[k]);
+		dirty.push(2*k+1);
+		dirty.push(2*k+2);
+	}
+	std::sort((int*) moves, (int*) moves + moves.size());
+	return moves[engine().randInt(moves.size())];
+}
+
 // Creates and adds a branching to the engine
 void branch(vec<Branching*> x, VarBranch var_branch, ValBranch val_branch) {
-    engine.branching->add(createBranch(x, var_branch, val_branch));
+    engine().branching->add(createBranch(x, var_branch, val_branch));
 }
 // Creates a branching without adding to the engine
 BranchGroup* createBranch(vec<Branching*> x, VarBranch var_branch, ValBranch val_branch) {
@@ -108,6 +242,10 @@ BranchGroup* createBranch(vec<Branching*> x, VarBranch var_branch, ValBranch val
 PriorityBranchGroup::PriorityBranchGroup(vec<Branching*>& _x, VarBranch vb) 
     : BranchGroup(_x, vb) {}
 
+PriorityBranchGroup::~PriorityBranchGroup() {
+	deleteBranchings(annotations);
+}
+
 bool PriorityBranchGroup::finished() {
 	if (fin) return true;
 	for (int i = 0; i < annotations.size(); i++) {
@@ -125,7 +263,7 @@ double PriorityBranchGroup::getScore(VarBranch vb) {
 	return sum / x.size();
 }
 
-DecInfo* PriorityBranchGroup::branch() {
+DecInfo PriorityBranchGroup::branch() {
     // Check whether the current branching group has finished, 
     // if not yet then continue search with this one
 	if (cur >= 0 && !annotations[cur]->finished())
@@ -138,7 +276,7 @@ DecInfo* PriorityBranchGroup::branch() {
 		int i = 0;
 		while (i < annotations.size() && annotations[i]->finished()) i++;
 		if (i == annotations.size()) {
-			return NULL;
+			return DecInfo();
 		}
 		if (!terminal) cur = i;
 		return annotations[i]->branch();
@@ -152,11 +290,8 @@ DecInfo* PriorityBranchGroup::branch() {
             }
         }
         if (moves.size() == 0)
-            return NULL;
-        int rand_int = rand();
-        int index = rand_int % moves.size();
-
-        int best_i = moves[rand() % moves.size()];
+            return DecInfo();
+        int best_i = moves[engine().randInt(moves.size())];
         if (!terminal)
             cur = best_i;
         return annotations[best_i]->branch();
@@ -177,11 +312,11 @@ DecInfo* PriorityBranchGroup::branch() {
 		}
 	}
 	if (moves.size() == 0) {
-		return NULL;
+		return DecInfo();
 	}
 	int best_i = moves[0];
     // Special case of random selection of best moves
-	if (so.branch_random) best_i = moves[rand() % moves.size()];
+	if (so().branch_random) best_i = moves[engine().randInt(moves.size())];
 
 	if (!terminal) cur = best_i;
 	return annotations[best_i]->branch();
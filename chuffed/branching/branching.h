@@ -5,6 +5,7 @@
 #include <cassert>
 #include <climits>
 #include <chuffed/support/misc.h>
+#include <chuffed/support/heap.h>
 #include <chuffed/core/engine.h>
 
 //-----
@@ -43,21 +44,32 @@ enum ValBranch {
 
 class Tint;
 
+// A decision, returned by value; type 0 means there is nothing to branch on
 class DecInfo {
 public:
 	void *var; int val; int type;
+	DecInfo() : var(NULL), val(0), type(0) {}
 	DecInfo(void *_var, int _val, int _type = -1) :
 		var(_var), val(_val), type(_type) {}
+	bool none() const { return type == 0; }
 };
 
 class Branching {
 public:
+	virtual ~Branching() {}
 	virtual bool finished() = 0;
 	virtual double getScore(VarBranch vb) = 0;
-	virtual DecInfo* branch() = 0;
+	virtual DecInfo branch() = 0;
 };
 
 class BranchGroup : public Branching {
+	// For the heap of children, best score first, then input order
+	struct ScoreLt {
+		const vec<double>& score;
+		bool operator () (int i, int j) const { return score[i] > score[j] || (score[i] == score[j] && i < j); }
+		ScoreLt(const vec<double>& s) : score(s) {}
+	};
+
 public:
 	vec<Branching*> x;
 	VarBranch var_branch;
@@ -70,12 +82,31 @@ public:
 	// Intermediate data
 	vec<int> moves;
 
+	// Incremental selection, when all children are int vars and the
+	// heuristic depends on their domains or activities only
+	bool use_order;
+	vec<double> score;                // Score of each child when last computed
+	Heap<ScoreLt> order;              // Children by score, finished ones removed lazily
+	vec<int> dirty;                   // Children to rescore
+	vec<char> is_dirty;
+	vec<int> changed;                 // Children changed at each decision level, in order
+	vec<int> changed_level;
+	vec<int> changed_at;              // Level of the last entry of each child in changed, or -1
+
 	BranchGroup(VarBranch vb = VAR_INORDER, bool t = false);
 	BranchGroup(vec<Branching*>& _x, VarBranch vb, bool t = false);
+	~BranchGroup();
 
 	bool finished();
 	double getScore(VarBranch vb);
-	DecInfo* branch();
+	DecInfo branch();
+
+	void initOrder();
+	void domainChanged(int i);
+	void markChanged(int i);
+	void scoreChanged(int i);
+	void untrailChanged();
+	int bestChild();
 
 	virtual void add(Branching *n) { 
         x.push(n); 
@@ -87,16 +118,19 @@ public:
 void branch(vec<Branching*> x, VarBranch var_branch, ValBranch val_branch);
 // Creates a BranchGroup
 BranchGroup* createBranch(vec<Branching*> x, VarBranch var_branch, ValBranch val_branch);
+// Deletes the branchings in x that are owned by it
+void deleteBranchings(vec<Branching*>& x);
 
 class PriorityBranchGroup : public BranchGroup {
 public:
     vec<Branching*> annotations;
 
 	PriorityBranchGroup(vec<Branching*>& _x, VarBranch vb);
+	~PriorityBranchGroup();
 
 	bool finished();
 	double getScore(VarBranch vb);
-	DecInfo* branch();
+	DecInfo branch();
 
 	void add(Branching *n) { 
         annotations.push(n);
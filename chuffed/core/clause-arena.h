@@ -0,0 +1,184 @@
+#ifndef clause_arena_h
+#define clause_arena_h
+
+#include <cstdlib>
+#include <new>
+#include <chuffed/support/misc.h>
+#include <chuffed/core/sat-types.h>
+
+//=================================================================================================
+// ClauseArena -- storage for the clauses kept in the clause database:
+//
+// Clauses are packed into large chunks and named by 32-bit references made of
+// a chunk index and a word offset. Each clause is preceded by its own
+// reference. Chunks never move, so Clause pointers stay valid until the next
+// garbage collection, which copies the live clauses into a fresh arena.
+
+typedef unsigned int CRef;
+
+class ClauseArena {
+	static const int OFFSET_BITS = 20;
+	static const unsigned int OFFSET_MASK = (1u << OFFSET_BITS) - 1;
+	static const int MAX_CHUNKS = 1 << (30 - OFFSET_BITS);
+	static const int MIN_CHUNK = 1 << 12;
+
+	int* chunks[MAX_CHUNKS];
+	int nchunks;
+	int cap;                                    // words in the last chunk
+	int used;                                   // words used in the last chunk
+
+	// Allocate words plus the leading reference
+	int* allocWords(int words, CRef& r) {
+		int need = words + 1;
+		if (nchunks == 0 || used + need > cap) {
+			if (nchunks == MAX_CHUNKS) CHUFFED_ERROR("Clause arena is full\n");
+			int c = MIN_CHUNK << (nchunks < OFFSET_BITS - 12 ? nchunks : OFFSET_BITS - 12);
+			// A chunk holding an oversized clause takes nothing else
+			cap = need > c ? need : c;
+			chunks[nchunks++] = (int*) malloc(cap * sizeof(int));
+			used = 0;
+		}
+		int *mem = chunks[nchunks-1] + used;
+		r = (nchunks-1) << OFFSET_BITS | (used + 1);
+		used += need;
+		size += need;
+		*mem = r;
+		return mem + 1;
+	}
+
+public:
+	long long size;                             // words allocated
+	long long wasted;                           // words held by removed clauses
+
+	ClauseArena() : nchunks(0), cap(0), used(0), size(0), wasted(0) {}
+	~ClauseArena() { clear(); }
+
+	static int words(const Clause& c) { return 1 + 1 + c.size() + (c.learnt ? 4 : 0); }
+
+	Clause*  operator [] (CRef r) const { return (Clause*) (chunks[r >> OFFSET_BITS] + (r & OFFSET_MASK)); }
+	CRef     ref         (const Clause& c) const { return ((const CRef*) &c)[-1]; }
+
+	template<class V>
+	Clause* alloc(const V& ps, bool learnt = false) {
+		CRef r;
+		int *mem = allocWords(1 + ps.size() + (learnt ? 4 : 0), r);
+		Clause *c = new (mem) Clause(ps, learnt);
+		c->in_arena = 1;
+		if (learnt) c->lbd() = ps.size();
+		return c;
+	}
+
+	// Copy c, including the activity data of learnt clauses
+	Clause* alloc(const Clause& c) {
+		CRef r;
+		int w = words(c) - 1;
+		int *mem = allocWords(w, r);
+		for (int i = 0; i < w; i++) mem[i] = ((const int*) &c)[i];
+		Clause *n = (Clause*) mem;
+		n->in_arena = 1;
+		return n;
+	}
+
+	void free(Clause& c) { wasted += words(c); }
+
+	void clear() {
+		for (int i = 0; i < nchunks; i++) ::free(chunks[i]);
+		nchunks = cap = used = 0;
+		size = wasted = 0;
+	}
+
+	void moveTo(ClauseArena& to) {
+		to.clear();
+		for (int i = 0; i < nchunks; i++) to.chunks[i] = chunks[i];
+		to.nchunks = nchunks; to.cap = cap; to.used = used;
+		to.size = size; to.wasted = wasted;
+		nchunks = cap = used = 0;
+		size = wasted = 0;
+	}
+};
+
+//=================================================================================================
+// ExplRegion -- bump allocator for temporary explanation clauses:
+//
+// Explanations made at a decision level are only needed until that level is
+// undone, so they are carved out of large blocks and released all at once by
+// resetting to the position recorded when the level was opened. Blocks are
+// kept for reuse. An explanation made for an earlier level must outlive the
+// current one, so while a spill list is set it is malloc'd and pushed there.
+
+class ExplRegion {
+	static const int BLOCK_SIZE = 1 << 16;
+
+	vec<int*> blocks;
+	vec<int> block_cap;
+	int cur;                                    // block being carved
+	int pos;                                    // next free word in that block
+	vec<int> level_block;                       // position at the start of each level above the root
+	vec<int> level_pos;
+	vec<Clause*> *spill;                        // takes the allocations while set
+
+public:
+	ExplRegion() : cur(-1), pos(0), spill(NULL) {}
+	~ExplRegion() { for (int i = 0; i < blocks.size(); i++) ::free(blocks[i]); }
+
+	void spillTo(vec<Clause*> *list) { spill = list; }
+
+	Clause* alloc(int sz) {
+		if (spill != NULL) {
+			Clause *c = (Clause*) malloc(sizeof(Clause) + sz * sizeof(Lit));
+			c->clearFlags(); c->temp_expl = 1; c->sz = sz;
+			spill->push(c);
+			return c;
+		}
+		if (cur < 0 || pos + sz + 1 > block_cap[cur]) {
+			cur++;
+			pos = 0;
+			if (cur == blocks.size()) {
+				blocks.push(NULL);
+				block_cap.push(0);
+			}
+			if (block_cap[cur] < sz + 1) {
+				::free(blocks[cur]);
+				block_cap[cur] = sz + 1 > BLOCK_SIZE ? sz + 1 : BLOCK_SIZE;
+				blocks[cur] = (int*) malloc(block_cap[cur] * sizeof(int));
+			}
+		}
+		Clause *c = (Clause*) (blocks[cur] + pos);
+		pos += sz + 1;
+		c->clearFlags(); c->temp_expl = 1; c->sz = sz;
+		return c;
+	}
+
+	void newLevel() { level_block.push(cur); level_pos.push(pos); }
+
+	// Release everything allocated above the given level
+	void btToLevel(int level) {
+		if (level >= level_block.size()) return;
+		cur = level_block[level];
+		pos = level_pos[level];
+		level_block.resize(level);
+		level_pos.resize(level);
+	}
+
+	// Free the blocks past the one being carved
+	void releaseSpare() {
+		for (int i = cur+1; i < blocks.size(); i++) ::free(blocks[i]);
+		blocks.resize(cur+1);
+		block_cap.resize(cur+1);
+	}
+
+	long long bytes() const {
+		long long b = blocks.bytes() + block_cap.bytes() + level_block.bytes() + level_pos.bytes();
+		for (int i = 0; i < block_cap.size(); i++) b += (long long) block_cap[i] * sizeof(int);
+		return b;
+	}
+
+	// Release everything allocated at the root level
+	void clearRoot() {
+		assert(level_block.size() == 0);
+		cur = -1;
+		pos = 0;
+	}
+};
+
+#endif
@@ -5,7 +5,9 @@
 #include <chuffed/core/engine.h>
 #include <chuffed/core/sat.h>
 #include <chuffed/core/propagator.h>
+#include <chuffed/core/solver.h>
 #include <chuffed/parallel/parallel.h>
+#include <chuffed/parallel/portfolio.h>
 #include <chuffed/ldsb/ldsb.h>
 
 #include <iostream>
@@ -13,7 +15,7 @@
 
 #define PRINT_ANALYSIS 0
 
-std::ofstream implication_stream;
+thread_local std::ofstream implication_stream;
 
 
 //---------
@@ -21,7 +23,7 @@ std::ofstream implication_stream;
 
 inline void SAT::learntLenBumpActivity(int l) {
 	if (l >= MAX_SHARE_LEN) return;
-	if (engine.conflicts % 16 == 0) {
+	if (engine().conflicts % 16 == 0) {
 		time_point new_ll_time = chuffed_clock::now();
 		auto diff = std::chrono::duration_cast<duration>(new_ll_time-ll_time);
 		double factor = exp(to_sec(diff)/learnt_len_el);
@@ -39,23 +41,27 @@ inline void SAT::learntLenBumpActivity(int l) {
 inline void SAT::varDecayActivity() {
 	if ((var_inc *= 1.05) > 1e100) {
 		for (int i = 0; i < nVars(); i++) activity[i] *= 1e-100;
-		for (int i = 0; i < engine.vars.size(); i++) engine.vars[i]->activity *= 1e-100;
+		for (int i = 0; i < engine().vars.size(); i++) {
+			engine().vars[i]->activity *= 1e-100;
+			engine().vars[i]->scoreChanged();
+		}
 		var_inc *= 1e-100;
 	}
 }
 
 inline void SAT::varBumpActivity(Lit p) {
 	int v = var(p);
-	if (so.vsids) {
+	if (so().vsids) {
 		activity[v] += var_inc;
 		if (order_heap.inHeap(v)) order_heap.decrease(v);
-		if (so.sat_polarity == 1) polarity[v] = sign(p)^1;
-		if (so.sat_polarity == 2) polarity[v] = sign(p);
+		if (so().sat_polarity == 1) polarity[v] = sign(p)^1;
+		if (so().sat_polarity == 2) polarity[v] = sign(p);
 	}
 	if (c_info[v].cons_type == 1) {
 		int var_id = c_info[v].cons_id;
 		if (!ivseen[var_id]) {
-			engine.vars[var_id]->activity += var_inc;
+			engine().vars[var_id]->activity += var_inc;
+			engine().vars[var_id]->scoreChanged();
 			ivseen[var_id] = true;
 			ivseen_toclear.push(var_id);
 		}
@@ -78,10 +84,23 @@ inline void SAT::claDecayActivity() {
 //---------
 // main methods
 
+// Ask the propagator behind lazy reason r to explain p
+static inline Clause* explainLazy(Reason& r, Lit p) {
+	Propagator *prop = engine().propagators[r.d.d2];
+	if (!so().prop_profile) return prop->explain(p, r.d.d1);
+	auto start = chuffed_clock::now();
+	Clause *c = prop->explain(p, r.d.d1);
+	PropProfile& pp = engine().propProfile(prop->prop_id);
+	pp.expl_time += chuffed_clock::now() - start;
+	pp.explains++;
+	if (c) pp.expl_lits += c->size() - 1;
+	return c;
+}
+
 Clause* SAT::_getExpl(Lit p) {
 //	fprintf(stderr, "L%d - %d\n", decisionLevel(), trailpos[var(p)]);
 	Reason& r = reason[var(p)];
-	return engine.propagators[r.d.d2]->explain(p, r.d.d1);
+	return explainLazy(r, p);
 }
 
 Clause* SAT::getConfl(Reason& r, Lit p) {
@@ -89,7 +108,7 @@ Clause* SAT::getConfl(Reason& r, Lit p) {
 		case 0:
 			return r.pt;
 		case 1:
-			return engine.propagators[r.d.d2]->explain(p, r.d.d1);
+			return explainLazy(r, p);
 		default:
 			Clause& c = *short_expl;
 			c.sz = r.d.type; c[1] = toLit(r.d.d1);
@@ -119,9 +138,11 @@ void SAT::analyze(int nodeid, std::set<int>& contributingNogoods) {
 	claDecayActivity();
 	getLearntClause(nodeid, contributingNogoods);
 	explainUnlearnable(contributingNogoods);
-        if (so.exhaustive_activity)
+	if (so().learnt_minimize) minimizeLearnt();
+        if (so().exhaustive_activity)
             explainToExhaustion(contributingNogoods);
 	clearSeen();
+	int lbd = computeLBD();
 
 	int btlevel = findBackTrackLevel();
 	back_jumps += decisionLevel()-1-btlevel;
@@ -129,7 +150,7 @@ void SAT::analyze(int nodeid, std::set<int>& contributingNogoods) {
 	btToLevel(btlevel);
 	confl = NULL;
 
-	if (so.sort_learnt_level && out_learnt.size() >= 4) {
+	if (so().sort_learnt_level && out_learnt.size() >= 4) {
 		std::sort((Lit*) out_learnt + 2, (Lit*) out_learnt + out_learnt.size(), lit_sort);
 	}
 
@@ -140,39 +161,46 @@ void SAT::analyze(int nodeid, std::set<int>& contributingNogoods) {
         std::cerr << "\n";
         std::cerr << "out_learnt (interpreted):";
         for (int i = 0 ; i < out_learnt.size() ; i++)
-          std::cerr << " " << litString[toInt(out_learnt[i])];
+          std::cerr << " " << litString()[toInt(out_learnt[i])];
         std::cerr << "\n";
 #endif
 
-	Clause *c = Clause_new(out_learnt, true);
+	// Clauses which will be watched go straight into the clause arena
+	bool keep = so().learn && out_learnt.size() >= 2 && !(so().bin_clause_opt && out_learnt.size() == 2);
+	Clause *c = keep ? ca.alloc(out_learnt, true) : Clause_new(out_learnt, true);
 	c->activity() = cla_inc;
   c->rawActivity() = 1;
   c->clauseID() = nodeid;
+	c->lbd() = lbd;
 
 	learntLenBumpActivity(c->size());
 
-	if (so.parallel && so.learn && c->size()-(rand()/RAND_MAX) <= so.share_param) {
+	if (so().parallel && so().learn && c->size()-(engine().rng() / engine().rng.max()) <= so().share_param) {
 		slave.shareClause(*c);
 	}
 
+	if (portfolio.running && so().learn && c->size() <= so().share_param) {
+		portfolio.exportClause(*c);
+	}
+
         /* std::cerr << "conflict found clause of length " << c->size() << "\n"; */
 
         /* if (c->size() == 1) { */
         /*     std::cerr << "learntfact: " << getLitString(toInt((*c)[0])) << "\n"; */
         /* } */
 
-	if (so.learn && c->size() >= 2) {
-          addClause(*c, so.one_watch);
+	if (so().learn && c->size() >= 2) {
+          addClause(*c, so().one_watch);
         }
 
-	if (!so.learn || (so.bin_clause_opt && c->size() <= 2)) rtrail.last().push(c);
+	if (!so().learn || (so().bin_clause_opt && c->size() <= 2)) rtrail.last().push(c);
 
-	enqueue(out_learnt[0], (so.bin_clause_opt && c->size() == 2) ? Reason(out_learnt[1]) : c);
+	enqueue(out_learnt[0], (so().bin_clause_opt && c->size() == 2) ? Reason(out_learnt[1]) : c);
 
 	if (PRINT_ANALYSIS) printClause(*c);
 
-	if (so.ldsbad) {
-		assert(!so.parallel);
+	if (so().ldsbad) {
+		assert(!so().parallel);
 		vec<Lit> out_learnt2;
 		out_learnt2.push(out_learnt[0]);
 		for (int i = 0; i < decisionLevel(); i++) out_learnt2.push(~decLit(decisionLevel()-i));
@@ -180,10 +208,11 @@ void SAT::analyze(int nodeid, std::set<int>& contributingNogoods) {
 		rtrail.last().push(c);
 	}
 
-	if (so.ldsb && !ldsb.processImpl(c)) engine.async_fail = true;
+	if (so().ldsb && !ldsb->processImpl(c)) engine().async_fail = true;
 
-	if (learnts.size() >= so.nof_learnts ||
-		learnts_literals >= so.learnts_mlimit/4) reduceDB();
+	if (learnts.size() >= std::max(std::min(so().nof_learnts, learnts_cap), reduce_db_size) ||
+		learnts_literals >= so().learnts_mlimit/4 ||
+		(so().lbd_tiers && engine().conflicts >= next_reduce_db)) reduceDB();
 
 }
 
@@ -196,7 +225,7 @@ void SAT::getLearntClause(int nodeid, std::set<int>& contributingNogoods) {
 	Clause* expl = confl;
 	Reason last_reason = NULL;
 
-        if (so.debug) {
+        if (so().debug) {
             std::cerr << "trail of conflict level:";
             for (int i = 0 ; i < ctrail.size() ; i++) {
                 std::cerr << " ";
@@ -224,6 +253,7 @@ void SAT::getLearntClause(int nodeid, std::set<int>& contributingNogoods) {
 		if (c.learnt) {
       c.activity() += cla_inc;
       c.rawActivity() += 1;
+      c.used = 1;
       contributingNogoods.insert(c.clauseID());
     }
 
@@ -239,7 +269,7 @@ void SAT::getLearntClause(int nodeid, std::set<int>& contributingNogoods) {
                 /*   std::cerr << "\n"; */
                 /* } */
 
-                if (so.print_implications) {
+                if (so().print_implications) {
                   if (!implication_stream.is_open()) {
                     implication_stream.open("implication-log.csv");
                   }
@@ -257,7 +287,7 @@ void SAT::getLearntClause(int nodeid, std::set<int>& contributingNogoods) {
                   implication_stream << "\n";
                 }
 
-                if (so.debug) {
+                if (so().debug) {
                     if (c.learnt) {
                         std::cerr << "L" << c.clauseID() << " ";
                     }
@@ -285,18 +315,18 @@ void SAT::getLearntClause(int nodeid, std::set<int>& contributingNogoods) {
 				seen[x] = 1;
 				if (isCurLevel(x)) {
                                   pathC++;
-                                  if (so.debug) {
+                                  if (so().debug) {
                                       std::cerr << getLitString(toInt(~q)) << " is from current level; incremented pathC to " << pathC << "\n";
                                   }
                                 } else {
-                                  if (so.debug) {
+                                  if (so().debug) {
                                       std::cerr << "added " << getLitString(toInt(~q)) << " to nogood\n";
                                   }
                                   out_learnt.push(q);
                                   out_learnt_level.push(getLevel(x));
                                 }
 			} else {
-                          if (so.debug) {
+                          if (so().debug) {
                               //                            std::cerr << " but already seen this variable";
                               std::cerr << getLitString(toInt(~q)) << " already marked as seen; skipping explanation\n";
                           }
@@ -318,12 +348,12 @@ FindNextExpl:
 		seen[var(p)] = 0;
 		pathC--;
 
-                if (so.debug) {
+                if (so().debug) {
                     std::cerr << "selected " << getLitString(toInt(p)) << " as next literal to explain away\n";
                 }
 
 		if (pathC == 0 && flags[var(p)].uipable) {
-                    if (so.debug) {
+                    if (so().debug) {
                         std::cerr << "one only literal left at current level; finished\n";
                     }
                     break;
@@ -331,7 +361,7 @@ FindNextExpl:
 
                 // This appears to be just an optimisation.
 		if (last_reason == reason[var(p)]) {
-                    if (so.debug)
+                    if (so().debug)
                         std::cerr << "same reason as previously explained literal; skipping\n";
                     goto FindNextExpl;
                 }
@@ -351,11 +381,11 @@ int SAT::findConflictLevel() {
 		int l = trailpos[var((*confl)[i])];
 		if (l > tp) tp = l;
 	}
-	int clevel = engine.tpToLevel(tp);
+	int clevel = engine().tpToLevel(tp);
 
-	if (so.sym_static && clevel == 0) {
+	if (so().sym_static && clevel == 0) {
 		btToLevel(0);
-		engine.async_fail = true;
+		engine().async_fail = true;
 		NOT_SUPPORTED;
 		// need to abort analyze as well
 		return 0;
@@ -388,6 +418,7 @@ void SAT::explainUnlearnable(std::set<int>& contributingNogoods) {
 		Clause& c = *getExpl(~p);
 		removed.push(p);
 		out_learnt[i] = out_learnt.last();
+                out_learnt_level[i] = out_learnt_level.last();
                 out_learnt.pop();
                 out_learnt_level.pop();
                 i--;
@@ -406,6 +437,89 @@ void SAT::explainUnlearnable(std::set<int>& contributingNogoods) {
 	pushback_time += std::chrono::duration_cast<duration>(chuffed_clock::now() - start);
 }
 
+// Remove the literals of the learnt clause whose reasons are covered by the
+// rest of the clause, recursively (MiniSat's minimisation). Lazy reasons
+// below the conflict level are explained by stepping the engine trail back,
+// which is redone before the clause is used.
+void SAT::minimizeLearnt() {
+	unsigned int abstract_levels = 0;
+	for (int i = 1; i < out_learnt.size(); i++) abstract_levels |= abstractLevel(out_learnt_level[i]);
+
+	rewind_pos = engine().trail.size();
+	analyze_toclear.clear();
+	int i, j;
+	for (i = j = 1; i < out_learnt.size(); i++) {
+		Lit p = out_learnt[i];
+		if (litRedundant(p, abstract_levels)) {
+			analyze_toclear.push(p);
+		} else {
+			out_learnt[j] = p;
+			out_learnt_level[j++] = out_learnt_level[i];
+		}
+	}
+	minimize_lits += out_learnt.size();
+	minimize_removed_lits += i - j;
+	out_learnt.shrink(i - j);
+	out_learnt_level.shrink(i - j);
+
+	vec<TrailElem>& t = engine().trail;
+	while (rewind_pos < t.size()) t[rewind_pos++].swap();
+
+	for (int i = 0; i < analyze_toclear.size(); i++) seen[var(analyze_toclear[i])] = 0;
+}
+
+// Explanation of p from its lazy reason, with the engine trail stepped to
+// where p was set. Only the engine state is stepped back, not the Boolean
+// assignment, so the caller must not trust literals set at or after p. The
+// explanation lives as long as p, as a propagator may keep it for reuse.
+Clause* SAT::getRewoundExpl(Lit p) {
+	int pos = trailpos[var(p)];
+	vec<TrailElem>& t = engine().trail;
+	while (rewind_pos > pos) t[--rewind_pos].swap();
+	while (rewind_pos < pos) t[rewind_pos++].swap();
+	int sz = t.size();
+	expl_region.spillTo(&rtrail[getLevel(var(p))]);
+	Clause *c = _getExpl(p);
+	expl_region.spillTo(NULL);
+	assert(t.size() == sz);           // (explaining must not trail anything)
+	return c;
+}
+
+// Whether ~p, false in the learnt clause, is implied by the seen literals.
+// Literals found redundant on the way stay seen and are queued in
+// analyze_toclear.
+bool SAT::litRedundant(Lit p, unsigned int abstract_levels) {
+	Reason& r = reason[var(p)];
+	if (r.d.type == 0 && r.pt == NULL) return false;
+
+	analyze_stack.clear(); analyze_stack.push(p);
+	int top = analyze_toclear.size();
+	while (analyze_stack.size() > 0) {
+		Lit s = analyze_stack.last(); analyze_stack.pop();
+		bool lazy = reason[var(s)].isLazy();
+		Clause *cp = lazy ? getRewoundExpl(~s) : getExpl(~s);
+		for (int i = 1; cp != NULL && i < cp->size(); i++) {
+			Lit q = (*cp)[i];
+			int x = var(q);
+			if (lazy && (value(q) != l_False || trailpos[x] >= trailpos[var(s)])) cp = NULL;
+			else if (seen[x]) continue;
+			else if (reason[x].d.type == 0 && reason[x].pt == NULL) cp = NULL;
+			else if (!(abstractLevel(getLevel(x)) & abstract_levels)) cp = NULL;
+			else {
+				seen[x] = 1;
+				analyze_stack.push(q);
+				analyze_toclear.push(q);
+			}
+		}
+		if (cp == NULL) {
+			for (int j = top; j < analyze_toclear.size(); j++) seen[var(analyze_toclear[j])] = 0;
+			analyze_toclear.shrink(analyze_toclear.size() - top);
+			return false;
+		}
+	}
+	return true;
+}
+
 void SAT::explainToExhaustion(std::set<int>& contributingNogoods) {
     vec<char> oldseen(seen);
     vec<Lit> old_out_learnt(out_learnt);
@@ -415,11 +529,11 @@ void SAT::explainToExhaustion(std::set<int>& contributingNogoods) {
         Lit p = out_learnt[i];
         assert(!reason[var(p)].isLazy());
         Clause* cp = getExpl(~p);
-        if (so.debug) {
+        if (so().debug) {
             std::cerr << "checking literal " << getLitString(toInt(~p)) << "\n";
         }
         if (cp == NULL) {
-            if (so.debug) {
+            if (so().debug) {
                 std::cerr << "it has no reason\n";
             }
             continue;
@@ -430,12 +544,13 @@ void SAT::explainToExhaustion(std::set<int>& contributingNogoods) {
             contributingNogoods.insert(c.clauseID());
         }
         out_learnt[i] = out_learnt.last();
+        out_learnt_level[i] = out_learnt_level.last();
         out_learnt.pop();
         out_learnt_level.pop();
         i--;
         for (int j = 1; j < c.size(); j++) {
             Lit q = c[j];
-            if (so.debug) {
+            if (so().debug) {
                 std::cerr << "adding literal " << getLitString(toInt(q));
             }
             if (!seen[var(q)]) {
@@ -443,11 +558,11 @@ void SAT::explainToExhaustion(std::set<int>& contributingNogoods) {
                 out_learnt.push(q);
                 out_learnt_level.push(getLevel(var(q)));
             } else {
-                if (so.debug) {
+                if (so().debug) {
                     std::cerr << " but already seen it";
                 }
             }
-            if (so.debug) {
+            if (so().debug) {
                 std::cerr << "\n";
             }
         }
@@ -465,6 +580,18 @@ void SAT::clearSeen() {
 	for (int i = 0; i < out_learnt.size(); i++) seen[var(out_learnt[i])] = 0;    // ('seen[]' is now cleared)
 }
 
+// Number of distinct decision levels in the learnt clause
+int SAT::computeLBD() {
+	int lbd = 0;
+	level_seen.growTo(decisionLevel()+1, 0);
+	for (int i = 0; i < out_learnt_level.size(); i++) {
+		int l = out_learnt_level[i];
+		if (!level_seen[l]) { level_seen[l] = 1; lbd++; }
+	}
+	for (int i = 0; i < out_learnt_level.size(); i++) level_seen[out_learnt_level[i]] = 0;
+	return lbd;
+}
+
 int SAT::findBackTrackLevel() {
 	if (out_learnt.size() < 2) {
 		nrestarts++;
@@ -482,7 +609,7 @@ int SAT::findBackTrackLevel() {
 	out_learnt[1] = p;
         out_learnt_level[1] = plevel;
 
-	return engine.tpToLevel(trailpos[var(p)]);
+	return engine().tpToLevel(trailpos[var(p)]);
 }
 
 
@@ -496,9 +623,9 @@ void SAT::printLit(Lit p) {
 	printf("%d:", toInt(p));
 	ChannelInfo& ci = c_info[var(p)];
 	if (ci.cons_type == 1) {
-		engine.vars[ci.cons_id]->printLit(ci.val, ci.val_type * 3 ^ sign(p));
+		engine().vars[ci.cons_id]->printLit(ci.val, ci.val_type * 3 ^ sign(p));
 	} else if (ci.cons_type == 2) {
-		engine.propagators[ci.cons_id]->printLit(ci.val, sign(p));
+		engine().propagators[ci.cons_id]->printLit(ci.val, sign(p));
 	} else {
 		printf(":%d:%d, ", sign(p), trailpos[var(p)]);
 	}
@@ -532,7 +659,7 @@ void SAT::checkExplanation(Clause& c, int clevel, int index) {
 	NOT_SUPPORTED;
 	for (int i = 1; i < c.size(); i++) {
 		assert(value(c[i]) == l_False);
-		assert(trailpos[var(c[i])] < engine.trail_lim[clevel]);
+		assert(trailpos[var(c[i])] < engine().trail_lim[clevel]);
 		vec<Lit>& ctrail = trail[trailpos[var(c[i])]];
 		int pos = -1;
 		for (int j = 0; j < ctrail.size(); j++) {
@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <cassert>
+#include <algorithm>
 
 #include <fstream>
 #include <iostream>
@@ -10,10 +11,12 @@
 #include <chuffed/core/options.h>
 #include <chuffed/core/engine.h>
 #include <chuffed/core/sat.h>
+#include <chuffed/core/solver.h>
 #include <chuffed/core/propagator.h>
 #include <chuffed/branching/branching.h>
 #include <chuffed/mip/mip.h>
 #include <chuffed/parallel/parallel.h>
+#include <chuffed/parallel/portfolio.h>
 #include <chuffed/ldsb/ldsb.h>
 
 #include <chuffed/flatzinc/flatzinc.h>
@@ -28,40 +31,47 @@
 using namespace Profiling;
 #endif
 
-Engine engine;
-
 uint64_t bit[65];
 
-Tint trail_inc;
+static struct BitInit {
+    BitInit() { for (int i = 0; i < 64; i++) bit[i] = ((long long) 1 << i); }
+} bit_init;
+
+Engine main_engine;
+THREAD_LOCAL Engine* engine_ptr = &main_engine;
+
+Solver main_solver(&main_so, &main_engine, &main_sat);
 
-int nextnodeid = 0;
+thread_local int nextnodeid = 0;
+
+void topLevelFailure() {
+    engine().tl_failed = true;
+}
 
 #ifdef HAS_PROFILER
 Profiling::Connector profilerConnector(6565);
 #endif
 
-std::map<IntVar*, string> intVarString;
-std::map<BoolView, string> boolVarString;
-string mostRecentLabel;
+thread_local string mostRecentLabel;
 
-extern std::map<int,string> learntClauseString;
-extern std::ofstream learntStatsStream;
+extern thread_local std::map<int,string> learntClauseString;
+extern thread_local std::ofstream learntStatsStream;
 
-std::ofstream node_stream;
+thread_local std::ofstream node_stream;
 
 #ifdef HAS_PROFILER
 bool doProfiling() {
-    return so.print_nodes || profilerConnector.connected();
+    return so().print_nodes || profilerConnector.connected();
 }
 
 void sendNode(Node& node) {
-    if (so.print_nodes) {
+    if (so().print_nodes) {
         if (!node_stream.is_open()) {
             node_stream.open("node-log.csv");
             node_stream << "type,id,restart,parent,alt,children,status,time,label,nogood,block,uses_objective,backjump_distance,decision_level,info\n";
         } 
         node.print(node_stream);
-        if (so.debug) {
+        if (so().debug) {
             node.print(std::cerr);
         }
     }
@@ -71,12 +81,12 @@ void sendNode(Node& node) {
 
 // nodepath is the sequence of node ids leading from the root to the
 // current node (inclusive).
-std::vector<int> nodepath;
+thread_local std::vector<int> nodepath;
 
 // altpath is the sequence of alternatives one follows to get from the
 // root to the current node.  It is typically one element shorter than
 // nodepath.
-std::vector<int> altpath;
+thread_local std::vector<int> altpath;
 
 // decisionLevelTip[i] is the number of elements in nodepath that
 // belong to decision level i or above.  For example, in this
@@ -95,7 +105,7 @@ std::vector<int> altpath;
 // be depended on.  In other words, there may be elements at the end
 // of the vector, past the current decision level, whose values are
 // stale and meaningless.
-std::vector<int> decisionLevelTip;
+thread_local std::vector<int> decisionLevelTip;
 
 // When we rewind after a backjump, should we send the skipped nodes
 // to the profiler?
@@ -171,7 +181,7 @@ void rewindPaths(
             if (doProfiling()) {
               sendNode(profilerConnector
                        .createNode(nodeid, parent, myalt, 0, SKIPPED)
-                       .set_restart_id(engine.restart_count)
+                       .set_restart_id(engine().restart_count)
                        .set_decision_level(currentDecisionLevel)
                        .set_time(timestamp));
             }
@@ -193,39 +203,81 @@ void rewindPaths(
 
 Engine::Engine()
     : finished_init(false)
+    , tl_failed(false)
     , problem(NULL)
     , opt_var(NULL)
     , best_sol(-1)
+    , warm_bound(false)
+    , status(RES_UNK)
+    , queue_mask(0)
     , last_prop(NULL)
+    , async_fail(false)
+    , lns_active(false)
+    , lns_complete(false)
+    , lns_relax(0)
+    , lns_start(0)
 
     , start_time(chuffed_clock::now())
+    , init_time(duration::zero())
     , opt_time(duration::zero())
+    , parse_time(duration::zero())
+    , base_memory(0)
+    , mem_static(0)
+    , next_mem_check(0)
     , conflicts(0)
     , nodes(1)
     , propagations(0)
     , solutions(0)
     , next_simp_db(0)
+    , lns_neighbourhoods(0)
+    , lns_exhausted(0)
+    , peak_depth(0)
+    , restart_count(0)
+    , trail_inc(0)
     , output_stream(&std::cout)
 {
-    p_queue.growTo(num_queues);
-    for (int i = 0; i < 64; i++) bit[i] = ((long long) 1 << i);
+    // The MIP propagator registers with the engine bound to the thread,
+    // which is another one while a Solver builds this
+    Engine *prev = engine_ptr;
+    engine_ptr = this;
     branching = new BranchGroup();
     mip = new MIP();
+    ldsb = new LDSB();
+    engine_ptr = prev;
+}
+
+// The engine owns the model built in it: the problem, branchings, outputs,
+// propagators (the MIP one included) and vars
+Engine::~Engine() {
+    delete problem;
+    delete branching;
+    deleteBranchings(outputs);
+    // Most checkers are propagators too, and go with them
+    for (int i = 0; i < checkers.size(); i++) {
+        if (!dynamic_cast<Propagator*>(checkers[i])) delete checkers[i];
+    }
+    for (int i = 0; i < propagators.size(); i++) delete propagators[i];
+    for (int i = 0; i < pseudo_props.size(); i++) delete pseudo_props[i];
+    // Vars are specialised in place in blocks from malloc, see newIntVar
+    for (int i = 0; i < vars.size(); i++) {
+        vars[i]->~IntVar();
+        free(vars[i]);
+    }
 }
 
 inline void Engine::newDecisionLevel() {
-    trail_inc++;
-    if (so.debug) {
+    trailChange(trail_inc, trail_inc + 1);
+    if (so().debug) {
         std::cerr << "Engine::newDecisionLevel\n";
         std::cerr << "  trail_lim size is currently " << trail_lim.size() << "\n";
         std::cerr << "  pushing " << trail.size() << " to trail_lim\n";
     }
     trail_lim.push(trail.size());
-    if (so.debug) {
+    if (so().debug) {
         std::cerr << "trail_lim is now: " << showVec(trail_lim) << "\n";
     }
-    sat.newDecisionLevel();
-    if (so.mip) mip->newDecisionLevel();
+    sat().newDecisionLevel();
+    if (so().mip) mip->newDecisionLevel();
     assert(dec_info.size() == decisionLevel());
     peak_depth = max(peak_depth, decisionLevel());
 }
@@ -242,13 +294,13 @@ inline void Engine::makeDecision(DecInfo& di, int alt) {
     altpath.push_back(alt);
     if (di.var) {
 #if DEBUG_VERBOSE
-        std::cerr << "makeDecision: " << intVarString[(IntVar*)di.var] << " / " << di.val << " (" << alt << ")" << std::endl;
+        std::cerr << "makeDecision: " << intVarString()[(IntVar*)di.var] << " / " << di.val << " (" << alt << ")" << std::endl;
 #endif
 #ifdef HAS_PROFILER
         if (doProfiling()) {
             std::stringstream ss;
-            /* ss << intVarString[(IntVar*)di.var] << " / " << di.val << " (" << alt << ")"; */
-            ss << intVarString[(IntVar*)di.var];
+            /* ss << intVarString()[(IntVar*)di.var] << " / " << di.val << " (" << alt << ")"; */
+            ss << intVarString()[(IntVar*)di.var];
             switch (di.type) {
             case 1: ss << "=="; break;
             case 2: ss << ">="; break;
@@ -271,24 +323,37 @@ inline void Engine::makeDecision(DecInfo& di, int alt) {
             mostRecentLabel = ss.str();
         }
 #endif
-        sat.enqueue(toLit(di.val ^ alt));
+        sat().enqueue(toLit(di.val ^ alt));
     }
-    if (so.ldsb && di.var && di.type == 1) ldsb.processDec(sat.trail.last()[0]);
+    if (so().ldsb && di.var && di.type == 1) ldsb->processDec(sat().trail.last()[0]);
     //  if (opt_var && di.var == opt_var && ((IntVar*) di.var)->isFixed()) printf("objective = %d\n", ((IntVar*) di.var)->getVal());
 }
 
 void optimize(IntVar* v, int t) {
-    engine.opt_var = v;
-    engine.opt_type = t;
-    engine.branching->add(v);
+    engine().opt_var = v;
+    engine().opt_type = t;
+    engine().branching->add(v);
     v->setPreferredVal(t == OPT_MIN ? PV_MIN : PV_MAX);
 }
 
+// The warm start only leads to the first solution, after which the vars
+// branch as they did without it
+void Engine::clearWarmStart() {
+    warm_bound = false;
+    if (so().warm_start.empty()) return;
+    for (int i = 0; i < vars.size(); i++) vars[i]->hint_val = INT_MIN;
+    for (int i = hint_polarity.size(); i-- > 0; ) {
+        sat().polarity[var(hint_polarity[i])] = sign(hint_polarity[i]);
+    }
+    hint_polarity.clear(true);
+}
+
 inline bool Engine::constrain() {
     best_sol = opt_var->getVal();
+    if (so().lns && so().lazy) lnsSolution();
     opt_time = std::chrono::duration_cast<duration>(chuffed_clock::now() - start_time) - init_time;
 
-    sat.btToLevel(0);
+    sat().btToLevel(0);
     restart_count++;
     nodepath.resize(0);
     altpath.resize(0);
@@ -299,7 +364,7 @@ inline bool Engine::constrain() {
     }
 #endif
   
-    if (so.parallel) {
+    if (so().parallel) {
         Lit p = opt_type ? opt_var->getLit(best_sol+1, 2) : opt_var->getLit(best_sol-1, 3);
         vec<Lit> ps;
         ps.push(p);
@@ -314,47 +379,194 @@ inline bool Engine::constrain() {
     Lit p = opt_type ? opt_var->getLit(best_sol+1, 2) : opt_var->getLit(best_sol-1, 3);
     assumptions.clear();
     assumptions.push(toInt(p));
+    clearWarmStart();
 
-    if (so.mip) mip->setObjective(best_sol);
+    if (so().mip) mip->setObjective(best_sol);
+    if (lns_active) lnsNeighbourhood();
 
     /* return (opt_type ? opt_var->setMin(best_sol+1) : opt_var->setMax(best_sol-1)); */
     return true;
 }
 
+//-----
+// Large neighbourhood search
+//
+// Once a solution is found, each neighbourhood fixes part of the outputs to
+// their values in it by assumption literals decided after the objective
+// bound. Assumptions are ordinary decisions, so every clause learnt inside a
+// neighbourhood is valid outside it and is kept. A neighbourhood ends with a
+// better solution, when conflict analysis refutes one of its fixings (no
+// better solution is left in it), or after so.lns_fail_limit conflicts.
+
+// Outputs that can be fixed during search: literals of lazily encoded int
+// vars can only be made at the root
+static bool lnsFixable(Branching *b) {
+    VarType t = ((Var*) b)->getType();
+    return t == BOOL_VAR || t == INT_VAR_EL || t == INT_VAR_SL;
+}
+
+static int lnsDomSize(Branching *b) {
+    if (((Var*) b)->getType() == BOOL_VAR) return ((BoolView*) b)->isFixed() ? 1 : 2;
+    IntVar *x = (IntVar*) b;
+    return x->getMax() - x->getMin() + 1;
+}
+
+// Record the incumbent
+void Engine::lnsSolution() {
+    lns_sol.growTo(outputs.size());
+    for (int i = 0; i < outputs.size(); i++) {
+        Branching *b = outputs[i];
+        lns_sol[i] = INT_MIN;
+        if (!lnsFixable(b)) continue;
+        if (((Var*) b)->getType() == BOOL_VAR) {
+            if (((BoolView*) b)->isFixed()) lns_sol[i] = ((BoolView*) b)->getVal();
+        } else if (((IntVar*) b)->isFixed()) {
+            lns_sol[i] = ((IntVar*) b)->getVal();
+        }
+    }
+    if (!lns_active) {
+        lns_active = true;
+        lns_relax = so().lns_relax / 100.0;
+    }
+}
+
+// Start a neighbourhood, assumptions holds the objective bound only
+void Engine::lnsNeighbourhood() {
+    lns_neighbourhoods++;
+    lns_complete = false;
+    lns_start = conflicts;
+    lns_dom.clear();
+}
+
+// Leave the neighbourhood for a new one. One that was exhausted was too
+// small, one that hit the fail limit too large.
+void Engine::lnsRestart(bool exhausted) {
+    if (exhausted) {
+        lns_exhausted++;
+        lns_relax = std::min(1.0, lns_relax * 1.2);
+    } else {
+        lns_relax = std::max(0.01, lns_relax / 1.2);
+    }
+    if (so().verbosity >= 2) {
+        std::cerr << "% lns: " << (exhausted ? "exhausted" : "fail limit") << ", relax " << lns_relax << "\n";
+    }
+    sat().btToLevel(0);
+    restart_count++;
+    nodepath.resize(0);
+    altpath.resize(0);
+#ifdef HAS_PROFILER
+    if (doProfiling()) {
+        profilerConnector.restart("chuffed", restart_count);
+    }
+#endif
+    sat().confl = NULL;
+    assumptions.shrink(assumptions.size()-1);
+    lnsNeighbourhood();
+}
+
+// Assume the next fixing of the neighbourhood, false once enough outputs are
+// fixed. With so.lns_pg, outputs whose domains shrank since the last fixing
+// are preferred, so the fixed part stays connected.
+bool Engine::lnsExtend() {
+    if (!lns_active || lns_complete || decisionLevel() != assumptions.size()) return false;
+    int n = outputs.size();
+    int target = n - (int) (lns_relax * n + 0.5);
+    bool first = lns_dom.size() == 0;
+    lns_dom.growTo(n, 0);
+    lns_cand.clear();
+    lns_reduced.clear();
+    int fixed = 0;
+    for (int i = 0; i < n; i++) {
+        Branching *b = outputs[i];
+        if (!lnsFixable(b)) continue;
+        int sz = lnsDomSize(b);
+        if (sz == 1) {
+            fixed++;
+        } else if (lns_sol[i] != INT_MIN &&
+                   (((Var*) b)->getType() == BOOL_VAR || ((IntVar*) b)->indomain(lns_sol[i]))) {
+            if (!first && sz < lns_dom[i]) lns_reduced.push(i);
+            else lns_cand.push(i);
+        }
+        lns_dom[i] = sz;
+    }
+    if (fixed >= target || lns_cand.size() + lns_reduced.size() == 0) {
+        lns_complete = true;
+        return false;
+    }
+    vec<int>& from = (so().lns_pg && lns_reduced.size()) || lns_cand.size() == 0 ? lns_reduced : lns_cand;
+    int i = from[randInt(from.size())];
+    Lit p;
+    if (((Var*) outputs[i])->getType() == BOOL_VAR) p = ((BoolView*) outputs[i])->getLit(lns_sol[i]);
+    else p = ((IntVar*) outputs[i])->getLit(lns_sol[i], 1);
+    assumptions.push(toInt(p));
+    return true;
+}
+
 bool Engine::propagate() {
     if (async_fail) {
         async_fail = false;
-        assert(!so.lazy || sat.confl);
+        assert(!so().lazy || sat().confl);
         return false;
     }
 
     last_prop = NULL;
 
- WakeUp:
-
-    if (!sat.consistent() && !sat.propagate()) return false;
+    while (true) {
+        if (!sat().consistent() && !sat().propagate()) return false;
+        wakeChangedVars();
+        if (sat().confl) return false;
+        if (!queue_mask) return true;
+
+        // Run the most urgent queue as a batch. The domain changes of each
+        // propagator are passed on right away, but unit propagation waits
+        // until a more urgent queue fills or the batch is over.
+        int i = lowestBit(queue_mask);
+        do {
+            Propagator *p = p_queue[i].pop();
+            if (!p_queue[i].size()) queue_mask &= ~(1u << i);
+            propagations++;
+            bool ok = so().prop_profile ? propagateProfiled(p) : p->propagate();
+            p->clearPropState();
+            if (!ok) {
+                p->next_stage = -1;
+                return false;
+            }
+            if (p->next_stage >= 0) {
+                p->in_queue = true;
+                schedule(p, p->next_stage);
+                p->next_stage = -1;
+            }
+            wakeChangedVars();
+            if (sat().confl) return false;
+        } while (queue_mask && lowestBit(queue_mask) == i);
+    }
+}
 
+// Wake the propagators of the vars changed since the last call
+void Engine::wakeChangedVars() {
     for (int i = 0; i < v_queue.size(); i++) {
         v_queue[i]->wakePropagators();
     }
     v_queue.clear();
-
-    if (sat.confl) return false;
-
     last_prop = NULL;
+}
 
-    for (int i = 0; i < num_queues; i++) {
-        if (p_queue[i].size()) {
-            Propagator *p = p_queue[i].last(); p_queue[i].pop();
-            propagations++;
-            bool ok = p->propagate();
-            p->clearPropState();
-            if (!ok) return false;
-            goto WakeUp;
-        }
+// Run p, charging its time, prunings and failure to its profile.
+// Changes are the int vars it woke plus the pure Boolean literals it set.
+bool Engine::propagateProfiled(Propagator *p) {
+    PropProfile& pp = propProfile(p->prop_id);
+    int sat_pos = sat().trail.last().size();
+    auto start = chuffed_clock::now();
+    bool ok = p->propagate();
+    pp.prop_time += chuffed_clock::now() - start;
+    pp.calls++;
+    pp.changes += v_queue.size();
+    vec<Lit>& t = sat().trail.last();
+    for (int i = sat_pos; i < t.size(); i++) {
+        if (sat().c_info[var(t[i])].cons_type == 0) pp.changes++;
     }
-
-    return true;
+    if (!ok) pp.failures++;
+    return ok;
 }
 
 // Clear all uncleared intermediate propagation states
@@ -366,6 +578,7 @@ void Engine::clearPropState() {
         for (int j = 0; j < p_queue[i].size(); j++) p_queue[i][j]->clearPropState();
         p_queue[i].clear();
     }
+    queue_mask = 0;
 }
 
 void Engine::btToPos(int pos) {
@@ -376,7 +589,7 @@ void Engine::btToPos(int pos) {
 }
 
 void Engine::btToLevel(int level) {
-    if (so.debug) {
+    if (so().debug) {
         std::cerr << "Engine::btToLevel( " << level << ")\n";
     }
     if (decisionLevel() == 0 && level == 0) return;
@@ -384,10 +597,11 @@ void Engine::btToLevel(int level) {
 
     btToPos(trail_lim[level]);
     trail_lim.resize(level);
-    if (so.debug) {
+    if (so().debug) {
         std::cerr << "trail_lim is now: " << showVec(trail_lim) << "\n";
     }
     dec_info.resize(level);
+    for (int i = 0; i < ordered_groups.size(); i++) ordered_groups[i]->untrailChanged();
 }
 
 
@@ -395,9 +609,9 @@ void Engine::btToLevel(int level) {
 void Engine::topLevelCleanUp() {
     trail.clear();
 
-    if (so.fd_simplify && propagations >= next_simp_db) simplifyDB();
+    if (so().fd_simplify && propagations >= next_simp_db) simplifyDB();
 
-    sat.topLevelCleanUp();
+    sat().topLevelCleanUp();
 }
 
 void Engine::simplifyDB() {
@@ -426,25 +640,25 @@ void Engine::blockCurrentSol() {
         } else {
             c[i] = ((IntVar*) outputs[i])->getValLit();
         }
-        if (!sat.isRootLevel(var(c[i]))) root_failure = false;
-        assert(sat.value(c[i]) == l_False);
+        if (!sat().isRootLevel(var(c[i]))) root_failure = false;
+        assert(sat().value(c[i]) == l_False);
     }
-    if (root_failure) sat.btToLevel(0);
-    sat.confl = &c;
+    if (root_failure) sat().btToLevel(0);
+    sat().confl = &c;
 }
 
 
 unsigned int Engine::getRestartLimit(unsigned int i) {
-    switch (so.restart_type) {
+    switch (so().restart_type) {
         case NONE:
             if (i > 1) {
                 CHUFFED_ERROR("A restart occurred while using search without restarts");
             }
             return UINT_MAX;
         case CONSTANT:
-            return so.restart_scale;
+            return so().restart_scale;
         case LINEAR:
-            return i * so.restart_scale;
+            return i * so().restart_scale;
         case LUBY:
             while (true) {
                 unsigned int exp = 0U;
@@ -452,35 +666,35 @@ unsigned int Engine::getRestartLimit(unsigned int i) {
                     while ( (i >> (++exp)) > 1U ) {}
                 }
                 if (i == (1U<<(exp+1))-1) {
-                    return static_cast<int>(1UL << exp) * so.restart_scale;
+                    return static_cast<int>(1UL << exp) * so().restart_scale;
                 }
                 i=i-(1U<<exp)+1;
             }
         case GEOMETRIC:
-            return so.restart_scale * ((int) pow(so.restart_base, i));
+            return so().restart_scale * ((int) pow(so().restart_base, i));
         default:
             i = (i+1)/2;
-            return (((i-1) & ~i) + 1) * so.restart_scale;
+            return (((i-1) & ~i) + 1) * so().restart_scale;
     }
     NEVER;
 }
 
 void Engine::toggleVSIDS() {
-    if (!so.vsids) {
+    if (!so().vsids) {
         vec<Branching*> old_x;
         branching->x.moveTo(old_x);
-        branching->add(&sat);
+        branching->add(&sat());
         for (int i = 0; i < old_x.size(); i++) branching->add(old_x[i]);
         branching->fin = 0;
         branching->cur = -1;
-        so.vsids = true;
+        so().vsids = true;
     } else {
         vec<Branching*> old_x;
         branching->x.moveTo(old_x);
         for (int i = 1; i < old_x.size(); i++) branching->add(old_x[i]);
         branching->fin = 0;
         branching->cur = -1;
-        so.vsids = false;
+        so().vsids = false;
     }
 }
 
@@ -489,23 +703,23 @@ RESULT Engine::search(const std::string& problemLabel) {
     unsigned int nof_conflicts = getRestartLimit(starts);
     unsigned int conflictC = 0;
 
-    if (so.print_variable_list) {
+    if (so().print_variable_list) {
         std::ofstream s;
         s.open("variable-list");
-        for (auto const & p : intVarString) {
+        for (auto const & p : intVarString()) {
             s << p.second << "\n";
         }
-        for (auto const & p : boolVarString) {
+        for (auto const & p : boolVarString()) {
             s << p.second << "\n";
         }
     }
 
     std::stringstream ss;
-    for (auto const & p : intVarString) {
+    for (auto const & p : intVarString()) {
         ss << p.second << " ";
     }
     ss << ";";
-    for (auto const & p : boolVarString) {
+    for (auto const & p : boolVarString()) {
         ss << p.second << " ";
     }
     std::string variableListString = ss.str();
@@ -522,7 +736,16 @@ RESULT Engine::search(const std::string& problemLabel) {
     /* boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::universal_time(); */
 
     while (true) {
-        if (so.parallel && slave.checkMessages()) return RES_UNK;
+        if (so().parallel && slave.checkMessages()) return RES_UNK;
+        if (so().mem_limit && conflicts >= next_mem_check && !checkMemLimit()) {
+            (*output_stream) << "% Memory limit exceeded!\n";
+            if (so().thread_no == -1 && solutions == 0) (*output_stream) << "=====UNKNOWN=====\n";
+            return RES_UNK;
+        }
+        if (portfolio.running) {
+            RESULT r = portfolio.sync();
+            if (r != RES_SEA) return r;
+        }
 
         int nodeid = nextnodeid;
         nextnodeid++;
@@ -568,7 +791,7 @@ RESULT Engine::search(const std::string& problemLabel) {
         Conflict:
             conflicts++; conflictC++;
 
-            if (so.time_out > duration(0) && chuffed_clock::now() > time_out) {
+            if (so().time_out > duration(0) && chuffed_clock::now() > time_out) {
                 (*output_stream) << "% Time limit exceeded!\n";
                 return RES_UNK;
             }
@@ -585,14 +808,14 @@ RESULT Engine::search(const std::string& problemLabel) {
                     
 
             // Derive learnt clause and perform backjump
-            if (so.lazy) {
+            if (so().lazy) {
                 std::set<int> contributingNogoods;
-                sat.analyze(nodeid, contributingNogoods);
+                sat().analyze(nodeid, contributingNogoods);
 #ifdef HAS_PROFILER
                 if (doProfiling()) {
                     std::stringstream ss;
-                    for (int i = 0 ; i < sat.out_learnt.size() ; i++)
-                        ss << " " << getLitString(toInt(sat.out_learnt[i]));
+                    for (int i = 0 ; i < sat().out_learnt.size() ; i++)
+                        ss << " " << getLitString(toInt(sat().out_learnt[i]));
                     std::stringstream contribString;
                     contribString << "{\"nogoods\":[";
                     for (std::set<int>::const_iterator it = contributingNogoods.begin() ;
@@ -605,8 +828,8 @@ RESULT Engine::search(const std::string& problemLabel) {
                     // We leave duplicates in the list of blocks, so
                     // that the profiler can make use of them.
                     std::set<int> levels;
-                    for (int i = 0 ; i < sat.out_learnt_level.size() ; i++) {
-                        int rawLevel = sat.out_learnt_level[i];
+                    for (int i = 0 ; i < sat().out_learnt_level.size() ; i++) {
+                        int rawLevel = sat().out_learnt_level[i];
                         // We increment the "raw level" by one,
                         // because internally (on the trail) the first
                         // decision level -- that is, after a single
@@ -626,13 +849,13 @@ RESULT Engine::search(const std::string& problemLabel) {
                     // derived from assumption literals?
                     int numAssumptions = assumptions.size();
                     bool usesAssumptions = false;
-                    for (int i = 0 ; i < sat.out_learnt_level.size() ; i++) {
-                        if (sat.out_learnt_level[i] < numAssumptions) {
+                    for (int i = 0 ; i < sat().out_learnt_level.size() ; i++) {
+                        if (sat().out_learnt_level[i] < numAssumptions) {
                             usesAssumptions = true;
                         }
                     }
 
-                    if (so.debug) {
+                    if (so().debug) {
                         std::cerr << "uses assumptions: " << usesAssumptions << "\n";
                     }
 
@@ -650,14 +873,14 @@ RESULT Engine::search(const std::string& problemLabel) {
                     std::cerr << "\n";
 #endif
 
-                    rewindPaths(profilerConnector, previousDecisionLevel, decisionLevel(), (so.send_skipped ? REWIND_SEND_SKIPPED : REWIND_OMIT_SKIPPED), timeus);
+                    rewindPaths(profilerConnector, previousDecisionLevel, decisionLevel(), (so().send_skipped ? REWIND_SEND_SKIPPED : REWIND_OMIT_SKIPPED), timeus);
                                 
                     std::stringstream ss2;
                     /* ss2 << "-> "; */
-                    string ls = getLitString(toInt(sat.out_learnt[0]));
+                    string ls = getLitString(toInt(sat().out_learnt[0]));
                     ss2 << ls;
                     if (ls.size() < 2) {
-                        std::cerr << "WARNING: short label for " << toInt(sat.out_learnt[0]) << ": " << ls << "\n";
+                        std::cerr << "WARNING: short label for " << toInt(sat().out_learnt[0]) << ": " << ls << "\n";
                     }
                     mostRecentLabel = ss2.str();
                     altpath.push_back(1);
@@ -670,22 +893,22 @@ RESULT Engine::search(const std::string& problemLabel) {
                     mostRecentLabel = "";
                 }
 #endif
-                sat.confl = NULL;
+                sat().confl = NULL;
                 DecInfo& di = dec_info.last();
-                sat.btToLevel(decisionLevel()-1);
+                sat().btToLevel(decisionLevel()-1);
 #ifdef HAS_PROFILER
                 if (doProfiling()) {
-                    rewindPaths(profilerConnector, previousDecisionLevel, decisionLevel(), (so.send_skipped ? REWIND_SEND_SKIPPED : REWIND_OMIT_SKIPPED), timeus);
+                    rewindPaths(profilerConnector, previousDecisionLevel, decisionLevel(), (so().send_skipped ? REWIND_SEND_SKIPPED : REWIND_OMIT_SKIPPED), timeus);
                 }
 #endif
                 makeDecision(di, 1);
             }
 
-            if (!so.vsids && !so.toggle_vsids &&  conflictC >= so.switch_to_vsids_after) {
-            if (so.restart_scale >= 1000000000) so.restart_scale = 100;
-                if (so.verbosity >= 2)
+            if (!so().vsids && !so().toggle_vsids &&  conflictC >= so().switch_to_vsids_after) {
+            if (so().restart_scale >= 1000000000) so().restart_scale = 100;
+                if (so().verbosity >= 2)
                     std::cerr << "restarting and switching to VSIDS\n";
-                sat.btToLevel(0);
+                sat().btToLevel(0);
                 restart_count++;
                 nodepath.resize(0);
                 altpath.resize(0);
@@ -700,12 +923,17 @@ RESULT Engine::search(const std::string& problemLabel) {
 
         } else {
 
+            if (lns_active && conflicts - lns_start >= so().lns_fail_limit) {
+                lnsRestart(false);
+                continue;
+            }
+
             if (conflictC >= nof_conflicts) {
-                if (so.verbosity >= 2)
+                if (so().verbosity >= 2)
                     std::cerr << "restarting due to number of conflicts\n";
                 starts++;
                 nof_conflicts += getRestartLimit(starts);
-                sat.btToLevel(0);
+                sat().btToLevel(0);
                 restart_count++;
                 nodepath.resize(0);
                 altpath.resize(0);
@@ -716,48 +944,67 @@ RESULT Engine::search(const std::string& problemLabel) {
                 }
 #endif
 
-                sat.confl = NULL;
-                if (so.lazy && so.toggle_vsids && (starts % 2 == 1)) toggleVSIDS();
+                sat().confl = NULL;
+                if (so().lazy && so().toggle_vsids && (starts % 2 == 1)) toggleVSIDS();
                 continue;
             }
             
             if (decisionLevel() == 0) {
                 topLevelCleanUp();
-                if (opt_var && so.verbosity >= 3) {
+                if (so().inprocess && so().lazy && conflicts >= sat().next_inprocess && !inprocess()) return RES_GUN;
+                if (opt_var && so().verbosity >= 3) {
                     printf("%% root level bounds on objective: min %d max %d\n", opt_var->getMin(), opt_var->getMax());
                 }
             }
 
-            DecInfo *di = NULL;
+            DecInfo di;
             
             // Propagate assumptions
-            while (decisionLevel() < assumptions.size()) {
+            bool refuted = false;
+            while (decisionLevel() < assumptions.size() || lnsExtend()) {
                 int p = assumptions[decisionLevel()];
-                if (sat.value(toLit(p)) == l_True) {
+                if (sat().value(toLit(p)) == l_True) {
                     // Dummy decision level:
-                    assert(sat.trail.last().size() == sat.qhead.last());
-                    engine.dec_info.push(DecInfo(NULL, p));
+                    assert(sat().trail.last().size() == sat().qhead.last());
+                    engine().dec_info.push(DecInfo(NULL, p));
                     newDecisionLevel();
-                } else if (sat.value(toLit(p)) == l_False) {
-                    return RES_LUN;
+                } else if (sat().value(toLit(p)) == l_False) {
+                    // No solution is as good as the warm start, search without its bound
+                    if (warm_bound) {
+                        assumptions.clear();
+                        warm_bound = false;
+                        continue;
+                    }
+                    // A refuted fixing exhausts the LNS neighbourhood
+                    if (!lns_active || decisionLevel() == 0) return RES_LUN;
+                    refuted = true;
+                    break;
                 } else {
-                    di = new DecInfo(NULL, p);
+                    di = DecInfo(NULL, p);
                     break;
                 }
             }
+            if (refuted) {
+                lnsRestart(true);
+                continue;
+            }
 
-            if (!di) di = branching->branch();
+            if (di.none()) di = branching->branch();
 
-            if (!di) {
+            if (di.none()) {
                 solutions++;
                 if (std::stringstream* oss = dynamic_cast<std::stringstream*>(output_stream)) {
                     oss->str("");
                 }
-                if (so.print_sol) {
+                if (so().print_sol) {
                     problem->print(*output_stream);
                     (*output_stream) << "\n----------\n";
+                    if (so().intermediate) {
+                        (*output_stream) << "% time elapsed: " << to_sec(std::chrono::duration_cast<duration>(chuffed_clock::now() - start_time)) << " s\n";
+                    }
                     output_stream->flush();
                 }
+                if (portfolio.running && !portfolio.publishSolution()) return RES_UNK;
 #if DEBUG_VERBOSE
                 std::cerr << "solution\n";
                 std::cerr << "createNode(" << nodeid << ", " << parent << ", " << myalt << ", 0, SOLVED)\n";
@@ -810,8 +1057,10 @@ RESULT Engine::search(const std::string& problemLabel) {
                                     
                 mostRecentLabel = "";
                 if (!opt_var) {
-                    if (solutions == so.nof_solutions) return RES_SAT;
-                    if (so.lazy) blockCurrentSol();
+                    // In a portfolio, the solutions of all threads count
+                    if (portfolio.running ? portfolio.finished.load() : solutions == so().nof_solutions) return RES_SAT;
+                    if (so().lazy) blockCurrentSol();
+                    clearWarmStart();
                     goto Conflict;
                 }
                 if (!constrain()) {
@@ -821,7 +1070,7 @@ RESULT Engine::search(const std::string& problemLabel) {
             }
 
 
-            engine.dec_info.push(*di);
+            engine().dec_info.push(di);
             newDecisionLevel();
 
             doFixPointStuff();
@@ -833,7 +1082,7 @@ RESULT Engine::search(const std::string& problemLabel) {
 #ifdef HAS_PROFILER
             if (doProfiling()) {
                 string info;
-                if (so.send_domains) {
+                if (so().send_domains) {
                     FlatZinc::FlatZincSpace* fzs = dynamic_cast<FlatZinc::FlatZincSpace*>(problem);
                     if (fzs != NULL) {
                         info = fzs->getDomainsString();
@@ -850,9 +1099,7 @@ RESULT Engine::search(const std::string& problemLabel) {
             }
 #endif
           
-            makeDecision(*di, 0);
-
-            delete di;
+            makeDecision(di, 0);
 
         }
     }
@@ -861,43 +1108,53 @@ RESULT Engine::search(const std::string& problemLabel) {
 void Engine::solve(Problem *p, const std::string& problemLabel) {
     problem = p;
 
-    // Setting the random seed
-    if (so.rnd_seed == 0) {
-        so.rnd_seed = time(0);
+    if (so().num_threads > 1 && !portfolio.running && !so().parallel) {
+        fprintf(stderr, "%% Portfolio search is not available here, using a single thread.\n");
+        so().num_threads = 1;
     }
-    srand(so.rnd_seed);
 
+    // Setting the random seed
+    if (so().rnd_seed == 0) {
+        so().rnd_seed = time(0);
+    }
+    rng.seed(so().rnd_seed);
 
-    init();
+    // A model that failed while it was built is not initialised or searched
+    if (!tl_failed) init();
+    if (tl_failed && so().verbosity >= 1) fprintf(stderr, "%% Top level failure!\n");
 
-    time_out = chuffed_clock::now() + so.time_out;
+    time_out = chuffed_clock::now() + so().time_out;
 
     init_time = std::chrono::duration_cast<duration>(chuffed_clock::now() - start_time);
     base_memory = memUsed();
+    // The peak may be from parsing, only what is still resident counts
+    MemUsage mu;
+    memUsage(mu);
+    mem_static = std::max(0LL, (long long) (memResident() * 1048576) - mu.total());
 
 #ifdef HAS_PROFILER
-    if (so.use_profiler)
+    if (so().use_profiler)
         profilerConnector.connect();
 #endif
 
     /* if (so.debug) { */
     /*   for (int i = 0 ; i < 2*sat.nVars() ; i++) { */
-    /*     std::cerr << "literal " << i << " is " << litString[i] << "\n"; */
+    /*     std::cerr << "literal " << i << " is " << litString()[i] << "\n"; */
     /*   } */
     /* } */
 
-    if (so.learnt_stats) {
+    if (so().learnt_stats) {
         learntStatsStream.open("learnt-stats.csv");
         learntStatsStream << "id,length,block";
-        if (so.learnt_stats_nogood)
+        if (so().learnt_stats_nogood)
             learntStatsStream << ",nogood";
         learntStatsStream << ",rawActivity\n";
     }
 
-    if (!so.parallel) {
+    if (!so().parallel) {
         // sequential
-        status = search(problemLabel);
-        if (status == RES_GUN || status == RES_LUN) {
+        status = tl_failed ? RES_GUN : search(problemLabel);
+        if (so().thread_no == -1 && (status == RES_GUN || status == RES_LUN)) {
             if (solutions > 0)
                 (*output_stream) << "==========\n";
             else
@@ -905,14 +1162,16 @@ void Engine::solve(Problem *p, const std::string& problemLabel) {
         }
     } else {
         // parallel
-        if (so.thread_no == -1) master.solve();
+        if (so().thread_no == -1) master.solve();
         else slave.solve();
-        if (so.thread_no == -1 && master.status == RES_GUN) (*output_stream) << "==========\n";
+        if (so().thread_no == -1 && master.status == RES_GUN) (*output_stream) << "==========\n";
     }
 
-    if (so.learnt_stats) {
-        for (int i = 0 ; i < sat.learnts.size() ; i++) {
-            Clause& c = *(sat.learnts[i]);
+    if (!so().nogoods_out.empty() && !so().parallel) sat().saveNogoods(so().nogoods_out);
+
+    if (so().learnt_stats) {
+        for (int i = 0 ; i < sat().learnts.size() ; i++) {
+            Clause& c = *(sat().learnts[i]);
             //        std::cerr << "clausescore," << c.clauseID() << ","
             //        << c.rawActivity() << "\n";
             int id = c.clauseID();
@@ -928,7 +1187,8 @@ void Engine::solve(Problem *p, const std::string& problemLabel) {
     profilerConnector.disconnect();
 #endif
 
-    if (so.verbosity >= 1) printStats();
+    if (!so().prop_profile_file.empty() && so().thread_no == -1) writePropProfile();
+    if (so().verbosity >= 1) printStats();
 
-    if (so.parallel) master.finalizeMPI();
+    if (so().parallel) master.finalizeMPI();
 }
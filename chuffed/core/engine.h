@@ -2,6 +2,7 @@
 #define engine_h
 
 #include <chuffed/support/misc.h>
+#include <random>
 #include <string>
 
 #define DEBUG 0
@@ -14,8 +15,10 @@ class BranchGroup;
 class Branching;
 class BTPos;
 class Checker;
+class Clause;
 class DecInfo;
 class IntVar;
+class Lit;
 class Problem;
 class Propagator;
 class PseudoProp;
@@ -23,6 +26,69 @@ class TrailElem;
 
 //-----
 
+// Propagators waiting to run at one priority level. They are taken from the
+// front (FIFO) or the back (LIFO); the storage is reused once it drains.
+
+class PropQueue {
+    vec<Propagator*> q;
+    int head;
+public:
+    bool fifo;
+
+    PropQueue() : head(0), fifo(false) {}
+
+    int size() const { return q.size() - head; }
+    Propagator* operator [] (int i) const { return q[head+i]; }
+    void push(Propagator *p) { q.push(p); }
+    Propagator* pop() {
+        Propagator *p;
+        if (fifo) p = q[head++];
+        else { p = q.last(); q.pop(); }
+        if (head == q.size()) clear();
+        return p;
+    }
+    void clear() { q.clear(); head = 0; }
+};
+
+//-----
+
+// Per-propagator counters, recorded when so.prop_profile is set
+
+struct PropProfile {
+    long long wakeups;              // Times the propagator was woken by a domain change
+    long long calls;                // Times propagate() was run
+    long long changes;              // Domain changes made by propagate()
+    long long failures;             // Calls that returned false
+    long long explains;             // Lazy explanations built
+    long long expl_lits;            // Literals in those explanations
+    chuffed_clock::duration prop_time, expl_time;
+
+    PropProfile() : wakeups(0), calls(0), changes(0), failures(0), explains(0), expl_lits(0),
+                    prop_time(0), expl_time(0) {}
+};
+
+// Estimated bytes held by each part of the solver
+
+struct MemUsage {
+    long long trail;                // Core and SAT trails
+    long long watches;              // SAT watch lists
+    long long clauses;              // Problem clauses
+    long long learnts;              // Learnt clauses, and removed clauses not yet collected
+    long long expl;                 // Temporary reason clauses
+    long long vars;                 // Int vars and the per-variable SAT arrays
+    long long lazy_lits;            // Lazy literal nodes of IntVarLL
+    long long mdd;                  // MDD propagators
+    long long mip;                  // MIP tableau
+
+    MemUsage() : trail(0), watches(0), clauses(0), learnts(0), expl(0), vars(0), lazy_lits(0),
+                 mdd(0), mip(0) {}
+    long long total() const {
+        return trail + watches + clauses + learnts + expl + vars + lazy_lits + mdd + mip;
+    }
+};
+
+//-----
+
 class Engine {
 
 public:
@@ -36,25 +102,40 @@ public:
     vec<Checker*> checkers;         // List of constraint checkers
     vec<int> assumptions;           // List of assumption literals
     bool finished_init;
+    bool tl_failed;                 // The model failed at the top level while it was built, see TL_FAIL
 
 
     Problem *problem;
     BranchGroup *branching;
+    vec<BranchGroup*> ordered_groups; // Branch groups selecting incrementally, untrailed on backtrack
     IntVar *opt_var;
     int opt_type;
     int best_sol;
+    bool warm_bound;                // The objective bound in assumptions is the warm start's
+    vec<Lit> hint_polarity;         // Polarities the warm start overwrote, as Lit(var, polarity)
     RESULT status;
     time_point time_out;
+    std::mt19937 rng;               // Random numbers of the search, seeded with so().rnd_seed
 
     // Intermediate propagation state
     vec<IntVar*> v_queue;           // List of changed vars
-    vec<vec<Propagator*> > p_queue; // Queue of propagators to run
+    PropQueue p_queue[num_queues];  // Queues of propagators to run, most urgent first
+    unsigned int queue_mask;        // Bit i is set iff p_queue[i] is non-empty
     Propagator *last_prop;          // Last propagator run, set for idempotent propagators
     bool async_fail;                // Asynchronous failure
 
     // Decision stack
     vec<DecInfo> dec_info;
 
+    // Large neighbourhood search
+    bool lns_active;                // An incumbent exists and its neighbourhoods are searched
+    bool lns_complete;              // All the fixings of the neighbourhood are in assumptions
+    double lns_relax;               // Fraction of the outputs left free
+    long long lns_start;            // Conflicts when the neighbourhood was started
+    vec<int> lns_sol;               // Output values in the incumbent, INT_MIN if unfixed
+    vec<int> lns_dom;               // Output domain sizes when the last fixing was chosen
+    vec<int> lns_cand, lns_reduced; // Outputs that can be fixed next
+
     // Trails
     vec<TrailElem> trail;           // Raw data changes
     vec<int> trail_lim;
@@ -62,11 +143,19 @@ public:
     // Statistics
     time_point start_time;
     duration init_time, opt_time;
+    duration parse_time;            // Reading and posting the model, part of init_time
     double base_memory;
+    long long mem_static;           // Bytes in use after init that memUsage() does not see
+    long long next_mem_check;       // Conflicts before --mem-limit is next checked
     long long int conflicts, nodes, propagations, solutions, next_simp_db;
+    long long int lns_neighbourhoods, lns_exhausted;
     int peak_depth;
     int restart_count;
 
+    int trail_inc;                  // Trailed once per decision level
+
+    vec<PropProfile> prop_profile;  // Indexed by prop_id
+
     std::ostream* output_stream;
 private:
 
@@ -79,11 +168,21 @@ private:
     void doFixPointStuff();
     void makeDecision(DecInfo& di, int alt);
     bool constrain();
+    void clearWarmStart();
+    void lnsSolution();
+    void lnsNeighbourhood();
+    void lnsRestart(bool exhausted);
+    bool lnsExtend();
     bool propagate();
+    bool propagateProfiled(Propagator *p);
+    void wakeChangedVars();
     void clearPropState();
     void topLevelCleanUp();
     void simplifyDB();
     void blockCurrentSol();
+    bool inprocess();
+    bool probe(Lit p);
+    bool vivify(Clause& c, vec<Lit>& ps);
     unsigned int getRestartLimit(unsigned int i); // Return the restart limit for restart i
     void toggleVSIDS();
 
@@ -91,18 +190,37 @@ public:
 
     // Constructor
     Engine();
+    ~Engine();
 
     // Trail methods
     void btToPos(int pos);
     void btToLevel(int level);
 
+    // Queue p to run at the given priority
+    void schedule(Propagator *p, int priority) {
+        p_queue[priority].push(p);
+        queue_mask |= 1u << priority;
+    }
+
     // Interface methods
     RESULT search(const std::string& problemLabel = "chuffed");
     void solve(Problem *p, const std::string& problemLabel = "chuffed");
 
     // Stats
     void printStats();
+    void printPropProfile();
+    void writePropProfile();
+    void memUsage(MemUsage& mu);
     void checkMemoryUsage();
+    bool checkMemLimit();
+
+    PropProfile& propProfile(int prop_id) {
+        if (prop_id >= prop_profile.size()) prop_profile.growTo(prop_id+1);
+        return prop_profile[prop_id];
+    }
+
+    // Random number in [0, n)
+    int randInt(int n) { return rng() % n; }
 
     int decisionLevel() const { return trail_lim.size(); }
     int trailPos() const { return trail.size(); }
@@ -117,7 +235,10 @@ public:
     
 };
 
-extern Engine engine;
+extern Engine main_engine;
+extern THREAD_LOCAL Engine* engine_ptr;
+// The engine of the instance bound to the calling thread, see Solver
+inline Engine& engine() { return *engine_ptr; }
 
 void optimize(IntVar* v, int t);
 
@@ -127,6 +248,13 @@ class TrailElem {
 public:
     int *pt; int x; int sz;
     TrailElem(int *_pt, int _sz) : pt(_pt), x(_sz == 1 ? *((char*) pt) : _sz == 2 ? *((short*) pt) : *pt), sz(_sz) {}
+    // Exchange the saved value with the current one. Done backwards over the
+    // trail it steps the changes back, done forwards again it redoes them.
+    void swap() {
+        int y = sz == 1 ? *((char*) pt) : sz == 2 ? *((short*) pt) : *pt;
+        undo();
+        x = y;
+    }
     void undo() {
         switch (sz) {
             case 1: *((char*)  pt) = x; break;
@@ -139,9 +267,9 @@ public:
 template <class T, class U>
 static inline void trailChange(T& v, const U u) {
     int *pt = (int*) &v;
-    engine.trail.push(TrailElem(pt, sizeof(T)));
+    engine().trail.push(TrailElem(pt, sizeof(T)));
     if (sizeof(T) == 8) {
-        engine.trail.push(TrailElem(pt+1, sizeof(T)));
+        engine().trail.push(TrailElem(pt+1, sizeof(T)));
     }
     v = u;
 }
@@ -187,20 +315,20 @@ cassert(sizeof(Tint64_t) == 8);
 
 inline char Tchar::operator = (char o) {
     int *pt = (int*) this;
-    engine.trail.push(TrailElem(pt, 1));
+    engine().trail.push(TrailElem(pt, 1));
     return v = o;
 }
 
 inline int Tint::operator = (int o) {
     int *pt = (int*) this;
-    engine.trail.push(TrailElem(pt, 4));
+    engine().trail.push(TrailElem(pt, 4));
     return v = o;
 }
 
 inline int64_t Tint64_t::operator = (int64_t o) {
     int *pt = (int*) this;
-    engine.trail.push(TrailElem(pt, 4));
-    engine.trail.push(TrailElem(pt+1, 4));
+    engine().trail.push(TrailElem(pt, 4));
+    engine().trail.push(TrailElem(pt+1, 4));
     return v = o;
 }
 
@@ -208,8 +336,10 @@ inline int64_t Tint64_t::operator = (int64_t o) {
 
 class Problem {
 public: 
+    virtual ~Problem() {}
     virtual void print(std::ostream&) = 0;
     virtual void restrict_learnable() {};
+    virtual void warm_start(const std::string& file) {};
 };
 
 
@@ -14,8 +14,8 @@
 void process_ircs();
 
 void SIGINT_handler(int signum) {
-	if (so.thread_no == -1) fprintf(stderr, "*** INTERRUPTED ***\n");
-	engine.printStats();
+	if (so().thread_no == -1) fprintf(stderr, "*** INTERRUPTED ***\n");
+	engine().printStats();
 	exit(1);
 }
 
@@ -23,7 +23,9 @@ void Engine::init() {
 	signal(SIGINT,SIGINT_handler);
 	//	signal(SIGHUP,SIGINT_handler);
 
-	if (so.parallel) master.initMPI();
+	if (so().parallel) master.initMPI();
+
+	for (int i = 0; i < num_queues; i++) p_queue[i].fifo = (so().prop_fifo_levels >> i) & 1;
 
 	// Get the vars ready
 
@@ -33,12 +35,12 @@ void Engine::init() {
 		else v->pushInQueue();
 	}
 
-	if (so.lazy) {
+	if (so().lazy) {
 		for (int i = 0; i < vars.size(); i++) {
-			if (vars[i]->getMax() - vars[i]->getMin() <= so.eager_limit) {
+			if (vars[i]->getMax() - vars[i]->getMin() <= so().eager_limit) {
 				vars[i]->specialiseToEL();
 			} else {
-        if (so.verbosity >= 2)
+        if (so().verbosity >= 2)
           std::cerr << "using lazy literal\n";
 				vars[i]->specialiseToLL();
 			}
@@ -57,22 +59,47 @@ void Engine::init() {
 
 	// Get MIP propagator ready
 
-	if (so.mip) mip->init();
+	if (so().mip) mip->init();
 
 	// Get SAT propagator ready
 
-	sat.init();
+	sat().init();
+
+	// Get the branchings ready
+
+	branching->initOrder();
 
 	// Set lits allowed to be in learnt clauses
 	problem->restrict_learnable();
 
+	// Load nogoods saved by an earlier solve
+
+	if (!so().nogoods_in.empty()) sat().loadNogoods(so().nogoods_in);
+
+	// Branch towards the assignment of an earlier solve, and when optimising
+	// look for a solution at least as good as it first
+
+	if (!so().warm_start.empty()) {
+		problem->warm_start(so().warm_start);
+		if (opt_var && opt_var->hint_val != INT_MIN) {
+			int v = opt_var->hint_val;
+			Lit p = opt_type ? opt_var->getLit(v, 2) : opt_var->getLit(v, 3);
+			assumptions.push(toInt(p));
+			warm_bound = true;
+		}
+	}
+
 	// Get LDSB ready
 
-	if (so.ldsb) ldsb.init();
+	if (so().ldsb) ldsb->init();
 
 	// Do MIP presolve
 
-	if (so.mip) mip->presolve();
+	if (so().mip) mip->presolve();
+
+	// Substitute and eliminate the Boolean vars only constrained by clauses
+
+	if (so().sat_presolve) sat().presolve();
 
 	// Ready
 
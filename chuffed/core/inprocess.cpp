@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <chuffed/core/options.h>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/sat.h>
+#include <chuffed/core/propagator.h>
+
+// Inprocessing
+//
+// When search is back at the root, the learnt clauses are shortened and
+// pruned under a budget of propagations:
+//
+// - subsumption: a learnt clause containing a binary, problem or learnt clause
+//   is removed, and one containing such a clause but for a negated literal
+//   loses that literal (self-subsuming resolution);
+// - vivification: the negations of the literals of an active learnt clause are
+//   decided in turn and propagated. A conflict, or a literal of the clause made
+//   true, shows that the literals decided so far (with the true one) are
+//   implied on their own, and literals made false by the earlier ones drop out.
+//
+// Only learnt clauses are changed, as the clauses they are shortened with may
+// be learnts that reduceDB removes later. Every result is implied by the
+// model, so it stays valid outside the current objective bound.
+
+// Replace the literals of learnt clause c by ps, a subset of them, at the
+// root. False if c left the database, as a unit or a binary watch.
+bool SAT::shrinkLearnt(Clause& c, vec<Lit>& ps) {
+	assert(decisionLevel() == 0 && ps.size() > 0 && ps.size() < c.size());
+	if (ps.size() == 1 || (ps.size() == 2 && so().bin_clause_opt)) {
+		c.removed = 1;
+		removeClause(c);
+		if (ps.size() == 1) enqueue(ps[0]);
+		else addLearntBin(ps[0], ps[1]);
+		return false;
+	}
+	CRef cr = ca.ref(c);
+	watches[toInt(~c[0])].remove(WatchElem(cr, c[1]));
+	watches[toInt(~c[1])].remove(WatchElem(cr, c[0]));
+	for (int i = 0; i < c.size(); i++) decVarUse(var(c[i]));
+	learnts_literals -= c.size() - ps.size();
+	ca.wasted += c.size() - ps.size();
+	for (int i = 0; i < ps.size(); i++) c[i] = ps[i];
+	c.resize(ps.size());
+	for (int i = 0; i < c.size(); i++) incVarUse(var(c[i]));
+	if (c.lbd() > c.size()) c.lbd() = c.size();
+	watches[toInt(~c[0])].push(WatchElem(cr, c[1]));
+	watches[toInt(~c[1])].push(WatchElem(cr, c[0]));
+	return true;
+}
+
+// Remove or strengthen the learnts that clause c of n literals subsumes, or
+// subsumes but for one negated literal. Clauses with a literal fixed at the
+// root are left to simplifyDB.
+void SAT::backSubsume(const Lit* c, int n, Clause *self, long long& budget) {
+	int best = -1, best_occ = INT_MAX;
+	for (int i = 0; i < n; i++) {
+		if (value(c[i]) != l_Undef) return;
+		int occ = occurs[toInt(c[i])].size() + occurs[toInt(~c[i])].size();
+		if (occ < best_occ) { best = i; best_occ = occ; }
+	}
+	for (int i = 0; i < n; i++) lit_mark[toInt(c[i])] = 1;
+
+	vec<Lit> ps;
+	for (int s = 0; s < 2; s++) {
+		vec<Clause*>& os = occurs[toInt(s ? ~c[best] : c[best])];
+		for (int i = 0; i < os.size() && budget > 0; i++) {
+			Clause& d = *os[i];
+			if (&d == self || d.removed || d.size() < n) continue;
+			budget -= d.size();
+			int same = 0, flip = -1;
+			bool fixed = false;
+			for (int k = 0; k < d.size(); k++) {
+				if (value(d[k]) != l_Undef) { fixed = true; break; }
+				if (lit_mark[toInt(d[k])]) same++;
+				else if (lit_mark[toInt(~d[k])]) {
+					if (flip >= 0) { fixed = true; break; }
+					flip = k;
+				}
+			}
+			if (fixed) continue;
+			if (same == n) {
+				d.removed = 1;
+				removeClause(d);
+				subsumed_clauses++;
+			} else if (same == n-1 && flip >= 0) {
+				ps.clear();
+				for (int k = 0; k < d.size(); k++) if (k != flip) ps.push(d[k]);
+				shrinkLearnt(d, ps);
+				strengthened_lits++;
+			}
+		}
+	}
+
+	for (int i = 0; i < n; i++) lit_mark[toInt(c[i])] = 0;
+}
+
+struct size_lt { bool operator() (Clause* x, Clause* y) { return x->size() < y->size(); } };
+void SAT::subsume(long long& budget) {
+	occurs.growTo(2*nVars());
+	lit_mark.growTo(2*nVars(), 0);
+	for (int i = 0; i < occurs.size(); i++) occurs[i].clear();
+	for (int i = 0; i < learnts.size(); i++) {
+		Clause& c = *learnts[i];
+		for (int k = 0; k < c.size(); k++) occurs[toInt(c[k])].push(&c);
+	}
+
+	// Binary clauses are kept as watches, each once in the watches of both
+	// negated literals
+	Lit bin[2];
+	for (int i = 0; i < watches.size() && budget > 0; i++) {
+		vec<WatchElem>& ws = watches[i];
+		for (int j = 0; j < ws.size() && budget > 0; j++) {
+			if (ws[j].d.type != 1) continue;
+			bin[0] = ~toLit(i);
+			bin[1] = toLit(ws[j].d.d2);
+			if (toInt(bin[0]) < toInt(bin[1])) backSubsume(bin, 2, NULL, budget);
+		}
+	}
+
+	// Then the longer clauses, shortest first
+	vec<Clause*> cs;
+	for (int i = 0; i < clauses.size(); i++) cs.push(clauses[i]);
+	for (int i = 0; i < learnts.size(); i++) cs.push(learnts[i]);
+	std::sort((Clause**) cs, (Clause**) cs + cs.size(), size_lt());
+	for (int i = 0; i < cs.size() && budget > 0; i++) {
+		Clause& c = *cs[i];
+		if (c.removed) continue;
+		backSubsume(c, c.size(), &c, budget);
+	}
+}
+
+// Decide p at a new level and propagate, false on a conflict
+bool Engine::probe(Lit p) {
+	dec_info.push(DecInfo(NULL, toInt(p)));
+	newDecisionLevel();
+	for (int i = 0; i < pseudo_props.size(); i++) pseudo_props[i]->doFixPointStuff();
+	sat().enqueue(p);
+	if (propagate()) return true;
+	clearPropState();
+	sat().confl = NULL;
+	return false;
+}
+
+// Put in ps the literals of c that are implied on their own, see above.
+// True if they are fewer than those of c.
+bool Engine::vivify(Clause& c, vec<Lit>& ps) {
+	// Propagation moves the watches of c, so its literals are copied first
+	vec<Lit> lits;
+	for (int i = 0; i < c.size(); i++) lits.push(c[i]);
+	ps.clear();
+	for (int i = 0; i < lits.size(); i++) {
+		Lit p = lits[i];
+		if (sat().value(p) == l_True) { ps.push(p); break; }
+		if (sat().value(p) == l_False) continue;
+		ps.push(p);
+		if (!probe(~p)) break;
+	}
+	sat().btToLevel(0);
+	return ps.size() < c.size();
+}
+
+struct activity_gt { bool operator() (Clause* x, Clause* y) { return x->activity() > y->activity(); } };
+bool Engine::inprocess() {
+	assert(decisionLevel() == 0 && sat().consistent());
+	sat().inprocess_passes++;
+	long long props = sat().propagations + propagations;
+	long long budget = (props - sat().inprocess_props) * so().inprocess_effort / 100;
+
+	// Learnts satisfied at the root go, and the others lose their false literals
+	sat().simplifyDB();
+
+	// Subsumption is charged a literal per propagation
+	long long work = budget;
+	sat().subsume(work);
+	if (!propagate()) {
+		clearPropState();
+		return false;
+	}
+
+	// The most active learnts first, each vivified once
+	vec<Clause*> cs;
+	for (int i = 0; i < sat().learnts.size(); i++) {
+		Clause& c = *sat().learnts[i];
+		if (!c.removed && !c.vivified && c.size() > 2) cs.push(&c);
+	}
+	std::sort((Clause**) cs, (Clause**) cs + cs.size(), activity_gt());
+	vec<Lit> ps;
+	for (int i = 0; i < cs.size() && budget > 0; i++) {
+		Clause& c = *cs[i];
+		if (c.removed) continue;
+		c.vivified = 1;
+		long long before = sat().propagations + propagations;
+		bool shorter = vivify(c, ps);
+		budget -= sat().propagations + propagations - before + c.size();
+		if (!shorter) continue;
+		// Satisfied at the root
+		if (sat().value(ps.last()) == l_True) {
+			c.removed = 1;
+			sat().removeClause(c);
+			continue;
+		}
+		sat().vivified_lits += c.size() - ps.size();
+		if (!sat().shrinkLearnt(c, ps) && !propagate()) {
+			clearPropState();
+			return false;
+		}
+	}
+
+	int i, j;
+	for (i = j = 0; i < sat().learnts.size(); i++) {
+		if (!sat().learnts[i]->removed) sat().learnts[j++] = sat().learnts[i];
+	}
+	sat().learnts.resize(j);
+	sat().checkGarbage();
+
+	sat().inprocess_props = sat().propagations + propagations;
+	sat().next_inprocess = conflicts + 2000;
+	if (so().verbosity >= 2) {
+		fprintf(stderr, "%% inprocess: %lld subsumed, %lld strengthened, %lld vivified lits, %d learnts\n",
+			sat().subsumed_clauses, sat().strengthened_lits, sat().vivified_lits, sat().learnts.size());
+	}
+	return true;
+}
@@ -0,0 +1,258 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <chuffed/core/options.h>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/sat.h>
+#include <chuffed/core/solver.h>
+#include <chuffed/vars/int-var.h>
+
+// Nogood cache
+//
+// The learnt clauses are saved with their literals written in terms of the
+// model's variables, one clause per line, after a line with the hash of the
+// model text and that of its signature, the text without its numbers:
+//
+//   % model 5c1f3b0e8a2d4967 0e3b6c52f1a9d870
+//   x>=3 y!=2 b=false
+//
+// so that a later solve of the same model, e.g. with other options or a
+// longer time limit, can start with them. A model with other data can load
+// them if it has the same signature, i.e. the same variables and constraints,
+// as the names the flattening gives to the vars it introduces would not mean
+// the same otherwise. The clauses follow from the data they were learnt with,
+// so it is up to the user that they still hold, and --nogoods-strict only
+// loads them into the same text. A clause with a literal of a variable or
+// value the model does not have is skipped. One with a literal of a variable
+// without a name, e.g. one made by a propagator, is not saved.
+
+// Name the literal of an int var after the var's values
+static bool intLitName(Lit p, std::ostream& out) {
+	ChannelInfo& ci = sat().c_info[var(p)];
+	IntVar *x = engine().vars[ci.cons_id];
+	std::map<IntVar*, std::string>::iterator it = intVarString().find(x);
+	if (it == intVarString().end() || it->second.empty()) return false;
+
+	// [x = val] or [x != val], otherwise [x >= val+1] or [x <= val]
+	int val = ci.val;
+	const char *op;
+	if (ci.val_type == 0) {
+		// The fixed literal of a lazily encoded var is never learnt
+		if (x->getType() == INT_VAR_LL) return false;
+		op = sign(p) ? "==" : "!=";
+	} else {
+		op = sign(p) ? ">=" : "<=";
+		if (sign(p)) val++;
+	}
+	if (x->getType() == INT_VAR_SL) {
+		// Literals of a sparse var are on the indices of its values
+		const vec<int>& values = ((IntVarSL*) x)->getValues();
+		if (val < 0 || val >= values.size()) return false;
+		val = values[val];
+	}
+	out << it->second << op << val;
+	return true;
+}
+
+// Write the clause of the n literals ps as a line, false if a literal has no name
+static bool clauseLine(const Lit *ps, int n, std::map<int, std::string>& bool_names, std::ostream& out) {
+	for (int j = 0; j < n; j++) {
+		if (j > 0) out << " ";
+		if (sat().c_info[var(ps[j])].cons_type == 1) {
+			if (!intLitName(ps[j], out)) return false;
+		} else {
+			std::map<int, std::string>::iterator it = bool_names.find(toInt(ps[j]));
+			if (sat().c_info[var(ps[j])].cons_type != 0 || it == bool_names.end()) return false;
+			out << it->second;
+		}
+	}
+	return true;
+}
+
+void SAT::saveNogoods(const std::string& file) {
+	// Clauses learnt once a solution has been blocked may exclude it
+	if (!engine().opt_var && engine().solutions > 0 && so().nof_solutions != 1) {
+		fprintf(stderr, "%% Nogoods are not saved when solutions have been blocked\n");
+		return;
+	}
+
+	std::ofstream out(file.c_str());
+	if (!out) {
+		fprintf(stderr, "%% Cannot write nogoods to %s\n", file.c_str());
+		return;
+	}
+
+	char header[64];
+	snprintf(header, sizeof(header), "%% model %016llx %016llx",
+	         (unsigned long long) modelHash(), (unsigned long long) modelSignature());
+	out << header << "\n";
+
+	std::map<int, std::string> bool_names;
+	for (std::map<BoolView, std::string>::iterator it = boolVarString().begin(); it != boolVarString().end(); ++it) {
+		if (it->second.empty() || it->second == "ASSIGNED_AT_ROOT") continue;
+		bool_names.insert(std::make_pair(toInt(it->first.getLit(true)), it->second + "=true"));
+		bool_names.insert(std::make_pair(toInt(it->first.getLit(false)), it->second + "=false"));
+	}
+
+	int saved = 0;
+	std::stringstream line;
+	for (int i = 0; i < learnts.size(); i++) {
+		Clause& c = *learnts[i];
+		line.str("");
+		if (!clauseLine(&c[0], c.size(), bool_names, line)) continue;
+		out << line.str() << "\n";
+		saved++;
+	}
+	// Those of length 2 are only in the watches, see addLearntBin
+	for (int i = 0; i < learnt_bins.size(); i += 2) {
+		line.str("");
+		if (!clauseLine(&learnt_bins[i], 2, bool_names, line)) continue;
+		out << line.str() << "\n";
+		saved++;
+	}
+
+	if (so().verbosity >= 1) {
+		fprintf(stderr, "%% Saved %d of %d learnt clauses to %s\n", saved,
+		        learnts.size() + learnt_bins.size() / 2, file.c_str());
+	}
+}
+
+// Parse a literal written by saveNogoods, false if the model has no such var or value
+static bool parseLit(const std::string& s, std::map<std::string, IntVar*>& int_vars,
+		std::map<std::string, BoolView>& bool_vars, Lit& p) {
+	// Operators, tried in this order, and the IntVar::getLit type of each
+	static const char *ops[] = { "!=", "==", ">=", "<=", "=" };
+	static const int types[] = { 0, 1, 2, 3, -1 };
+	size_t at = std::string::npos;
+	int k;
+	for (k = 0; k < 5; k++) {
+		at = s.find(ops[k]);
+		if (at != std::string::npos) break;
+	}
+	if (at == std::string::npos || at == 0) return false;
+	std::string name = s.substr(0, at);
+	std::string val = s.substr(at + strlen(ops[k]));
+
+	if (types[k] < 0) {
+		std::map<std::string, BoolView>::iterator it = bool_vars.find(name);
+		if (it == bool_vars.end() || (val != "true" && val != "false")) return false;
+		p = it->second.getLit(val == "true");
+		return true;
+	}
+
+	std::map<std::string, IntVar*>::iterator it = int_vars.find(name);
+	if (it == int_vars.end()) return false;
+	char *end;
+	errno = 0;
+	long v = strtol(val.c_str(), &end, 10);
+	if (val.empty() || *end != '\0' || errno != 0 || v < INT_MIN || v > INT_MAX) return false;
+	IntVar *x = it->second;
+	switch (x->getType()) {
+		case INT_VAR_EL:
+		case INT_VAR_SL:
+			break;
+		case INT_VAR_LL:
+			// Only bounds literals can be made for a lazily encoded var
+			if (types[k] < 2) return false;
+			break;
+		default:
+			return false;
+	}
+	// A value outside the domain has a constant literal
+	p = x->getLit(v, types[k]);
+	return var(p) != var(lit_True);
+}
+
+void SAT::loadNogoods(const std::string& file) {
+	assert(decisionLevel() == 0);
+	std::ifstream in(file.c_str());
+	if (!in) {
+		fprintf(stderr, "%% Cannot read nogoods from %s\n", file.c_str());
+		return;
+	}
+	if (!so().lazy) {
+		fprintf(stderr, "%% Nogoods are not loaded without lazy clause generation\n");
+		return;
+	}
+	std::string line;
+	unsigned long long hash, signature;
+	if (!std::getline(in, line) || sscanf(line.c_str(), "%% model %llx %llx", &hash, &signature) != 2 ||
+			signature != modelSignature() || (so().nogoods_strict && hash != modelHash())) {
+		fprintf(stderr, "%% Nogoods in %s are of another model, not loaded\n", file.c_str());
+		return;
+	}
+	if (hash != modelHash() && so().verbosity >= 1) {
+		fprintf(stderr, "%% Nogoods in %s are of the same model with other data\n", file.c_str());
+	}
+
+	// The inner var of a sparse var has the same name, the sparse one is kept
+	std::map<std::string, IntVar*> int_vars;
+	for (std::map<IntVar*, std::string>::iterator it = intVarString().begin(); it != intVarString().end(); ++it) {
+		if (it->second.empty()) continue;
+		IntVar*& x = int_vars[it->second];
+		if (x == NULL || it->first->getType() == INT_VAR_SL) x = it->first;
+	}
+	std::map<std::string, BoolView> bool_vars;
+	for (std::map<BoolView, std::string>::iterator it = boolVarString().begin(); it != boolVarString().end(); ++it) {
+		if (it->second.empty() || it->second == "ASSIGNED_AT_ROOT") continue;
+		bool_vars.insert(std::make_pair(it->second, it->first));
+	}
+
+	int loaded = 0, skipped = 0;
+	std::string tok;
+	vec<Lit> ps;
+	while (std::getline(in, line)) {
+		if (line.empty() || line[0] == '%') continue;
+		std::istringstream toks(line);
+		ps.clear();
+		bool known = true;
+		while (known && toks >> tok) {
+			Lit p;
+			known = parseLit(tok, int_vars, bool_vars, p);
+			if (known) ps.push(p);
+		}
+		if (!known || ps.size() == 0) {
+			skipped++;
+			continue;
+		}
+
+		// Simplify by the root level assignment
+		std::sort((Lit*) ps, (Lit*) ps + ps.size());
+		bool sat_root = false;
+		int i, j;
+		Lit prev = lit_Undef;
+		for (i = j = 0; i < ps.size(); i++) {
+			if (value(ps[i]) == l_True || ps[i] == ~prev) { sat_root = true; break; }
+			if (value(ps[i]) == l_False || ps[i] == prev) continue;
+			ps[j++] = prev = ps[i];
+		}
+		if (sat_root) continue;
+		ps.shrink(i - j);
+		loaded++;
+
+		if (ps.size() == 0) { TL_FAIL(); return; }
+		if (ps.size() == 1) {
+			enqueue(ps[0]);
+			continue;
+		}
+		// Learnt clauses of length 2 are kept as watches only, as in analyze
+		if (ps.size() == 2 && so().bin_clause_opt) {
+			addLearntBin(ps[0], ps[1]);
+			continue;
+		}
+		Clause *c = ca.alloc(ps, true);
+		c->activity() = cla_inc;
+		c->rawActivity() = 1;
+		c->clauseID() = 0;
+		addClause(*c);
+	}
+
+	if (so().verbosity >= 1) {
+		fprintf(stderr, "%% Loaded %d nogoods from %s, %d skipped\n", loaded, file.c_str(), skipped);
+	}
+}
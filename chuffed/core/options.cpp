@@ -5,7 +5,8 @@
 
 #include <iostream>
 
-Options so;
+Options main_so;
+THREAD_LOCAL Options* so_ptr = &main_so;
 
 Options::Options() :
 		nof_solutions(1)
@@ -13,6 +14,7 @@ Options::Options() :
 	, rnd_seed(0)
 	, verbosity(0)
 	, print_sol(true)
+	, intermediate(false)
 	, restart_scale(1000000000)
     , restart_scale_override(true)
     , restart_base(1.5)
@@ -24,25 +26,37 @@ Options::Options() :
 	, branch_random(false)
 	, switch_to_vsids_after(1000000000)
 	, sat_polarity(0)
+	, lns(false)
+	, lns_pg(true)
+	, lns_relax(30)
+	, lns_fail_limit(500)
+	, warm_start("")
 
 	, prop_fifo(false)
+	, prop_fifo_levels(0)
+	, prop_profile(false)
+	, prop_profile_file("")
 
 	, disj_edge_find(true)
 	, disj_set_bp(true)
+	, disj_theta_lambda(false)
 
 	, cumu_global(true)
 
 	, sat_simplify(true)
 	, fd_simplify(true)
+	, sat_presolve(false)
 
 	, lazy(true)
 	, finesse(true)
+	, linear_lift(true)
 	, learn(true)
 	, vsids(false)
 #if PHASE_SAVING
 	, phase_saving(0)
 #endif
 	, sort_learnt_level(false)
+	, learnt_minimize(true)
 	, one_watch(true)
 
         , exclude_introduced(false)
@@ -67,10 +81,21 @@ Options::Options() :
 	, sat_var_limit(2000000)
 	, nof_learnts(100000)
 	, learnts_mlimit(500000000)
+	, mem_limit(0)
+	, lbd_tiers(false)
+	, lbd_core(2)
+	, lbd_mid(6)
+	, inprocess(false)
+	, inprocess_effort(10)
+	, nogoods_in("")
+	, nogoods_out("")
+	, nogoods_strict(false)
 
 	, lang_ext_linear(false)
     
 	, mdd(false)
+	, table_ct(false)
+	, element_native_size(1000)
 	, mip(false)
 	, mip_branch(false)
 
@@ -80,7 +105,7 @@ Options::Options() :
 	, ldsbad(false)
 
 	, parallel(false)
-	, num_threads(-1)
+	, num_threads(1)
 	, thread_no(-1)
 	, share_param(10)
 	, bandwidth(3000000)
@@ -243,6 +268,10 @@ void printHelp(int& argc, char**& argv, const std::string& fileExt) {
   "  -a\n"
   "     Satisfaction problems: Find and print all solutions.\n"
   "     Optimisation problems: Print all (sub-optimal) intermediate solutions.\n"
+  "  -i [on|off], --intermediate [on|off]\n"
+  "     Optimisation problems: Print each improving solution as soon as it is\n"
+  "     found, followed by the time elapsed, instead of only the last one\n"
+  "     (default " << (def.intermediate ? "on" : "off") << ").\n"
   "  -n <n>, --n-of-solutions <n>\n"
   "     An upper bound on the number of solutions (default " << def.nof_solutions << ").\n"
   "  -v, --verbose\n"
@@ -252,6 +281,8 @@ void printHelp(int& argc, char**& argv, const std::string& fileExt) {
   "  --rnd-seed <n>\n"
   "     Set random seed (default " << def.rnd_seed << "). If 0 then the current time\n"
   "     via std::time(0) is used.\n"
+  "  -p <n>\n"
+  "     Number of threads used for portfolio search (default " << def.num_threads << ").\n"
   "\n"
   "Search Options:\n"
   "  -f [on|off]\n"
@@ -279,6 +310,16 @@ void printLongHelp(int& argc, char**& argv, const std::string& fileExt) {
   "  --prop-fifo [on|off], --no-prop-fifo\n"
   "     Use FIFO (first in, first out) queues for propagation executions instead\n"
   "     of LIFO (last in, first out) queues (default " << (def.prop_fifo ? "on" : "off") << ").\n"
+  "  --prop-fifo-levels <n>\n"
+  "     Use FIFO queues only for the propagator priorities whose bit is set in\n"
+  "     <n>, e.g. 1 for priority 0 alone (default " << def.prop_fifo_levels << ").\n"
+  "  --prop-profile [on|off], --no-prop-profile\n"
+  "     Record wakeups, calls, time, domain changes, failures and explanations for\n"
+  "     every propagator and report them per propagator class with the\n"
+  "     statistics (-s) (default " << (def.prop_profile ? "on" : "off") << ").\n"
+  "  --prop-profile-file <file>\n"
+  "     Write the propagator profile of every instance to <file> as JSON after\n"
+  "     search, with or without -s (implies --prop-profile).\n"
   "\n"
   "More Search Options:\n"
   "  --vsids [on|off], --no-vsids\n"
@@ -302,12 +343,32 @@ void printLongHelp(int& argc, char**& argv, const std::string& fileExt) {
   "  --sat-polarity <n>\n"
   "     Selection of the polarity of Boolean variables\n"
   "     (0 = default, 1 = same, 2 = anti, 3 = random) (default " << def.sat_polarity << ").\n"
+  "  --lns [on|off], --no-lns\n"
+  "     Optimisation problems: once a solution is found, search neighbourhoods\n"
+  "     of it that fix part of the output variables to their values in the\n"
+  "     solution (default " << (def.lns ? "on" : "off") << ").\n"
+  "  --lns-pg [on|off], --no-lns-pg\n"
+  "     Choose the variables to fix guided by propagation instead of at random\n"
+  "     (default " << (def.lns_pg ? "on" : "off") << ").\n"
+  "  --lns-relax <n>\n"
+  "     Initial percentage of the output variables left free. It grows when a\n"
+  "     neighbourhood is exhausted and shrinks when one reaches its fail limit\n"
+  "     (default " << def.lns_relax << ").\n"
+  "  --lns-fail-limit <n>\n"
+  "     Conflicts allowed in a neighbourhood (default " << def.lns_fail_limit << ").\n"
+  "  --warm-start <file>\n"
+  "     Branch towards the output values in <file>, written as in the solutions\n"
+  "     printed (x = 3; xs = array1d(1..2, [1, 2]);). When optimising, a solution\n"
+  "     at least as good as the objective value in <file> is looked for first.\n"
   "\n"
   "Learning Options:\n"
   "  --lazy [on|off], --no-lazy\n"
   "     Allow clause generation for domain updates (default " << (def.lazy ? "on" : "off") << ").\n"
   "  --finesse [on|off], --no-finesse\n"
   "     Try to generated stronger clauses (default " << (def.finesse ? "on" : "off") << ").\n"
+  "  --linear-lift [on|off], --no-linear-lift\n"
+  "     Drop and weaken bounds in the explanations of linear inequalities as far\n"
+  "     as their slack allows (default " << (def.linear_lift ? "on" : "off") << ").\n"
   "  --learn [on|off], --no-learn\n"
   "     Compute nogoods when a conflict is encountered (default " << (def.learn ? "on" : "off") << ").\n"
 #if PHASE_SAVING
@@ -328,9 +389,46 @@ void printLongHelp(int& argc, char**& argv, const std::string& fileExt) {
   "  --learnts-mlimit <n>\n"
   "     The maximal memory limit for learnt clauses in Bytes (default " << def.learnts_mlimit << ").\n"
   "     If the limit is reached then some learnt clauses will be deleted.\n"
+  "  --mem-limit <n>\n"
+  "     Limit the estimated memory use of the solver to n Mb, 0 for no limit\n"
+  "     (default " << def.mem_limit << "). When it is exceeded, learnt clauses are\n"
+  "     pruned hard, then all but those in use are discarded, and if that is not\n"
+  "     enough the search stops, printing =====UNKNOWN===== if no solution was\n"
+  "     found.\n"
+  "  --lbd-tiers [on|off], --no-lbd-tiers\n"
+  "     Reduce the learnt clause database periodically, keeping clauses by their\n"
+  "     literal block distance (LBD) before their activity (default " << (def.lbd_tiers ? "on" : "off") << ").\n"
+  "  --lbd-core <n>\n"
+  "     Learnt clauses with LBD up to this are kept, unless with the mid tier\n"
+  "     they fill half of --n-of-learnts (default " << def.lbd_core << ").\n"
+  "  --lbd-mid <n>\n"
+  "     Learnt clauses with LBD up to this are kept while they are used in\n"
+  "     conflict analysis (default " << def.lbd_mid << ").\n"
+  "  --inprocess [on|off], --no-inprocess\n"
+  "     When search is back at the root, remove the learnt clauses subsumed by\n"
+  "     others and shorten the rest by self-subsumption and vivification\n"
+  "     (default " << (def.inprocess ? "on" : "off") << ").\n"
+  "  --inprocess-effort <n>\n"
+  "     Propagations allowed in an inprocessing pass, as a percentage of those\n"
+  "     made by search since the last pass (default " << def.inprocess_effort << ").\n"
+  "  --nogoods-in <file>\n"
+  "     Load learnt clauses saved by --nogoods-out before search. They are only\n"
+  "     loaded into a model that differs from theirs in its numbers at most, and\n"
+  "     those on variables or values it does not have are skipped. With other\n"
+  "     data they must still hold, e.g. where only a bound that is never reached\n"
+  "     changes.\n"
+  "  --nogoods-out <file>\n"
+  "     Save the learnt clauses over named variables to <file> after search, one\n"
+  "     per line with literals such as x>=3, x!=2 or b=true.\n"
+  "  --nogoods-strict [on|off], --no-nogoods-strict\n"
+  "     Load the nogoods of --nogoods-in only into the model text they were saved\n"
+  "     from (default " << (def.nogoods_strict ? "on" : "off") << ").\n"
   "  --sort-learnt-level [on|off], --no-sort-learnt-level\n"
   "     Sort literals in a learnt clause based on their decision level\n"
   "     (default " << (def.sort_learnt_level ? "on" : "off") << ").\n"
+  "  --learnt-minimize [on|off], --no-learnt-minimize\n"
+  "     Remove the literals of a learnt clause that are implied by its other\n"
+  "     literals (default " << (def.learnt_minimize ? "on" : "off") << ").\n"
   "  --one-watch [on|off], --no-one-watch\n"
   "     Watch only one literal in a learn clause (default " << (def.one_watch ? "on" : "off") << ").\n"
   "  --bin-clause-opt [on|off], --no-bin-clause-opt\n"
@@ -355,15 +453,18 @@ void printLongHelp(int& argc, char**& argv, const std::string& fileExt) {
   "     Removal of FD propagators that are satisfied globally (default " << (def.fd_simplify ? "on" : "off") << ").\n"
   "  --sat-simplify [on|off], --no-sat-simplify\n"
   "     Removal of clauses that are satisfied globally default " << (def.sat_simplify ? "on" : "off") << ").\n"
+  "  --sat-presolve [on|off], --no-sat-presolve\n"
+  "     Before search, substitute equivalent Boolean variables and eliminate\n"
+  "     those only constrained by clauses, if they are neither decidable (see\n"
+  "     --decide-introduced) nor output (default " << (def.sat_presolve ? "on" : "off") << ").\n"
   "\n"
-#ifdef PARALLEL
   "Parallel Options:\n"
-  "  --parallel [on|off], --no-parallel\n"
-  "     Run Chuffed in parallel mode (default " << (def.parallel ? "on" : "off") << ").\n"
-  "  -p <n>\n"
-  "     Number of CPU cores in the machine (default " << def.num_cores << ").\n"
   "  --share-param <n>\n"
-  "     Default: " << def.share_param << "\n"
+  "     Maximum length of learnt clauses shared between portfolio threads\n"
+  "     (default " << def.share_param << ").\n"
+#ifdef PARALLEL
+  "  --parallel [on|off], --no-parallel\n"
+  "     Run Chuffed in parallel mode using MPI (default " << (def.parallel ? "on" : "off") << ").\n"
   "  --bandwidth <n>\n"
   "     The total number of literals that can be shared between all threads per second\n"
   "     (default " << def.bandwidth << ").\n"
@@ -373,8 +474,8 @@ void printLongHelp(int& argc, char**& argv, const std::string& fileExt) {
   "  --share-act <n>\n"
   "     How to share clause activities between threads (0 = none, 1 = act, 2 = react)\n"
   "     (default " << def.share_act << ").\n"
-  "\n"
 #endif
+  "\n"
   "Propagator Options:\n"
   "  --cumu-global [on|off], --no-cumu-global\n"
   "     Use the global cumulative propagator if possible (default " << (def.cumu_global ? "on" : "off") << ").\n"
@@ -382,8 +483,20 @@ void printLongHelp(int& argc, char**& argv, const std::string& fileExt) {
   "     Use the edge-finding propagator for disjunctive constraints (default " << (def.disj_edge_find ? "on" : "off") << ").\n"
   "  --disj-set-bp [on|off], --no-disj-set-bp\n"
   "     Use the set bounds propagator for disjunctive constraints (default " << (def.disj_set_bp ? "on" : "off") << ").\n"
+  "  --disj-theta-lambda [on|off], --no-disj-theta-lambda\n"
+  "     Propagate disjunctive constraints with Theta-Lambda trees (overload checking,\n"
+  "     detectable precedences, not-first/not-last and edge finding) in O(n log n),\n"
+  "     without precedence literals. Replaces the edge-finding and set bounds\n"
+  "     propagators (default " << (def.disj_theta_lambda ? "on" : "off") << ").\n"
   "  --mdd [on|off], --no-mdd\n"
   "     Use the MDD propagator if possible (default " << (def.mdd ? "on" : "off") << ").\n"
+  "  --table-ct [on|off], --no-table-ct\n"
+  "     Use the Compact-Table propagator for table constraints instead of a clausal\n"
+  "     decomposition (default " << (def.table_ct ? "on" : "off") << ").\n"
+  "  --element-native-size <n>\n"
+  "     Use a native propagator instead of a clausal decomposition for element\n"
+  "     constraints on constant arrays of at least this many entries, 0 for never\n"
+  "     (default " << def.element_native_size << ").\n"
   "  --mip [on|off], --no-mip\n"
   "     Use the MIP propagator if possible (default " << (def.mip ? "on" : "off") << ").\n"
   "  --mip-branch [on|off], --no-mip-branch\n"
@@ -450,164 +563,211 @@ void parseOptions(int& argc, char**& argv, std::string* fileArg, const std::stri
       std::exit(EXIT_SUCCESS);
     }
     if (cop.get("-n --n-of-solutions", &intBuffer)) {
-      so.nof_solutions = intBuffer;
+      so().nof_solutions = intBuffer;
     } else if (cop.get("-t --time-out", &intBuffer)) {
       // TODO: Remove warning when appropriate
       std::cerr << "WARNING: the --time-out flag has recently been changed."
                 << "The time-out is now provided in milliseconds instead of seconds"
                 << std::endl;
-      so.time_out = duration(intBuffer);
+      so().time_out = duration(intBuffer);
     } else if (cop.get("-r --rnd-seed", &intBuffer)) {
-      so.rnd_seed = intBuffer;
+      so().rnd_seed = intBuffer;
     } else if (cop.getBool("-v --verbose", boolBuffer)) {
-      so.verbosity = boolBuffer;
+      so().verbosity = boolBuffer;
     } else if (cop.get("--verbosity", &intBuffer)) {
-      so.verbosity = intBuffer;
+      so().verbosity = intBuffer;
     } else if (cop.getBool("--print-sol", boolBuffer)) {
-      so.print_sol = boolBuffer;
+      so().print_sol = boolBuffer;
     } else if (cop.get("--restart", &stringBuffer)) {
       if (stringBuffer == "chuffed") {
-        so.restart_type = CHUFFED_DEFAULT;
+        so().restart_type = CHUFFED_DEFAULT;
       } else if (stringBuffer == "none") {
-        so.restart_type = NONE;
+        so().restart_type = NONE;
       } else if (stringBuffer == "constant") {
-        so.restart_type = CONSTANT;
+        so().restart_type = CONSTANT;
       } else if (stringBuffer == "linear") {
-        so.restart_type = LINEAR;
+        so().restart_type = LINEAR;
       } else if (stringBuffer == "luby") {
-        so.restart_type = LUBY;
+        so().restart_type = LUBY;
       } else if (stringBuffer == "geometric") {
-        so.restart_type = GEOMETRIC;
+        so().restart_type = GEOMETRIC;
       } else {
         std::cerr << argv[0] << ": Unknown restart strategy " << stringBuffer
                   << ". Chuffed will use its default strategy.\n";
       }
-      so.restart_type_override = false;
+      so().restart_type_override = false;
     } else if (cop.get("--restart-scale", &intBuffer)) {
-      so.restart_scale = static_cast<unsigned int>(intBuffer);
-      so.restart_scale_override = false;
+      so().restart_scale = static_cast<unsigned int>(intBuffer);
+      so().restart_scale_override = false;
     } else if (cop.get("--restart-base", &stringBuffer)) {
       // TODO: Remove warning when appropriate
       std::cerr << "WARNING: the --restart-base flag has recently been changed."
                 << "The old behaviour of \"restart base\" is now implemented by --restart-scale."
                 << std::endl;
-      so.restart_base = stod(stringBuffer);
-      if (so.restart_base < 1.0) {
+      so().restart_base = stod(stringBuffer);
+      if (so().restart_base < 1.0) {
         CHUFFED_ERROR("Illegal restart base. Restart count will converge to zero.");
       }
-      so.restart_base_override = false;
+      so().restart_base_override = false;
     } else if (cop.getBool("--toggle-vsids", boolBuffer)) {
-      so.toggle_vsids = boolBuffer;
+      so().toggle_vsids = boolBuffer;
     } else if (cop.getBool("--branch-random", boolBuffer)) {
-      so.branch_random = boolBuffer;
+      so().branch_random = boolBuffer;
     } else if (cop.get("--switch-to-vsids-after", &intBuffer)) {
-      so.switch_to_vsids_after = intBuffer;
+      so().switch_to_vsids_after = intBuffer;
     } else if (cop.get("--sat-polarity", &intBuffer)) {
-      so.sat_polarity = intBuffer;
+      so().sat_polarity = intBuffer;
+    } else if (cop.getBool("--lns", boolBuffer)) {
+      so().lns = boolBuffer;
+    } else if (cop.getBool("--lns-pg", boolBuffer)) {
+      so().lns_pg = boolBuffer;
+    } else if (cop.get("--lns-relax", &intBuffer)) {
+      so().lns_relax = intBuffer;
+    } else if (cop.get("--lns-fail-limit", &intBuffer)) {
+      so().lns_fail_limit = intBuffer;
+    } else if (cop.get("--warm-start", &stringBuffer)) {
+      so().warm_start = stringBuffer;
     } else if (cop.getBool("--prop-fifo", boolBuffer)) {
-      so.prop_fifo = boolBuffer;
+      so().prop_fifo = boolBuffer;
+    } else if (cop.get("--prop-fifo-levels", &intBuffer)) {
+      so().prop_fifo_levels = intBuffer;
+    } else if (cop.getBool("--prop-profile", boolBuffer)) {
+      so().prop_profile = boolBuffer;
+    } else if (cop.get("--prop-profile-file", &stringBuffer)) {
+      so().prop_profile_file = stringBuffer;
     } else if (cop.getBool("--disj-edge-find", boolBuffer)) {
-      so.disj_edge_find = boolBuffer;
+      so().disj_edge_find = boolBuffer;
     } else if (cop.getBool("--disj-set-bp", boolBuffer)) {
-      so.disj_set_bp = boolBuffer;
+      so().disj_set_bp = boolBuffer;
+    } else if (cop.getBool("--disj-theta-lambda", boolBuffer)) {
+      so().disj_theta_lambda = boolBuffer;
     } else if (cop.getBool("--cumu-global", boolBuffer)) {
-      so.cumu_global = boolBuffer;
+      so().cumu_global = boolBuffer;
     } else if (cop.getBool("--sat-simplify", boolBuffer)) {
-      so.sat_simplify = boolBuffer;
+      so().sat_simplify = boolBuffer;
     } else if (cop.getBool("--fd-simplify", boolBuffer)) {
-      so.fd_simplify = boolBuffer;
+      so().fd_simplify = boolBuffer;
+    } else if (cop.getBool("--sat-presolve", boolBuffer)) {
+      so().sat_presolve = boolBuffer;
     } else if (cop.getBool("--lazy", boolBuffer)) {
-      so.lazy = boolBuffer;
+      so().lazy = boolBuffer;
     } else if (cop.getBool("--finesse", boolBuffer)) {
-      so.finesse = boolBuffer;
+      so().finesse = boolBuffer;
+    } else if (cop.getBool("--linear-lift", boolBuffer)) {
+      so().linear_lift = boolBuffer;
     } else if (cop.getBool("--learn", boolBuffer)) {
-      so.learn = boolBuffer;
+      so().learn = boolBuffer;
     } else if (cop.getBool("--vsids", boolBuffer)) {
-      so.vsids = boolBuffer;
+      so().vsids = boolBuffer;
     } else if (cop.getBool("--sort-learnt-level", boolBuffer)) {
-      so.sort_learnt_level = boolBuffer;
+      so().sort_learnt_level = boolBuffer;
+    } else if (cop.getBool("--learnt-minimize", boolBuffer)) {
+      so().learnt_minimize = boolBuffer;
     } else if (cop.getBool("--one-watch", boolBuffer)) {
-      so.one_watch = boolBuffer;
+      so().one_watch = boolBuffer;
     } else if (cop.getBool("--exclude-introduced", boolBuffer)) {
-      so.exclude_introduced = boolBuffer;
+      so().exclude_introduced = boolBuffer;
     } else if (cop.getBool("--decide-introduced", boolBuffer)) {
-      so.decide_introduced = boolBuffer;
+      so().decide_introduced = boolBuffer;
     } else if (cop.getBool("--introduced-heuristic", boolBuffer)) {
-      so.introduced_heuristic = boolBuffer;
+      so().introduced_heuristic = boolBuffer;
     } else if (cop.getBool("--use-var-is-introduced", boolBuffer)) {
-      so.use_var_is_introduced = boolBuffer;
+      so().use_var_is_introduced = boolBuffer;
 #ifdef HAS_PROFILER
     } else if (cop.getBool("--profiling", boolBuffer)) {
-      so.use_profiler = boolBuffer;
+      so().use_profiler = boolBuffer;
 #endif
     } else if (cop.getBool("--print-nodes", boolBuffer)) {
-      so.print_nodes = boolBuffer;
+      so().print_nodes = boolBuffer;
     } else if (cop.getBool("--print-variable-list", boolBuffer)) {
-      so.print_variable_list = boolBuffer;
+      so().print_variable_list = boolBuffer;
     } else if (cop.getBool("--print-implications", boolBuffer)) {
-      so.print_implications = boolBuffer;
+      so().print_implications = boolBuffer;
     } else if (cop.getBool("--send-skipped", boolBuffer)) {
-      so.send_skipped = boolBuffer;
+      so().send_skipped = boolBuffer;
     } else if (cop.get("--filter-domains", &stringBuffer)) {
-      so.filter_domains = stringBuffer;
+      so().filter_domains = stringBuffer;
     } else if (cop.getBool("--learnt-stats", boolBuffer)) {
-      so.learnt_stats = boolBuffer;
+      so().learnt_stats = boolBuffer;
     } else if (cop.getBool("--learnt-stats-nogood", boolBuffer)) {
-      so.learnt_stats_nogood = boolBuffer;
+      so().learnt_stats_nogood = boolBuffer;
     } else if (cop.getBool("--debug", boolBuffer)) {
-      so.debug = boolBuffer;
+      so().debug = boolBuffer;
     } else if (cop.getBool("--exhaustive-activity", boolBuffer)) {
-      so.exhaustive_activity = boolBuffer;
+      so().exhaustive_activity = boolBuffer;
     } else if (cop.getBool("--bin-clause-opt", boolBuffer)) {
-      so.bin_clause_opt = boolBuffer;
+      so().bin_clause_opt = boolBuffer;
     } else if (cop.get("--eager-limit", &intBuffer)) {
-      so.eager_limit = intBuffer;
+      so().eager_limit = intBuffer;
     } else if (cop.get("--sat-var-limit", &intBuffer)) {
-      so.sat_var_limit = intBuffer;
+      so().sat_var_limit = intBuffer;
     } else if (cop.get("--n-of-learnts", &intBuffer)) {
-      so.nof_learnts = intBuffer;
+      so().nof_learnts = intBuffer;
     } else if (cop.get("--learnts-mlimit", &intBuffer)) {
-      so.learnts_mlimit = intBuffer;
+      so().learnts_mlimit = intBuffer;
+    } else if (cop.get("--mem-limit", &intBuffer)) {
+      so().mem_limit = intBuffer;
+    } else if (cop.getBool("--lbd-tiers", boolBuffer)) {
+      so().lbd_tiers = boolBuffer;
+    } else if (cop.get("--lbd-core", &intBuffer)) {
+      so().lbd_core = intBuffer;
+    } else if (cop.get("--lbd-mid", &intBuffer)) {
+      so().lbd_mid = intBuffer;
+    } else if (cop.getBool("--inprocess", boolBuffer)) {
+      so().inprocess = boolBuffer;
+    } else if (cop.get("--inprocess-effort", &intBuffer)) {
+      so().inprocess_effort = intBuffer;
+    } else if (cop.get("--nogoods-in", &stringBuffer)) {
+      so().nogoods_in = stringBuffer;
+    } else if (cop.get("--nogoods-out", &stringBuffer)) {
+      so().nogoods_out = stringBuffer;
+    } else if (cop.getBool("--nogoods-strict", boolBuffer)) {
+      so().nogoods_strict = boolBuffer;
     } else if (cop.getBool("--lang-ext-linear", boolBuffer)) {
-      so.lang_ext_linear = boolBuffer;
+      so().lang_ext_linear = boolBuffer;
     } else if (cop.getBool("--mdd", boolBuffer)) {
-      so.mdd = boolBuffer;
+      so().mdd = boolBuffer;
+    } else if (cop.getBool("--table-ct", boolBuffer)) {
+      so().table_ct = boolBuffer;
+    } else if (cop.get("--element-native-size", &intBuffer)) {
+      so().element_native_size = intBuffer;
     } else if (cop.getBool("--mip", boolBuffer)) {
-      so.mip = boolBuffer;
+      so().mip = boolBuffer;
     } else if (cop.getBool("--mip-branch", boolBuffer)) {
-      so.mip_branch = boolBuffer;
+      so().mip_branch = boolBuffer;
     } else if (cop.getBool("--sym-static", boolBuffer)) {
-      so.sym_static = boolBuffer;
+      so().sym_static = boolBuffer;
     } else if (cop.getBool("--ldsb", boolBuffer)) {
-      so.ldsb = boolBuffer;
+      so().ldsb = boolBuffer;
     } else if (cop.getBool("--ldsbta", boolBuffer)) {
-      so.ldsbta = boolBuffer;
+      so().ldsbta = boolBuffer;
     } else if (cop.getBool("--ldsbad", boolBuffer)) {
-      so.ldsbad = boolBuffer;
+      so().ldsbad = boolBuffer;
     } else if (cop.getBool("--well-founded", boolBuffer)) {
-      so.well_founded = boolBuffer;
+      so().well_founded = boolBuffer;
+    } else if (cop.get("--share-param", &intBuffer)) {
+      so().share_param = intBuffer;
 #ifdef PARALLEL
     } else if (cop.getBool("--parallel", boolBuffer)) {
-      so.parallel = boolBuffer;
-    } else if (cop.get("--share-param", &intBuffer)) {
-      so.share_param = intBuffer;
+      so().parallel = boolBuffer;
     } else if (cop.get("--bandwidth", &intBuffer)) {
-      so.bandwidth = intBuffer;
+      so().bandwidth = intBuffer;
     } else if (cop.get("--trial-size", &intBuffer)) {
-      so.trial_size = intBuffer;
+      so().trial_size = intBuffer;
     } else if (cop.get("--share-act", &intBuffer)) {
-      so.share_act = intBuffer;
+      so().share_act = intBuffer;
 #endif
+    } else if (cop.getBool("-i --intermediate", boolBuffer)) {
+      so().intermediate = boolBuffer;
     } else if (cop.get("-a")) {
-      so.nof_solutions = 0;
+      so().nof_solutions = 0;
     } else if (cop.get("-f")) {
-      so.toggle_vsids = true;
-      so.restart_scale = 100;
+      so().toggle_vsids = true;
+      so().restart_scale = 100;
     } else if (cop.get("-p", &intBuffer)) {
-      so.parallel = true;
-      so.num_cores = intBuffer;
+      so().num_threads = intBuffer;
     } else if (cop.get("-s -S")) {
-      so.verbosity = 1;
+      so().verbosity = 1;
     } else if (argv[i][0] == '-') {
       std::cerr << argv[0] << ": unrecognized option " << argv[i] << "\n";
       std::cerr << argv[0] << ": use --help for more information.\n";
@@ -639,17 +799,19 @@ void parseOptions(int& argc, char**& argv, std::string* fileArg, const std::stri
     }
   }
   
-  rassert(so.sym_static + so.ldsb + so.ldsbta + so.ldsbad <= 1);
+  rassert(so().sym_static + so().ldsb + so().ldsbta + so().ldsbad <= 1);
   
-  if (so.ldsbta || so.ldsbad) so.ldsb = true;
-  if (so.ldsb) rassert(so.lazy);
-  if (so.mip_branch) rassert(so.mip);
-  if (so.vsids) engine.branching->add(&sat);
+  if (so().ldsbta || so().ldsbad) so().ldsb = true;
+  if (so().ldsb) rassert(so().lazy);
+  if (so().mip_branch) rassert(so().mip);
+  if (so().vsids) engine().branching->add(&sat());
   
-  if (so.learnt_stats_nogood) so.learnt_stats = true;
+  if (so().learnt_stats_nogood) so().learnt_stats = true;
+  if (!so().prop_profile_file.empty()) so().prop_profile = true;
+  if (so().prop_fifo) so().prop_fifo_levels = ~0;
   
 #ifndef PARALLEL
-  if (so.parallel) {
+  if (so().parallel) {
     fprintf(stderr, "Parallel solving not supported! Please recompile with PARALLEL=true.\n");
     rassert(false);
   }
@@ -23,6 +23,7 @@ public:
 	int rnd_seed;                    // Random seed
 	int verbosity;                   // Verbosity
 	bool print_sol;                  // Print solutions
+	bool intermediate;               // Print improving solutions as they are found, with their time
 	unsigned int restart_scale;      // How many conflicts before restart
 	bool restart_scale_override;     // Restart scale set from CLI
 	double restart_base;             // How is the restart limit scaled (geometric)
@@ -35,13 +36,22 @@ public:
 	bool branch_random;              // Use randomization for tie-breaking
     int switch_to_vsids_after;       // Switch from search ann to vsids after a given number of conflicts
 	int sat_polarity;                // Polarity of bool var to choose (0 = default, 1 = same, 2 = anti, 3 = random)
+	bool lns;                        // Search neighbourhoods of the incumbent once one is found
+	bool lns_pg;                     // Choose the vars to fix guided by propagation, otherwise at random
+	int lns_relax;                   // Initial percentage of the output vars left free
+	int lns_fail_limit;              // Conflicts allowed per neighbourhood
+	std::string warm_start;          // Assignment of the outputs to branch towards first
 
 	// Propagator options
 	bool prop_fifo;                  // Propagators are queued in FIFO, otherwise LIFO
+	int prop_fifo_levels;            // Bitmask of the priority levels queued in FIFO
+	bool prop_profile;               // Record time, calls, prunings and explanations per propagator
+	std::string prop_profile_file;   // Write the per-propagator profile as JSON to this file
 
 	// Disjunctive propagator options
 	bool disj_edge_find;             // Use edge finding
 	bool disj_set_bp;                // Use set bounds propagation
+	bool disj_theta_lambda;          // Use Theta-Lambda tree propagation instead of precedence literals
 
 	// Cumulative propagator options
 	bool cumu_global;		 // Use the global cumulative propagator
@@ -49,16 +59,19 @@ public:
 	// Preprocessing options
 	bool sat_simplify;               // Simplify clause database at top level
 	bool fd_simplify;                // Simplify FD propagators at top level
+	bool sat_presolve;               // Substitute and eliminate Boolean vars before search
 
 	// Lazy clause options
 	bool lazy;                       // Use lazy clause
 	bool finesse;                    // Get better explanations sometimes
+	bool linear_lift;                // Weaken the explanations of linear inequalities by their slack
 	bool learn;                      // Learn clauses
 	bool vsids;                      // Use VSIDS as branching heuristic
 #if PHASE_SAVING
 	int phase_saving;                // Repeat same variable polarity (0=no, 1=recent, 2=always)
 #endif
 	bool sort_learnt_level;          // Sort lits in learnt clause based on level
+	bool learnt_minimize;            // Remove lits implied by the rest of the learnt clause
 	bool one_watch;                  // One watch learnt clauses
 
         bool exclude_introduced;         // Exclude introduced variables from learnt clauses
@@ -86,6 +99,15 @@ public:
 	int sat_var_limit;               // Max number of sat vars before turning off lazy clause
 	int nof_learnts;                 // Learnt clause no. limit
 	int learnts_mlimit;              // Learnt clause mem limit
+	int mem_limit;                   // Estimated memory limit of the solver in Mb, 0 for none
+	bool lbd_tiers;                  // Reduce learnt clauses by LBD tier, then activity
+	int lbd_core;                    // Max LBD of learnt clauses that are never removed
+	int lbd_mid;                     // Max LBD of learnt clauses kept while they are used
+	bool inprocess;                  // Vivify and subsume the learnt clauses at the root between restarts
+	int inprocess_effort;            // Propagations of a pass per hundred made by search since the last
+	std::string nogoods_in;          // Load learnt clauses from this file before search
+	std::string nogoods_out;         // Save the learnt clauses to this file after search
+	bool nogoods_strict;             // Load learnt clauses only into the model text they were saved from
 
 	// Language of explanation extension options
 	bool lang_ext_linear;
@@ -93,6 +115,10 @@ public:
     // MDD options 
 	bool mdd;                        // Use MDD propagator
 
+	// Table options
+	bool table_ct;                   // Use the Compact-Table propagator for table constraints
+	int element_native_size;         // Min constant array size for the native element propagator, 0 for never
+
 	// MIP options
 	bool mip;                        // Use MIP propagator
 	bool mip_branch;                 // Use MIP branching
@@ -108,9 +134,9 @@ public:
 
 	// Parallel options
 	bool parallel;                   // Running in parallel mode
-	int num_threads;                 // Number of worker threads
+	int num_threads;                 // Number of worker threads (portfolio threads unless MPI)
 	int thread_no;                   // Thread number of this thread
-	double share_param;              // Parameter for controlling which clauses are shared
+	double share_param;              // Max length of learnt clauses shared between threads
 	double bandwidth;                // How many lits per second we can share, counting all threads
 	int trial_size;                  // Number of shared clauses put on trial (temp. immune to pruning)
 	int share_act;                   // How to share clause activities between threads (0 = none, 1 = act, 2 = react)
@@ -149,7 +175,10 @@ public:
 
 };
 
-extern Options so;
+extern Options main_so;
+extern THREAD_LOCAL Options* so_ptr;
+// The options of the instance bound to the calling thread, see Solver
+inline Options& so() { return *so_ptr; }
 
 /// Parse command line options. If \a fileArg is not NULL, expect
 /// a filename with extension \a fileExt.
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <chuffed/core/options.h>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/sat.h>
+#include <chuffed/vars/bool-view.h>
+
+// SAT presolve
+//
+// Before search, the clauses posted by the model are simplified on the
+// Boolean vars that nothing but clauses refers to:
+//
+// - equivalence: literals in a cycle of binary clauses are equivalent, and all
+//   but one of each set are substituted away;
+// - bounded variable elimination: a var whose clauses have no more
+//   non-tautological resolvents on it than they are themselves is replaced by
+//   those resolvents.
+//
+// A var is kept (frozen) if it is channelled to an int var or a propagator,
+// watched by a propagator, decidable, output or assumed. So in FlatZinc only
+// the introduced vars are removed, and only with --no-decide-introduced. A
+// removed var may still be fixed by the search annotations, which is harmless
+// as nothing looks at it, and its value is not restored in solutions. Learnt
+// clauses on removed vars, e.g. from --nogoods-in, are dropped, while learnt
+// binaries cannot be told apart from problem ones and are kept as such.
+
+#define PRESOLVE_CLAUSE_LIM 20           // Longest resolvent allowed
+
+// Copy c into ps without its literals false at the root. False if c is
+// satisfied at the root.
+static bool rootLits(const Lit* c, int n, vec<Lit>& ps) {
+	ps.clear();
+	for (int i = 0; i < n; i++) {
+		if (sat().value(c[i]) == l_True) return false;
+		if (sat().value(c[i]) == l_Undef) ps.push(c[i]);
+	}
+	if (ps.size() == 0) { TL_FAIL(); return false; }
+	return true;
+}
+
+// A binary clause, as the codes of its literals with p < q
+struct BinClause {
+	int p, q;
+	bool operator < (const BinClause& o) const { return p < o.p || (p == o.p && q < o.q); }
+	bool operator == (const BinClause& o) const { return p == o.p && q == o.q; }
+};
+
+// Label each literal with the strongly connected component of the binary
+// implication graph it is in (Tarjan's algorithm, without recursion)
+static void implicationSCCs(vec<vec<Lit> >& cs, vec<int>& comp) {
+	int n = 2*sat().nVars();
+	vec<int> start(n+1, 0), edges;
+	for (int i = 0; i < cs.size(); i++) {
+		if (cs[i].size() != 2) continue;
+		start[toInt(~cs[i][0])+1]++;
+		start[toInt(~cs[i][1])+1]++;
+	}
+	for (int i = 0; i < n; i++) start[i+1] += start[i];
+	edges.growTo(start[n]);
+	vec<int> fill(n);
+	for (int i = 0; i < n; i++) fill[i] = start[i];
+	for (int i = 0; i < cs.size(); i++) {
+		if (cs[i].size() != 2) continue;
+		edges[fill[toInt(~cs[i][0])]++] = toInt(cs[i][1]);
+		edges[fill[toInt(~cs[i][1])]++] = toInt(cs[i][0]);
+	}
+
+	comp.growTo(n, -1);
+	vec<int> index(n, -1), lowlink(n), stack;
+	vec<char> on_stack(n, 0);
+	// Literal u being visited, and its next edge e
+	struct Call { int u, e; };
+	vec<Call> calls;
+	int next_index = 0, next_comp = 0;
+	for (int r = 0; r < n; r++) {
+		if (index[r] >= 0 || start[r] == start[r+1]) continue;
+		calls.push(Call{r, start[r]});
+		index[r] = lowlink[r] = next_index++;
+		stack.push(r); on_stack[r] = 1;
+		while (calls.size() > 0) {
+			int u = calls.last().u;
+			int& e = calls.last().e;
+			if (e < start[u+1]) {
+				int w = edges[e++];
+				if (index[w] < 0) {
+					index[w] = lowlink[w] = next_index++;
+					stack.push(w); on_stack[w] = 1;
+					calls.push(Call{w, start[w]});
+				} else if (on_stack[w] && index[w] < lowlink[u]) lowlink[u] = index[w];
+				continue;
+			}
+			calls.pop();
+			if (calls.size() > 0) {
+				int p = calls.last().u;
+				if (lowlink[u] < lowlink[p]) lowlink[p] = lowlink[u];
+			}
+			if (lowlink[u] == index[u]) {
+				int w;
+				do {
+					w = stack.last(); stack.pop();
+					on_stack[w] = 0;
+					comp[w] = next_comp;
+				} while (w != u);
+				next_comp++;
+			}
+		}
+	}
+}
+
+// Put in out the resolvent of p and n on var v. False if it is a tautology.
+static bool resolve(vec<Lit>& p, vec<Lit>& n, int v, vec<char>& mark, vec<Lit>& out) {
+	out.clear();
+	for (int i = 0; i < p.size(); i++) {
+		if (var(p[i]) == v) continue;
+		mark[toInt(p[i])] = 1;
+		out.push(p[i]);
+	}
+	bool taut = false;
+	for (int i = 0; i < n.size() && !taut; i++) {
+		if (var(n[i]) == v || mark[toInt(n[i])]) continue;
+		if (mark[toInt(~n[i])]) taut = true;
+		else out.push(n[i]);
+	}
+	for (int i = 0; i < p.size(); i++) mark[toInt(p[i])] = 0;
+	return !taut;
+}
+
+struct occ_lt {
+	const vec<long long>& cost;
+	bool operator() (int x, int y) const { return cost[x] < cost[y]; }
+	occ_lt(const vec<long long>& c) : cost(c) {}
+};
+
+void SAT::presolve() {
+	assert(decisionLevel() == 0);
+	int n = nVars();
+
+	vec<char> frozen(n, 0);
+	for (int v = 0; v < n; v++) {
+		if (c_info[v].cons_type != 0 || assigns[v] != toInt(l_Undef) || flags[v].decidable) frozen[v] = 1;
+	}
+	for (int i = 0; i < watches.size(); i++) {
+		vec<WatchElem>& ws = watches[i];
+		for (int j = 0; j < ws.size(); j++) if (ws[j].d.type == 2) frozen[i/2] = 1;
+	}
+	for (int i = 0; i < engine().outputs.size(); i++) {
+		if (BoolView *b = dynamic_cast<BoolView*>(engine().outputs[i])) frozen[var(b->getLit(true))] = 1;
+	}
+	for (int i = 0; i < engine().assumptions.size(); i++) frozen[var(toLit(engine().assumptions[i]))] = 1;
+
+	int free_vars = 0;
+	for (int v = 0; v < n; v++) if (!frozen[v]) free_vars++;
+	if (free_vars == 0) return;
+
+	// Copy the clauses, binaries once each
+	vec<vec<Lit> > cs;
+	vec<Lit> ps;
+	vec<BinClause> bins;
+	for (int i = 0; i < watches.size(); i++) {
+		vec<WatchElem>& ws = watches[i];
+		for (int j = 0; j < ws.size(); j++) {
+			if (ws[j].d.type != 1) continue;
+			int p = toInt(~toLit(i)), q = ws[j].d.d2;
+			bins.push(p < q ? BinClause{p, q} : BinClause{q, p});
+		}
+	}
+	std::sort((BinClause*) bins, (BinClause*) bins + bins.size());
+	for (int i = 0; i < bins.size(); i++) {
+		if (i > 0 && bins[i] == bins[i-1]) continue;
+		Lit b[2] = { toLit(bins[i].p), toLit(bins[i].q) };
+		if (b[0] == ~b[1] || !rootLits(b, 2, ps)) continue;
+		cs.push(); ps.copyTo(cs.last());
+	}
+	bins.clear(true);
+	for (int i = 0; i < clauses.size(); i++) {
+		Clause& c = *clauses[i];
+		if (!rootLits(c, c.size(), ps)) continue;
+		cs.push(); ps.copyTo(cs.last());
+	}
+	int orig_clauses = cs.size();
+
+	// Substitute each set of equivalent literals by one of them, a frozen one
+	// if there is one, otherwise that of the least var. Both rules pick the
+	// negation of the representative in the set of the negations.
+	vec<int> comp;
+	implicationSCCs(cs, comp);
+	vec<Lit> rep(2*n, lit_Undef);
+	for (int v = 0; v < n; v++) {
+		for (int s = 0; s < 2; s++) {
+			Lit p(v, s);
+			int k = comp[toInt(p)];
+			if (k < 0) continue;
+			if (comp[toInt(~p)] == k) { TL_FAIL(); return; }
+			Lit& r = rep[k];
+			if (r == lit_Undef || (frozen[v] && !frozen[var(r)])) r = p;
+		}
+	}
+	vec<Lit> subst(n, lit_Undef);
+	for (int v = 0; v < n; v++) {
+		if (frozen[v] || comp[2*v] < 0) continue;
+		Lit r = rep[comp[2*v]];
+		if (var(r) == v) continue;
+		subst[v] = r;
+		presolve_equiv++;
+	}
+	if (presolve_equiv > 0) {
+		int i, j;
+		for (i = j = 0; i < cs.size(); i++) {
+			vec<Lit>& c = cs[i];
+			for (int k = 0; k < c.size(); k++) {
+				if (subst[var(c[k])] != lit_Undef) c[k] = id(subst[var(c[k])], sign(c[k]));
+			}
+			std::sort((Lit*) c, (Lit*) c + c.size());
+			int a, b;
+			bool taut = false;
+			for (a = b = 0; a < c.size(); a++) {
+				if (b > 0 && c[a] == c[b-1]) continue;
+				if (b > 0 && c[a] == ~c[b-1]) { taut = true; break; }
+				c[b++] = c[a];
+			}
+			if (taut) continue;
+			c.resize(b);
+			if (i != j) c.moveTo(cs[j]);
+			j++;
+		}
+		cs.resize(j);
+	}
+
+	// Eliminate the free vars with the fewest resolution candidates first
+	vec<vec<int> > occ(2*n);
+	for (int i = 0; i < cs.size(); i++) {
+		for (int k = 0; k < cs[i].size(); k++) occ[toInt(cs[i][k])].push(i);
+	}
+	vec<char> removed;
+	removed.growTo(cs.size(), 0);
+	vec<long long> cost(n, 0);
+	vec<int> cands;
+	long long budget = 100000;
+	for (int v = 0; v < n; v++) {
+		if (frozen[v] || subst[v] != lit_Undef) continue;
+		cost[v] = (long long) occ[2*v].size() * occ[2*v+1].size();
+		cands.push(v);
+	}
+	for (int i = 0; i < cs.size(); i++) budget += 10 * cs[i].size();
+	std::sort((int*) cands, (int*) cands + cands.size(), occ_lt(cost));
+
+	vec<char> elim(n, 0), mark(2*n, 0);
+	vec<vec<Lit> > res;
+	vec<int> pos, neg;
+	for (int c = 0; c < cands.size() && budget > 0; c++) {
+		int v = cands[c];
+		pos.clear(); neg.clear();
+		for (int s = 0; s < 2; s++) {
+			vec<int>& os = occ[2*v+s];
+			int i, j;
+			for (i = j = 0; i < os.size(); i++) if (!removed[os[i]]) os[j++] = os[i];
+			os.resize(j);
+			for (i = 0; i < os.size(); i++) (s ? neg : pos).push(os[i]);
+		}
+
+		res.clear();
+		bool ok = true;
+		for (int i = 0; i < pos.size() && ok; i++) {
+			for (int j = 0; j < neg.size() && ok; j++) {
+				budget -= cs[pos[i]].size() + cs[neg[j]].size();
+				if (!resolve(cs[pos[i]], cs[neg[j]], v, mark, ps)) continue;
+				if (ps.size() == 0) { TL_FAIL(); return; }
+				if (ps.size() > PRESOLVE_CLAUSE_LIM || res.size() >= pos.size() + neg.size()) ok = false;
+				else { res.push(); ps.copyTo(res.last()); }
+			}
+		}
+		if (!ok) continue;
+
+		elim[v] = 1;
+		presolve_elim++;
+		for (int i = 0; i < pos.size(); i++) removed[pos[i]] = 1;
+		for (int i = 0; i < neg.size(); i++) removed[neg[i]] = 1;
+		for (int i = 0; i < res.size(); i++) {
+			int ci = cs.size();
+			cs.push();
+			res[i].moveTo(cs.last());
+			removed.push(0);
+			for (int k = 0; k < cs[ci].size(); k++) occ[toInt(cs[ci][k])].push(ci);
+		}
+	}
+	if (presolve_equiv == 0 && presolve_elim == 0) return;
+
+	// Rebuild the clause database from the presolved clauses, keeping the
+	// propagator watches in place
+	for (int i = 0; i < watches.size(); i++) {
+		vec<WatchElem>& ws = watches[i];
+		int j, k;
+		for (j = k = 0; j < ws.size(); j++) if (ws[j].d.type == 2) ws[k++] = ws[j];
+		ws.resize(k);
+	}
+	for (int i = 0; i < clauses.size(); i++) ca.free(*clauses[i]);
+	clauses.clear();
+	bin_clauses = tern_clauses = long_clauses = 0;
+	clauses_literals = 0;
+
+	int i, j;
+	for (i = j = 0; i < learnts.size(); i++) {
+		Clause& c = *learnts[i];
+		bool gone = false;
+		for (int k = 0; k < c.size() && !gone; k++) gone = elim[var(c[k])] || subst[var(c[k])] != lit_Undef;
+		if (gone) {
+			for (int k = 0; k < c.size(); k++) decVarUse(var(c[k]));
+			learnts_literals -= c.size();
+			ca.free(c);
+			continue;
+		}
+		CRef cr = ca.ref(c);
+		watches[toInt(~c[0])].push(WatchElem(cr, c[1]));
+		watches[toInt(~c[1])].push(WatchElem(cr, c[0]));
+		learnts[j++] = &c;
+	}
+	learnts.resize(j);
+
+	int kept = 0;
+	for (int i = 0; i < cs.size(); i++) {
+		if (removed[i]) continue;
+		kept++;
+		addClause(cs[i]);
+	}
+	presolve_clauses = orig_clauses - kept;
+
+	for (int v = 0; v < n; v++) {
+		if (elim[v] || subst[v] != lit_Undef) flags[v].setDecidable(false);
+	}
+	checkGarbage();
+
+	if (so().verbosity >= 2) {
+		fprintf(stderr, "%% presolve: %lld equivalent vars, %lld eliminated vars, %lld fewer clauses\n",
+			presolve_equiv, presolve_elim, presolve_clauses);
+	}
+}
@@ -39,10 +39,11 @@ public:
 
 	// Intermediate state
 	bool in_queue;
+	int next_stage;               // Priority asked for by requestStage(), or -1
 
-	Propagator() : prop_id(engine.propagators.size()), priority(0),
-		satisfied(false), in_queue(false) {
-		engine.propagators.push(this);
+	Propagator() : prop_id(engine().propagators.size()), priority(0),
+		satisfied(false), in_queue(false), next_stage(-1) {
+		engine().propagators.push(this);
 	}
   
   virtual ~Propagator() {}
@@ -51,10 +52,16 @@ public:
 	void pushInQueue() {
 		if (!in_queue) {
 			in_queue = true;
-			engine.p_queue[priority].push(this);
+			engine().schedule(this, priority);
 		}
 	}
 
+	// Called from propagate(): run propagate() once more at priority prio when
+	// the more urgent queues are empty, e.g. an expensive pass after a cheap
+	// one. Wakeups arriving before then are left to that pass, so it must do
+	// the work of the cheap pass as well.
+	void requestStage(int prio) { next_stage = prio; }
+
 	// Wake up only parts relevant to this event
 	virtual void wakeup(int i, int c) { pushInQueue(); }
 
@@ -70,6 +77,9 @@ public:
 	// Free a lazily generated literal
 	virtual void freeLazyVar(int v) { NEVER; }
 
+	// Add the memory held by large internal tables to the accounting
+	virtual void memUsage(MemUsage& mu) {}
+
 	// Check if constraint is satisfied, return cost of check
 	virtual int checkSatisfied() { return 0; }
 
@@ -94,7 +104,8 @@ public:
 
 class PseudoProp {
 public:
-	PseudoProp() { engine.pseudo_props.push(this); }
+	PseudoProp() { engine().pseudo_props.push(this); }
+	virtual ~PseudoProp() {}
 	virtual void doFixPointStuff() = 0;
 };
 
@@ -102,22 +113,20 @@ public:
 
 class Checker {
 public:
-	Checker() { engine.checkers.push(this); }
+	Checker() { engine().checkers.push(this); }
+	virtual ~Checker() {}
 	virtual bool check() = 0;
 };
 
 
+// Temporary explanations live until the current decision level is undone
 static inline Clause* Reason_new(int sz) {
-  Clause *c = (Clause*) malloc(sizeof(Clause) + sz * sizeof(Lit));
-	c->clearFlags(); c->temp_expl = 1; c->sz = sz;
-	sat.rtrail.last().push(c);
-  return c;
+	return sat().expl_region.alloc(sz);
 }
 
 static inline Clause* Reason_new(vec<Lit>& ps) {
-	Clause *c = Clause_new(ps);
-	c->temp_expl = 1;
-	sat.rtrail.last().push(c);
+	Clause *c = sat().expl_region.alloc(ps.size());
+	for (int i = 0; i < ps.size(); i++) c->data[i] = ps[i];
 	return c;
 }
 
@@ -130,7 +139,7 @@ static inline Clause* Reason_new(vec<Lit>& ps) {
 	int64_t m_v = (val);                           \
 	if (var.op ## NotR(m_v)) {                     \
 		Reason m_r = NULL;                           \
-		if (so.lazy) new (&m_r) Reason(__VA_ARGS__); \
+		if (so().lazy) new (&m_r) Reason(__VA_ARGS__); \
 		if (!var.op(m_v, m_r)) return false;         \
 	}                                              \
 } while (0)
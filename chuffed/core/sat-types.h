@@ -79,7 +79,12 @@ class Clause {
 public:
   unsigned int learnt    : 1;             // is it a learnt clause
 	unsigned int temp_expl : 1;             // is it a temporary explanation clause
-	unsigned int padding   : 6;             // save some bits for other bitflags
+	unsigned int used      : 1;             // learnt clause used in analysis since the last reduceDB
+	unsigned int in_arena  : 1;             // is it stored in the clause arena
+	unsigned int reloced   : 1;             // moved by garbage collection, data[0] holds the new reference
+	unsigned int vivified  : 1;             // learnt clause vivified by inprocessing
+	unsigned int removed   : 1;             // removed by inprocessing, still in the learnts list
+	unsigned int padding   : 1;             // save some bits for other bitflags
 	unsigned int sz        : 24;            // the size of the clause
   Lit data[0];                            // the literals of the clause
   /* 	float data2[0]; */
@@ -108,10 +113,12 @@ public:
     float* data2 = (float*)data;
     int* data3 = (int*)data;
     int* data4 = (int*)data;
+    int* data5 = (int*)data;
     if (learnt) {
       data2[newSize]   = data2[sz];
       data3[newSize+1] = data3[sz+1];
       data4[newSize+2] = data4[sz+2];
+      data5[newSize+3] = data5[sz+3];
     }
     sz = newSize;
   }
@@ -125,13 +132,15 @@ public:
 	float&       activity    ()              {     float* data2 = (float*)data; return data2[sz]; }
 	int&         rawActivity ()              { int* data3 = (int*)data; return data3[sz+1]; }
 	int& clauseID() { int* data4 = (int*)data; return data4[sz+2]; }
+	int&         lbd         ()              { int* data5 = (int*)data; return data5[sz+3]; }
 };
 
 template<class V>
 static Clause* Clause_new(const V& ps, bool learnt = false) {
-	int mem_size = sizeof(Clause) + ps.size() * sizeof(Lit) + (learnt ? 3 : 0) * sizeof(int);
+	int mem_size = sizeof(Clause) + ps.size() * sizeof(Lit) + (learnt ? 4 : 0) * sizeof(int);
 	void* mem = malloc(mem_size);
   Clause* newClause = new (mem) Clause(ps, learnt);
+	if (learnt) newClause->lbd() = ps.size();
 	return newClause;
 }
 
@@ -170,24 +179,27 @@ const ChannelInfo ci_null(0,0,0,0);
 
 //=================================================================================================
 // WatchElem -- watch list element:
-// relies on all pointers being aligned to multiples of 4
 
 class WatchElem {
 public:
 	union {
-		Clause *pt;                               // clause pointer
 		struct {
-			unsigned int type : 2;                  // which type of watch elem if it's not a clause pointer
+			unsigned int type : 2;                  // which type of watch elem
 			unsigned int d1   : 30;                 // data 1
 			unsigned int d2   : 32;                 // data 2
 		} d;
 		int64_t a;
 	};
 	WatchElem() : a(0) {}
-	WatchElem(Clause *c) : pt(c) { if (sizeof(Clause *) == 4) d.d2 = 0; }
+	// Long clause: reference into the clause arena and a blocker literal,
+	// which when true means the clause is satisfied
+	WatchElem(unsigned int cr, Lit b) : a((int64_t) toInt(b) << 32 | cr << 2) {}
 	WatchElem(Lit p) { d.type = 1; d.d2 = toInt(p); }
 	WatchElem(int prop_id, int pos) { d.type = 2, d.d1 = pos, d.d2 = prop_id; }
-	bool operator != (WatchElem o) const { return a != o.a; }
+	// Clause watches are equal whatever their blockers
+	bool operator != (WatchElem o) const {
+		return d.type != o.d.type || d.d1 != o.d.d1 || (d.type != 0 && d.d2 != o.d.d2);
+	}
 };
 
 //=================================================================================================
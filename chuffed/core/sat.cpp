@@ -1,10 +1,12 @@
 #include <cstdio>
 #include <algorithm>
 #include <cassert>
+#include <climits>
 #include <chuffed/core/options.h>
 #include <chuffed/core/engine.h>
 #include <chuffed/core/sat.h>
 #include <chuffed/core/propagator.h>
+#include <chuffed/core/solver.h>
 #include <chuffed/mip/mip.h>
 #include <chuffed/parallel/parallel.h>
 
@@ -14,12 +16,26 @@
 
 #define PRINT_ANALYSIS 0
 
-SAT sat;
-
-std::map<int,std::string> litString;
-
-std::map<int,string> learntClauseString;
-std::ofstream learntStatsStream;
+SAT main_sat;
+THREAD_LOCAL SAT* sat_ptr = &main_sat;
+
+thread_local std::map<int,string> learntClauseString;
+thread_local std::ofstream learntStatsStream;
+
+std::string getLitString(int n) {
+  if (n == toInt(lit_True)) return "true";
+  if (n == toInt(lit_False)) return "false";
+  if (n == toInt(~lit_True)) return "false";
+  if (n == toInt(~lit_False)) return "true";
+    std::map<int,std::string>::const_iterator it = litString().find(n);
+    if (it != litString().end())
+        return it->second;
+    else {
+      std::stringstream ss;
+      ss << "UNKNOWN_LITERAL (" << n << ")";
+      return ss.str();
+    }
+}
 
 cassert(sizeof(Lit) == 4);
 cassert(sizeof(Clause) == 4);
@@ -48,7 +64,7 @@ inline void SAT::untrailToPos(vec<Lit>& t, int p) {
 		int x = var(t[i]);
 		assigns[x] = toInt(l_Undef);
 #if PHASE_SAVING
-		if (so.phase_saving >= 1 || (so.phase_saving == 1 && dl >= l0))
+		if (so().phase_saving >= 1 || (so().phase_saving == 1 && dl >= l0))
 			polarity[x] = sign(t[i]);
 #endif
 		insertVarOrder(x);
@@ -78,6 +94,22 @@ SAT::SAT() :
 	, back_jumps(0)
 	, nrestarts(0)
 	, next_simp_db(100000)
+	, next_reduce_db(2000)
+	, reduce_dbs(0)
+	, reduce_db_inc(2000)
+	, learnts_cap(INT_MAX)
+	, reduce_db_size(0)
+	, next_inprocess(2000)
+	, inprocess_props(0)
+	, inprocess_passes(0)
+	, vivified_lits(0)
+	, subsumed_clauses(0)
+	, strengthened_lits(0)
+	, presolve_equiv(0)
+	, presolve_elim(0)
+	, presolve_clauses(0)
+	, minimize_lits(0)
+	, minimize_removed_lits(0)
 	, clauses_literals(0)
 	, learnts_literals(0)
 	, max_literals(0)
@@ -100,13 +132,17 @@ SAT::SAT() :
 }
 
 SAT::~SAT() {
-	for (int i = 0; i < clauses.size(); i++) free(clauses[i]);
-	for (int i = 0; i < learnts.size(); i++) free(learnts[i]);
+	for (int l = 0; l < rtrail.size(); l++) {
+		for (int i = 0; i < rtrail[l].size(); i++) free(rtrail[l][i]);
+	}
+	free(temp_sc);
+	free(short_expl);
+	free(short_confl);
 }
 
 void SAT::init() {
 	orig_cutoff = nVars();
-	ivseen.growTo(engine.vars.size(), false);
+	ivseen.growTo(engine().vars.size(), false);
 }
 
 int SAT::newVar(int n, ChannelInfo ci) {
@@ -162,9 +198,9 @@ void SAT::removeLazyVar(int v) {
 	fprintf(stderr, "free %d\n", v);
 	var_free_list.push(v);
 	if (ci.cons_type == 1) {
-		((IntVarLL*) engine.vars[ci.cons_id])->freeLazyVar(ci.val);
+		((IntVarLL*) engine().vars[ci.cons_id])->freeLazyVar(ci.val);
 	} else if (ci.cons_type == 2) {
-		engine.propagators[ci.cons_id]->freeLazyVar(ci.val);
+		engine().propagators[ci.cons_id]->freeLazyVar(ci.val);
 	} else NEVER;
 }
 
@@ -173,6 +209,7 @@ void SAT::addClause(Lit p, Lit q) {
 	if (value(p) == l_False && value(q) == l_False) {
 		assert(false);
 		TL_FAIL();
+		return;
 	}
 	if (value(p) == l_False) {
 		assert(decisionLevel() == 0);
@@ -189,6 +226,12 @@ void SAT::addClause(Lit p, Lit q) {
 	watches[toInt(~q)].push(p);
 }
 
+// Add a learnt clause of two literals, which is kept as watches only
+void SAT::addLearntBin(Lit p, Lit q) {
+	addClause(p, q);
+	if (!so().nogoods_out.empty()) { learnt_bins.push(p); learnt_bins.push(q); }
+}
+
 void SAT::addClause(vec<Lit>& ps, bool one_watch) {
 	int i, j;
 	for (i = j = 0; i < ps.size(); i++) {
@@ -199,19 +242,23 @@ void SAT::addClause(vec<Lit>& ps, bool one_watch) {
 	if (ps.size() == 0) {
 		assert(false);
 		TL_FAIL();
+		return;
 	}
-	addClause(*Clause_new(ps), one_watch);
+	addClause(ps.size() > 2 ? *ca.alloc(ps) : *Clause_new(ps), one_watch);
 }
 
-void SAT::addClause(Clause& c, bool one_watch) {
+// Returns the clause as kept by the database, which is a copy in the clause
+// arena for long clauses, or NULL if c was absorbed and freed.
+Clause* SAT::addClause(Clause& c, bool one_watch) {
 	assert(c.size() > 0);
 	if (c.size() == 1) {
 		assert(decisionLevel() == 0);
 		if (DEBUG) fprintf(stderr, "warning: adding length 1 clause!\n");
 		if (value(c[0]) == l_False) TL_FAIL();
 		if (value(c[0]) == l_Undef) enqueue(c[0]);
-		free(&c);
-		return;
+		if (c.in_arena) ca.free(c);
+		else free(&c);
+		return NULL;
 	}
 	if (!c.learnt) {
 		if (c.size() == 2) bin_clauses++;
@@ -222,45 +269,58 @@ void SAT::addClause(Clause& c, bool one_watch) {
 	// Mark lazy lits which are used
 	if (c.learnt) for (int i = 0; i < c.size(); i++) incVarUse(var(c[i]));
 
-	if (c.size() == 2 && ((!c.learnt) || (so.bin_clause_opt))) {
+	if (c.size() == 2 && ((!c.learnt) || (so().bin_clause_opt))) {
 		if (!one_watch) watches[toInt(~c[0])].push(c[1]);
 		watches[toInt(~c[1])].push(c[0]);
-		if (!c.learnt) free(&c);
-		return;
+		if (c.learnt) {
+			if (!so().nogoods_out.empty()) { learnt_bins.push(c[0]); learnt_bins.push(c[1]); }
+			return &c;
+		}
+		if (c.in_arena) ca.free(c);
+		else free(&c);
+		return NULL;
 	}
-	if (!one_watch) watches[toInt(~c[0])].push(&c);
-	watches[toInt(~c[1])].push(&c);
-	if (c.learnt) learnts_literals += c.size();
-	else            clauses_literals += c.size();
-	if (c.learnt) {
-          learnts.push(&c);
-          if (so.learnt_stats) {
+	Clause *cp = &c;
+	if (!c.in_arena) {
+		cp = ca.alloc(c);
+		free(&c);
+	}
+	CRef cr = ca.ref(*cp);
+	if (!one_watch) watches[toInt(~(*cp)[0])].push(WatchElem(cr, (*cp)[1]));
+	watches[toInt(~(*cp)[1])].push(WatchElem(cr, (*cp)[0]));
+	if (cp->learnt) learnts_literals += cp->size();
+	else            clauses_literals += cp->size();
+	if (cp->learnt) {
+          learnts.push(cp);
+          if (so().learnt_stats) {
             std::set<int> levels;
-            for (int i = 0 ; i < c.size() ; i++) {
+            for (int i = 0 ; i < cp->size() ; i++) {
               levels.insert(out_learnt_level[i]);
             }
             std::stringstream s;
             //            s << "learntclause,";
-            s << c.clauseID() << "," << c.size() << "," << levels.size();
-            if (so.learnt_stats_nogood) {
+            s << cp->clauseID() << "," << cp->size() << "," << levels.size();
+            if (so().learnt_stats_nogood) {
                 s << ",";
-                for (int i = 0 ; i < c.size() ; i++) {
-                    s << (i == 0 ? "" : " ") << getLitString(toInt(c[i]));
+                for (int i = 0 ; i < cp->size() ; i++) {
+                    s << (i == 0 ? "" : " ") << getLitString(toInt((*cp)[i]));
               //              s << " (" << out_learnt_level[i] << ")";
                 }
             }
             //std::cerr << "\n";
-            learntClauseString[c.clauseID()] = s.str();
+            learntClauseString[cp->clauseID()] = s.str();
           }
         } else {
-          clauses.push(&c);
+          clauses.push(cp);
         }
+	return cp;
 }
 
 void SAT::removeClause(Clause& c) {
 	assert(c.size() > 1);
-	watches[toInt(~c[0])].remove(&c);
-	watches[toInt(~c[1])].remove(&c);
+	CRef cr = ca.ref(c);
+	watches[toInt(~c[0])].remove(WatchElem(cr, c[1]));
+	watches[toInt(~c[1])].remove(WatchElem(cr, c[0]));
 	if (c.learnt) learnts_literals -= c.size();
 	else          clauses_literals -= c.size();
 
@@ -269,7 +329,7 @@ void SAT::removeClause(Clause& c) {
         if (c.learnt) {
             //            learntClauseScore[c.clauseID()] = c.rawActivity();
             /* if (so.debug) { */
-            if (so.learnt_stats) {
+            if (so().learnt_stats) {
                 int id = c.clauseID();
                 learntStatsStream << learntClauseString[id];
                 learntStatsStream << ",";
@@ -280,7 +340,7 @@ void SAT::removeClause(Clause& c) {
             /* } */
         }
 
-	free(&c);
+	ca.free(c);
 }
 
 
@@ -289,11 +349,12 @@ void SAT::topLevelCleanUp() {
 
 	for (int i = rtrail[0].size(); i-- > 0; ) free(rtrail[0][i]);
 	rtrail[0].clear();
+	expl_region.clearRoot();
 
-	if (so.sat_simplify && propagations >= next_simp_db) simplifyDB();
+	if (so().sat_simplify && propagations >= next_simp_db) simplifyDB();
 
 	for (int i = 0; i < trail[0].size(); i++) {
-            if (so.debug) {
+            if (so().debug) {
                 std::cerr << "setting true at top-level: " << getLitString(toInt(trail[0][i])) << "\n";
             }
         seen[var(trail[0][i])] = true;
@@ -312,6 +373,7 @@ void SAT::simplifyDB() {
 	}
   learnts.resize(j);
 	next_simp_db = propagations + clauses_literals + learnts_literals;
+	checkGarbage();
 }
 
 bool SAT::simplify(Clause& c) {
@@ -359,11 +421,11 @@ void SAT::enqueue(Lit p, Reason r) {
 	assert(value(p) == l_Undef);
 	int v = var(p);
 	assigns [v] = toInt(lbool(!sign(p)));
-	trailpos[v] = engine.trailPos();
+	trailpos[v] = engine().trailPos();
 	reason  [v] = r;
 	trail.last().push(p);
 	ChannelInfo& ci = c_info[v];
-	if (ci.cons_type == 1) engine.vars[ci.cons_id]->channel(ci.val, ci.val_type, sign(p));
+	if (ci.cons_type == 1) engine().vars[ci.cons_id]->channel(ci.val, ci.val_type, sign(p));
 }
 
 // enqueue from FD variable, value(p) = u/f, r = ?, don't channel
@@ -375,7 +437,7 @@ void SAT::cEnqueue(Lit p, Reason r) {
 	assert(value(p) != l_True);
 	int v = var(p);
 	if (value(p) == l_False) {
-		if (so.lazy) {
+		if (so().lazy) {
 			if (r == NULL) {
 				assert(decisionLevel() == 0);
 				setConfl();
@@ -387,20 +449,20 @@ void SAT::cEnqueue(Lit p, Reason r) {
 		return;
 	}
 	assigns [v] = toInt(lbool(!sign(p)));
-	trailpos[v] = engine.trailPos();
+	trailpos[v] = engine().trailPos();
 	reason  [v] = r;
 	trail.last().push(p);
 }
 
 
 void SAT::aEnqueue(Lit p, Reason r, int l) {
-  if (so.debug) {
+  if (so().debug) {
     std::cerr << "a-enqueue literal " << getLitString(toInt(p)) << " because " << showReason(r) << " and l=" << l << "\n";
   }
 	assert(value(p) == l_Undef);
 	int v = var(p);
 	assigns [v] = toInt(lbool(!sign(p)));
-	trailpos[v] = engine.trail_lim[l]-1;
+	trailpos[v] = engine().trail_lim[l]-1;
 	reason  [v] = r;
 	trail[l].push(p);
 }
@@ -420,15 +482,16 @@ void SAT::btToLevel(int level) {
   trail.resize(level+1);
 	qhead.resize(level+1);
 	rtrail.resize(level+1);
+	expl_region.btToLevel(level);
 
-	engine.btToLevel(level);
-	if (so.mip) mip->btToLevel(level);
+	engine().btToLevel(level);
+	if (so().mip) mip->btToLevel(level);
 
 }
 
 void SAT::btToPos(int sat_pos, int core_pos) {
 	untrailToPos(trail.last(), sat_pos);
-	engine.btToPos(core_pos);
+	engine().btToPos(core_pos);
 }
 
 
@@ -471,34 +534,44 @@ bool SAT::propagate() {
 			case 2: {
 				// wake up FD propagator
 				*j++ = *i++;
-				engine.propagators[we.d.d2]->wakeup(we.d.d1, 0);
+				if (so().prop_profile) engine().propProfile(we.d.d2).wakeups++;
+				engine().propagators[we.d.d2]->wakeup(we.d.d1, 0);
 				continue;
 			}
 			default:
-				Clause& c = *we.pt;
-				i++;
-
-				// Check if already satisfied
-				if (value(c[0]) == l_True || value(c[1]) == l_True) {
-					*j++ = &c;
+				// Check if already satisfied, without touching the clause
+				Lit blocker = toLit(we.d.d2);
+				if (value(blocker) == l_True) {
+					*j++ = *i++;
 					continue;
 				}
 
+				CRef cr = we.d.d1;
+				Clause& c = *ca[cr];
+				i++;
+
 				Lit false_lit = ~p;
 
 				// Make sure the false literal is data[1]:
 				if (c[0] == false_lit) c[0] = c[1], c[1] = false_lit;
 
+				// Check if satisfied by the other watch, which becomes the blocker
+				WatchElem w(cr, c[0]);
+				if (c[0] != blocker && value(c[0]) == l_True) {
+					*j++ = w;
+					continue;
+				}
+
 				// Look for new watch:
 				for (int k = 2; k < c.size(); k++)
 					if (value(c[k]) != l_False) {
 						c[1] = c[k]; c[k] = false_lit;
-						watches[toInt(~c[1])].push(&c);
+						watches[toInt(~c[1])].push(w);
 						goto FoundWatch;
 					}
 
 				// Did not find watch -- clause is unit under assignment:
-				*j++ = &c;
+				*j++ = w;
 				if (value(c[0]) == l_False) {
 					confl = &c;
 					qhead = trail.size();
@@ -519,6 +592,53 @@ bool SAT::propagate() {
 struct activity_lt { bool operator() (Clause* x, Clause* y) { return x->activity() < y->activity(); } };
 void SAT::reduceDB() {
   int i, j;
+	reduce_dbs++;
+
+	if (so().lbd_tiers) {
+		// Core tier clauses are kept, and mid tier clauses are kept while
+		// they are used. Half of the rest are removed by activity.
+		vec<Clause*> core, mid, local;
+		for (i = 0; i < learnts.size(); i++) {
+			Clause& c = *learnts[i];
+			if (c.lbd() <= so().lbd_core) core.push(&c);
+			else if (c.lbd() <= so().lbd_mid && c.used) mid.push(&c);
+			else local.push(&c);
+			c.used = 0;
+		}
+		// The kept tiers count towards the size limit too, so if they grew
+		// past half of it the limit would be hit again at once. Their least
+		// active clauses, mid tier first, go with the local ones then.
+		int limit = std::min(so().nof_learnts, learnts_cap);
+		int over = core.size() + mid.size() - limit / 2;
+		vec<Clause*>* tiers[2] = { &mid, &core };
+		for (int t = 0; t < 2 && over > 0; t++) {
+			vec<Clause*>& tier = *tiers[t];
+			int n = std::min(over, tier.size());
+			std::sort((Clause**) tier, (Clause**) tier + tier.size(), activity_lt());
+			for (i = 0; i < n; i++) local.push(tier[i]);
+			for (i = n, j = 0; i < tier.size(); i++) tier[j++] = tier[i];
+			tier.resize(j);
+			over -= n;
+		}
+		learnts.clear();
+		for (i = 0; i < core.size(); i++) learnts.push(core[i]);
+		for (i = 0; i < mid.size(); i++) learnts.push(mid[i]);
+		std::sort((Clause**) local, (Clause**) local + local.size(), activity_lt());
+		// Locked clauses are passed over, so that half are removed if they can be
+		int pruned = 0;
+		for (i = 0; i < local.size(); i++) {
+			if (pruned < local.size()/2 && !locked(*local[i])) { removeClause(*local[i]); pruned++; }
+			else learnts.push(local[i]);
+		}
+		reduce_db_inc += 300;
+		next_reduce_db = engine().conflicts + reduce_db_inc;
+		// Locked clauses may keep the learnts over the limit, and another
+		// reduction would not remove them
+		reduce_db_size = learnts.size() + limit / 2;
+		if (so().verbosity >= 1) printf("%% Pruned %d learnt clauses\n", pruned);
+		checkGarbage();
+		return;
+	}
 
 	std::sort((Clause**) learnts, (Clause**) learnts + learnts.size(), activity_lt());
 
@@ -531,7 +651,71 @@ void SAT::reduceDB() {
   }
   learnts.resize(j);
 
-	if (so.verbosity >= 1) printf("%% Pruned %d learnt clauses\n", i-j);
+	if (so().verbosity >= 1) printf("%% Pruned %d learnt clauses\n", i-j);
+	checkGarbage();
+}
+
+// Remove every learnt clause that is not a reason, and free what they and
+// the spare explanation blocks took
+void SAT::discardLearnts() {
+	int i, j;
+	for (i = j = 0; i < learnts.size(); i++) {
+		if (!locked(*learnts[i])) removeClause(*learnts[i]);
+		else learnts[j++] = learnts[i];
+	}
+	learnts.resize(j);
+	garbageCollect();
+	expl_region.releaseSpare();
+	if (so().verbosity >= 1) printf("%% Discarded %d learnt clauses\n", i-j);
+}
+
+// Compact the clause arena once a fifth of it is taken by removed clauses
+void SAT::checkGarbage() {
+	if (ca.wasted * 5 > ca.size) garbageCollect();
+}
+
+// Copy the live clauses into a fresh arena, then redirect the clause lists,
+// the reasons of the current assignment and the watches to the copies.
+void SAT::garbageCollect() {
+	ClauseArena to;
+	vec<Clause*>* lists[2] = { &clauses, &learnts };
+	for (int k = 0; k < 2; k++) {
+		vec<Clause*>& cs = *lists[k];
+		for (int i = 0; i < cs.size(); i++) {
+			Clause& c = *cs[i];
+			assert(c.in_arena && !c.reloced);
+			cs[i] = to.alloc(c);
+			c.reloced = 1;
+			c.data[0] = toLit(to.ref(*cs[i]));
+		}
+	}
+	// Root level facts are never explained, and their reasons may already be
+	// freed by topLevelCleanUp
+	for (int i = 0; i < trail[0].size(); i++) {
+		Reason& r = reason[var(trail[0][i])];
+		if (r.d.type == 0) r.pt = NULL;
+	}
+	for (int l = 1; l < trail.size(); l++) {
+		for (int i = 0; i < trail[l].size(); i++) {
+			Reason& r = reason[var(trail[l][i])];
+			if (r.d.type == 0 && r.pt && r.pt->in_arena) {
+				r.pt = r.pt->reloced ? to[toInt(r.pt->data[0])] : NULL;
+			}
+		}
+	}
+	for (int i = 0; i < watches.size(); i++) {
+		vec<WatchElem>& ws = watches[i];
+		for (int j = 0; j < ws.size(); j++) {
+			if (ws[j].d.type != 0) continue;
+			Clause& c = *ca[ws[j].d.d1];
+			assert(c.reloced);
+			ws[j].d.d1 = toInt(c.data[0]);
+		}
+	}
+	if (so().verbosity >= 2) {
+		printf("%% Garbage collected %lld of %lld clause arena words\n", ca.wasted, ca.size);
+	}
+	to.moveTo(ca);
 }
 
 std::string showClause(Clause& c) {
@@ -565,9 +749,35 @@ void SAT::printStats() {
 	printf("%%%%%%mzn-stat: avgLongClauseLen=%.2f\n", long_clauses ? (double) (clauses_literals - 3*tern_clauses) / long_clauses : 0);
 	printf("%%%%%%mzn-stat: learntClauses=%d\n", learnts.size());
 	printf("%%%%%%mzn-stat: avgLearntClauseLen=%.2f\n", learnts.size() ? (double) learnts_literals / learnts.size() : 0);
+	if (so().learnt_minimize) {
+		printf("%%%%%%mzn-stat: minimizeLits=%lld\n", minimize_lits);
+		printf("%%%%%%mzn-stat: minimizeRemovedLits=%lld\n", minimize_removed_lits);
+	}
+	if (so().lbd_tiers) {
+		int core = 0, mid = 0;
+		for (int i = 0; i < learnts.size(); i++) {
+			if (learnts[i]->lbd() <= so().lbd_core) core++;
+			else if (learnts[i]->lbd() <= so().lbd_mid) mid++;
+		}
+		printf("%%%%%%mzn-stat: learntCoreClauses=%d\n", core);
+		printf("%%%%%%mzn-stat: learntMidClauses=%d\n", mid);
+		printf("%%%%%%mzn-stat: learntLocalClauses=%d\n", learnts.size() - core - mid);
+		printf("%%%%%%mzn-stat: learntReductions=%lld\n", reduce_dbs);
+	}
 	printf("%%%%%%mzn-stat: satPropagations=%lld\n", propagations);
+	if (so().sat_presolve) {
+		printf("%%%%%%mzn-stat: presolveEquivVars=%lld\n", presolve_equiv);
+		printf("%%%%%%mzn-stat: presolveElimVars=%lld\n", presolve_elim);
+		printf("%%%%%%mzn-stat: presolveRemovedClauses=%lld\n", presolve_clauses);
+	}
+	if (so().inprocess) {
+		printf("%%%%%%mzn-stat: inprocessPasses=%lld\n", inprocess_passes);
+		printf("%%%%%%mzn-stat: subsumedClauses=%lld\n", subsumed_clauses);
+		printf("%%%%%%mzn-stat: strengthenedLits=%lld\n", strengthened_lits);
+		printf("%%%%%%mzn-stat: vivifiedLits=%lld\n", vivified_lits);
+	}
 	printf("%%%%%%mzn-stat: naturalRestarts=%lld\n", nrestarts);
-	if (so.ldsb) {
+	if (so().ldsb) {
 		printf("%%%%%%mzn-stat: pushbackTime=%.3f\n", to_sec(pushback_time));
 	}
 }
@@ -577,7 +787,7 @@ void SAT::printStats() {
 // Branching methods
 
 bool SAT::finished() {
-	assert(so.vsids);
+	assert(so().vsids);
 	while (!order_heap.empty()) {
 		int x = order_heap[0];
 		if (!assigns[x] && flags[x].decidable) return false;
@@ -586,8 +796,8 @@ bool SAT::finished() {
 	return true;
 }
 
-DecInfo* SAT::branch() {
-	if (!so.vsids) return NULL;
+DecInfo SAT::branch() {
+	if (!so().vsids) return DecInfo();
 
 	assert(!order_heap.empty());
 
@@ -596,14 +806,14 @@ DecInfo* SAT::branch() {
 	assert(!assigns[next]);
 	assert(flags[next].decidable);
 
-	return new DecInfo(NULL, 2*next+polarity[next]);
+	return DecInfo(NULL, 2*next+polarity[next]);
 }
 
 //-----
 // Parallel methods
 
 void SAT::updateShareParam() {
-	so.share_param = 16;
+	so().share_param = 16;
 /*
 	double bmax = so.bandwidth / so.num_threads;
 	double bsum = 0;
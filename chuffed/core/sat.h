@@ -9,6 +9,7 @@
 #include <chuffed/support/misc.h>
 #include <chuffed/support/heap.h>
 #include <chuffed/core/sat-types.h>
+#include <chuffed/core/clause-arena.h>
 #include <chuffed/branching/branching.h>
 
 #include <sstream>
@@ -19,23 +20,7 @@
 class IntVar;
 class SClause;
 
-extern std::map<int,std::string> litString;
-
-inline
-std::string getLitString(int n) {
-  if (n == toInt(lit_True)) return "true";
-  if (n == toInt(lit_False)) return "false";
-  if (n == toInt(~lit_True)) return "false";
-  if (n == toInt(~lit_False)) return "true";
-    std::map<int,std::string>::const_iterator it = litString.find(n);
-    if (it != litString.end())
-        return it->second;
-    else {
-      std::stringstream ss;
-      ss << "UNKNOWN_LITERAL (" << n << ")";
-      return ss.str();
-    }
-}
+std::string getLitString(int n);
 
 class SAT : public Branching {
 	// For sorting Lits in learnt clause
@@ -58,6 +43,8 @@ public:
 
   vec<Clause*> clauses;             // List of problem clauses
   vec<Clause*> learnts;             // List of learnt clauses
+  vec<Lit> learnt_bins;             // Learnt clauses kept as watches only, two literals each, for --nogoods-out
+  ClauseArena ca;                   // Storage for the watched clauses in the lists above
 
 	vec<ChannelInfo> c_info;          // Channel info
   vec<vec<WatchElem> > watches;     // Watched lists
@@ -77,17 +64,20 @@ public:
 	vec<int> qhead;
 
 	vec<vec<Clause*> > rtrail;        // List of temporary reason clauses
+	ExplRegion expl_region;           // Temporary explanations made by Reason_new
 
 	// Intermediate state
 	Clause *confl;
 	int index;
 	vec<Lit> out_learnt;
         vec<int> out_learnt_level;
+	vec<char> level_seen;
   vec<char> seen;
 	vec<bool> ivseen;
 	vec<int> ivseen_toclear;
   vec<Lit> analyze_stack;
   vec<Lit> analyze_toclear;
+	int rewind_pos;                   // Engine trail position minimisation has stepped back to
 	vec<IntVar*> min_vars;
 	SClause *temp_sc;
 
@@ -111,6 +101,17 @@ public:
 	// Statistics
 	int bin_clauses, tern_clauses, long_clauses, learnt_clauses;
 	long long int propagations, back_jumps, nrestarts, next_simp_db;
+	long long int next_reduce_db;
+	long long int reduce_dbs;              // Learnt clause reductions made
+	int reduce_db_inc;
+	int learnts_cap;                       // Learnt clause no. limit set by --mem-limit, INT_MAX if none
+	int reduce_db_size;                    // Learnts needed for the next reduction by size, if over the limit
+	long long int next_inprocess;          // Conflicts before the next inprocessing pass
+	long long int inprocess_props;         // Propagations when the last pass ended
+	long long int inprocess_passes, vivified_lits, subsumed_clauses, strengthened_lits;
+	long long int presolve_equiv, presolve_elim, presolve_clauses;
+	long long int minimize_lits;           // Learnt clause literals before minimisation
+	long long int minimize_removed_lits;   // and removed by it
   long long int clauses_literals, learnts_literals, max_literals, tot_literals;
 	double avg_depth;
 	double confl_rate;
@@ -131,8 +132,9 @@ public:
 	int  getLazyVar(ChannelInfo ci);
 	void removeLazyVar(int v);
 	void addClause(Lit p, Lit q);
+	void addLearntBin(Lit p, Lit q);
 	void addClause(vec<Lit>& ps, bool one_watch = false);
-	void addClause(Clause& c, bool one_watch = false);
+	Clause* addClause(Clause& c, bool one_watch = false);
 	void removeClause(Clause& c);
 	void topLevelCleanUp();
 	void simplifyDB();
@@ -150,14 +152,32 @@ public:
 
 
 	void reduceDB();
+	void discardLearnts();
+	void checkGarbage();
+	void garbageCollect();
 	void printStats();
 	void printLearntStats();
 
+	// Presolve
+	void presolve();
+
+	// Inprocessing
+	vec<vec<Clause*> > occurs;             // Learnts by literal
+	vec<char> lit_mark;
+
+	void subsume(long long& budget);
+	void backSubsume(const Lit* c, int n, Clause *self, long long& budget);
+	bool shrinkLearnt(Clause& c, vec<Lit>& ps);
+
+	// Nogood cache
+	void saveNogoods(const std::string& file);
+	void loadNogoods(const std::string& file);
+
 	// Branching methods
 
 	bool finished();
 	double getScore(VarBranch vb) { NEVER; }
-	DecInfo* branch();
+	DecInfo branch();
 
 	// Parallel methods
 
@@ -172,9 +192,13 @@ public:
 	void getLearntClause(int nodeid, std::set<int>& contributingNogoods);
 	int findConflictLevel();
 	void explainUnlearnable(std::set<int>& contributingNogoods);
+	void minimizeLearnt();
+	bool litRedundant(Lit p, unsigned int abstract_levels);
+	Clause* getRewoundExpl(Lit p);
 	void explainToExhaustion(std::set<int>& contributingNogoods);
 	void clearSeen();
 	int  findBackTrackLevel();
+	int  computeLBD();
 
 
 	bool     consistent    ()      const   { return qhead.last() == trail.last().size(); }
@@ -189,15 +213,19 @@ public:
 	void    decVarUse(int v);
 	void    setConfl(Lit p = lit_False, Lit q = lit_False);
 
-	bool isRootLevel(int v) const { return trailpos[v] < engine.trail_lim[0]; }
-	bool isCurLevel(int v) const { return trailpos[v] >= engine.trail_lim.last(); }
-	int getLevel(int v) const { 
-          for (int i = engine.trail_lim.size(); i--; ) {
-            if (trailpos[v] >= engine.trail_lim[i])
-              return i;
-          }
-          return 0;
+	bool isRootLevel(int v) const { return trailpos[v] < engine().trail_lim[0]; }
+	bool isCurLevel(int v) const { return trailpos[v] >= engine().trail_lim.last(); }
+	int getLevel(int v) const {
+		// Last level starting at or before the assignment, found by bisection
+		int lo = 0, hi = engine().trail_lim.size();
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (engine().trail_lim[mid] <= trailpos[v]) lo = mid + 1;
+			else hi = mid;
+		}
+		return lo ? lo - 1 : 0;
 	}
+	unsigned int abstractLevel(int level) const { return 1u << (level & 31); }
 
 	// Debug Methods
 
@@ -212,6 +240,7 @@ inline void SAT::newDecisionLevel() {
 	trail.push();
 	qhead.push(0);
 	rtrail.push();
+	expl_region.newLevel();
 }
 
 inline void SAT::incVarUse(int v) {
@@ -241,6 +270,9 @@ inline Clause* SAT::getExpl(Lit p) {
 	}
 }
 
-extern SAT sat;
+extern SAT main_sat;
+extern THREAD_LOCAL SAT* sat_ptr;
+// The SAT core of the instance bound to the calling thread, see Solver
+inline SAT& sat() { return *sat_ptr; }
 
 #endif
@@ -0,0 +1,59 @@
+#include <chuffed/core/solver.h>
+#include <chuffed/core/options.h>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/sat.h>
+#include <chuffed/branching/branching.h>
+#include <chuffed/mip/mip.h>
+#include <chuffed/mip/simplex.h>
+#include <chuffed/ldsb/ldsb.h>
+
+// main_solver is defined in engine.cpp, after the instance it wraps
+THREAD_LOCAL Solver* solver_ptr = &main_solver;
+
+Solver::Solver(Options *o, Engine *e, SAT *s) :
+		owned(false)
+	, so_p(o)
+	, engine_p(e)
+	, sat_p(s)
+	, simplex_p(simplex)
+	, mip_p(mip)
+	, ldsb_p(ldsb)
+	, model_hash(0)
+	, model_signature(0)
+{}
+
+Solver::Solver(const Options& o) : owned(true), model_hash(0), model_signature(0) {
+	Solver *prev = solver_ptr;
+
+	// Each part is built with the parts it depends on already bound
+	solver_ptr = this;
+	so_p = so_ptr = new Options(o);
+	engine_p = engine_ptr = new Engine();
+	sat_p = sat_ptr = new SAT();
+	simplex_p = simplex;
+	mip_p = mip;
+	ldsb_p = ldsb;
+	if (so().vsids) engine().branching->add(&sat());
+
+	prev->bind();
+}
+
+Solver::~Solver() {
+	if (!owned) return;
+	// The MIP propagator goes with the engine's other propagators
+	delete ldsb_p;
+	delete simplex_p;
+	delete sat_p;
+	delete engine_p;
+	delete so_p;
+}
+
+void Solver::bind() {
+	solver_ptr = this;
+	so_ptr = so_p;
+	engine_ptr = engine_p;
+	sat_ptr = sat_p;
+	simplex = simplex_p;
+	mip = mip_p;
+	ldsb = ldsb_p;
+}
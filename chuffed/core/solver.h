@@ -0,0 +1,67 @@
+#ifndef solver_h
+#define solver_h
+
+#include <map>
+#include <string>
+#include <chuffed/support/misc.h>
+#include <chuffed/vars/bool-view.h>
+
+// A complete solver instance: options, engine, SAT core, MIP and LDSB state,
+// and the tables that describe the model built in it.
+//
+// The engine(), sat() and so() accessors and the mip, ldsb and simplex
+// pointers used throughout the code refer to the instance bound to the
+// calling thread. Variables, propagators
+// and clauses created while an instance is bound belong to it, so several
+// models can be built and solved in one process, one per thread at a time.
+// The process starts with main_solver bound to every thread.
+
+class Options;
+class Engine;
+class SAT;
+class Simplex;
+class MIP;
+class LDSB;
+class IntVar;
+
+class Solver {
+	bool owned;                                 // Instance objects are deleted with the solver
+
+public:
+	Options *so_p;
+	Engine *engine_p;
+	SAT *sat_p;
+	Simplex *simplex_p;
+	MIP *mip_p;
+	LDSB *ldsb_p;
+
+	// Model tables
+	std::map<int, IntVar*> constants;           // Constant variables made by getConstant
+	std::map<IntVar*, std::string> int_var_names;
+	std::map<BoolView, std::string> bool_var_names;
+	std::map<int, std::string> lit_names;       // Names of literals, for debugging
+	uint64_t model_hash;                        // Hash of the model text
+	uint64_t model_signature;                   // Hash of the model text without its numbers
+
+	// Create a new instance using the options o. The solver bound to the
+	// calling thread is left unchanged.
+	Solver(const Options& o);
+	// Wrap the instance bound to the calling thread
+	Solver(Options *o, Engine *e, SAT *s);
+	~Solver();
+
+	// Make this the instance used by the calling thread
+	void bind();
+};
+
+extern Solver main_solver;
+extern THREAD_LOCAL Solver* solver_ptr;
+
+// Model tables of the instance bound to the calling thread
+inline std::map<IntVar*, std::string>& intVarString() { return solver_ptr->int_var_names; }
+inline std::map<BoolView, std::string>& boolVarString() { return solver_ptr->bool_var_names; }
+inline std::map<int, std::string>& litString() { return solver_ptr->lit_names; }
+inline uint64_t& modelHash() { return solver_ptr->model_hash; }
+inline uint64_t& modelSignature() { return solver_ptr->model_signature; }
+
+#endif
@@ -1,15 +1,26 @@
 #include <cstdio>
 #include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
 #include <chuffed/core/options.h>
 #include <chuffed/core/engine.h>
 #include <chuffed/core/sat.h>
+#include <chuffed/core/propagator.h>
 #include <chuffed/parallel/parallel.h>
 #include <chuffed/mip/mip.h>
 #include <chuffed/ldsb/ldsb.h>
 
 
 void Engine::printStats() {
-	if (so.thread_no != -1) return;
+	if (so().thread_no != -1) return;
 
 	auto total_time = std::chrono::duration_cast<duration>(chuffed_clock::now() - start_time);
 	duration search_time = total_time - init_time;
@@ -18,19 +29,20 @@ void Engine::printStats() {
 	printf("%%%%%%mzn-stat: nodes=%lld\n", nodes);
 	printf("%%%%%%mzn-stat: failures=%lld\n", conflicts);
 	printf("%%%%%%mzn-stat: restarts=%d\n", restart_count);
-	printf("%%%%%%mzn-stat: variables=%d\n", vars.size() + sat.nVars());
+	printf("%%%%%%mzn-stat: variables=%d\n", vars.size() + sat().nVars());
 	printf("%%%%%%mzn-stat: intVars=%d\n", vars.size());
-	printf("%%%%%%mzn-stat: boolVariables=%d\n", sat.nVars()-2); //Do not count constant True/False
+	printf("%%%%%%mzn-stat: boolVariables=%d\n", sat().nVars()-2); //Do not count constant True/False
 //    printf("%%%%%%mzn-stat: floatVariables=%d\n", );
 //    printf("%%%%%%mzn-stat: setVariables=%d\n", );
 	printf("%%%%%%mzn-stat: propagators=%d\n", propagators.size());
 	printf("%%%%%%mzn-stat: propagations=%lld\n", propagations);
 	printf("%%%%%%mzn-stat: peakDepth=%d\n", peak_depth);
 	printf("%%%%%%mzn-stat: nogoods=%lld\n", conflicts); //TODO: Is this correct (e.g., sat.learnts.size())
-	printf("%%%%%%mzn-stat: backjumps=%lld\n", sat.back_jumps);
+	printf("%%%%%%mzn-stat: backjumps=%lld\n", sat().back_jumps);
 	printf("%%%%%%mzn-stat: peakMem=%.2f\n", memUsed());
 	printf("%%%%%%mzn-stat: time=%.3f\n", to_sec(total_time));
 	printf("%%%%%%mzn-stat: initTime=%.3f\n", to_sec(init_time));
+	printf("%%%%%%mzn-stat: parseTime=%.3f\n", to_sec(parse_time));
 	printf("%%%%%%mzn-stat: solveTime=%.3f\n", to_sec(search_time));
 
 	// Chuffed specific statistics
@@ -38,11 +50,16 @@ void Engine::printStats() {
 		printf("%%%%%%mzn-stat: objective=%d\n", best_sol);
 		printf("%%%%%%mzn-stat: optTime=%.3f\n", to_sec(opt_time));
 	}
+	if (so().lns) {
+		printf("%%%%%%mzn-stat: lnsNeighbourhoods=%lld\n", lns_neighbourhoods);
+		printf("%%%%%%mzn-stat: lnsExhausted=%lld\n", lns_exhausted);
+		printf("%%%%%%mzn-stat: lnsRelax=%.3f\n", lns_relax);
+	}
 	printf("%%%%%%mzn-stat: baseMem=%.2f\n", base_memory);
 	printf("%%%%%%mzn-stat: trailMem=%.2f\n", trail.capacity() * sizeof(TrailElem) / 1048576.0);
-	printf("%%%%%%mzn-stat: randomSeed=%d\n", so.rnd_seed);
+	printf("%%%%%%mzn-stat: randomSeed=%d\n", so().rnd_seed);
 
-	if (so.verbosity >= 2) {
+	if (so().verbosity >= 2) {
 		int nl = 0, el = 0, ll = 0, sl = 0;
 		for (int i = 0; i < vars.size(); i++) {
 			switch (vars[i]->getType()) {
@@ -59,69 +76,242 @@ void Engine::printStats() {
 		printf("%%%%%%mzn-stat: sparseLitIntVars=%d\n", sl);
 		printf("%%%%%%mzn-stat: solutions=%lld\n", solutions);
 
-		if (so.ldsb) {
-			printf("%%%%%%mzn-stat: ldsbTime=%.3f\n", to_sec(ldsb.ldsb_time));
+		MemUsage mu;
+		memUsage(mu);
+		printf("%%%%%%mzn-stat: memTrail=%.2f\n", mu.trail / 1048576.0);
+		printf("%%%%%%mzn-stat: memWatches=%.2f\n", mu.watches / 1048576.0);
+		printf("%%%%%%mzn-stat: memClauses=%.2f\n", mu.clauses / 1048576.0);
+		printf("%%%%%%mzn-stat: memLearnts=%.2f\n", mu.learnts / 1048576.0);
+		printf("%%%%%%mzn-stat: memExplanations=%.2f\n", mu.expl / 1048576.0);
+		printf("%%%%%%mzn-stat: memVars=%.2f\n", mu.vars / 1048576.0);
+		printf("%%%%%%mzn-stat: memLazyLits=%.2f\n", mu.lazy_lits / 1048576.0);
+		if (mu.mdd) printf("%%%%%%mzn-stat: memMDD=%.2f\n", mu.mdd / 1048576.0);
+		if (so().mip) printf("%%%%%%mzn-stat: memMIP=%.2f\n", mu.mip / 1048576.0);
+
+		if (so().ldsb) {
+			printf("%%%%%%mzn-stat: ldsbTime=%.3f\n", to_sec(ldsb->ldsb_time));
 		}
-		if (so.parallel) {
+		if (so().parallel) {
 			master.printStats();
 		}
-		sat.printStats();
+		sat().printStats();
 		/* sat.printLearntStats(); */
-		if (so.mip) {
+		if (so().mip) {
 			mip->printStats();
 		}
-		for (int i = 0; i < engine.propagators.size(); i++) {
-			engine.propagators[i]->printStats();
+		for (int i = 0; i < engine().propagators.size(); i++) {
+			engine().propagators[i]->printStats();
 		}
 	}
+
+	if (so().prop_profile) printPropProfile();
 }
 
-void Engine::checkMemoryUsage() {
-	fprintf(stderr, "%d int vars, %d sat vars, %d propagators\n", vars.size(), sat.nVars(), propagators.size());
-	fprintf(stderr, "%.2fMb memory usage\n", memUsed());
-
-	fprintf(stderr, "Size of IntVars: %d %d %d\n", static_cast<int>(sizeof(IntVar)), static_cast<int>(sizeof(IntVarEL)), static_cast<int>(sizeof(IntVarLL)));
-	fprintf(stderr, "Size of Propagator: %d\n", static_cast<int>(sizeof(Propagator)));
-
-	long long var_mem = 0;
-	for (int i = 0; i < vars.size(); i++) {
-		var_mem += sizeof(IntVarLL);
-/*
-		var_mem += vars[i]->sz;
-		if (vars[i]->getType() == INT_VAR_LL) {
-			var_mem += 24 * ((IntVarLL*) vars[i])->ld.size();
-		}
-*/
+// Readable class name of a propagator, e.g. "LinearGE<0, 0>"
+static std::string propClassName(Propagator *p) {
+	const char *name = typeid(*p).name();
+#ifdef __GNUG__
+	int status;
+	char *dem = abi::__cxa_demangle(name, NULL, NULL, &status);
+	if (status == 0 && dem) {
+		std::string r(dem);
+		free(dem);
+		return r;
 	}
-	fprintf(stderr, "%lld bytes used by vars\n", var_mem);
+#endif
+	return name;
+}
 
-	long long prop_mem = 0;
-	for (int i = 0; i < propagators.size(); i++) {
-		prop_mem += sizeof(*propagators[i]);
+// Class name reduced to the characters allowed in a statistic key
+static std::string statKey(const std::string& name) {
+	std::string r;
+	for (unsigned int i = 0; i < name.size(); i++) {
+		char c = name[i];
+		if (isalnum(c)) r += c;
+		else if (c == ' ') continue;
+		else if (r.size() && r[r.size()-1] != '_') r += '_';
 	}
-	fprintf(stderr, "%lld bytes used by propagators\n", prop_mem);
-/*
-	long long var_range_sum = 0;
-	for (int i = 0; i < vars.size(); i++) {
-		var_range_sum += vars[i]->max - vars[i]->min;
+	while (r.size() && r[r.size()-1] == '_') r.erase(r.size()-1);
+	return r;
+}
+
+static void jsonString(FILE *f, const std::string& s) {
+	fputc('"', f);
+	for (unsigned int i = 0; i < s.size(); i++) {
+		if (s[i] == '"' || s[i] == '\\') fputc('\\', f);
+		fputc(s[i], f);
+	}
+	fputc('"', f);
+}
+
+static void jsonProfile(FILE *f, const PropProfile& pp) {
+	fprintf(f, "\"wakeups\": %lld, \"calls\": %lld, \"time\": %.6f, \"changes\": %lld, \"failures\": %lld, "
+	           "\"explains\": %lld, \"explLits\": %lld, \"explTime\": %.6f",
+	        pp.wakeups, pp.calls, std::chrono::duration<double>(pp.prop_time).count(), pp.changes, pp.failures,
+	        pp.explains, pp.expl_lits, std::chrono::duration<double>(pp.expl_time).count());
+}
+
+// Report the propagator profile summed over each propagator class, most
+// expensive first, and dump every instance to so.prop_profile_file if set.
+// Profile of all the instances of a propagator class
+struct ClassProfile {
+	std::string name;
+	int instances;
+	PropProfile pp;
+	ClassProfile() : instances(0) {}
+};
+
+// Sum the profiles by class, most time first, and name the class of each propagator
+static void profileClasses(std::map<std::string, ClassProfile>& by_name,
+		std::vector<ClassProfile*>& classes, std::vector<std::string>& names) {
+	Engine& e = engine();
+	e.prop_profile.growTo(e.propagators.size());
+	for (int i = 0; i < e.propagators.size(); i++) {
+		names.push_back(propClassName(e.propagators[i]));
+		ClassProfile& cp = by_name[names.back()];
+		const PropProfile& pp = e.prop_profile[i];
+		cp.name = names.back();
+		cp.instances++;
+		cp.pp.wakeups += pp.wakeups;
+		cp.pp.calls += pp.calls;
+		cp.pp.changes += pp.changes;
+		cp.pp.failures += pp.failures;
+		cp.pp.explains += pp.explains;
+		cp.pp.expl_lits += pp.expl_lits;
+		cp.pp.prop_time += pp.prop_time;
+		cp.pp.expl_time += pp.expl_time;
 	}
-	fprintf(stderr, "%lld range sum in vars\n", var_range_sum);
-*/
-	long long clause_mem = 0;
-	for (int i = 0; i < sat.clauses.size(); i++) {
-		clause_mem += sizeof(Lit) * sat.clauses[i]->size();
+
+	for (auto& it : by_name) classes.push_back(&it.second);
+	std::stable_sort(classes.begin(), classes.end(), [](ClassProfile *a, ClassProfile *b) {
+		return a->pp.prop_time + a->pp.expl_time > b->pp.prop_time + b->pp.expl_time;
+	});
+}
+
+void Engine::printPropProfile() {
+	std::map<std::string, ClassProfile> by_name;
+	std::vector<ClassProfile*> classes;
+	std::vector<std::string> names;
+	profileClasses(by_name, classes, names);
+
+	for (unsigned int i = 0; i < classes.size(); i++) {
+		std::string k = statKey(classes[i]->name);
+		const char *key = k.c_str();
+		const PropProfile& pp = classes[i]->pp;
+		printf("%%%%%%mzn-stat: prof_%s_instances=%d\n", key, classes[i]->instances);
+		printf("%%%%%%mzn-stat: prof_%s_wakeups=%lld\n", key, pp.wakeups);
+		printf("%%%%%%mzn-stat: prof_%s_calls=%lld\n", key, pp.calls);
+		printf("%%%%%%mzn-stat: prof_%s_time=%.3f\n", key, std::chrono::duration<double>(pp.prop_time).count());
+		printf("%%%%%%mzn-stat: prof_%s_changes=%lld\n", key, pp.changes);
+		printf("%%%%%%mzn-stat: prof_%s_failures=%lld\n", key, pp.failures);
+		printf("%%%%%%mzn-stat: prof_%s_explains=%lld\n", key, pp.explains);
+		printf("%%%%%%mzn-stat: prof_%s_explLits=%lld\n", key, pp.expl_lits);
+		printf("%%%%%%mzn-stat: prof_%s_explTime=%.3f\n", key, std::chrono::duration<double>(pp.expl_time).count());
 	}
-	fprintf(stderr, "%lld bytes used by sat clauses\n", clause_mem);
-/*
-	int constants, hundred, thousand, large;
-	constants = hundred = thousand = large = 0;
-	for (int i = 0; i < vars.size(); i++) {
-		int sz = vars[i]->max - vars[i]->min;
-		if (sz == 0) constants++;
-		else if (sz <= 100) hundred++;
-		else if (sz <= 1000) thousand++;
-		else large++;
+}
+
+// Write the profile to --prop-profile-file, whatever the verbosity
+void Engine::writePropProfile() {
+	std::map<std::string, ClassProfile> by_name;
+	std::vector<ClassProfile*> classes;
+	std::vector<std::string> names;
+	profileClasses(by_name, classes, names);
+
+	FILE *f = fopen(so().prop_profile_file.c_str(), "w");
+	if (!f) {
+		fprintf(stderr, "%% Could not write propagator profile to %s\n", so().prop_profile_file.c_str());
+		return;
 	}
-	fprintf(stderr, "Int sizes: %d %d %d %d\n", constants, hundred, thousand, large);
-*/
+	fprintf(f, "{\n  \"classes\": [");
+	for (unsigned int i = 0; i < classes.size(); i++) {
+		fprintf(f, "%s\n    {\"class\": ", i ? "," : "");
+		jsonString(f, classes[i]->name);
+		fprintf(f, ", \"instances\": %d, ", classes[i]->instances);
+		jsonProfile(f, classes[i]->pp);
+		fprintf(f, "}");
+	}
+	fprintf(f, "\n  ],\n  \"propagators\": [");
+	for (int i = 0; i < propagators.size(); i++) {
+		fprintf(f, "%s\n    {\"id\": %d, \"class\": ", i ? "," : "", i);
+		jsonString(f, names[i]);
+		fprintf(f, ", \"priority\": %d, ", propagators[i]->priority);
+		jsonProfile(f, prop_profile[i]);
+		fprintf(f, "}");
+	}
+	fprintf(f, "\n  ]\n}\n");
+	fclose(f);
+}
+
+// Estimate the memory held by each part of the solver
+void Engine::memUsage(MemUsage& mu) {
+	mu.trail += trail.bytes() + trail_lim.bytes() + sat().trail.bytes() + sat().qhead.bytes();
+	for (int i = 0; i < sat().trail.size(); i++) mu.trail += sat().trail[i].bytes();
+
+	mu.watches += sat().watches.bytes();
+	for (int i = 0; i < sat().watches.size(); i++) mu.watches += sat().watches[i].bytes();
+
+	// Removed clauses stay in the arena until it is collected, and most are learnts
+	long long problem_words = 0;
+	for (int i = 0; i < sat().clauses.size(); i++) problem_words += ClauseArena::words(*sat().clauses[i]);
+	mu.clauses += problem_words * sizeof(int) + sat().clauses.bytes();
+	mu.learnts += (sat().ca.size - problem_words) * sizeof(int) + sat().learnts.bytes() + sat().learnt_bins.bytes();
+
+	mu.expl += sat().expl_region.bytes() + sat().rtrail.bytes();
+	for (int i = 0; i < sat().rtrail.size(); i++) {
+		mu.expl += sat().rtrail[i].bytes();
+		for (int j = 0; j < sat().rtrail[i].size(); j++) {
+			mu.expl += sizeof(Clause) + sat().rtrail[i][j]->size() * sizeof(Lit);
+		}
+	}
+
+	mu.vars += vars.bytes() + sat().assigns.bytes() + sat().reason.bytes() + sat().trailpos.bytes()
+	         + sat().flags.bytes() + sat().c_info.bytes() + sat().activity.bytes() + sat().polarity.bytes();
+	for (int i = 0; i < vars.size(); i++) vars[i]->memUsage(mu);
+
+	for (int i = 0; i < propagators.size(); i++) propagators[i]->memUsage(mu);
+}
+
+void Engine::checkMemoryUsage() {
+	MemUsage mu;
+	memUsage(mu);
+	const double mb = 1048576.0;
+	fprintf(stderr, "%% %d int vars, %d sat vars, %d propagators, %d learnt clauses\n",
+	        vars.size(), sat().nVars(), propagators.size(), sat().learnts.size());
+	fprintf(stderr, "%% memory: trail %.2fMb, watches %.2fMb, clauses %.2fMb, learnts %.2fMb, explanations %.2fMb\n",
+	        mu.trail / mb, mu.watches / mb, mu.clauses / mb, mu.learnts / mb, mu.expl / mb);
+	fprintf(stderr, "%% memory: vars %.2fMb, lazy literals %.2fMb, MDD %.2fMb, MIP %.2fMb, rest %.2fMb, peak %.2fMb\n",
+	        mu.vars / mb, mu.lazy_lits / mb, mu.mdd / mb, mu.mip / mb, mem_static / mb, memUsed());
+}
+
+// Keep the estimated memory under --mem-limit, by pruning the learnt clauses
+// hard and then discarding all those not in use. Returns false if even that
+// is not enough.
+bool Engine::checkMemLimit() {
+	next_mem_check = conflicts + 1000;
+	long long limit = (long long) so().mem_limit * 1048576;
+	long long used;
+	auto over = [&]() {
+		MemUsage mu;
+		memUsage(mu);
+		used = mu.total() + mem_static;
+		return used > limit;
+	};
+	if (!over()) {
+		// Let the learnts grow again once there is room for them
+		if (used < limit / 4 * 3) sat().learnts_cap = INT_MAX;
+		return true;
+	}
+	if (so().verbosity >= 2) checkMemoryUsage();
+
+	// Stop the learnts from growing back past what is left
+	sat().reduceDB();
+	sat().learnts_cap = std::max(sat().learnts.size(), 1000);
+	sat().reduce_db_size = 0;
+	if (!over()) return true;
+
+	sat().discardLearnts();
+	if (!over()) return true;
+
+	if (so().verbosity >= 1) checkMemoryUsage();
+	return false;
 }
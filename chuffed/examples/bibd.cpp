@@ -66,7 +66,7 @@ public:
 
 		output_vars(s);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			// row sym
 			vec<IntVar*> sym1;
 			flatten(x, sym1);
@@ -77,14 +77,14 @@ public:
 			flatten(xt, sym2);
 			var_seq_sym_ldsb(b, v, sym2);
 
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 			printf("No sym breaks!\n");
 		}
 	}
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < v; i++) {
 			for (int j = 0; j < b; j++) {
 				assert(x[i][j]->getType() == INT_VAR_EL);
@@ -118,7 +118,7 @@ int main(int argc, char** argv) {
 	k = atoi(argv[4]);
 	l = atoi(argv[5]);
 
-	engine.solve(new BIBD(v, b, r, k, l));
+	engine().solve(new BIBD(v, b, r, k, l));
 
 	return 0;
 }
@@ -37,7 +37,7 @@ public:
 		for (int i = 0; i < piles; i++) {
 			for (int j = 0; j < layers; j++) {
 				int r;
-				while (dealt[r = myrand(so.rnd_seed)%(cards-1)+1]);
+				while (dealt[r = myrand(so().rnd_seed)%(cards-1)+1]);
 				dealt[r] = true;
 				layout[i][j] = r;
 				ctop[r] = i;
@@ -172,7 +172,7 @@ public:
 int main(int argc, char** argv) {
 	parseOptions(argc, argv);
 
-	engine.solve(new BlackHole());
+	engine().solve(new BlackHole());
 
 	return 0;
 }
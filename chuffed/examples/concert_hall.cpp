@@ -72,9 +72,9 @@ public:
 
 		optimize(total, OPT_MAX);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			val_sym_ldsb(x, 0, k-1);
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 			val_sym_break(x, 0, k-1);
 		}
 
@@ -91,8 +91,8 @@ public:
 				i++;
 			}
 //			printf("\n");
-			if (so.ldsb) var_sym_ldsb(sym);
-			else if (so.sym_static) var_sym_break(sym);
+			if (so().ldsb) var_sym_ldsb(sym);
+			else if (so().sym_static) var_sym_break(sym);
 			sym.clear();
 			base = i;
 		}
@@ -101,7 +101,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < x.size(); i++) {
 			assert(x[i]->getType() == INT_VAR_EL);
 			((IntVarEL*) x[i])->setVLearnable();
@@ -112,12 +112,12 @@ public:
 			((IntVarEL*) bi[i])->setBLearnable();
 		}
 		for (int i = 0; i < t.size(); i++) {
-			sat.flags[var(t[i].getLit(0))].setLearnable(true);
-			sat.flags[var(t[i].getLit(0))].setUIPable(true);
+			sat().flags[var(t[i].getLit(0))].setLearnable(true);
+			sat().flags[var(t[i].getLit(0))].setUIPable(true);
 		}
 		for (int i = 0; i < qs.size(); i++) {
-			sat.flags[var(qs[i].getLit(0))].setLearnable(true);
-			sat.flags[var(qs[i].getLit(0))].setUIPable(true);
+			sat().flags[var(qs[i].getLit(0))].setLearnable(true);
+			sat().flags[var(qs[i].getLit(0))].setUIPable(true);
 		}
 	}
 
@@ -137,7 +137,7 @@ public:
 	}
 
 	void generateInstance() {
-		srand(so.rnd_seed);
+		srand(so().rnd_seed);
 		n = 25;
 		k = 5;
 		int total = 100;
@@ -165,7 +165,7 @@ public:
 int main(int argc, char** argv) {
 	parseOptions(argc, argv);
 
-	engine.solve(new ConcertHall(argc == 2 ? argv[1] : NULL));
+	engine().solve(new ConcertHall(argc == 2 ? argv[1] : NULL));
 
 	return 0;
 }
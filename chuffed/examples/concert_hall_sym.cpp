@@ -70,9 +70,9 @@ public:
 
 		optimize(total, OPT_MAX);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			val_sym_ldsb(x, 0, k-1);
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 			val_sym_break(x, 0, k-1);
 		}
 
@@ -89,8 +89,8 @@ public:
 				i++;
 			}
 			printf("\n");
-			if (so.ldsb) var_sym_ldsb(sym);
-			else if (so.sym_static) var_sym_break(sym);
+			if (so().ldsb) var_sym_ldsb(sym);
+			else if (so().sym_static) var_sym_break(sym);
 			sym.clear();
 			base = i;
 		}
@@ -99,7 +99,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < x.size(); i++) {
 			assert(x[i]->getType() == INT_VAR_EL);
 			((IntVarEL*) x[i])->setVLearnable();
@@ -110,12 +110,12 @@ public:
 			((IntVarEL*) bi[i])->setBLearnable();
 		}
 		for (int i = 0; i < t.size(); i++) {
-			sat.flags[var(t[i].getLit(0))].setLearnable(true);
-			sat.flags[var(t[i].getLit(0))].setUIPable(true);
+			sat().flags[var(t[i].getLit(0))].setLearnable(true);
+			sat().flags[var(t[i].getLit(0))].setUIPable(true);
 		}
 		for (int i = 0; i < qs.size(); i++) {
-			sat.flags[var(qs[i].getLit(0))].setLearnable(true);
-			sat.flags[var(qs[i].getLit(0))].setUIPable(true);
+			sat().flags[var(qs[i].getLit(0))].setLearnable(true);
+			sat().flags[var(qs[i].getLit(0))].setUIPable(true);
 		}
 	}
 
@@ -147,7 +147,7 @@ int main(int argc, char** argv) {
 
 	assert(argc == 2);
 
-	engine.solve(new ConcertHall(argv[1]));
+	engine().solve(new ConcertHall(argv[1]));
 
 	return 0;
 }
@@ -80,7 +80,7 @@ public:
             }
             std::cin.ignore();
             
-            if( !so.mdd )
+            if( !so().mdd )
             {
                 table(w, tables[rel]);
             } else {
@@ -110,7 +110,7 @@ public:
 int main(int argc, char** argv) {
     parseOptions(argc, argv);
 
-    engine.solve(new Cross());
+    engine().solve(new Cross());
 
     return 0;
 }
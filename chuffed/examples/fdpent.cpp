@@ -894,7 +894,7 @@ int main(int argc, char** argv)
     parseOptions(argc, argv);
 
     Problem* p(new Pent(opts));
-    engine.solve(p);
+    engine().solve(p);
 
 }
 
@@ -85,7 +85,7 @@ int main(int argc, char** argv) {
 
 	assert(argc == 2);
 
-	engine.solve(new GolombRuler(atoi(argv[1])));
+	engine().solve(new GolombRuler(atoi(argv[1])));
 
 	return 0;
 }
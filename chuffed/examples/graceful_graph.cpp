@@ -57,7 +57,7 @@ public:
 
 		output_vars(x);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 				// clique sym
 			vec<IntVar*> sym1;
 			for (int i = 0; i < m; i++) {
@@ -91,7 +91,7 @@ public:
 
 			val_seq_sym_ldsb(2, nedges+1, x, sym3);
 
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 			for (int i = 0; i < m-1; i++) {
 				int_rel(x[i], IRT_LT, x[i+1]);
 			}
@@ -104,7 +104,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < x.size(); i++) {
 			assert(x[i]->getType() == INT_VAR_EL);
 			((IntVarEL*) x[i])->setVLearnable();
@@ -140,7 +140,7 @@ int main(int argc, char** argv) {
 	m = atoi(argv[1]);
 	n = atoi(argv[2]);
 
-	engine.solve(new GracefulGraph(m, n));
+	engine().solve(new GracefulGraph(m, n));
 
 	return 0;
 }
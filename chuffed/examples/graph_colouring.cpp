@@ -68,7 +68,7 @@ int main(int argc, char** argv) {
 
 	assert(argc == 2);
 
-	engine.solve(new GraphColouring(argv[1]));
+	engine().solve(new GraphColouring(argv[1]));
 
 	return 0;
 }
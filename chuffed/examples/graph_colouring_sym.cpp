@@ -81,12 +81,12 @@ public:
 
 		// Declare symmetries (optional)
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			val_sym_ldsb(x, 1, v);
 			for (int i = 0; i < p; i++) {
 				var_sym_ldsb(partitions[i]);
 			}
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 			val_sym_break(x, 1, v);
 			for (int i = 0; i < p; i++) {
 				var_sym_break(partitions[i]);
@@ -97,7 +97,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < x.size(); i++) {
 			assert(x[i]->getType() == INT_VAR_EL);
 			((IntVarEL*) x[i])->setVLearnable();
@@ -117,8 +117,8 @@ public:
 		os << "\n";
 //		fprintf(stderr, "Objective = %d\n", colours->getVal());
 		// hack for this problem
-		if (so.ldsb) {
-			int *a = (int*) ldsb.symmetries[0];
+		if (so().ldsb) {
+			int *a = (int*) ldsb->symmetries[0];
 //			for (int i = 0; i < 6; i++) printf("%d ", a[i]); printf("\n");
 			a[5] = colours->getVal()-1;
 		}
@@ -131,7 +131,7 @@ int main(int argc, char** argv) {
 
 	assert(argc == 2);
 
-	engine.solve(new GraphColouringSym(argv[1]));
+	engine().solve(new GraphColouringSym(argv[1]));
 
 	return 0;
 }
@@ -117,7 +117,7 @@ int main(int argc, char** argv) {
 	int m = atoi(argv[2]);
 	int c = atoi(argv[3]);
 
-	engine.solve(new GridColouring(n, m, c));
+	engine().solve(new GridColouring(n, m, c));
 
 	return 0;
 }
@@ -146,7 +146,7 @@ public:
 
 
 	GridColouringProp(GridColouring& _p) : p(_p), n_sets(1<<p.m), row(0) {
-		assert(!so.lazy);
+		assert(!so().lazy);
 		// set priority
 		priority = 2; 
 		// attach to var events
@@ -31,7 +31,7 @@ public:
 
 		output_vars(s);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			// row sym
 			vec<IntVar*> sym1;
 			flatten(x, sym1);
@@ -45,7 +45,7 @@ public:
 			// value sym
 			val_sym_ldsb(s, 1, n);
 
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 			for (int i = 0; i < n; i++) {
 				int_rel(x[0][i], IRT_EQ, i+1);
 			}
@@ -58,7 +58,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < n; i++) {
 			for (int j = 0; j < n; j++) {
 				assert(x[i][j]->getType() == INT_VAR_EL);
@@ -88,7 +88,7 @@ int main(int argc, char** argv) {
 	assert(argc == 2);
 	n = atoi(argv[1]);
 
-	engine.solve(new LatinSquare(n));
+	engine().solve(new LatinSquare(n));
 
 	return 0;
 }
@@ -41,7 +41,7 @@ public:
 
 		output_vars(s);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			// horizontal flip 
 			vec<IntVar*> sym1;
 
@@ -74,7 +74,7 @@ public:
 
 			var_seq_sym_ldsb(2, n*(n-1)/2, sym2);
 
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 
 			int_rel(x[0][0], IRT_LT, x[n-1][0]);
 			int_rel(x[0][0], IRT_LT, x[0][n-1]);
@@ -105,7 +105,7 @@ int main(int argc, char** argv) {
 	assert(argc == 2);
 	n = atoi(argv[1]);
 
-	engine.solve(new MagicSquare(n));
+	engine().solve(new MagicSquare(n));
 
 	return 0;
 }
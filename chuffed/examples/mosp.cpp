@@ -105,7 +105,7 @@ public:
 	}
 
 	void generateInstance() {
-		srand(so.rnd_seed);
+		srand(so().rnd_seed);
 
 		int cust_per_prod = rand()%4 + 2;
 		double density = (double) cust_per_prod / n;
@@ -227,7 +227,7 @@ int main(int argc, char** argv) {
 
 	assert(argc == 3);
 
-	engine.solve(new MOSP(atoi(argv[1]),atoi(argv[2])));
+	engine().solve(new MOSP(atoi(argv[1]),atoi(argv[2])));
 
 	return 0;
 }
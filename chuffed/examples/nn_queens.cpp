@@ -49,7 +49,7 @@ public:
 
 		output_vars(s);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			val_sym_ldsb(s, 1, n);
 
 			// horizontal flip 
@@ -84,7 +84,7 @@ public:
 
 			var_seq_sym_ldsb(2, n*(n-1)/2, sym2);
 
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 
 			for (int i = 0; i < n; i++) {
 				int_rel(x[0][i], IRT_EQ, i+1);
@@ -96,7 +96,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < n; i++) {
 			for (int j = 0; j < n; j++) {
 				assert(x[i][j]->getType() == INT_VAR_EL);
@@ -126,7 +126,7 @@ int main(int argc, char** argv) {
 	assert(argc == 2);
 	n = atoi(argv[1]);
 
-	engine.solve(new NNQueens(n));
+	engine().solve(new NNQueens(n));
 
 	return 0;
 }
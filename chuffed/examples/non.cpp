@@ -117,7 +117,7 @@ static void nonogram(vec<IntVar*>& x, vec<int>& blocks)
     nonogramDFA(blocks,dfa);
     accepts.push(dfa.size());
 
-    if( so.mdd )
+    if( so().mdd )
     {
 //        mdd_regular(x, dfa.size()+1, 2, dfa, 1, accepts);
         MDDOpts mopts;
@@ -179,7 +179,7 @@ static void nonogramDFA(vec<int>& blocks,
 int main(int argc, char** argv) {
     parseOptions(argc, argv);
 
-    engine.solve(new Nonogram());
+    engine().solve(new Nonogram());
 
     return 0;
 }
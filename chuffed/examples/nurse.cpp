@@ -346,7 +346,7 @@ int main(int argc, char** argv) {
 #ifdef DUMP_ONLY
     return 0;
 #endif
-    engine.solve(p);
+    engine().solve(p);
 
     return 0;
 }
@@ -18,11 +18,11 @@ public:
 
 	vec<IntVar*> x;                 
 	vec<BoolView> f;
-	IntVar *sat;
+	IntVar *satisfied;
 
 	Photo() {
 
-		srand(so.rnd_seed);
+		srand(so().rnd_seed);
 //		n_names = 12 + (int) floor((double) rand()/RAND_MAX*4);
 //		n_prefs = 24 + (int) floor((double) rand()/RAND_MAX*12);
 		n_names = 10 + (int) floor((double) rand()/RAND_MAX*3);
@@ -36,7 +36,7 @@ public:
 
 		createVars(x, n_names, 1, n_names);
 		createVars(f, 2*n_prefs);
-		createVar(sat, 0, n_prefs);
+		createVar(satisfied, 0, n_prefs);
 
 		// Post some constraints
 
@@ -47,7 +47,7 @@ public:
     }
 
     // Sum of fulfilment
-		bool_linear(f, IRT_GE, sat);
+		bool_linear(f, IRT_GE, satisfied);
 
 		all_different(x);
 
@@ -61,7 +61,7 @@ public:
 
 		// Declare output variables (optional)
 
-		optimize(sat, OPT_MAX);
+		optimize(satisfied, OPT_MAX);
 
 	}
 
@@ -72,7 +72,7 @@ public:
       os << x[i]->getVal() << ", ";
 		}
     os << std::endl;
-		os << "SAT = " << sat->getVal() << "\n";
+		os << "SAT = " << satisfied->getVal() << "\n";
 	}
 
 };
@@ -80,7 +80,7 @@ public:
 int main(int argc, char** argv) {
 	parseOptions(argc, argv);
 
-	engine.solve(new Photo());
+	engine().solve(new Photo());
 
 	return 0;
 }
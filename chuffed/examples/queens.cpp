@@ -30,7 +30,7 @@ public:
 
 		output_vars(x);
 
-		if (so.ldsb) {
+		if (so().ldsb) {
 			// horizontal flip 
 			vec<IntVar*> sym1;
 
@@ -51,7 +51,7 @@ public:
 
 			val_seq_sym_ldsb(2, n, x, sym2);
 
-		} else if (so.sym_static) {
+		} else if (so().sym_static) {
 
 			int_rel(x[0], IRT_LT, x[n-1]);
 			int_rel(x[0], IRT_LE, (n+1)/2);
@@ -81,7 +81,7 @@ int main(int argc, char** argv) {
 	assert(argc == 2);
 	n = atoi(argv[1]);
 
-	engine.solve(new Queens(n));
+	engine().solve(new Queens(n));
 
 	return 0;
 }
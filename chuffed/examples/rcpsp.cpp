@@ -154,7 +154,7 @@ int main(int argc, char** argv) {
 
 	assert(argc == 2);
 
-	engine.solve(new RCPSP(argv[1]));
+	engine().solve(new RCPSP(argv[1]));
 
 	return 0;
 }
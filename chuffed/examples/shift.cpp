@@ -431,6 +431,6 @@ int main(int argc, char** argv)
   
   parseInst(std::cin, acts, shifts, demand);   
 
-  engine.solve(new ShiftSched(staff,shifts,acts,demand,mode));
+  engine().solve(new ShiftSched(staff,shifts,acts,demand,mode));
   return 0;
 }
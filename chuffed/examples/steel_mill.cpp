@@ -252,7 +252,7 @@ public:
 
 	void restrict_learnable() {
 		printf("Setting learnable white list\n");
-		for (int i = 0; i < sat.nVars(); i++) sat.flags[i] = 0;
+		for (int i = 0; i < sat().nVars(); i++) sat().flags[i] = 0;
 		for (int i = 0; i < x.size(); i++) {
 			assert(x[i]->getType() == INT_VAR_EL);
 			((IntVarEL*) x[i])->setVLearnable();
@@ -288,7 +288,7 @@ int main(int argc, char** argv) {
 	assert(argc == 2);
 	n = atoi(argv[1]);
 
-	engine.solve(new SteelMill(n));
+	engine().solve(new SteelMill(n));
 
 	return 0;
 }
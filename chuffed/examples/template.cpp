@@ -62,7 +62,7 @@ int main(int argc, char** argv) {
 	assert(argc == 2);
 	n = atoi(argv[1]);
 
-	engine.solve(new ProblemName(n));
+	engine().solve(new ProblemName(n));
 
 	return 0;
 }
@@ -28,6 +28,8 @@
 #include <iostream>
 #include <cstdlib>
 
+#include <chuffed/support/misc.h>
+
 /**
  * \namespace FlatZinc::AST
  * \brief Abstract syntax trees for the %FlatZinc interpreter
@@ -48,7 +50,51 @@ namespace FlatZinc { namespace AST {
     TypeError(std::string what) : _what(what) {}
     std::string what(void) const { return _what; }
   };
-  
+
+  /**
+   * \brief Bump allocator for the nodes of a single FlatZinc item
+   *
+   * Nodes built while an arena is active are carved out of its blocks,
+   * deleting them is a no-op and reset() releases them all at once.
+   */
+  class Arena {
+  private:
+    static const size_t block_size = 1 << 16;
+    std::vector<char*> blocks;
+    size_t cur;
+    size_t used;
+  public:
+    Arena(void) : cur(0), used(0) {}
+    ~Arena(void) {
+      for (unsigned int i = 0; i < blocks.size(); i++) std::free(blocks[i]);
+    }
+    void* alloc(size_t sz) {
+      sz = (sz + 7) & ~(size_t) 7;
+      if (blocks.empty() || used + sz > block_size) {
+        if (!blocks.empty()) cur++;
+        if (cur == blocks.size()) blocks.push_back((char*) std::malloc(block_size));
+        used = 0;
+      }
+      void* p = blocks[cur] + used;
+      used += sz;
+      return p;
+    }
+    bool owns(const void* p) const {
+      for (unsigned int i = 0; i < blocks.size(); i++)
+        if (p >= blocks[i] && p < blocks[i] + block_size) return true;
+      return false;
+    }
+    /// Release every node, keeping the first block for the next item
+    void reset(void) {
+      for (unsigned int i = 1; i < blocks.size(); i++) std::free(blocks[i]);
+      if (blocks.size() > 1) blocks.resize(1);
+      cur = 0; used = 0;
+    }
+  };
+
+  /// Arena new nodes are allocated from, or NULL for the heap
+  extern THREAD_LOCAL Arena* node_arena;
+
   /**
    * \brief A node in a FlatZinc abstract syntax tree
    */
@@ -56,7 +102,16 @@ namespace FlatZinc { namespace AST {
   public:
     /// Destructor
     virtual ~Node(void);
-    
+
+    static void* operator new(size_t sz) {
+      if (node_arena) return node_arena->alloc(sz);
+      return ::operator new(sz);
+    }
+    static void operator delete(void* p) {
+      if (node_arena && node_arena->owns(p)) return;
+      ::operator delete(p);
+    }
+
     /// Append \a n to an array node
     void append(Node* n);
 
@@ -20,6 +20,10 @@
  *
  */
 
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
 #include <chuffed/support/vec.h>
 #include <chuffed/flatzinc/flatzinc.h>
 #include <chuffed/core/engine.h>
@@ -32,7 +36,8 @@ void output_var(Branching *v);
 
 namespace FlatZinc {
 
-    FlatZincSpace *s;
+    THREAD_LOCAL FlatZincSpace *s;
+    THREAD_LOCAL AST::Arena *AST::node_arena = NULL;
 
     VarBranch ann2ivarsel(AST::Node* ann) {
         if (AST::Atom* s = dynamic_cast<AST::Atom*>(ann)) {
@@ -79,6 +84,13 @@ namespace FlatZinc {
     :   intVarCount(0), boolVarCount(0), iv(intVars), iv_introduced(intVars),
         bv(boolVars), bv_introduced(boolVars), output(NULL) { 
         s = this; 
+        // Deleted with the engine the model is built in
+        engine().problem = this;
+    }
+
+    FlatZincSpace::~FlatZincSpace(void) {
+        delete output;
+        if (s == this) s = NULL;
     }
 
     void FlatZincSpace::newIntVar(IntVarSpec* vs) {
@@ -89,9 +101,9 @@ namespace FlatZinc {
             iv_introduced.resize(newSize);
         }
         bool considerIntroduced = false;
-        if (so.use_var_is_introduced) considerIntroduced = vs->introduced;
+        if (so().use_var_is_introduced) considerIntroduced = vs->introduced;
         else                          considerIntroduced = !vs->output;
-        if (so.introduced_heuristic && vs->looks_introduced) considerIntroduced = true;
+        if (so().introduced_heuristic && vs->looks_introduced) considerIntroduced = true;
         if (vs->alias) {
             iv[intVarCount++] = iv[vs->i];
         } else {
@@ -106,7 +118,7 @@ namespace FlatZinc {
                     sort((int*) d, (int*) d + d.size());
                     v = ::newIntVar(d[0], d.last());
                     if ((d.last()-d[0] >= d.size() * mylog2(d.size())) ||
-                        (d.size() <= so.eager_limit && (d.last() - d[0] + 1) > so.eager_limit)) {
+                        (d.size() <= so().eager_limit && (d.last() - d[0] + 1) > so().eager_limit)) {
                         new (v) IntVarSL(*v, d);
                     } else {
                         if (!v->allowSet(d)) TL_FAIL();
@@ -118,9 +130,9 @@ namespace FlatZinc {
             }
             /* std::cerr << "int var: " << intVarCount << " " << v << "\n"; */
                         
-            if (so.exclude_introduced && considerIntroduced)
+            if (so().exclude_introduced && considerIntroduced)
                 v->should_be_learnable = false;
-            if (!so.decide_introduced && considerIntroduced)
+            if (!so().decide_introduced && considerIntroduced)
                 v->should_be_decidable = false;
             iv[intVarCount++] = v;
         }
@@ -135,9 +147,9 @@ namespace FlatZinc {
             bv_introduced.resize(newSize);
         }
         bool considerIntroduced = false;
-        if (so.use_var_is_introduced) considerIntroduced = vs->introduced;
+        if (so().use_var_is_introduced) considerIntroduced = vs->introduced;
         else                          considerIntroduced = !vs->output;
-        if (so.introduced_heuristic && vs->looks_introduced) considerIntroduced = true;
+        if (so().introduced_heuristic && vs->looks_introduced) considerIntroduced = true;
         if (vs->alias) {
             bv[boolVarCount++] = bv[vs->i];
         } 
@@ -183,12 +195,12 @@ namespace FlatZinc {
                 if (sl->min == 1) v.setVal(true);
                 if (sl->max == 0) v.setVal(false);
             }
-            if (so.exclude_introduced && considerIntroduced) {
+            if (so().exclude_introduced && considerIntroduced) {
                 v.setLearnable(false);
                 v.setDecidable(false);
                 v.setUIPable(false);
             }
-            if (!so.decide_introduced && considerIntroduced) {
+            if (!so().decide_introduced && considerIntroduced) {
                 v.setDecidable(false);
             }
             bv[boolVarCount++] = v;
@@ -231,7 +243,7 @@ namespace FlatZinc {
             }
             branching->add(createBranch(va, ann2ivarsel(args->a[1]), ann2ivalsel(args->a[2])));
             if (AST::String* s = dynamic_cast<AST::String*>(args->a[3])) {
-                if (s->s == "all") so.nof_solutions = 0;
+                if (s->s == "all") so().nof_solutions = 0;
             }
             nbNonEmptySearchAnnotations++;
         }
@@ -253,7 +265,7 @@ namespace FlatZinc {
                 va[i] = new BoolView(bv[vars->a[i]->getBoolVar()]);
             branching->add(createBranch(va, ann2ivarsel(args->a[1]), ann2ivalsel(args->a[2]))); 
             if (AST::String* s = dynamic_cast<AST::String*>(args->a[3])) {
-                if (s->s == "all") so.nof_solutions = 0;
+                if (s->s == "all") so().nof_solutions = 0;
             }
             nbNonEmptySearchAnnotations++;
         }
@@ -295,7 +307,7 @@ namespace FlatZinc {
             if (vars->a.size() != nbChildSearchAnnotations)
                 throw FlatZinc::Error("Type error in priority_search annotation", "Variable and annotation array must have the same size");
             if (AST::String* s = dynamic_cast<AST::String*>(args->a[3])) {
-                if (s->s == "all") so.nof_solutions = 0;
+                if (s->s == "all") so().nof_solutions = 0;
             }
             branching->add(priorityBranching);
             nbNonEmptySearchAnnotations++;
@@ -327,20 +339,21 @@ namespace FlatZinc {
         int nbNonEmptySearchAnnotations = 0;
         try {
             // Parse the search annotation
-            parseSolveAnn(ann, engine.branching, nbNonEmptySearchAnnotations);
+            parseSolveAnn(ann, engine().branching, nbNonEmptySearchAnnotations);
         } 
         catch (FlatZinc::Error& e) {
             cerr << "% " << e.toString() << ". Ignore search annotation!" << endl;
             // Removal of successful parsed parts of the search annotation
-            engine.branching = new BranchGroup();
+            delete engine().branching;
+            engine().branching = new BranchGroup();
             // Reset counter
             nbNonEmptySearchAnnotations = 0;
         }
         // Check whether a search was specified
         if (nbNonEmptySearchAnnotations == 0) {
-            if (!so.vsids) {
-                so.vsids = true;
-                engine.branching->add(&sat);
+            if (!so().vsids) {
+                so().vsids = true;
+                engine().branching->add(&sat());
             }
         }
     }
@@ -348,29 +361,29 @@ namespace FlatZinc {
     void FlatZincSpace::parseSolveAnn(AST::Array* ann, BranchGroup* branching, int & nbNonEmptySearchAnnotations) {
         if (ann) {
             for (unsigned int i = 0; i < ann->a.size(); i++) {
-                if (ann->a[i]->isCall("restart_none") && so.restart_type_override) {
-                    so.restart_type = NONE;
+                if (ann->a[i]->isCall("restart_none") && so().restart_type_override) {
+                    so().restart_type = NONE;
                 } else if (ann->a[i]->isCall("restart_constant")) {
                     AST::Call* call = ann->a[i]->getCall("restart_constant");
-                    if (so.restart_type_override) { so.restart_type = CONSTANT; }
-                    if (so.restart_scale_override) { so.restart_scale = static_cast<unsigned int>(call->args->getInt()); }
+                    if (so().restart_type_override) { so().restart_type = CONSTANT; }
+                    if (so().restart_scale_override) { so().restart_scale = static_cast<unsigned int>(call->args->getInt()); }
                 } else if (ann->a[i]->isCall("restart_linear")) {
                     AST::Call* call = ann->a[i]->getCall("restart_linear");
-                    if (so.restart_type_override) { so.restart_type = LINEAR; }
-                    if (so.restart_scale_override) { so.restart_scale = static_cast<unsigned int>(call->args->getInt()); }
+                    if (so().restart_type_override) { so().restart_type = LINEAR; }
+                    if (so().restart_scale_override) { so().restart_scale = static_cast<unsigned int>(call->args->getInt()); }
                 } else if (ann->a[i]->isCall("restart_luby")) {
                     AST::Call* call = ann->a[i]->getCall("restart_luby");
-                    if (so.restart_type_override) { so.restart_type = LUBY; }
-                    if (so.restart_scale_override) { so.restart_scale = static_cast<unsigned int>(call->args->getInt()); }
+                    if (so().restart_type_override) { so().restart_type = LUBY; }
+                    if (so().restart_scale_override) { so().restart_scale = static_cast<unsigned int>(call->args->getInt()); }
                 } else if (ann->a[i]->isCall("restart_geometric")) {
                     AST::Call* call = ann->a[i]->getCall("restart_geometric");
-                    if (so.restart_type_override) { so.restart_type = GEOMETRIC; }
+                    if (so().restart_type_override) { so().restart_type = GEOMETRIC; }
                     AST::Array* args = call->getArgs(2);
-                    if (so.restart_base_override) { so.restart_base = args->a[0]->getFloat(); }
-                    if (so.restart_base < 1.0) {
+                    if (so().restart_base_override) { so().restart_base = args->a[0]->getFloat(); }
+                    if (so().restart_base < 1.0) {
                         CHUFFED_ERROR("Illegal restart base. Restart count will converge to zero.");
                     }
-                    if (so.restart_scale_override) { so.restart_scale = static_cast<unsigned int>(args->a[1]->getInt()); }
+                    if (so().restart_scale_override) { so().restart_scale = static_cast<unsigned int>(args->a[1]->getInt()); }
                 } else if (ann->a[i]->isCall("seq_search")) {
                     // Get the call
                     AST::Call* c = ann->a[i]->getCall();
@@ -468,6 +481,141 @@ namespace FlatZinc {
         }
     }
 
+    // Parse a value of a warm start, false if it is not an int or a bool
+    static bool parseHintVal(const string& tok, bool& is_bool, int& v) {
+        is_bool = (tok == "true" || tok == "false");
+        if (is_bool) {
+            v = (tok == "true");
+            return true;
+        }
+        char *end;
+        errno = 0;
+        long l = strtol(tok.c_str(), &end, 10);
+        if (tok.empty() || *end != '\0' || errno != 0 || l < INT_MIN || l > INT_MAX) return false;
+        v = l;
+        return true;
+    }
+
+    static string trim(const string& s) {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        if (b == string::npos) return "";
+        return s.substr(b, s.find_last_not_of(" \t\r\n") + 1 - b);
+    }
+
+    void FlatZincSpace::warm_start(const std::string& file) {
+        ifstream in(file.c_str());
+        if (!in) {
+            cerr << "% Cannot read the warm start from " << file << endl;
+            return;
+        }
+
+        // The vars printed under each output name, then the other named vars
+        map<string, vector<AST::Node*> > printed;
+        if (output != NULL) {
+            vector<AST::Node*>* cur = NULL;
+            for (unsigned int i=0; i< output->a.size(); i++) {
+                AST::Node* ai = output->a[i];
+                if (ai->isString()) {
+                    string str = ai->getString();
+                    if (str.size() > 3 && str.compare(str.size()-3, 3, " = ") == 0) {
+                        cur = &printed[str.substr(0, str.size()-3)];
+                    }
+                } else if (cur == NULL) {
+                    continue;
+                } else if (ai->isArray()) {
+                    AST::Array* aia = ai->getArray();
+                    cur->insert(cur->end(), aia->a.begin(), aia->a.end());
+                } else {
+                    cur->push_back(ai);
+                }
+            }
+        }
+        map<string, IntVar*> int_names;
+        for (int i = 0; i < iv.size(); i++) {
+            map<IntVar*, string>::iterator it = intVarString().find(iv[i]);
+            if (it != intVarString().end() && !it->second.empty()) int_names[it->second] = iv[i];
+        }
+        map<string, int> bool_names;
+        for (int i = 0; i < bv.size(); i++) {
+            map<BoolView, string>::iterator it = boolVarString().find(bv[i]);
+            if (it != boolVarString().end() && !it->second.empty()) bool_names[it->second] = i;
+        }
+
+        // Statements name = value; or name = array<n>d(<index sets>, [values]);
+        string text, line;
+        while (getline(in, line)) {
+            line = line.substr(0, line.find('%'));
+            if (line.compare(0, 3, "---") == 0 || line.compare(0, 3, "===") == 0) continue;
+            text += line;
+            text += '\n';
+        }
+
+        int hinted = 0, skipped = 0;
+        size_t start = 0;
+        for (size_t end; (end = text.find(';', start)) != string::npos; start = end + 1) {
+            string stmt = text.substr(start, end - start);
+            size_t eq = stmt.find('=');
+            if (eq == string::npos) continue;
+            string name = trim(stmt.substr(0, eq));
+            string val = stmt.substr(eq + 1);
+
+            vector<string> toks;
+            size_t open = val.find('[');
+            if (open != string::npos) {
+                size_t close = val.rfind(']');
+                if (close == string::npos || close < open) { skipped++; continue; }
+                string elems = val.substr(open + 1, close - open - 1);
+                for (size_t b = 0, e; b <= elems.size(); b = e + 1) {
+                    e = elems.find(',', b);
+                    if (e == string::npos) e = elems.size();
+                    string tok = trim(elems.substr(b, e - b));
+                    if (!tok.empty()) toks.push_back(tok);
+                }
+            } else {
+                toks.push_back(trim(val));
+            }
+
+            // An output, otherwise a named var. The values of an output that
+            // has changed shape are not matched up.
+            map<string, vector<AST::Node*> >::iterator pit = printed.find(name);
+            bool is_output = (pit != printed.end());
+            if (is_output ? pit->second.size() != toks.size() : toks.size() != 1) {
+                skipped += toks.size();
+                continue;
+            }
+
+            for (unsigned int k = 0; k < toks.size(); k++) {
+                bool is_bool;
+                int v;
+                if (!parseHintVal(toks[k], is_bool, v)) { skipped++; continue; }
+                IntVar* x = NULL;
+                int b = -1;
+                if (is_output) {
+                    AST::Node* ai = pit->second[k];
+                    if (ai->isIntVar()) x = iv[ai->getIntVar()];
+                    else if (ai->isBoolVar()) b = ai->getBoolVar();
+                } else if (int_names.count(name)) {
+                    x = int_names[name];
+                } else if (bool_names.count(name)) {
+                    b = bool_names[name];
+                }
+                if (x != NULL && !is_bool) {
+                    x->setHintVal(v);
+                } else if (b >= 0 && is_bool) {
+                    bv[b].setHintVal(v);
+                } else {
+                    skipped++;
+                    continue;
+                }
+                hinted++;
+            }
+        }
+
+        if (so().verbosity >= 1) {
+            cerr << "% Warm start: " << hinted << " values from " << file << ", " << skipped << " skipped" << endl;
+        }
+    }
+
     void FlatZincSpace::printElem(AST::Node* ai, ostream& out) const {
         int k;
         if (ai->isInt(k)) {
@@ -24,6 +24,8 @@
 #define flatzinc_h
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -34,10 +36,9 @@
 #include <chuffed/support/vec.h>
 #include <chuffed/core/engine.h>
 #include <chuffed/core/propagator.h>
+#include <chuffed/core/solver.h>
 #include <chuffed/flatzinc/ast.h>
 
-extern std::map<IntVar*, std::string> intVarString;
-extern std::map<BoolView, std::string> boolVarString;
 
 // Controls whether expressions like bool_sum_eq([x[i] = j | i in 1..n], 1)
 // access the underlying literals x[i] = j or new ones via int_eq_reif(...)
@@ -238,21 +239,74 @@ namespace FlatZinc {
     /// Return global registry object
     Registry& registry(void);
 
-    /// Symbol table mapping identifiers (strings) to values
+    /// Hash and equality on the contents of C strings
+    struct CStrHash {
+        size_t operator()(const char* s) const {
+            size_t h = 2166136261u;
+            for (; *s; s++) h = (h ^ (unsigned char) *s) * 16777619u;
+            return h;
+        }
+    };
+    struct CStrEq {
+        bool operator()(const char* a, const char* b) const { return strcmp(a, b) == 0; }
+    };
+
+    /// Interned identifiers, so that equal names share one pointer
+    class StringPool {
+    private:
+        static const size_t block_size = 1 << 16;
+        std::unordered_set<const char*, CStrHash, CStrEq> strings;
+        std::vector<char*> blocks;
+        size_t used;
+    public:
+        StringPool(void) : used(block_size) {}
+        ~StringPool(void) {
+            for (unsigned int i = 0; i < blocks.size(); i++) free(blocks[i]);
+        }
+        /// Return the unique copy of \a s
+        char* intern(const char* s) {
+            std::unordered_set<const char*, CStrHash, CStrEq>::const_iterator i = strings.find(s);
+            if (i != strings.end()) return const_cast<char*>(*i);
+            size_t len = strlen(s) + 1;
+            char* r;
+            if (len > block_size / 4) {
+                // Long strings get their own block, kept behind the current one
+                r = (char*) malloc(len);
+                blocks.insert(blocks.begin(), r);
+            } else {
+                if (used + len > block_size) {
+                    blocks.push_back((char*) malloc(block_size));
+                    used = 0;
+                }
+                r = blocks.back() + used;
+                used += len;
+            }
+            memcpy(r, s, len);
+            strings.insert(r);
+            return r;
+        }
+    };
+
+    /// Symbol table mapping interned identifiers to values
     template<class Val>
     class SymbolTable {
     private:
-        std::map<std::string,Val> m;
+        std::unordered_map<const char*,Val> m;
     public:
         /// Insert \a val with \a key
-        void put(const std::string& key, const Val& val) { m[key] = val; }
+        void put(const char* key, const Val& val) { m[key] = val; }
         /// Return whether \a key exists, and set \a val if it does exist
-        bool get(const std::string& key, Val& val) const {
-            typename std::map<std::string,Val>::const_iterator i = m.find(key);
-            if (i == m.end()) return false;
-            val = i->second;
+        bool get(const char* key, Val& val) const {
+            const Val* v = find(key);
+            if (!v) return false;
+            val = *v;
             return true;
         }
+        /// Return the value stored with \a key, or NULL
+        const Val* find(const char* key) const {
+            typename std::unordered_map<const char*,Val>::const_iterator i = m.find(key);
+            return i == m.end() ? NULL : &i->second;
+        }
     };
 
     class FlatZincSpace : public Problem {
@@ -275,6 +329,8 @@ namespace FlatZinc {
 
         /// Construct problem with given number of variables
         FlatZincSpace(int intVars, int boolVars, int setVars);
+        /// Destructor
+        ~FlatZincSpace(void);
 
         /// Create priority branch group
         PriorityBranchGroup* priorityBranch(vec<Branching*> x, AST::Array* ann, VarBranch var_branch);
@@ -305,6 +361,9 @@ namespace FlatZinc {
         void setOutputElem(AST::Node* ai) const;
         void setOutput();
 
+        /// Branch towards the output values in \a file, written as the solutions are printed
+        void warm_start(const std::string& file);
+
         void printElem(AST::Node* ai, std::ostream& out = std::cout) const;
         // Needed by the profiler
         void print(std::ostream& out) {
@@ -354,9 +413,9 @@ namespace FlatZinc {
                     continue;
 
                 IntVar* var = iv[i];
-                std::string varName = intVarString[var];
+                std::string varName = intVarString()[var];
 
-                if (varName.empty() || varName.find(so.filter_domains) == std::string::npos)
+                if (varName.empty() || varName.find(so().filter_domains) == std::string::npos)
                     continue;
 
                 if (!outerFirst)
@@ -387,9 +446,9 @@ namespace FlatZinc {
                     continue;
 
                 BoolView bview = bv[i];
-                std::string bvstring = boolVarString[bview];
+                std::string bvstring = boolVarString()[bview];
 
-                if (bvstring.find(so.filter_domains) == std::string::npos) {
+                if (bvstring.find(so().filter_domains) == std::string::npos) {
                     continue;
                 }
 
@@ -398,7 +457,7 @@ namespace FlatZinc {
                     // Try the other value
                     BoolView otherval = bview;
                     otherval.setSign(!otherval.getSign());
-                    bvstring = boolVarString[otherval];
+                    bvstring = boolVarString()[otherval];
                 }
 
                 if (bvstring.compare("ASSIGNED_AT_ROOT") == 0)
@@ -408,9 +467,9 @@ namespace FlatZinc {
                     out << ",";
                 outerFirst = false;
 
-                out << boolVarString[bview] << ":";
-                /* out << litString[toInt(bview.getLit(true))] << ":"; */
-                /* out << litString[toInt(bview.getLit(false))] << ":"; */
+                out << boolVarString()[bview] << ":";
+                /* out << litString()[toInt(bview.getLit(true))] << ":"; */
+                /* out << litString()[toInt(bview.getLit(false))] << ":"; */
                 bool first = true;
                 if (!bview.isFixed())
                     out << "'undef'";
@@ -440,27 +499,42 @@ namespace FlatZinc {
         void parseSolveAnnPrioritySearch(AST::Node* elemAnn, BranchGroup* branching, int& nbNonEmptySearchAnnotations);
     };
 
-    extern FlatZincSpace *s;
+    extern THREAD_LOCAL FlatZincSpace *s;
 
     typedef std::pair<std::string,Option<std::vector<int>* > > intvartype;
-    typedef std::pair<std::string, VarSpec*> varspec;
+    typedef std::pair<const char*, VarSpec*> varspec;
 
 
     /// State of the FlatZinc parser
     class ParserState {
     public:
-        ParserState(const std::string& b, std::ostream& err0)
-        : buf(b.c_str()), pos(0), length(b.size()), fg(NULL),
-            hadError(false), err(err0) {}
+        ParserState(std::istream& is0, std::ostream& err0)
+        : buf(NULL), pos(0), length(0), is(&is0), fg(NULL),
+            text_hash(14695981039346656037ULL), signature_hash(14695981039346656037ULL),
+            sig_state(0), hadError(false), err(err0) {}
 
-        ParserState(char* buf0, int length0, std::ostream& err0)
-        : buf(buf0), pos(0), length(length0), fg(NULL),
-            hadError(false), err(err0) {}
+        ParserState(char* buf0, size_t length0, std::ostream& err0)
+        : buf(buf0), pos(0), length(length0), is(NULL), fg(NULL),
+            text_hash(14695981039346656037ULL), signature_hash(14695981039346656037ULL),
+            sig_state(0), hadError(false), err(err0) {}
 
         void* yyscanner;
         const char* buf;
-        unsigned int pos, length;
+        size_t pos, length;
+        /// Stream read chunk by chunk when there is no mapped buffer
+        std::istream* is;
         FlatZinc::FlatZincSpace* fg;
+        /// FNV-1a hash of the model text read so far
+        uint64_t text_hash;
+        /// The same, without comments, white space and the digits of numbers
+        uint64_t signature_hash;
+        /// Where the signature is: 0 between tokens, 1 in a name, 2 in a number,
+        /// 3 in a comment, 4 after a '-' that may be the sign of a number
+        int sig_state;
+        /// Identifiers of the model
+        StringPool names;
+        /// Nodes of the constraint item being parsed
+        AST::Arena arena;
         std::vector<std::pair<std::string,AST::Node*> > _output;
 
         SymbolTable<int> intvarTable;
@@ -494,13 +568,57 @@ namespace FlatZinc {
         std::ostream& err;
 
         int fillBuffer(char* lexBuf, unsigned int lexBufSize) {
-            if (pos >= length) return 0;
-            int num = std::min(length - pos, lexBufSize);
-            memcpy(lexBuf,buf+pos,num);
-            pos += num;
-            return num;      
+            int num;
+            if (is) {
+                is->read(lexBuf, lexBufSize);
+                num = is->gcount();
+            } else {
+                if (pos >= length) return 0;
+                num = std::min(length - pos, (size_t) lexBufSize);
+                memcpy(lexBuf,buf+pos,num);
+                pos += num;
+            }
+            for (int i = 0; i < num; i++) {
+                text_hash = (text_hash ^ (unsigned char) lexBuf[i]) * 1099511628211ULL;
+                hashSignature(lexBuf[i]);
+            }
+            return num;
         }
 
+        /// Hash c into the signature, where each number is a single '#'
+        void hashSignature(char c) {
+            if (sig_state == 3) {
+                if (c == '\n') sig_state = 0;
+                return;
+            }
+            if (sig_state == 4) {
+                if (c < '0' || c > '9') signature_hash = (signature_hash ^ '-') * 1099511628211ULL;
+                sig_state = 0;
+            }
+            if (c == '-' && sig_state != 1) {
+                sig_state = 4;
+                return;
+            }
+            if (c == '%') {
+                sig_state = 3;
+                return;
+            }
+            if (c >= '0' && c <= '9' && sig_state != 1) {
+                if (sig_state != 2) signature_hash = (signature_hash ^ '#') * 1099511628211ULL;
+                sig_state = 2;
+                return;
+            }
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                sig_state = 0;
+                return;
+            }
+            signature_hash = (signature_hash ^ (unsigned char) c) * 1099511628211ULL;
+            bool name = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+            sig_state = name ? 1 : 0;
+        }
+
+        char* intern(const char* s) { return names.intern(s); }
+
         void output(std::string x, AST::Node* n) {
             _output.push_back(std::pair<std::string,AST::Node*>(x,n));
         }
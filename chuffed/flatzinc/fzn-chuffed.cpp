@@ -3,6 +3,7 @@
 #include <chuffed/core/options.h>
 #include <chuffed/core/engine.h>
 #include <chuffed/flatzinc/flatzinc.h>
+#include <chuffed/parallel/portfolio.h>
 
 // #include "version.h"
 
@@ -29,20 +30,38 @@ int main(int argc, char** argv) {
     std::exit(EXIT_FAILURE);
   }
 
+  if (so().num_threads > 1) {
+    // Every thread parses the model into its own solver instance
+    std::string input;
+    if (filename.empty()) {
+      input = std::string(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+    portfolio.solve([&]() -> Problem* {
+      if (filename.empty()) {
+        std::istringstream is(input);
+        FlatZinc::solve(is, std::cerr);
+      } else {
+        FlatZinc::solve(filename);
+      }
+      return FlatZinc::s;
+    }, commandLine);
+    return 0;
+  }
+
 	if (filename.empty()) {
 		FlatZinc::solve(std::cin, std::cerr);
 	} else {
 		FlatZinc::solve(filename);
 	}
 
-  if (engine.opt_var && so.nof_solutions!=0) {
+  if (engine().opt_var && so().nof_solutions!=0 && !so().intermediate) {
     std::string os;
     std::stringstream oss(os);
-    engine.setOutputStream(oss);
-    engine.solve(FlatZinc::s, commandLine);
+    engine().setOutputStream(oss);
+    engine().solve(FlatZinc::s, commandLine);
     std::cout << oss.str();
   } else {
-    engine.solve(FlatZinc::s, commandLine);
+    engine().solve(FlatZinc::s, commandLine);
   }
 
 	return 0;
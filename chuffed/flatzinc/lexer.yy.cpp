@@ -1169,13 +1169,15 @@ YY_RULE_SETUP
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
-{ yylval->sValue = strdup(yytext); return ID; }
+{ yylval->sValue = static_cast<FlatZinc::ParserState*>(yyextra)->intern(yytext);
+                    return ID; }
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
 {
-                    yylval->sValue = strdup(yytext+1);
-                    yylval->sValue[strlen(yytext)-2] = 0; 
+                    yytext[yyleng-1] = 0;
+                    yylval->sValue = static_cast<FlatZinc::ParserState*>(yyextra)->intern(yytext+1);
+                    yytext[yyleng-1] = '"';
                     return STRING_LIT; }
 	YY_BREAK
 case 54:
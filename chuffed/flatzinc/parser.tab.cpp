@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,7 @@
 
 
 
-/* Copy the first part of user declarations.  */
-
+/* First part of user prologue.  */
 
 #define YYPARSE_PARAM parm
 #define YYLEX_PARAM static_cast<ParserState*>(parm)->yyscanner
@@ -120,23 +124,23 @@ void yyassert(ParserState* pp, bool cond, const char* str)
  *
  */
 
-AST::Node* getArrayElement(ParserState* pp, string id, unsigned int offset) {
+AST::Node* getArrayElement(ParserState* pp, const char* id, unsigned int offset) {
     if (offset > 0) {
-        vector<int> tmp;
-        if (pp->intvararrays.get(id, tmp) && offset<= tmp.size())
-            return new AST::IntVar(tmp[offset-1]);
-        if (pp->boolvararrays.get(id, tmp) && offset<= tmp.size())
-            return new AST::BoolVar(tmp[offset-1]);
-        if (pp->setvararrays.get(id, tmp) && offset<= tmp.size())
-            return new AST::SetVar(tmp[offset-1]);
-
-        if (pp->intvalarrays.get(id, tmp) && offset<= tmp.size())
-            return new AST::IntLit(tmp[offset-1]);
-        if (pp->boolvalarrays.get(id, tmp) && offset<= tmp.size())
-            return new AST::BoolLit(tmp[offset-1]);
-        vector<AST::SetLit> tmpS;
-        if (pp->setvalarrays.get(id, tmpS) && offset<= tmpS.size())
-            return new AST::SetLit(tmpS[offset-1]);      
+        const vector<int>* tmp;
+        if ((tmp = pp->intvararrays.find(id)) && offset<= tmp->size())
+            return new AST::IntVar((*tmp)[offset-1]);
+        if ((tmp = pp->boolvararrays.find(id)) && offset<= tmp->size())
+            return new AST::BoolVar((*tmp)[offset-1]);
+        if ((tmp = pp->setvararrays.find(id)) && offset<= tmp->size())
+            return new AST::SetVar((*tmp)[offset-1]);
+
+        if ((tmp = pp->intvalarrays.find(id)) && offset<= tmp->size())
+            return new AST::IntLit((*tmp)[offset-1]);
+        if ((tmp = pp->boolvalarrays.find(id)) && offset<= tmp->size())
+            return new AST::BoolLit((*tmp)[offset-1]);
+        const vector<AST::SetLit>* tmpS;
+        if ((tmpS = pp->setvalarrays.find(id)) && offset<= tmpS->size())
+            return new AST::SetLit((*tmpS)[offset-1]);      
     }
 
     pp->err << "Error: array access to " << id << " invalid"
@@ -145,7 +149,7 @@ AST::Node* getArrayElement(ParserState* pp, string id, unsigned int offset) {
     pp->hadError = true;
     return new AST::IntVar(0); // keep things consistent
 }
-AST::Node* getVarRefArg(ParserState* pp, string id, bool annotation = false) {
+AST::Node* getVarRefArg(ParserState* pp, const char* id, bool annotation = false) {
     int tmp;
     if (pp->intvarTable.get(id, tmp))
         return new AST::IntVar(tmp);
@@ -173,6 +177,22 @@ void addDomainConstraint(
     pp->domainConstraints.push_back(new ConExpr(id, args));
 }
 
+/*
+ * Constraint items are posted as soon as they are parsed, so the nodes of
+ * each item come from the parser's arena and are released in one go.
+ */
+
+void beginItem(ParserState* pp) {
+#if !EXPOSE_INT_LITS
+    AST::node_arena = &pp->arena;
+#endif
+}
+
+void endItem(ParserState* pp) {
+    AST::node_arena = NULL;
+    pp->arena.reset();
+}
+
 /*
  * Initialize the root gecode space
  *
@@ -235,7 +255,7 @@ void initfg(ParserState* pp) {
             try {
                 pp->fg->newIntVar(static_cast<IntVarSpec*>(pp->intvars[i].second));
                 IntVar* newiv = pp->fg->iv[pp->fg->intVarCount-1];
-                intVarString.insert(std::pair<IntVar*, std::string>(newiv, pp->intvars[i].first));
+                intVarString().insert(std::pair<IntVar*, std::string>(newiv, pp->intvars[i].first));
             } catch (FlatZinc::Error& e) {
                 yyerror(pp, e.toString().c_str());
             }
@@ -251,16 +271,16 @@ void initfg(ParserState* pp) {
                 pp->fg->newBoolVar(static_cast<BoolVarSpec*>(pp->boolvars[i].second));
                 BoolView newiv = pp->fg->bv[pp->fg->boolVarCount-1];
                 if (pp->boolvars[i].second->assigned)
-                    boolVarString.insert(std::pair<BoolView, std::string>(newiv, "ASSIGNED_AT_ROOT"));
+                    boolVarString().insert(std::pair<BoolView, std::string>(newiv, "ASSIGNED_AT_ROOT"));
                 else
-                    boolVarString.insert(std::pair<BoolView, std::string>(newiv, pp->boolvars[i].first));
+                    boolVarString().insert(std::pair<BoolView, std::string>(newiv, pp->boolvars[i].first));
                 string label;
                 label = pp->boolvars[i].first;
                 label.append("=true");
-                litString.insert(std::pair<int,std::string>(toInt(newiv.getLit(true)), label));
+                litString().insert(std::pair<int,std::string>(toInt(newiv.getLit(true)), label));
                 label = pp->boolvars[i].first;
                 label.append("=false");
-                litString.insert(std::pair<int,std::string>(toInt(newiv.getLit(false)), label));
+                litString().insert(std::pair<int,std::string>(toInt(newiv.getLit(false)), label));
             } catch (FlatZinc::Error& e) {
                 yyerror(pp, e.toString().c_str());
             }
@@ -352,6 +372,22 @@ AST::Node* arrayOutput(AST::Call* ann) {
 
 namespace FlatZinc {
 
+    void parse(ParserState& pp) {
+        time_point start = chuffed_clock::now();
+        yylex_init(&pp.yyscanner);
+        yyset_extra(&pp, pp.yyscanner);
+        // yydebug = 1;
+        yyparse(&pp);
+        AST::node_arena = NULL;
+        FlatZinc::s->output = pp.getOutput();
+        FlatZinc::s->setOutput();
+        
+        if (pp.yyscanner)
+            yylex_destroy(pp.yyscanner);
+        engine().parse_time = std::chrono::duration_cast<duration>(chuffed_clock::now() - start);
+        if (pp.hadError) abort();
+    }
+
     void solve(const std::string& filename, std::ostream& err) {
 #ifdef HAVE_MMAP
         int fd;
@@ -362,17 +398,26 @@ namespace FlatZinc {
             err << "Cannot open file " << filename << endl;
             exit(0);
         }
-        if (stat(filename.c_str(), &sbuf) == -1) {
+        if (fstat(fd, &sbuf) == -1) {
             err << "Cannot stat file " << filename << endl;
             return;          
         }
-        data = (char*)mmap((caddr_t)0, sbuf.st_size, PROT_READ, MAP_SHARED, fd,0);
-        if (data == (caddr_t)(-1)) {
+        data = (char*)mmap(NULL, sbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == (char*) MAP_FAILED) {
             err << "Cannot mmap file " << filename << endl;
             return;          
         }
+        // The lexer reads the file front to back exactly once
+        madvise(data, sbuf.st_size, MADV_SEQUENTIAL);
 
-        ParserState pp(data, sbuf.st_size, err);
+        {
+            ParserState pp(data, sbuf.st_size, err);
+            parse(pp);
+            modelHash() = pp.text_hash;
+            modelSignature() = pp.signature_hash;
+        }
+        munmap(data, sbuf.st_size);
+        close(fd);
 #else
         std::ifstream file;
         file.open(filename.c_str());
@@ -380,191 +425,265 @@ namespace FlatZinc {
             err << "Cannot open file " << filename << endl;
             exit(0);
         }
-        std::string s = string(istreambuf_iterator<char>(file),
-                                                     istreambuf_iterator<char>());
-        ParserState pp(s, err);
+        ParserState pp(file, err);
+        parse(pp);
+        modelHash() = pp.text_hash;
+        modelSignature() = pp.signature_hash;
 #endif
-        yylex_init(&pp.yyscanner);
-        yyset_extra(&pp, pp.yyscanner);
-        // yydebug = 1;
-        yyparse(&pp);
-        FlatZinc::s->output = pp.getOutput();
-        FlatZinc::s->setOutput();
-        
-        if (pp.yyscanner)
-            yylex_destroy(pp.yyscanner);
-        if (pp.hadError) abort();
     }
 
     void solve(std::istream& is, std::ostream& err) {
-        std::string s = string(istreambuf_iterator<char>(is),
-                               istreambuf_iterator<char>());
-
-        ParserState pp(s, err);
-        yylex_init(&pp.yyscanner);
-        yyset_extra(&pp, pp.yyscanner);
-        // yydebug = 1;
-        yyparse(&pp);
-        FlatZinc::s->output = pp.getOutput();
-        FlatZinc::s->setOutput();
-        
-        if (pp.yyscanner)
-            yylex_destroy(pp.yyscanner);
-        if (pp.hadError) abort();
+        ParserState pp(is, err);
+        parse(pp);
+        modelHash() = pp.text_hash;
+        modelSignature() = pp.signature_hash;
     }
 
 }
 
 
 
-
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "parser.tab.h".  */
-#ifndef YY_YY_HOME_JDEKKER_REPOSITORIES_CHUFFED_BUILD_RELEASE_CHUFFED_FLATZINC_PARSER_TAB_H_INCLUDED
-# define YY_YY_HOME_JDEKKER_REPOSITORIES_CHUFFED_BUILD_RELEASE_CHUFFED_FLATZINC_PARSER_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    INT_LIT = 258,
-    BOOL_LIT = 259,
-    FLOAT_LIT = 260,
-    ID = 261,
-    STRING_LIT = 262,
-    VAR = 263,
-    PAR = 264,
-    ANNOTATION = 265,
-    ANY = 266,
-    ARRAY = 267,
-    BOOLTOK = 268,
-    CASE = 269,
-    COLONCOLON = 270,
-    CONSTRAINT = 271,
-    DEFAULT = 272,
-    DOTDOT = 273,
-    ELSE = 274,
-    ELSEIF = 275,
-    ENDIF = 276,
-    ENUM = 277,
-    FLOATTOK = 278,
-    FUNCTION = 279,
-    IF = 280,
-    INCLUDE = 281,
-    INTTOK = 282,
-    LET = 283,
-    MAXIMIZE = 284,
-    MINIMIZE = 285,
-    OF = 286,
-    SATISFY = 287,
-    OUTPUT = 288,
-    PREDICATE = 289,
-    RECORD = 290,
-    SET = 291,
-    SHOW = 292,
-    SHOWCOND = 293,
-    SOLVE = 294,
-    STRING = 295,
-    TEST = 296,
-    THEN = 297,
-    TUPLE = 298,
-    TYPE = 299,
-    VARIANT_RECORD = 300,
-    WHERE = 301
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-
- 
-    int iValue; 
-    char* sValue; 
-    bool bValue; 
-    double dValue;
-    std::vector<int>* setValue;
-    FlatZinc::AST::SetLit* setLit;
-    std::vector<double>* floatSetValue;
-    std::vector<FlatZinc::AST::SetLit>* setValueList;
-    FlatZinc::Option<FlatZinc::AST::SetLit* > oSet;
-    FlatZinc::VarSpec* varSpec;
-    FlatZinc::Option<FlatZinc::AST::Node*> oArg;
-    std::vector<FlatZinc::VarSpec*>* varSpecVec;
-    FlatZinc::Option<std::vector<FlatZinc::VarSpec*>* > oVarSpecVec;
-    FlatZinc::AST::Node* arg;
-    FlatZinc::AST::Array* argVec;
-
-
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT_LIT = 3,                    /* INT_LIT  */
+  YYSYMBOL_BOOL_LIT = 4,                   /* BOOL_LIT  */
+  YYSYMBOL_FLOAT_LIT = 5,                  /* FLOAT_LIT  */
+  YYSYMBOL_ID = 6,                         /* ID  */
+  YYSYMBOL_STRING_LIT = 7,                 /* STRING_LIT  */
+  YYSYMBOL_VAR = 8,                        /* VAR  */
+  YYSYMBOL_PAR = 9,                        /* PAR  */
+  YYSYMBOL_ANNOTATION = 10,                /* ANNOTATION  */
+  YYSYMBOL_ANY = 11,                       /* ANY  */
+  YYSYMBOL_ARRAY = 12,                     /* ARRAY  */
+  YYSYMBOL_BOOLTOK = 13,                   /* BOOLTOK  */
+  YYSYMBOL_CASE = 14,                      /* CASE  */
+  YYSYMBOL_COLONCOLON = 15,                /* COLONCOLON  */
+  YYSYMBOL_CONSTRAINT = 16,                /* CONSTRAINT  */
+  YYSYMBOL_DEFAULT = 17,                   /* DEFAULT  */
+  YYSYMBOL_DOTDOT = 18,                    /* DOTDOT  */
+  YYSYMBOL_ELSE = 19,                      /* ELSE  */
+  YYSYMBOL_ELSEIF = 20,                    /* ELSEIF  */
+  YYSYMBOL_ENDIF = 21,                     /* ENDIF  */
+  YYSYMBOL_ENUM = 22,                      /* ENUM  */
+  YYSYMBOL_FLOATTOK = 23,                  /* FLOATTOK  */
+  YYSYMBOL_FUNCTION = 24,                  /* FUNCTION  */
+  YYSYMBOL_IF = 25,                        /* IF  */
+  YYSYMBOL_INCLUDE = 26,                   /* INCLUDE  */
+  YYSYMBOL_INTTOK = 27,                    /* INTTOK  */
+  YYSYMBOL_LET = 28,                       /* LET  */
+  YYSYMBOL_MAXIMIZE = 29,                  /* MAXIMIZE  */
+  YYSYMBOL_MINIMIZE = 30,                  /* MINIMIZE  */
+  YYSYMBOL_OF = 31,                        /* OF  */
+  YYSYMBOL_SATISFY = 32,                   /* SATISFY  */
+  YYSYMBOL_OUTPUT = 33,                    /* OUTPUT  */
+  YYSYMBOL_PREDICATE = 34,                 /* PREDICATE  */
+  YYSYMBOL_RECORD = 35,                    /* RECORD  */
+  YYSYMBOL_SET = 36,                       /* SET  */
+  YYSYMBOL_SHOW = 37,                      /* SHOW  */
+  YYSYMBOL_SHOWCOND = 38,                  /* SHOWCOND  */
+  YYSYMBOL_SOLVE = 39,                     /* SOLVE  */
+  YYSYMBOL_STRING = 40,                    /* STRING  */
+  YYSYMBOL_TEST = 41,                      /* TEST  */
+  YYSYMBOL_THEN = 42,                      /* THEN  */
+  YYSYMBOL_TUPLE = 43,                     /* TUPLE  */
+  YYSYMBOL_TYPE = 44,                      /* TYPE  */
+  YYSYMBOL_VARIANT_RECORD = 45,            /* VARIANT_RECORD  */
+  YYSYMBOL_WHERE = 46,                     /* WHERE  */
+  YYSYMBOL_47_ = 47,                       /* ';'  */
+  YYSYMBOL_48_ = 48,                       /* '('  */
+  YYSYMBOL_49_ = 49,                       /* ')'  */
+  YYSYMBOL_50_ = 50,                       /* ','  */
+  YYSYMBOL_51_ = 51,                       /* ':'  */
+  YYSYMBOL_52_ = 52,                       /* '['  */
+  YYSYMBOL_53_ = 53,                       /* ']'  */
+  YYSYMBOL_54_ = 54,                       /* '='  */
+  YYSYMBOL_55_ = 55,                       /* '{'  */
+  YYSYMBOL_56_ = 56,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 57,                  /* $accept  */
+  YYSYMBOL_model = 58,                     /* model  */
+  YYSYMBOL_preddecl_items = 59,            /* preddecl_items  */
+  YYSYMBOL_preddecl_items_head = 60,       /* preddecl_items_head  */
+  YYSYMBOL_vardecl_items = 61,             /* vardecl_items  */
+  YYSYMBOL_vardecl_items_head = 62,        /* vardecl_items_head  */
+  YYSYMBOL_constraint_items = 63,          /* constraint_items  */
+  YYSYMBOL_constraint_items_head = 64,     /* constraint_items_head  */
+  YYSYMBOL_preddecl_item = 65,             /* preddecl_item  */
+  YYSYMBOL_pred_arg_list = 66,             /* pred_arg_list  */
+  YYSYMBOL_pred_arg_list_head = 67,        /* pred_arg_list_head  */
+  YYSYMBOL_pred_arg = 68,                  /* pred_arg  */
+  YYSYMBOL_pred_arg_type = 69,             /* pred_arg_type  */
+  YYSYMBOL_pred_arg_simple_type = 70,      /* pred_arg_simple_type  */
+  YYSYMBOL_pred_array_init = 71,           /* pred_array_init  */
+  YYSYMBOL_pred_array_init_arg = 72,       /* pred_array_init_arg  */
+  YYSYMBOL_vardecl_item = 73,              /* vardecl_item  */
+  YYSYMBOL_int_init = 74,                  /* int_init  */
+  YYSYMBOL_int_init_list = 75,             /* int_init_list  */
+  YYSYMBOL_int_init_list_head = 76,        /* int_init_list_head  */
+  YYSYMBOL_list_tail = 77,                 /* list_tail  */
+  YYSYMBOL_int_var_array_literal = 78,     /* int_var_array_literal  */
+  YYSYMBOL_float_init = 79,                /* float_init  */
+  YYSYMBOL_float_init_list = 80,           /* float_init_list  */
+  YYSYMBOL_float_init_list_head = 81,      /* float_init_list_head  */
+  YYSYMBOL_float_var_array_literal = 82,   /* float_var_array_literal  */
+  YYSYMBOL_bool_init = 83,                 /* bool_init  */
+  YYSYMBOL_bool_init_list = 84,            /* bool_init_list  */
+  YYSYMBOL_bool_init_list_head = 85,       /* bool_init_list_head  */
+  YYSYMBOL_bool_var_array_literal = 86,    /* bool_var_array_literal  */
+  YYSYMBOL_set_init = 87,                  /* set_init  */
+  YYSYMBOL_set_init_list = 88,             /* set_init_list  */
+  YYSYMBOL_set_init_list_head = 89,        /* set_init_list_head  */
+  YYSYMBOL_set_var_array_literal = 90,     /* set_var_array_literal  */
+  YYSYMBOL_vardecl_int_var_array_init = 91, /* vardecl_int_var_array_init  */
+  YYSYMBOL_vardecl_bool_var_array_init = 92, /* vardecl_bool_var_array_init  */
+  YYSYMBOL_vardecl_float_var_array_init = 93, /* vardecl_float_var_array_init  */
+  YYSYMBOL_vardecl_set_var_array_init = 94, /* vardecl_set_var_array_init  */
+  YYSYMBOL_constraint_start = 95,          /* constraint_start  */
+  YYSYMBOL_constraint_item = 96,           /* constraint_item  */
+  YYSYMBOL_solve_item = 97,                /* solve_item  */
+  YYSYMBOL_int_ti_expr_tail = 98,          /* int_ti_expr_tail  */
+  YYSYMBOL_bool_ti_expr_tail = 99,         /* bool_ti_expr_tail  */
+  YYSYMBOL_float_ti_expr_tail = 100,       /* float_ti_expr_tail  */
+  YYSYMBOL_set_literal = 101,              /* set_literal  */
+  YYSYMBOL_int_list = 102,                 /* int_list  */
+  YYSYMBOL_int_list_head = 103,            /* int_list_head  */
+  YYSYMBOL_bool_list = 104,                /* bool_list  */
+  YYSYMBOL_bool_list_head = 105,           /* bool_list_head  */
+  YYSYMBOL_float_list = 106,               /* float_list  */
+  YYSYMBOL_float_list_head = 107,          /* float_list_head  */
+  YYSYMBOL_set_literal_list = 108,         /* set_literal_list  */
+  YYSYMBOL_set_literal_list_head = 109,    /* set_literal_list_head  */
+  YYSYMBOL_flat_expr_list = 110,           /* flat_expr_list  */
+  YYSYMBOL_flat_expr = 111,                /* flat_expr  */
+  YYSYMBOL_non_array_expr_opt = 112,       /* non_array_expr_opt  */
+  YYSYMBOL_non_array_expr = 113,           /* non_array_expr  */
+  YYSYMBOL_non_array_expr_list = 114,      /* non_array_expr_list  */
+  YYSYMBOL_non_array_expr_list_head = 115, /* non_array_expr_list_head  */
+  YYSYMBOL_solve_expr = 116,               /* solve_expr  */
+  YYSYMBOL_minmax = 117,                   /* minmax  */
+  YYSYMBOL_annotations = 118,              /* annotations  */
+  YYSYMBOL_annotations_head = 119,         /* annotations_head  */
+  YYSYMBOL_annotation = 120,               /* annotation  */
+  YYSYMBOL_annotation_list = 121,          /* annotation_list  */
+  YYSYMBOL_annotation_expr = 122,          /* annotation_expr  */
+  YYSYMBOL_ann_non_array_expr = 123        /* ann_non_array_expr  */
 };
-
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 
-int yyparse (void *parm);
 
-#endif /* !YY_YY_HOME_JDEKKER_REPOSITORIES_CHUFFED_BUILD_RELEASE_CHUFFED_FLATZINC_PARSER_TAB_H_INCLUDED  */
+#ifdef short
+# undef short
+#endif
 
-/* Copy the second part of user declarations.  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -572,15 +691,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -594,47 +726,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -647,8 +775,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -713,8 +855,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -723,17 +864,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -746,11 +887,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -762,12 +903,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -779,28 +920,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  7
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   341
+#define YYLAST   331
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  57
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  66
+#define YYNNTS  67
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  157
+#define YYNRULES  158
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  340
+#define YYNSTATES  341
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   301
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -836,54 +980,62 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   484,   484,   486,   488,   491,   492,   496,   501,   509,
-     510,   514,   519,   527,   528,   535,   537,   539,   542,   543,
-     546,   549,   550,   551,   552,   555,   556,   557,   558,   561,
-     562,   565,   566,   573,   605,   636,   643,   675,   701,   711,
-     724,   781,   832,   840,   894,   907,   920,   928,   943,   947,
-     962,   986,   989,   995,  1000,  1006,  1008,  1011,  1017,  1021,
-    1036,  1060,  1063,  1069,  1074,  1081,  1087,  1091,  1106,  1130,
-    1133,  1139,  1144,  1151,  1154,  1158,  1173,  1197,  1200,  1206,
-    1211,  1218,  1225,  1228,  1235,  1238,  1245,  1248,  1255,  1258,
-    1264,  1282,  1303,  1326,  1334,  1351,  1355,  1359,  1365,  1369,
-    1383,  1384,  1391,  1395,  1404,  1407,  1413,  1418,  1426,  1429,
-    1435,  1440,  1448,  1451,  1457,  1462,  1470,  1473,  1479,  1485,
-    1497,  1501,  1508,  1512,  1519,  1522,  1528,  1532,  1536,  1540,
-    1544,  1593,  1607,  1610,  1616,  1620,  1631,  1652,  1682,  1704,
-    1705,  1713,  1716,  1722,  1726,  1733,  1738,  1744,  1748,  1755,
-    1759,  1765,  1769,  1773,  1777,  1781,  1824,  1835
+       0,   500,   500,   502,   504,   507,   508,   512,   517,   525,
+     526,   530,   535,   543,   547,   557,   559,   561,   564,   565,
+     568,   571,   572,   573,   574,   577,   578,   579,   580,   583,
+     584,   587,   588,   595,   626,   656,   662,   693,   718,   727,
+     739,   795,   845,   852,   905,   917,   929,   936,   950,   954,
+     968,   990,   993,   999,  1004,  1010,  1012,  1015,  1021,  1025,
+    1039,  1061,  1064,  1070,  1075,  1082,  1088,  1092,  1106,  1128,
+    1131,  1137,  1142,  1149,  1152,  1156,  1170,  1192,  1195,  1201,
+    1206,  1213,  1220,  1223,  1230,  1233,  1240,  1243,  1250,  1253,
+    1259,  1265,  1282,  1302,  1324,  1332,  1349,  1353,  1357,  1363,
+    1367,  1381,  1382,  1389,  1393,  1402,  1405,  1411,  1416,  1424,
+    1427,  1433,  1438,  1446,  1449,  1455,  1460,  1468,  1471,  1477,
+    1483,  1495,  1499,  1506,  1510,  1517,  1520,  1526,  1530,  1534,
+    1538,  1542,  1590,  1603,  1606,  1612,  1616,  1627,  1648,  1677,
+    1698,  1699,  1707,  1710,  1716,  1720,  1727,  1731,  1737,  1741,
+    1748,  1752,  1758,  1762,  1766,  1770,  1774,  1816,  1826
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INT_LIT", "BOOL_LIT", "FLOAT_LIT", "ID",
-  "STRING_LIT", "VAR", "PAR", "ANNOTATION", "ANY", "ARRAY", "BOOLTOK",
-  "CASE", "COLONCOLON", "CONSTRAINT", "DEFAULT", "DOTDOT", "ELSE",
-  "ELSEIF", "ENDIF", "ENUM", "FLOATTOK", "FUNCTION", "IF", "INCLUDE",
-  "INTTOK", "LET", "MAXIMIZE", "MINIMIZE", "OF", "SATISFY", "OUTPUT",
-  "PREDICATE", "RECORD", "SET", "SHOW", "SHOWCOND", "SOLVE", "STRING",
-  "TEST", "THEN", "TUPLE", "TYPE", "VARIANT_RECORD", "WHERE", "';'", "'('",
-  "')'", "','", "':'", "'['", "']'", "'='", "'{'", "'}'", "$accept",
-  "model", "preddecl_items", "preddecl_items_head", "vardecl_items",
-  "vardecl_items_head", "constraint_items", "constraint_items_head",
-  "preddecl_item", "pred_arg_list", "pred_arg_list_head", "pred_arg",
-  "pred_arg_type", "pred_arg_simple_type", "pred_array_init",
-  "pred_array_init_arg", "vardecl_item", "int_init", "int_init_list",
-  "int_init_list_head", "list_tail", "int_var_array_literal", "float_init",
-  "float_init_list", "float_init_list_head", "float_var_array_literal",
-  "bool_init", "bool_init_list", "bool_init_list_head",
-  "bool_var_array_literal", "set_init", "set_init_list",
-  "set_init_list_head", "set_var_array_literal",
-  "vardecl_int_var_array_init", "vardecl_bool_var_array_init",
-  "vardecl_float_var_array_init", "vardecl_set_var_array_init",
-  "constraint_item", "solve_item", "int_ti_expr_tail", "bool_ti_expr_tail",
+  "\"end of file\"", "error", "\"invalid token\"", "INT_LIT", "BOOL_LIT",
+  "FLOAT_LIT", "ID", "STRING_LIT", "VAR", "PAR", "ANNOTATION", "ANY",
+  "ARRAY", "BOOLTOK", "CASE", "COLONCOLON", "CONSTRAINT", "DEFAULT",
+  "DOTDOT", "ELSE", "ELSEIF", "ENDIF", "ENUM", "FLOATTOK", "FUNCTION",
+  "IF", "INCLUDE", "INTTOK", "LET", "MAXIMIZE", "MINIMIZE", "OF",
+  "SATISFY", "OUTPUT", "PREDICATE", "RECORD", "SET", "SHOW", "SHOWCOND",
+  "SOLVE", "STRING", "TEST", "THEN", "TUPLE", "TYPE", "VARIANT_RECORD",
+  "WHERE", "';'", "'('", "')'", "','", "':'", "'['", "']'", "'='", "'{'",
+  "'}'", "$accept", "model", "preddecl_items", "preddecl_items_head",
+  "vardecl_items", "vardecl_items_head", "constraint_items",
+  "constraint_items_head", "preddecl_item", "pred_arg_list",
+  "pred_arg_list_head", "pred_arg", "pred_arg_type",
+  "pred_arg_simple_type", "pred_array_init", "pred_array_init_arg",
+  "vardecl_item", "int_init", "int_init_list", "int_init_list_head",
+  "list_tail", "int_var_array_literal", "float_init", "float_init_list",
+  "float_init_list_head", "float_var_array_literal", "bool_init",
+  "bool_init_list", "bool_init_list_head", "bool_var_array_literal",
+  "set_init", "set_init_list", "set_init_list_head",
+  "set_var_array_literal", "vardecl_int_var_array_init",
+  "vardecl_bool_var_array_init", "vardecl_float_var_array_init",
+  "vardecl_set_var_array_init", "constraint_start", "constraint_item",
+  "solve_item", "int_ti_expr_tail", "bool_ti_expr_tail",
   "float_ti_expr_tail", "set_literal", "int_list", "int_list_head",
   "bool_list", "bool_list_head", "float_list", "float_list_head",
   "set_literal_list", "set_literal_list_head", "flat_expr_list",
@@ -892,260 +1044,253 @@ static const char *const yytname[] =
   "minmax", "annotations", "annotations_head", "annotation",
   "annotation_list", "annotation_expr", "ann_non_array_expr", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,    59,    40,    41,
-      44,    58,    91,    93,    61,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -124
+#define YYPACT_NINF (-123)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-124)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-       4,    38,    76,    45,     4,    44,    49,  -124,    75,   105,
-      60,    72,  -124,   100,   137,   131,    45,   109,   102,   110,
-    -124,    27,   151,  -124,  -124,   134,   147,   112,   113,   115,
-     164,   163,    14,  -124,   114,   121,   166,   136,   131,   130,
-     135,  -124,   178,  -124,   107,   138,  -124,  -124,   155,   139,
-     142,  -124,   144,  -124,  -124,  -124,    14,  -124,  -124,   146,
-     148,   183,   188,   191,   181,   185,   150,  -124,   199,  -124,
-     133,   185,   157,   159,  -124,  -124,   185,  -124,    25,    14,
-    -124,    27,  -124,   202,   158,   206,   156,   208,   160,   185,
-     185,   185,   211,    61,   161,   196,   212,  -124,    84,   214,
-    -124,    17,  -124,  -124,   169,   209,  -124,   -24,  -124,  -124,
-    -124,  -124,   218,  -124,  -124,  -124,  -124,   172,   172,   172,
-     167,   210,  -124,  -124,    54,  -124,    61,   137,  -124,  -124,
-    -124,  -124,    56,    61,   185,   210,  -124,  -124,   177,    56,
-    -124,    36,  -124,  -124,   179,  -124,  -124,  -124,   119,    56,
-     228,    25,   203,   185,    56,  -124,  -124,  -124,   205,   230,
-      61,    18,  -124,    74,   182,  -124,  -124,   189,    56,  -124,
-     186,   192,   185,    84,   185,  -124,   193,  -124,  -124,  -124,
-    -124,    71,   172,  -124,   106,  -124,    55,   194,   195,    61,
-    -124,  -124,    56,   197,  -124,    56,  -124,  -124,  -124,  -124,
-     241,   107,  -124,  -124,   132,   198,   200,   216,   201,  -124,
-    -124,  -124,  -124,  -124,  -124,   204,  -124,   222,   207,   215,
-     219,   248,   249,    14,   250,  -124,    14,   253,   254,   255,
-     185,   185,   220,   185,   221,   185,   185,   185,   213,   223,
-     256,   224,   257,   225,   226,   227,   217,   231,   185,   232,
-     185,   233,  -124,   234,  -124,   235,  -124,   261,   268,   236,
-     137,   237,   143,  -124,    12,  -124,     1,  -124,   229,   146,
-     239,   148,   242,   240,   243,  -124,  -124,   244,  -124,   245,
-     238,  -124,   247,  -124,   251,   252,  -124,   258,  -124,   259,
-     263,  -124,  -124,  -124,  -124,    48,  -124,    89,  -124,   271,
-    -124,   143,  -124,   272,  -124,    12,  -124,   273,  -124,     1,
-    -124,   210,  -124,   262,   264,   265,  -124,   266,   270,  -124,
-     269,  -124,   274,  -124,   275,  -124,  -124,    48,  -124,   286,
-    -124,    89,  -124,  -124,  -124,  -124,  -124,   276,  -124,  -124
+     -15,     7,    47,    37,   -15,    11,    43,  -123,    79,    91,
+      59,    66,  -123,    90,   128,   118,    37,   111,    74,   112,
+    -123,    21,   157,  -123,  -123,   135,    64,   121,   124,   125,
+     168,   167,     8,  -123,   123,   127,  -123,   139,   118,   175,
+     137,   140,  -123,   179,  -123,    93,   134,  -123,  -123,   158,
+     141,   142,  -123,   143,  -123,  -123,  -123,     8,  -123,  -123,
+     145,   147,   182,   185,   187,   178,   183,   148,  -123,   197,
+    -123,   183,   155,   161,   122,  -123,  -123,   183,  -123,    15,
+       8,  -123,    21,  -123,   198,   159,   205,   156,   206,   160,
+     183,   183,   183,   210,    83,   163,   199,   209,  -123,    30,
+    -123,  -123,    78,   215,  -123,   166,   208,  -123,     3,  -123,
+    -123,  -123,  -123,   217,  -123,  -123,  -123,  -123,   170,   170,
+     170,   174,   211,  -123,  -123,   -21,  -123,    83,   128,  -123,
+    -123,  -123,  -123,   151,    83,   183,  -123,  -123,  -123,    95,
+     211,  -123,  -123,   176,   151,  -123,   -11,  -123,  -123,   180,
+     151,   228,    15,   201,   183,   151,  -123,  -123,  -123,   203,
+     233,    83,   146,  -123,    60,   186,  -123,  -123,   184,  -123,
+     191,  -123,   151,  -123,   192,   189,   183,    78,   183,  -123,
+    -123,  -123,    38,   170,  -123,    92,  -123,    53,   194,   195,
+      83,  -123,  -123,   151,   241,   196,  -123,   151,  -123,  -123,
+    -123,  -123,    93,  -123,  -123,   109,   200,   202,   216,   204,
+    -123,  -123,  -123,  -123,   207,  -123,  -123,  -123,   219,   212,
+     214,   218,   246,   248,     8,   250,  -123,     8,   251,   252,
+     253,   183,   183,   220,   183,   221,   183,   183,   183,   213,
+     222,   255,   223,   256,   224,   225,   226,   229,   230,   183,
+     231,   183,   232,  -123,   234,  -123,   235,  -123,   262,   265,
+     236,   128,   237,   120,  -123,   136,  -123,   138,  -123,   239,
+     145,   240,   147,   242,   243,   245,  -123,  -123,   247,  -123,
+     249,   238,  -123,   254,  -123,   257,   258,  -123,   259,  -123,
+     260,   264,  -123,  -123,  -123,  -123,    17,  -123,    22,  -123,
+     270,  -123,   120,  -123,   271,  -123,   136,  -123,   272,  -123,
+     138,  -123,   211,  -123,   263,   267,   266,  -123,   268,   269,
+    -123,   273,  -123,   274,  -123,   275,  -123,  -123,    17,  -123,
+     282,  -123,    22,  -123,  -123,  -123,  -123,  -123,   276,  -123,
+    -123
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
        3,     0,     0,     7,     4,     0,     0,     1,     0,     0,
-       0,     0,    95,     0,   104,    11,     8,     0,     0,     0,
-       5,    16,     0,    98,   100,     0,   104,     0,     0,     0,
-       0,     0,     0,   106,     0,    55,     0,     0,    12,     0,
-       0,     9,     0,     6,     0,     0,    27,    28,     0,     0,
-      55,    18,     0,    24,    25,    97,     0,   110,   114,    55,
-      55,     0,     0,     0,     0,   141,     0,    96,    56,   105,
-     141,   141,     0,     0,    13,    10,   141,    23,     0,     0,
-      15,    56,    17,     0,     0,    56,     0,    56,     0,   141,
-     141,   141,     0,     0,     0,   142,     0,   107,     0,     0,
-      91,     0,     2,    14,     0,     0,    31,     0,    29,    26,
-      19,    20,     0,   111,    99,   115,   101,   124,   124,   124,
-       0,   152,   151,   153,   155,   157,     0,   104,   154,   143,
-     146,   149,     0,     0,   141,   127,   126,   128,   130,   132,
-     129,     0,   120,   122,     0,   140,   139,    93,     0,     0,
-       0,     0,     0,   141,     0,    33,    34,    35,     0,     0,
-       0,     0,   147,     0,     0,    38,   144,     0,     0,   134,
-       0,    55,   141,     0,   141,   136,   137,    94,    37,    32,
-      30,     0,   124,   125,     0,   103,     0,   155,     0,     0,
-     150,   102,     0,     0,   123,    56,   133,    90,   121,    92,
-       0,     0,    21,    36,     0,     0,     0,     0,     0,   145,
-     156,   148,    39,   131,   135,     0,    22,     0,     0,     0,
-       0,     0,     0,     0,     0,   138,     0,     0,     0,     0,
-     141,   141,     0,   141,     0,   141,   141,   141,     0,     0,
-       0,     0,     0,    82,    84,    86,     0,     0,   141,     0,
-     141,     0,    40,     0,    41,     0,    42,   108,   112,     0,
-     104,    88,    51,    83,    69,    85,    61,    87,     0,    55,
-       0,    55,     0,     0,     0,    43,    48,    49,    53,     0,
-      55,    66,    67,    71,     0,    55,    58,    59,    63,     0,
-      55,    45,   109,    46,   113,   116,    44,    77,    89,     0,
-      57,    56,    52,     0,    73,    56,    70,     0,    65,    56,
-      62,     0,   118,     0,    55,    75,    79,     0,    55,    74,
-       0,    54,     0,    72,     0,    64,    47,    56,   117,     0,
-      81,    56,    78,    50,    68,    60,   119,     0,    80,    76
+       0,     0,    96,     0,   105,    11,     8,     0,     0,     0,
+       5,    16,     0,    99,   101,     0,   105,     0,     0,     0,
+       0,     0,     0,   107,     0,    55,    90,     0,    12,     0,
+       0,     0,     9,     0,     6,     0,     0,    27,    28,     0,
+       0,    55,    18,     0,    24,    25,    98,     0,   111,   115,
+      55,    55,     0,     0,     0,     0,   142,     0,    97,    56,
+     106,   142,     0,     0,   142,    13,    10,   142,    23,     0,
+       0,    15,    56,    17,     0,     0,    56,     0,    56,     0,
+     142,   142,   142,     0,     0,     0,   143,     0,   108,     0,
+       2,    14,     0,     0,    92,     0,     0,    31,     0,    29,
+      26,    19,    20,     0,   112,   100,   116,   102,   125,   125,
+     125,     0,   153,   152,   154,   156,   158,     0,   105,   155,
+     144,   147,   150,     0,     0,   142,   141,   140,    94,     0,
+     128,   127,   129,   131,   133,   130,     0,   121,   123,     0,
+       0,     0,     0,     0,   142,     0,    33,    34,    35,     0,
+       0,     0,     0,   148,     0,     0,    38,   145,     0,   137,
+     138,    95,     0,   135,     0,    55,   142,     0,   142,    37,
+      32,    30,     0,   125,   126,     0,   104,     0,   156,     0,
+       0,   151,   103,     0,     0,     0,   124,    56,   134,    91,
+     122,    93,     0,    21,    36,     0,     0,     0,     0,     0,
+     146,   157,   149,    39,     0,   132,   136,    22,     0,     0,
+       0,     0,     0,     0,     0,     0,   139,     0,     0,     0,
+       0,   142,   142,     0,   142,     0,   142,   142,   142,     0,
+       0,     0,     0,     0,    82,    84,    86,     0,     0,   142,
+       0,   142,     0,    40,     0,    41,     0,    42,   109,   113,
+       0,   105,    88,    51,    83,    69,    85,    61,    87,     0,
+      55,     0,    55,     0,     0,     0,    43,    48,    49,    53,
+       0,    55,    66,    67,    71,     0,    55,    58,    59,    63,
+       0,    55,    45,   110,    46,   114,   117,    44,    77,    89,
+       0,    57,    56,    52,     0,    73,    56,    70,     0,    65,
+      56,    62,     0,   119,     0,    55,    75,    79,     0,    55,
+      74,     0,    54,     0,    72,     0,    64,    47,    56,   118,
+       0,    81,    56,    78,    50,    68,    60,   120,     0,    80,
+      76
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -124,  -124,  -124,  -124,  -124,  -124,  -124,  -124,   293,  -124,
-    -124,   260,  -124,   -43,  -124,   149,   285,     2,  -124,  -124,
-     -50,  -124,    -4,  -124,  -124,  -124,     3,  -124,  -124,  -124,
-     -25,  -124,  -124,  -124,  -124,  -124,  -124,  -124,   278,  -124,
-      -1,   103,   117,   -90,  -123,  -124,  -124,    52,  -124,    53,
-    -124,  -124,  -124,   145,  -107,  -112,  -124,  -124,  -124,  -124,
-     -57,  -124,   -88,   165,  -124,   162
+    -123,  -123,  -123,  -123,  -123,  -123,  -123,  -123,   285,  -123,
+    -123,   227,  -123,   -41,  -123,   149,   279,    -4,  -123,  -123,
+     -51,  -123,   -10,  -123,  -123,  -123,    -3,  -123,  -123,  -123,
+     -28,  -123,  -123,  -123,  -123,  -123,  -123,  -123,  -123,   277,
+    -123,    -2,   100,   102,   -91,  -122,  -123,  -123,    54,  -123,
+      61,  -123,  -123,  -123,   153,  -103,  -118,  -123,  -123,  -123,
+    -123,   -69,  -123,   -82,   162,  -123,   169
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,     2,     3,     4,    15,    16,    37,    38,     5,    49,
-      50,    51,    52,    53,   107,   108,    17,   278,   279,   280,
-      69,   263,   288,   289,   290,   267,   283,   284,   285,   265,
-     316,   317,   318,   298,   252,   254,   256,   275,    39,    72,
-      54,    28,    29,   140,    34,    35,   268,    59,   270,    60,
-     313,   314,   141,   142,   155,   143,   170,   171,   177,   148,
-      94,    95,   162,   163,   130,   131
+       0,     2,     3,     4,    15,    16,    37,    38,     5,    50,
+      51,    52,    53,    54,   108,   109,    17,   279,   280,   281,
+      70,   264,   289,   290,   291,   268,   284,   285,   286,   266,
+     317,   318,   319,   299,   253,   255,   257,   276,    39,    40,
+      72,    55,    28,    29,   145,    34,    35,   269,    60,   271,
+      61,   314,   315,   146,   147,   156,   148,   174,   175,   171,
+     139,    95,    96,   163,   164,   131,   132
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint16 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-      82,    77,    18,   128,   164,   129,   286,   287,    27,    86,
-      88,   156,   157,   100,   101,    18,   281,     8,   282,   104,
-     165,   121,   122,   123,   187,   125,   151,   169,   105,   152,
-       8,    66,   117,   118,   119,    44,   128,   178,     1,    45,
-      46,    12,   183,   128,     6,   166,   145,   146,     8,   147,
-      47,   311,   106,     9,    12,    84,   193,    10,    11,   135,
-     136,   137,   138,    48,   121,   122,   123,   124,   125,    14,
-     128,   128,    12,   127,     8,   203,     7,   167,   109,   201,
-     212,    13,    14,   214,    46,   172,   173,   135,   136,   137,
-     138,    20,   311,    22,    47,   315,   182,    21,    12,   128,
-      14,   211,   160,   127,   209,   189,   161,    48,     8,     8,
-       8,   127,    30,   126,   204,   197,   127,   199,    23,   205,
-      46,   196,   175,    31,   189,   176,    14,   190,    24,   206,
-      47,    32,    12,    12,    12,     8,   139,   273,   202,   127,
-      33,    25,   207,    48,   127,    23,   276,    36,    93,   277,
-      33,    57,    58,    42,    55,    24,    41,    43,   216,    12,
-      26,    14,    14,    61,    62,    56,    63,    64,   217,    65,
-      67,    68,    70,   238,   239,    71,   241,    74,   243,   244,
-     245,    98,    75,   208,    76,    99,    79,    26,    80,    89,
-      78,   259,    81,   261,    90,    83,    85,    91,    87,    92,
-      93,    96,    97,   218,   102,   312,   103,   319,   111,   112,
-     113,   133,   114,   115,   120,   132,   116,   144,   134,   292,
-     158,   294,   232,   149,   153,   234,   154,   150,   159,   168,
-     302,   179,   174,   185,   181,   306,   184,   336,   191,   194,
-     310,   319,   195,   192,   215,   200,   161,   223,   210,   221,
-     213,   222,   224,   226,   230,   231,   233,   225,   227,   235,
-     236,   237,   248,   250,   328,    57,   228,   246,   332,   257,
-     229,   240,   242,    58,   320,   322,   324,   247,   249,   251,
-     253,   255,   291,   258,   260,   262,   264,   266,   301,   337,
-     272,   274,   293,   296,   295,   297,   299,    19,   300,   303,
-     180,    40,   305,   321,   304,   325,   338,   219,   323,   269,
-     307,   271,   308,   309,   327,   326,    73,   329,   198,   330,
-     331,   220,   333,   188,     0,   186,     0,   334,   335,   339,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   110
+      83,    18,    99,   129,    78,   104,   165,    27,   105,    87,
+      89,     8,   130,     6,    18,   166,   157,   158,   106,     1,
+     312,   118,   119,   120,     8,   312,   173,   161,   316,    45,
+      67,   162,   179,    46,    47,    12,   129,   184,   176,   177,
+       8,     8,   107,   129,    48,     9,   202,     7,    12,    10,
+      11,    47,   167,   152,   195,    85,   153,    49,    20,   136,
+     137,    48,   138,    14,    12,    12,   168,    33,    58,    59,
+     129,   129,   128,    13,    49,   213,    14,   128,   110,   216,
+     204,   140,   141,   142,   143,   183,   122,   123,   124,   125,
+     126,    21,    14,    14,     8,     8,     8,    22,   169,   129,
+     205,   170,   210,   190,    23,   206,    47,   199,   212,   201,
+     190,    30,     8,   191,    24,   207,    48,    31,    12,    12,
+      12,    32,    23,   277,   198,    43,   278,    25,   208,    49,
+     144,    33,    24,   128,    36,   127,    12,    94,   128,   274,
+     282,   203,   283,   287,   288,   218,    26,    14,    14,   122,
+     123,   124,   188,   126,   140,   141,   142,   143,    42,    44,
+      56,   217,   239,   240,    26,   242,    57,   244,   245,   246,
+     102,    65,    62,    66,   103,    63,    64,    69,    71,    68,
+     260,    74,   262,   209,    75,    77,    79,    76,    90,    80,
+      81,    91,    82,    92,    84,    86,    93,    88,    94,    97,
+      98,   128,   100,   219,   112,   313,   128,   320,   101,   114,
+     113,   116,   115,   121,   134,   135,   117,   133,   149,   293,
+     150,   295,   233,   154,   155,   235,   151,   159,   172,   160,
+     303,   180,   182,   178,   185,   307,   186,   337,   193,   197,
+     311,   320,   192,   194,   214,   196,   162,   224,   211,   215,
+     227,   222,   231,   223,   232,   225,   234,   236,   237,   238,
+     226,   249,   251,   228,   329,   229,    58,   247,   333,   230,
+      59,   241,   243,   321,   323,   325,   248,   250,   252,   254,
+     256,   258,   259,   261,   263,   338,   265,   267,   302,    19,
+     273,   275,   292,   294,   296,    41,   297,   298,   322,   300,
+     326,   181,   301,   324,   339,   220,   304,   221,   306,   111,
+     305,   308,   270,   309,   310,    73,   327,   328,   330,   332,
+     272,   331,     0,   187,     0,     0,   334,   335,   336,   340,
+     200,   189
 };
 
 static const yytype_int16 yycheck[] =
 {
-      50,    44,     3,    93,   127,    93,     5,     6,     9,    59,
-      60,   118,   119,    70,    71,    16,     4,     3,     6,    76,
-     132,     3,     4,     5,     6,     7,    50,   139,     3,    53,
-       3,    32,    89,    90,    91,     8,   126,   149,    34,    12,
-      13,    27,   154,   133,     6,   133,    29,    30,     3,    32,
-      23,     3,    27,     8,    27,    56,   168,    12,    13,     3,
-       4,     5,     6,    36,     3,     4,     5,     6,     7,    55,
-     160,   161,    27,    55,     3,   182,     0,   134,    79,     8,
-     192,    36,    55,   195,    13,    49,    50,     3,     4,     5,
-       6,    47,     3,    18,    23,     6,   153,    48,    27,   189,
-      55,   189,    48,    55,    49,    50,    52,    36,     3,     3,
-       3,    55,    52,    52,     8,   172,    55,   174,    13,    13,
-      13,   171,     3,    51,    50,     6,    55,    53,    23,    23,
-      23,    31,    27,    27,    27,     3,    52,   260,   181,    55,
-       3,    36,    36,    36,    55,    13,     3,    16,    15,     6,
-       3,     4,     5,    51,     3,    23,    47,    47,   201,    27,
-      55,    55,    55,    51,    51,    31,    51,     3,    36,     6,
-      56,    50,     6,   230,   231,    39,   233,    47,   235,   236,
-     237,    48,    47,   184,     6,    52,    31,    55,    49,     6,
-      52,   248,    50,   250,     6,    51,    50,     6,    50,    18,
-      15,    51,     3,   204,    47,   295,    47,   297,     6,    51,
-       4,    15,    56,     5,     3,    54,    56,     3,     6,   269,
-      53,   271,   223,    54,     6,   226,    54,    18,    18,    52,
-     280,     3,    53,     3,    31,   285,    31,   327,    56,    53,
-     290,   331,    50,    54,     3,    52,    52,    31,    53,    51,
-      53,    51,    51,    31,     6,     6,     6,    53,    51,     6,
-       6,     6,     6,     6,   314,     4,    51,    54,   318,    52,
-      51,    51,    51,     5,     3,     3,     3,    54,    54,    54,
-      54,    54,    53,    52,    52,    52,    52,    52,    50,     3,
-      54,    54,    53,    53,    52,    52,    52,     4,    53,    52,
-     151,    16,    50,   301,    53,   309,   331,   204,   305,   257,
-      52,   258,    53,    50,    50,    53,    38,    52,   173,    53,
-      50,   204,    53,   161,    -1,   160,    -1,    53,    53,    53,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    81
+      51,     3,    71,    94,    45,    74,   128,     9,    77,    60,
+      61,     3,    94,     6,    16,   133,   119,   120,     3,    34,
+       3,    90,    91,    92,     3,     3,   144,    48,     6,     8,
+      32,    52,   150,    12,    13,    27,   127,   155,    49,    50,
+       3,     3,    27,   134,    23,     8,     8,     0,    27,    12,
+      13,    13,   134,    50,   172,    57,    53,    36,    47,    29,
+      30,    23,    32,    55,    27,    27,   135,     3,     4,     5,
+     161,   162,    55,    36,    36,   193,    55,    55,    80,   197,
+     183,     3,     4,     5,     6,   154,     3,     4,     5,     6,
+       7,    48,    55,    55,     3,     3,     3,    18,     3,   190,
+       8,     6,    49,    50,    13,    13,    13,   176,   190,   178,
+      50,    52,     3,    53,    23,    23,    23,    51,    27,    27,
+      27,    31,    13,     3,   175,    51,     6,    36,    36,    36,
+      52,     3,    23,    55,    16,    52,    27,    15,    55,   261,
+       4,   182,     6,     5,     6,    36,    55,    55,    55,     3,
+       4,     5,     6,     7,     3,     4,     5,     6,    47,    47,
+       3,   202,   231,   232,    55,   234,    31,   236,   237,   238,
+      48,     3,    51,     6,    52,    51,    51,    50,    39,    56,
+     249,     6,   251,   185,    47,     6,    52,    47,     6,    31,
+      49,     6,    50,     6,    51,    50,    18,    50,    15,    51,
+       3,    55,    47,   205,     6,   296,    55,   298,    47,     4,
+      51,     5,    56,     3,    15,     6,    56,    54,     3,   270,
+      54,   272,   224,     6,    54,   227,    18,    53,    52,    18,
+     281,     3,    31,    53,    31,   286,     3,   328,    54,    50,
+     291,   332,    56,    52,     3,    53,    52,    31,    53,    53,
+      31,    51,     6,    51,     6,    51,     6,     6,     6,     6,
+      53,     6,     6,    51,   315,    51,     4,    54,   319,    51,
+       5,    51,    51,     3,     3,     3,    54,    54,    54,    54,
+      54,    52,    52,    52,    52,     3,    52,    52,    50,     4,
+      54,    54,    53,    53,    52,    16,    53,    52,   302,    52,
+     310,   152,    53,   306,   332,   205,    52,   205,    50,    82,
+      53,    52,   258,    53,    50,    38,    53,    50,    52,    50,
+     259,    53,    -1,   161,    -1,    -1,    53,    53,    53,    53,
+     177,   162
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    34,    58,    59,    60,    65,     6,     0,     3,     8,
-      12,    13,    27,    36,    55,    61,    62,    73,    97,    65,
-      47,    48,    18,    13,    23,    36,    55,    97,    98,    99,
-      52,    51,    31,     3,   101,   102,    16,    63,    64,    95,
-      73,    47,    51,    47,     8,    12,    13,    23,    36,    66,
-      67,    68,    69,    70,    97,     3,    31,     4,     5,   104,
-     106,    51,    51,    51,     3,     6,    97,    56,    50,    77,
-       6,    39,    96,    95,    47,    47,     6,    70,    52,    31,
-      49,    50,    77,    51,    97,    50,    77,    50,    77,     6,
-       6,     6,    18,    15,   117,   118,    51,     3,    48,    52,
-     117,   117,    47,    47,   117,     3,    27,    71,    72,    97,
-      68,     6,    51,     4,    56,     5,    56,   117,   117,   117,
-       3,     3,     4,     5,     6,     7,    52,    55,   100,   119,
-     121,   122,    54,    15,     6,     3,     4,     5,     6,    52,
-     100,   109,   110,   112,     3,    29,    30,    32,   116,    54,
-      18,    50,    53,     6,    54,   111,   111,   111,    53,    18,
-      48,    52,   119,   120,   101,   112,   119,   117,    52,   112,
-     113,   114,    49,    50,    53,     3,     6,   115,   112,     3,
-      72,    31,   117,   112,    31,     3,   120,     6,   122,    50,
-      53,    56,    54,   112,    53,    50,    77,   117,   110,   117,
-      52,     8,    70,   111,     8,    13,    23,    36,    97,    49,
-      53,   119,   112,    53,   112,     3,    70,    36,    97,    98,
-      99,    51,    51,    31,    51,    53,    31,    51,    51,    51,
-       6,     6,    97,     6,    97,     6,     6,     6,   117,   117,
-      51,   117,    51,   117,   117,   117,    54,    54,     6,    54,
-       6,    54,    91,    54,    92,    54,    93,    52,    52,   117,
-      52,   117,    52,    78,    52,    86,    52,    82,   103,   104,
-     105,   106,    54,   101,    54,    94,     3,     6,    74,    75,
-      76,     4,     6,    83,    84,    85,     5,     6,    79,    80,
-      81,    53,    77,    53,    77,    52,    53,    52,    90,    52,
-      53,    50,    77,    52,    53,    50,    77,    52,    53,    50,
-      77,     3,   100,   107,   108,     6,    87,    88,    89,   100,
-       3,    74,     3,    83,     3,    79,    53,    50,    77,    52,
-      53,    50,    77,    53,    53,    53,   100,     3,    87,    53
+      12,    13,    27,    36,    55,    61,    62,    73,    98,    65,
+      47,    48,    18,    13,    23,    36,    55,    98,    99,   100,
+      52,    51,    31,     3,   102,   103,    16,    63,    64,    95,
+      96,    73,    47,    51,    47,     8,    12,    13,    23,    36,
+      66,    67,    68,    69,    70,    98,     3,    31,     4,     5,
+     105,   107,    51,    51,    51,     3,     6,    98,    56,    50,
+      77,    39,    97,    96,     6,    47,    47,     6,    70,    52,
+      31,    49,    50,    77,    51,    98,    50,    77,    50,    77,
+       6,     6,     6,    18,    15,   118,   119,    51,     3,   118,
+      47,    47,    48,    52,   118,   118,     3,    27,    71,    72,
+      98,    68,     6,    51,     4,    56,     5,    56,   118,   118,
+     118,     3,     3,     4,     5,     6,     7,    52,    55,   101,
+     120,   122,   123,    54,    15,     6,    29,    30,    32,   117,
+       3,     4,     5,     6,    52,   101,   110,   111,   113,     3,
+      54,    18,    50,    53,     6,    54,   112,   112,   112,    53,
+      18,    48,    52,   120,   121,   102,   113,   120,   118,     3,
+       6,   116,    52,   113,   114,   115,    49,    50,    53,   113,
+       3,    72,    31,   118,   113,    31,     3,   121,     6,   123,
+      50,    53,    56,    54,    52,   113,    53,    50,    77,   118,
+     111,   118,     8,    70,   112,     8,    13,    23,    36,    98,
+      49,    53,   120,   113,     3,    53,   113,    70,    36,    98,
+      99,   100,    51,    51,    31,    51,    53,    31,    51,    51,
+      51,     6,     6,    98,     6,    98,     6,     6,     6,   118,
+     118,    51,   118,    51,   118,   118,   118,    54,    54,     6,
+      54,     6,    54,    91,    54,    92,    54,    93,    52,    52,
+     118,    52,   118,    52,    78,    52,    86,    52,    82,   104,
+     105,   106,   107,    54,   102,    54,    94,     3,     6,    74,
+      75,    76,     4,     6,    83,    84,    85,     5,     6,    79,
+      80,    81,    53,    77,    53,    77,    52,    53,    52,    90,
+      52,    53,    50,    77,    52,    53,    50,    77,    52,    53,
+      50,    77,     3,   101,   108,   109,     6,    87,    88,    89,
+     101,     3,    74,     3,    83,     3,    79,    53,    50,    77,
+      52,    53,    50,    77,    53,    53,    53,   101,     3,    87,
+      53
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    57,    58,    59,    59,    60,    60,    61,    61,    62,
       62,    63,    63,    64,    64,    65,    66,    66,    67,    67,
@@ -1156,17 +1301,17 @@ static const yytype_uint8 yyr1[] =
       79,    80,    80,    81,    81,    82,    83,    83,    83,    84,
       84,    85,    85,    86,    87,    87,    87,    88,    88,    89,
       89,    90,    91,    91,    92,    92,    93,    93,    94,    94,
-      95,    95,    95,    96,    96,    97,    97,    97,    98,    98,
-      99,    99,   100,   100,   101,   101,   102,   102,   103,   103,
-     104,   104,   105,   105,   106,   106,   107,   107,   108,   108,
-     109,   109,   110,   110,   111,   111,   112,   112,   112,   112,
-     112,   112,   113,   113,   114,   114,   115,   115,   115,   116,
-     116,   117,   117,   118,   118,   119,   119,   120,   120,   121,
-     121,   122,   122,   122,   122,   122,   122,   122
+      95,    96,    96,    96,    97,    97,    98,    98,    98,    99,
+      99,   100,   100,   101,   101,   102,   102,   103,   103,   104,
+     104,   105,   105,   106,   106,   107,   107,   108,   108,   109,
+     109,   110,   110,   111,   111,   112,   112,   113,   113,   113,
+     113,   113,   113,   114,   114,   115,   115,   116,   116,   116,
+     117,   117,   118,   118,   119,   119,   120,   120,   121,   121,
+     122,   122,   123,   123,   123,   123,   123,   123,   123
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     5,     0,     1,     2,     3,     0,     1,     2,
        3,     0,     1,     2,     3,     5,     0,     2,     1,     3,
@@ -1177,49 +1322,49 @@ static const yytype_uint8 yyr2[] =
        4,     0,     2,     1,     3,     3,     1,     1,     4,     0,
        2,     1,     3,     3,     1,     1,     4,     0,     2,     1,
        3,     3,     0,     2,     0,     2,     0,     2,     0,     2,
-       6,     3,     6,     3,     4,     1,     3,     3,     1,     4,
-       1,     4,     3,     3,     0,     2,     1,     3,     0,     2,
-       1,     3,     0,     2,     1,     3,     0,     2,     1,     3,
-       1,     3,     1,     3,     0,     2,     1,     1,     1,     1,
-       1,     4,     0,     2,     1,     3,     1,     1,     4,     1,
-       1,     0,     1,     2,     3,     4,     1,     1,     3,     1,
-       3,     1,     1,     1,     1,     1,     4,     1
+       1,     6,     3,     6,     3,     4,     1,     3,     3,     1,
+       4,     1,     4,     3,     3,     0,     2,     1,     3,     0,
+       2,     1,     3,     0,     2,     1,     3,     0,     2,     1,
+       3,     1,     3,     1,     3,     0,     2,     1,     1,     1,
+       1,     1,     4,     0,     2,     1,     3,     1,     1,     4,
+       1,     1,     0,     1,     2,     3,     4,     1,     1,     3,
+       1,     3,     1,     1,     1,     1,     1,     4,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (parm, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (parm, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -1236,56 +1381,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, parm); \
+                  Kind, Value, parm); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *parm)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *parm)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (parm);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (parm);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *parm)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *parm)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, parm);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, parm);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1294,7 +1436,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, voi
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1317,21 +1459,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule, void *parm)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void *parm)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              , parm);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], parm);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1346,8 +1488,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1370,28 +1512,76 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1405,10 +1595,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1416,14 +1606,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1434,7 +1623,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1449,36 +1641,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1502,63 +1678,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1567,7 +1758,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1579,40 +1770,43 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *parm)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void *parm)
 {
-  YYUSE (yyvaluep);
-  YYUSE (parm);
+  YY_USE (yyvaluep);
+  YY_USE (parm);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1620,7 +1814,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *parm)
 int
 yyparse (void *parm)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1631,45 +1825,41 @@ YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
 YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1677,71 +1867,75 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1749,30 +1943,31 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1783,18 +1978,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, YYLEX_PARAM);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1822,15 +2028,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1845,7 +2049,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1865,49 +2069,52 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 7:
-
-    {
+  case 7: /* vardecl_items: %empty  */
+        {
 #if !EXPOSE_INT_LITS
             initfg(static_cast<ParserState*>(parm));
 #endif
         }
-
     break;
 
-  case 8:
-
-    {
+  case 8: /* vardecl_items: vardecl_items_head  */
+        {
 #if !EXPOSE_INT_LITS
             initfg(static_cast<ParserState*>(parm));
 #endif
         }
-
     break;
 
-  case 11:
-
-    {
+  case 11: /* constraint_items: %empty  */
+        {
 #if EXPOSE_INT_LITS
             initfg(static_cast<ParserState*>(parm));
 #endif
         }
-
     break;
 
-  case 12:
-
-    {
+  case 12: /* constraint_items: constraint_items_head  */
+        {
 #if EXPOSE_INT_LITS
             initfg(static_cast<ParserState*>(parm));
 #endif
         }
+    break;
 
+  case 13: /* constraint_items_head: constraint_item ';'  */
+        {
+            endItem(static_cast<ParserState*>(parm));
+        }
     break;
 
-  case 33:
+  case 14: /* constraint_items_head: constraint_items_head constraint_item ';'  */
+        {
+            endItem(static_cast<ParserState*>(parm));
+        }
+    break;
 
-    {
+  case 33: /* vardecl_item: VAR int_ti_expr_tail ':' ID annotations non_array_expr_opt  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, !(yyvsp[-4].oSet)() || !(yyvsp[-4].oSet).some()->empty(), "Empty var int domain.");
             bool print = (yyvsp[-1].argVec) && (yyvsp[-1].argVec)->hasAtom("output_var");
@@ -1936,14 +2143,11 @@ yyreduce:
                 pp->intvars.push_back(varspec((yyvsp[-2].sValue), new IntVarSpec((yyvsp[-4].oSet),print,introduced,looks_introduced)));
             }
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 34:
-
-    {
+  case 34: /* vardecl_item: VAR bool_ti_expr_tail ':' ID annotations non_array_expr_opt  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             bool print = (yyvsp[-1].argVec) && (yyvsp[-1].argVec)->hasAtom("output_var");
             pp->boolvarTable.put((yyvsp[-2].sValue), pp->boolvars.size());
@@ -1971,25 +2175,19 @@ yyreduce:
                 pp->boolvars.push_back(varspec((yyvsp[-2].sValue), new BoolVarSpec((yyvsp[-4].oSet),print,introduced,looks_introduced)));
             }
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 35:
-
-    { 
+  case 35: /* vardecl_item: VAR float_ti_expr_tail ':' ID annotations non_array_expr_opt  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, false, "Floats not supported.");
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 36:
-
-    { 
+  case 36: /* vardecl_item: VAR SET OF int_ti_expr_tail ':' ID annotations non_array_expr_opt  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             bool print = (yyvsp[-1].argVec) && (yyvsp[-1].argVec)->hasAtom("output_var");
             pp->setvarTable.put((yyvsp[-2].sValue), pp->setvars.size());
@@ -2018,14 +2216,11 @@ yyreduce:
                 pp->setvars.push_back(varspec((yyvsp[-2].sValue), new SetVarSpec((yyvsp[-4].oSet),print,introduced,looks_introduced)));
             }
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 37:
-
-    {
+  case 37: /* vardecl_item: int_ti_expr_tail ':' ID annotations '=' non_array_expr  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, !(yyvsp[-5].oSet)() || !(yyvsp[-5].oSet).some()->empty(), "Empty int domain.");
             yyassert(pp, (yyvsp[0].arg)->isInt(), "Invalid int initializer.");
@@ -2048,28 +2243,22 @@ yyreduce:
             }
             pp->intvals.put((yyvsp[-3].sValue), i);
             delete (yyvsp[-2].argVec);
-            free((yyvsp[-3].sValue));                
         }
-
     break;
 
-  case 38:
-
-    {
+  case 38: /* vardecl_item: BOOLTOK ':' ID annotations '=' non_array_expr  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, (yyvsp[0].arg)->isBool(), "Invalid bool initializer.");
             if ((yyvsp[0].arg)->isBool()) {
                 pp->boolvals.put((yyvsp[-3].sValue), (yyvsp[0].arg)->getBool());
             }
             delete (yyvsp[-2].argVec);
-            free((yyvsp[-3].sValue));                
         }
-
     break;
 
-  case 39:
-
-    {
+  case 39: /* vardecl_item: SET OF int_ti_expr_tail ':' ID annotations '=' non_array_expr  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, !(yyvsp[-5].oSet)() || !(yyvsp[-5].oSet).some()->empty(), "Empty set domain.");
             yyassert(pp, (yyvsp[0].arg)->isSet(), "Invalid set initializer.");
@@ -2079,14 +2268,11 @@ yyreduce:
             pp->setvals.put((yyvsp[-3].sValue), *set);
             delete set;
             delete (yyvsp[-2].argVec);
-            free((yyvsp[-3].sValue));                
         }
-
     break;
 
-  case 40:
-
-    {
+  case 40: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF VAR int_ti_expr_tail ':' ID annotations vardecl_int_var_array_init  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, (yyvsp[-10].iValue) == 1, "Arrays must start at 1");
             if (!pp->hadError) {
@@ -2117,7 +2303,7 @@ yyreduce:
                         delete vsv;
                     } else {
                         IntVarSpec* ispec = new IntVarSpec((yyvsp[-4].oSet),print,!print,false);
-                        string arrayname = "["; arrayname += (yyvsp[-2].sValue);
+                        const char* arrayname = pp->intern((string("[") + (yyvsp[-2].sValue)).c_str());
                         for (int i = 0; i < (yyvsp[-8].iValue)-1; i++) {
                             vars[i] = pp->intvars.size();
                             pp->intvars.push_back(varspec(arrayname, ispec));
@@ -2139,14 +2325,11 @@ yyreduce:
                 pp->intvararrays.put((yyvsp[-2].sValue), vars);
             }
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 41:
-
-    {
+  case 41: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF VAR bool_ti_expr_tail ':' ID annotations vardecl_bool_var_array_init  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             bool print = (yyvsp[-1].argVec) && (yyvsp[-1].argVec)->hasCall("output_array");
             yyassert(pp, (yyvsp[-10].iValue) == 1, "Arrays must start at 1");
@@ -2193,25 +2376,19 @@ yyreduce:
                 pp->boolvararrays.put((yyvsp[-2].sValue), vars);
             }
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 42:
-
-    { 
+  case 42: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF VAR float_ti_expr_tail ':' ID annotations vardecl_float_var_array_init  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, false, "Floats not supported.");
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 43:
-
-    { 
+  case 43: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF VAR SET OF int_ti_expr_tail ':' ID annotations vardecl_set_var_array_init  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             bool print = (yyvsp[-1].argVec) && (yyvsp[-1].argVec)->hasCall("output_array");
             yyassert(pp, (yyvsp[-12].iValue) == 1, "Arrays must start at 1");
@@ -2240,7 +2417,7 @@ yyreduce:
                     delete vsv;
                 } else {
                     SetVarSpec* ispec = new SetVarSpec((yyvsp[-4].oSet),print,!print, false);
-                    string arrayname = "["; arrayname += (yyvsp[-2].sValue);
+                    const char* arrayname = pp->intern((string("[") + (yyvsp[-2].sValue)).c_str());
                     for (int i = 0; i < (yyvsp[-10].iValue)-1; i++) {
                         vars[i] = pp->setvars.size();
                         pp->setvars.push_back(varspec(arrayname, ispec));
@@ -2261,14 +2438,11 @@ yyreduce:
                 pp->setvararrays.put((yyvsp[-2].sValue), vars);
             }
             delete (yyvsp[-1].argVec);
-            free((yyvsp[-2].sValue));
         }
-
     break;
 
-  case 44:
-
-    {
+  case 44: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF int_ti_expr_tail ':' ID annotations '=' '[' int_list ']'  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, (yyvsp[-12].iValue) == 1, "Arrays must start at 1");
             yyassert(pp, (yyvsp[-1].setValue)->size() == static_cast<unsigned int>((yyvsp[-10].iValue)),
@@ -2276,15 +2450,12 @@ yyreduce:
             if (!pp->hadError)
                 pp->intvalarrays.put((yyvsp[-5].sValue), *(yyvsp[-1].setValue));
             delete (yyvsp[-1].setValue);
-            free((yyvsp[-5].sValue));
             delete (yyvsp[-4].argVec);
         }
-
     break;
 
-  case 45:
-
-    {
+  case 45: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF BOOLTOK ':' ID annotations '=' '[' bool_list ']'  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, (yyvsp[-12].iValue) == 1, "Arrays must start at 1");
             yyassert(pp, (yyvsp[-1].setValue)->size() == static_cast<unsigned int>((yyvsp[-10].iValue)),
@@ -2292,26 +2463,20 @@ yyreduce:
             if (!pp->hadError)
                 pp->boolvalarrays.put((yyvsp[-5].sValue), *(yyvsp[-1].setValue));
             delete (yyvsp[-1].setValue);
-            free((yyvsp[-5].sValue));
             delete (yyvsp[-4].argVec);
         }
-
     break;
 
-  case 46:
-
-    {
+  case 46: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF FLOATTOK ':' ID annotations '=' '[' float_list ']'  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, false, "Floats not supported.");
             delete (yyvsp[-4].argVec);
-            free((yyvsp[-5].sValue));
         }
-
     break;
 
-  case 47:
-
-    {
+  case 47: /* vardecl_item: ARRAY '[' INT_LIT DOTDOT INT_LIT ']' OF SET OF int_ti_expr_tail ':' ID annotations '=' '[' set_literal_list ']'  */
+        {
             ParserState* pp = static_cast<ParserState*>(parm);
             yyassert(pp, (yyvsp[-14].iValue) == 1, "Arrays must start at 1");
             yyassert(pp, (yyvsp[-1].setValueList)->size() == static_cast<unsigned int>((yyvsp[-12].iValue)),
@@ -2320,22 +2485,17 @@ yyreduce:
                 pp->setvalarrays.put((yyvsp[-5].sValue), *(yyvsp[-1].setValueList));
             delete (yyvsp[-1].setValueList);
             delete (yyvsp[-4].argVec);
-            free((yyvsp[-5].sValue));
         }
-
     break;
 
-  case 48:
-
-    { 
+  case 48: /* int_init: INT_LIT  */
+        { 
             (yyval.varSpec) = new IntVarSpec((yyvsp[0].iValue), false, true, false);
         }
-
     break;
 
-  case 49:
-
-    { 
+  case 49: /* int_init: ID  */
+        { 
             int v = 0;
             ParserState* pp = static_cast<ParserState*>(parm);
             if (pp->intvarTable.get((yyvsp[0].sValue), v))
@@ -2347,22 +2507,18 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new IntVarSpec(0,false,true,false); // keep things consistent
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 50:
-
-    { 
-            vector<int> v;
+  case 50: /* int_init: ID '[' INT_LIT ']'  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
-            if (pp->intvararrays.get((yyvsp[-3].sValue), v)) {
+            if (const vector<int>* v = pp->intvararrays.find((yyvsp[-3].sValue))) {
                 yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 && 
-                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                                  "array access out of bounds");
                 if (!pp->hadError)
-                    (yyval.varSpec) = new IntVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false,true,false);
+                    (yyval.varSpec) = new IntVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false,true,false);
                 else
                     (yyval.varSpec) = new IntVarSpec(0,false,true,false); // keep things consistent
             } else {
@@ -2372,64 +2528,49 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new IntVarSpec(0,false,true,false); // keep things consistent
             }
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 51:
-
-    { 
+  case 51: /* int_init_list: %empty  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(0); 
         }
-
     break;
 
-  case 52:
-
-    { 
+  case 52: /* int_init_list: int_init_list_head list_tail  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 53:
-
-    { 
+  case 53: /* int_init_list_head: int_init  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(1); 
             (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); 
         }
-
     break;
 
-  case 54:
-
-    { 
+  case 54: /* int_init_list_head: int_init_list_head ',' int_init  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); 
             (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); 
         }
-
     break;
 
-  case 57:
-
-    { 
+  case 57: /* int_var_array_literal: '[' int_init_list ']'  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 58:
-
-    { 
+  case 58: /* float_init: FLOAT_LIT  */
+        { 
             (yyval.varSpec) = new FloatVarSpec((yyvsp[0].dValue),false,true,false); 
         }
-
     break;
 
-  case 59:
-
-    { 
+  case 59: /* float_init: ID  */
+        { 
             int v = 0;
             ParserState* pp = static_cast<ParserState*>(parm);
             if (pp->floatvarTable.get((yyvsp[0].sValue), v))
@@ -2441,22 +2582,18 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new FloatVarSpec(0.0,false,true,false);
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 60:
-
-    { 
-            vector<int> v;
+  case 60: /* float_init: ID '[' INT_LIT ']'  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
-            if (pp->floatvararrays.get((yyvsp[-3].sValue), v)) {
+            if (const vector<int>* v = pp->floatvararrays.find((yyvsp[-3].sValue))) {
                 yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 && 
-                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                                  "array access out of bounds");
                 if (!pp->hadError)
-                    (yyval.varSpec) = new FloatVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false,true,false);
+                    (yyval.varSpec) = new FloatVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false,true,false);
                 else
                     (yyval.varSpec) = new FloatVarSpec(0.0,false,true,false);
             } else {
@@ -2466,64 +2603,49 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new FloatVarSpec(0.0,false,true,false);
             }
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 61:
-
-    { 
+  case 61: /* float_init_list: %empty  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(0); 
         }
-
     break;
 
-  case 62:
-
-    { 
+  case 62: /* float_init_list: float_init_list_head list_tail  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 63:
-
-    {   
+  case 63: /* float_init_list_head: float_init  */
+        {   
             (yyval.varSpecVec) = new vector<VarSpec*>(1); 
             (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); 
         }
-
     break;
 
-  case 64:
-
-    { 
+  case 64: /* float_init_list_head: float_init_list_head ',' float_init  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); 
             (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); 
         }
-
     break;
 
-  case 65:
-
-    { 
+  case 65: /* float_var_array_literal: '[' float_init_list ']'  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 66:
-
-    { 
+  case 66: /* bool_init: BOOL_LIT  */
+        { 
             (yyval.varSpec) = new BoolVarSpec((yyvsp[0].iValue),false,true,false); 
         }
-
     break;
 
-  case 67:
-
-    { 
+  case 67: /* bool_init: ID  */
+        { 
             int v = 0;
             ParserState* pp = static_cast<ParserState*>(parm);
             if (pp->boolvarTable.get((yyvsp[0].sValue), v))
@@ -2535,22 +2657,18 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new BoolVarSpec(false,false,true,false);
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 68:
-
-    { 
-            vector<int> v;
+  case 68: /* bool_init: ID '[' INT_LIT ']'  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
-            if (pp->boolvararrays.get((yyvsp[-3].sValue), v)) {
+            if (const vector<int>* v = pp->boolvararrays.find((yyvsp[-3].sValue))) {
                 yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 && 
-                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                                  "array access out of bounds");
                 if (!pp->hadError)
-                    (yyval.varSpec) = new BoolVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false,true,false);
+                    (yyval.varSpec) = new BoolVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false,true,false);
                 else
                     (yyval.varSpec) = new BoolVarSpec(false,false,true,false);
             } else {
@@ -2560,62 +2678,47 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new BoolVarSpec(false,false,true,false);
             }
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 69:
-
-    { 
+  case 69: /* bool_init_list: %empty  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(0); 
         }
-
     break;
 
-  case 70:
-
-    { 
+  case 70: /* bool_init_list: bool_init_list_head list_tail  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 71:
-
-    { 
+  case 71: /* bool_init_list_head: bool_init  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(1); 
             (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); 
         }
-
     break;
 
-  case 72:
-
-    { 
+  case 72: /* bool_init_list_head: bool_init_list_head ',' bool_init  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); 
             (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); 
         }
-
     break;
 
-  case 73:
-
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-
+  case 73: /* bool_var_array_literal: '[' bool_init_list ']'  */
+                               { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
     break;
 
-  case 74:
-
-    { 
+  case 74: /* set_init: set_literal  */
+        { 
             (yyval.varSpec) = new SetVarSpec(Option<AST::SetLit*>::some((yyvsp[0].setLit)),false,true,false); 
         }
-
     break;
 
-  case 75:
-
-    { 
+  case 75: /* set_init: ID  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             int v = 0;
             if (pp->setvarTable.get((yyvsp[0].sValue), v))
@@ -2627,22 +2730,18 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new SetVarSpec(Alias(0),false,true,false);
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 76:
-
-    { 
-            vector<int> v;
+  case 76: /* set_init: ID '[' INT_LIT ']'  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
-            if (pp->setvararrays.get((yyvsp[-3].sValue), v)) {
+            if (const vector<int>* v = pp->setvararrays.find((yyvsp[-3].sValue))) {
                 yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 && 
-                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                                        static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                                  "array access out of bounds");
                 if (!pp->hadError)
-                    (yyval.varSpec) = new SetVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false,true,false);
+                    (yyval.varSpec) = new SetVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false,true,false);
                 else
                     (yyval.varSpec) = new SetVarSpec(Alias(0),false,true,false);
             } else {
@@ -2652,120 +2751,97 @@ yyreduce:
                 pp->hadError = true;
                 (yyval.varSpec) = new SetVarSpec(Alias(0),false,true,false);
             }
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 77:
-
-    { 
+  case 77: /* set_init_list: %empty  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(0); 
         }
-
     break;
 
-  case 78:
-
-    { 
+  case 78: /* set_init_list: set_init_list_head list_tail  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 79:
-
-    { 
+  case 79: /* set_init_list_head: set_init  */
+        { 
             (yyval.varSpecVec) = new vector<VarSpec*>(1); 
             (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); 
         }
-
     break;
 
-  case 80:
-
-    { 
+  case 80: /* set_init_list_head: set_init_list_head ',' set_init  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); 
             (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); 
         }
-
     break;
 
-  case 81:
-
-    { 
+  case 81: /* set_var_array_literal: '[' set_init_list ']'  */
+        { 
             (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); 
         }
-
     break;
 
-  case 82:
-
-    { 
+  case 82: /* vardecl_int_var_array_init: %empty  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); 
         }
-
     break;
 
-  case 83:
-
-    { 
+  case 83: /* vardecl_int_var_array_init: '=' int_var_array_literal  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); 
         }
-
     break;
 
-  case 84:
-
-    { 
+  case 84: /* vardecl_bool_var_array_init: %empty  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); 
         }
-
     break;
 
-  case 85:
-
-    { 
+  case 85: /* vardecl_bool_var_array_init: '=' bool_var_array_literal  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); 
         }
-
     break;
 
-  case 86:
-
-    { 
+  case 86: /* vardecl_float_var_array_init: %empty  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); 
         }
-
     break;
 
-  case 87:
-
-    { 
+  case 87: /* vardecl_float_var_array_init: '=' float_var_array_literal  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); 
         }
-
     break;
 
-  case 88:
-
-    { 
+  case 88: /* vardecl_set_var_array_init: %empty  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); 
         }
-
     break;
 
-  case 89:
-
-    { 
+  case 89: /* vardecl_set_var_array_init: '=' set_var_array_literal  */
+        { 
             (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); 
         }
-
     break;
 
-  case 90:
+  case 90: /* constraint_start: CONSTRAINT  */
+        {
+            beginItem(static_cast<ParserState*>(parm));
+        }
+    break;
 
-    { 
+  case 91: /* constraint_item: constraint_start ID '(' flat_expr_list ')' annotations  */
+        { 
             ParserState *pp = static_cast<ParserState*>(parm);
 #if EXPOSE_INT_LITS
             pp->domainConstraints2.push_back(std::pair<ConExpr*, AST::Node*>(new ConExpr((yyvsp[-4].sValue), (yyvsp[-2].argVec)), (yyvsp[0].argVec)));
@@ -2780,14 +2856,11 @@ yyreduce:
             }
             delete (yyvsp[0].argVec);
 #endif
-            free((yyvsp[-4].sValue));
         }
-
     break;
 
-  case 91:
-
-    {
+  case 92: /* constraint_item: constraint_start ID annotations  */
+        {
             ParserState *pp = static_cast<ParserState*>(parm);
             AST::Array* args = new AST::Array(2);
             args->a[0] = getVarRefArg(pp,(yyvsp[-1].sValue));
@@ -2805,14 +2878,11 @@ yyreduce:
             }
             delete (yyvsp[0].argVec);
 #endif
-            free((yyvsp[-1].sValue));
         }
-
     break;
 
-  case 92:
-
-    { 
+  case 93: /* constraint_item: constraint_start ID '[' INT_LIT ']' annotations  */
+        { 
             ParserState *pp = static_cast<ParserState*>(parm);
             AST::Array* args = new AST::Array(2);
             args->a[0] = getArrayElement(pp,(yyvsp[-4].sValue),(yyvsp[-2].iValue));
@@ -2830,26 +2900,21 @@ yyreduce:
             }
             delete (yyvsp[0].argVec);
 #endif
-            free((yyvsp[-4].sValue));
         }
-
     break;
 
-  case 93:
-
-    { 
+  case 94: /* solve_item: SOLVE annotations SATISFY  */
+        { 
             ParserState *pp = static_cast<ParserState*>(parm);
             if (!pp->hadError) {
                 pp->fg->solve((yyvsp[-1].argVec));
             }
             delete (yyvsp[-1].argVec);
         }
-
     break;
 
-  case 94:
-
-    { 
+  case 95: /* solve_item: SOLVE annotations minmax solve_expr  */
+        { 
             ParserState *pp = static_cast<ParserState*>(parm);
             if (!pp->hadError) {
                 if ((yyvsp[-1].bValue))
@@ -2859,44 +2924,34 @@ yyreduce:
             }
             delete (yyvsp[-2].argVec);
         }
-
     break;
 
-  case 95:
-
-    { 
+  case 96: /* int_ti_expr_tail: INTTOK  */
+        { 
             (yyval.oSet) = Option<AST::SetLit* >::none(); 
         }
-
     break;
 
-  case 96:
-
-    { 
+  case 97: /* int_ti_expr_tail: '{' int_list '}'  */
+        { 
             (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit(*(yyvsp[-1].setValue))); 
         }
-
     break;
 
-  case 97:
-
-    { 
+  case 98: /* int_ti_expr_tail: INT_LIT DOTDOT INT_LIT  */
+        { 
             (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit((yyvsp[-2].iValue), (yyvsp[0].iValue)));
         }
-
     break;
 
-  case 98:
-
-    { 
+  case 99: /* bool_ti_expr_tail: BOOLTOK  */
+        { 
             (yyval.oSet) = Option<AST::SetLit* >::none(); 
         }
-
     break;
 
-  case 99:
-
-    { 
+  case 100: /* bool_ti_expr_tail: '{' bool_list_head list_tail '}'  */
+        { 
             bool haveTrue = false;
             bool haveFalse = false;
             for (int i = (yyvsp[-2].setValue)->size(); i--;) {
@@ -2907,283 +2962,225 @@ yyreduce:
             (yyval.oSet) = Option<AST::SetLit* >::some(
                 new AST::SetLit(!haveFalse,haveTrue));
         }
-
     break;
 
-  case 102:
-
-    { 
+  case 103: /* set_literal: '{' int_list '}'  */
+        { 
             (yyval.setLit) = new AST::SetLit(*(yyvsp[-1].setValue)); 
         }
-
     break;
 
-  case 103:
-
-    { 
+  case 104: /* set_literal: INT_LIT DOTDOT INT_LIT  */
+        { 
             (yyval.setLit) = new AST::SetLit((yyvsp[-2].iValue), (yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 104:
-
-    { 
+  case 105: /* int_list: %empty  */
+        { 
             (yyval.setValue) = new vector<int>(0); 
         }
-
     break;
 
-  case 105:
-
-    { 
+  case 106: /* int_list: int_list_head list_tail  */
+        { 
             (yyval.setValue) = (yyvsp[-1].setValue); 
         }
-
     break;
 
-  case 106:
-
-    { 
+  case 107: /* int_list_head: INT_LIT  */
+        { 
             (yyval.setValue) = new vector<int>(1); 
             (*(yyval.setValue))[0] = (yyvsp[0].iValue); 
         }
-
     break;
 
-  case 107:
-
-    { 
+  case 108: /* int_list_head: int_list_head ',' INT_LIT  */
+        { 
             (yyval.setValue) = (yyvsp[-2].setValue); 
             (yyval.setValue)->push_back((yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 108:
-
-    { 
+  case 109: /* bool_list: %empty  */
+        { 
             (yyval.setValue) = new vector<int>(0); 
         }
-
     break;
 
-  case 109:
-
-    { 
+  case 110: /* bool_list: bool_list_head list_tail  */
+        { 
             (yyval.setValue) = (yyvsp[-1].setValue); 
         }
-
     break;
 
-  case 110:
-
-    { 
+  case 111: /* bool_list_head: BOOL_LIT  */
+        { 
             (yyval.setValue) = new vector<int>(1); 
             (*(yyval.setValue))[0] = (yyvsp[0].iValue); 
         }
-
     break;
 
-  case 111:
-
-    { 
+  case 112: /* bool_list_head: bool_list_head ',' BOOL_LIT  */
+        { 
             (yyval.setValue) = (yyvsp[-2].setValue); 
             (yyval.setValue)->push_back((yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 112:
-
-    { 
+  case 113: /* float_list: %empty  */
+        { 
             (yyval.floatSetValue) = new vector<double>(0); 
         }
-
     break;
 
-  case 113:
-
-    { 
+  case 114: /* float_list: float_list_head list_tail  */
+        { 
             (yyval.floatSetValue) = (yyvsp[-1].floatSetValue); 
         }
-
     break;
 
-  case 114:
-
-    {
+  case 115: /* float_list_head: FLOAT_LIT  */
+        {
             (yyval.floatSetValue) = new vector<double>(1); 
             (*(yyval.floatSetValue))[0] = (yyvsp[0].dValue); 
         }
-
     break;
 
-  case 115:
-
-    { 
+  case 116: /* float_list_head: float_list_head ',' FLOAT_LIT  */
+        { 
             (yyval.floatSetValue) = (yyvsp[-2].floatSetValue); 
             (yyval.floatSetValue)->push_back((yyvsp[0].dValue)); 
         }
-
     break;
 
-  case 116:
-
-    { 
+  case 117: /* set_literal_list: %empty  */
+        { 
             (yyval.setValueList) = new vector<AST::SetLit>(0); 
         }
-
     break;
 
-  case 117:
-
-    { 
+  case 118: /* set_literal_list: set_literal_list_head list_tail  */
+        { 
             (yyval.setValueList) = (yyvsp[-1].setValueList); 
         }
-
     break;
 
-  case 118:
-
-    { 
+  case 119: /* set_literal_list_head: set_literal  */
+        { 
             (yyval.setValueList) = new vector<AST::SetLit>(1); 
             (*(yyval.setValueList))[0] = *(yyvsp[0].setLit); 
             delete (yyvsp[0].setLit); 
         }
-
     break;
 
-  case 119:
-
-    { 
+  case 120: /* set_literal_list_head: set_literal_list_head ',' set_literal  */
+        { 
             (yyval.setValueList) = (yyvsp[-2].setValueList); 
             (yyval.setValueList)->push_back(*(yyvsp[0].setLit)); 
             delete (yyvsp[0].setLit); 
         }
-
     break;
 
-  case 120:
-
-    { 
+  case 121: /* flat_expr_list: flat_expr  */
+        { 
             (yyval.argVec) = new AST::Array((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 121:
-
-    { 
+  case 122: /* flat_expr_list: flat_expr_list ',' flat_expr  */
+        { 
             (yyval.argVec) = (yyvsp[-2].argVec); 
             (yyval.argVec)->append((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 122:
-
-    { 
+  case 123: /* flat_expr: non_array_expr  */
+        { 
             (yyval.arg) = (yyvsp[0].arg); 
         }
-
     break;
 
-  case 123:
-
-    { 
+  case 124: /* flat_expr: '[' non_array_expr_list ']'  */
+        { 
             (yyval.arg) = (yyvsp[-1].argVec); 
         }
-
     break;
 
-  case 124:
-
-    { 
+  case 125: /* non_array_expr_opt: %empty  */
+        { 
             (yyval.oArg) = Option<AST::Node*>::none(); 
         }
-
     break;
 
-  case 125:
-
-    { 
+  case 126: /* non_array_expr_opt: '=' non_array_expr  */
+        { 
             (yyval.oArg) = Option<AST::Node*>::some((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 126:
-
-    { 
+  case 127: /* non_array_expr: BOOL_LIT  */
+        { 
             (yyval.arg) = new AST::BoolLit((yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 127:
-
-    { 
+  case 128: /* non_array_expr: INT_LIT  */
+        { 
             (yyval.arg) = new AST::IntLit((yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 128:
-
-    { 
+  case 129: /* non_array_expr: FLOAT_LIT  */
+        { 
             (yyval.arg) = new AST::FloatLit((yyvsp[0].dValue)); 
         }
-
     break;
 
-  case 129:
-
-    { 
+  case 130: /* non_array_expr: set_literal  */
+        { 
             (yyval.arg) = (yyvsp[0].setLit); 
         }
-
     break;
 
-  case 130:
-
-    { 
-            vector<int> as;
+  case 131: /* non_array_expr: ID  */
+        { 
+            const vector<int>* as;
             ParserState* pp = static_cast<ParserState*>(parm);
-            if (pp->intvararrays.get((yyvsp[0].sValue), as)) {
-                AST::Array *ia = new AST::Array(as.size());
-                for (int i = as.size(); i--;)
-                    ia->a[i] = new AST::IntVar(as[i]);
+            if ((as = pp->intvararrays.find((yyvsp[0].sValue)))) {
+                AST::Array *ia = new AST::Array(as->size());
+                for (int i = as->size(); i--;)
+                    ia->a[i] = new AST::IntVar((*as)[i]);
                 (yyval.arg) = ia;
-            } else if (pp->boolvararrays.get((yyvsp[0].sValue), as)) {
-                AST::Array *ia = new AST::Array(as.size());
-                for (int i = as.size(); i--;)
-                    ia->a[i] = new AST::BoolVar(as[i]);
+            } else if ((as = pp->boolvararrays.find((yyvsp[0].sValue)))) {
+                AST::Array *ia = new AST::Array(as->size());
+                for (int i = as->size(); i--;)
+                    ia->a[i] = new AST::BoolVar((*as)[i]);
                 (yyval.arg) = ia;
-            } else if (pp->setvararrays.get((yyvsp[0].sValue), as)) {
-                AST::Array *ia = new AST::Array(as.size());
-                for (int i = as.size(); i--;)
-                    ia->a[i] = new AST::SetVar(as[i]);
+            } else if ((as = pp->setvararrays.find((yyvsp[0].sValue)))) {
+                AST::Array *ia = new AST::Array(as->size());
+                for (int i = as->size(); i--;)
+                    ia->a[i] = new AST::SetVar((*as)[i]);
                 (yyval.arg) = ia;
             } else {
-                std::vector<int> is;
-                std::vector<AST::SetLit> isS;
+                const std::vector<int>* is;
+                const std::vector<AST::SetLit>* isS;
                 int ival = 0;
                 bool bval = false;
-                if (pp->intvalarrays.get((yyvsp[0].sValue), is)) {
-                    AST::Array *v = new AST::Array(is.size());
-                    for (int i = is.size(); i--;)
-                        v->a[i] = new AST::IntLit(is[i]);
+                if ((is = pp->intvalarrays.find((yyvsp[0].sValue)))) {
+                    AST::Array *v = new AST::Array(is->size());
+                    for (int i = is->size(); i--;)
+                        v->a[i] = new AST::IntLit((*is)[i]);
                     (yyval.arg) = v;
-                } else if (pp->boolvalarrays.get((yyvsp[0].sValue), is)) {
-                    AST::Array *v = new AST::Array(is.size());
-                    for (int i = is.size(); i--;)
-                        v->a[i] = new AST::BoolLit(is[i]);
+                } else if ((is = pp->boolvalarrays.find((yyvsp[0].sValue)))) {
+                    AST::Array *v = new AST::Array(is->size());
+                    for (int i = is->size(); i--;)
+                        v->a[i] = new AST::BoolLit((*is)[i]);
                     (yyval.arg) = v;
-                } else if (pp->setvalarrays.get((yyvsp[0].sValue), isS)) {
-                    AST::Array *v = new AST::Array(isS.size());
-                    for (int i = isS.size(); i--;)
-                        v->a[i] = new AST::SetLit(isS[i]);
+                } else if ((isS = pp->setvalarrays.find((yyvsp[0].sValue)))) {
+                    AST::Array *v = new AST::Array(isS->size());
+                    for (int i = isS->size(); i--;)
+                        v->a[i] = new AST::SetLit((*isS)[i]);
                     (yyval.arg) = v;                      
                 } else if (pp->intvals.get((yyvsp[0].sValue), ival)) {
                     (yyval.arg) = new AST::IntLit(ival);
@@ -3193,14 +3190,11 @@ yyreduce:
                     (yyval.arg) = getVarRefArg(pp,(yyvsp[0].sValue));
                 }
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 131:
-
-    { 
+  case 132: /* non_array_expr: ID '[' non_array_expr ']'  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             int i = -1;
             yyassert(pp, (yyvsp[-1].arg)->isInt(i), "Non-integer array index.");
@@ -3208,51 +3202,40 @@ yyreduce:
                 (yyval.arg) = getArrayElement(static_cast<ParserState*>(parm),(yyvsp[-3].sValue),i);
             else
                 (yyval.arg) = new AST::IntLit(0); // keep things consistent
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 132:
-
-    { 
+  case 133: /* non_array_expr_list: %empty  */
+        { 
             (yyval.argVec) = new AST::Array(0); 
         }
-
     break;
 
-  case 133:
-
-    { 
+  case 134: /* non_array_expr_list: non_array_expr_list_head list_tail  */
+        { 
             (yyval.argVec) = (yyvsp[-1].argVec); 
         }
-
     break;
 
-  case 134:
-
-    { 
+  case 135: /* non_array_expr_list_head: non_array_expr  */
+        { 
             (yyval.argVec) = new AST::Array((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 135:
-
-    { 
+  case 136: /* non_array_expr_list_head: non_array_expr_list_head ',' non_array_expr  */
+        { 
             (yyval.argVec) = (yyvsp[-2].argVec); 
             (yyval.argVec)->append((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 136:
-
-    {
+  case 137: /* solve_expr: INT_LIT  */
+        {
             ParserState *pp = static_cast<ParserState*>(parm);
             // Create a new variable in the parser and append at the end
             const int i = pp->intvars.size();
-            const std::string objname = "X_INTRODUCED_CHUFFEDOBJ";
+            const char* objname = pp->intern("X_INTRODUCED_CHUFFEDOBJ");
             pp->intvarTable.put(objname, i);
             pp->intvars.push_back(varspec(objname,
                 new IntVarSpec((yyvsp[0].iValue),false,true,false)));
@@ -3261,19 +3244,17 @@ yyreduce:
                 try {
                     pp->fg->newIntVar(static_cast<IntVarSpec*>(pp->intvars[i].second));
                     IntVar* newiv = pp->fg->iv[pp->fg->intVarCount-1];
-                    intVarString.insert(std::pair<IntVar*, std::string>(newiv, pp->intvars[i].first));
+                    intVarString().insert(std::pair<IntVar*, std::string>(newiv, pp->intvars[i].first));
                 } catch (FlatZinc::Error& e) {
                     yyerror(pp, e.toString().c_str());
                 }
             }
             (yyval.iValue) = i;
         }
-
     break;
 
-  case 137:
-
-    { 
+  case 138: /* solve_expr: ID  */
+        { 
             ParserState *pp = static_cast<ParserState*>(parm);
             int tmp = -1;
             // Check whether the Objective variable is an integer constant
@@ -3288,7 +3269,7 @@ yyreduce:
                     try {
                         pp->fg->newIntVar(static_cast<IntVarSpec*>(pp->intvars[i].second));
                         IntVar* newiv = pp->fg->iv[pp->fg->intVarCount-1];
-                        intVarString.insert(std::pair<IntVar*, std::string>(newiv, pp->intvars[i].first));
+                        intVarString().insert(std::pair<IntVar*, std::string>(newiv, pp->intvars[i].first));
                     } catch (FlatZinc::Error& e) {
                         yyerror(pp, e.toString().c_str());
                     }
@@ -3300,183 +3281,148 @@ yyreduce:
                         << yyget_lineno(pp->yyscanner) << std::endl;
                 pp->hadError = true;
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 138:
-
-    {
-            vector<int> tmp;
+  case 139: /* solve_expr: ID '[' INT_LIT ']'  */
+        {
             ParserState *pp = static_cast<ParserState*>(parm);
-            if (!pp->intvararrays.get((yyvsp[-3].sValue), tmp)) {
+            const vector<int>* tmp = pp->intvararrays.find((yyvsp[-3].sValue));
+            if (!tmp) {
                 pp->err << "Error: unknown integer variable array " << (yyvsp[-3].sValue)
                         << " in line no. "
                         << yyget_lineno(pp->yyscanner) << std::endl;
                 pp->hadError = true;
             }
-            if ((yyvsp[-1].iValue) == 0 || static_cast<unsigned int>((yyvsp[-1].iValue)) > tmp.size()) {
+            if (!tmp || (yyvsp[-1].iValue) == 0 || static_cast<unsigned int>((yyvsp[-1].iValue)) > tmp->size()) {
                 pp->err << "Error: array index out of bounds for array " << (yyvsp[-3].sValue)
                         << " in line no. "
                         << yyget_lineno(pp->yyscanner) << std::endl;
                 pp->hadError = true;
             } else {
-                (yyval.iValue) = tmp[(yyvsp[-1].iValue)-1];
+                (yyval.iValue) = (*tmp)[(yyvsp[-1].iValue)-1];
             }
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 141:
-
-    { 
+  case 142: /* annotations: %empty  */
+        { 
             (yyval.argVec) = NULL; 
         }
-
     break;
 
-  case 142:
-
-    { 
+  case 143: /* annotations: annotations_head  */
+        { 
             (yyval.argVec) = (yyvsp[0].argVec); 
         }
-
     break;
 
-  case 143:
-
-    { 
+  case 144: /* annotations_head: COLONCOLON annotation  */
+        { 
             (yyval.argVec) = new AST::Array((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 144:
-
-    { 
+  case 145: /* annotations_head: annotations_head COLONCOLON annotation  */
+        { 
             (yyval.argVec) = (yyvsp[-2].argVec); 
             (yyval.argVec)->append((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 145:
-
-    { 
+  case 146: /* annotation: ID '(' annotation_list ')'  */
+        { 
             (yyval.arg) = new AST::Call((yyvsp[-3].sValue), AST::extractSingleton((yyvsp[-1].arg))); 
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 146:
-
-    { 
+  case 147: /* annotation: annotation_expr  */
+        { 
             (yyval.arg) = (yyvsp[0].arg); 
         }
-
     break;
 
-  case 147:
-
-    { 
+  case 148: /* annotation_list: annotation  */
+        { 
             (yyval.arg) = new AST::Array((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 148:
-
-    { 
+  case 149: /* annotation_list: annotation_list ',' annotation  */
+        { 
             (yyval.arg) = (yyvsp[-2].arg); 
             (yyval.arg)->append((yyvsp[0].arg)); 
         }
-
     break;
 
-  case 149:
-
-    { 
+  case 150: /* annotation_expr: ann_non_array_expr  */
+        { 
             (yyval.arg) = (yyvsp[0].arg); 
         }
-
     break;
 
-  case 150:
-
-    { 
+  case 151: /* annotation_expr: '[' annotation_list ']'  */
+        { 
             (yyval.arg) = (yyvsp[-1].arg); 
         }
-
     break;
 
-  case 151:
-
-    { 
+  case 152: /* ann_non_array_expr: BOOL_LIT  */
+        { 
             (yyval.arg) = new AST::BoolLit((yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 152:
-
-    { 
+  case 153: /* ann_non_array_expr: INT_LIT  */
+        { 
             (yyval.arg) = new AST::IntLit((yyvsp[0].iValue)); 
         }
-
     break;
 
-  case 153:
-
-    { 
+  case 154: /* ann_non_array_expr: FLOAT_LIT  */
+        { 
             (yyval.arg) = new AST::FloatLit((yyvsp[0].dValue)); 
         }
-
     break;
 
-  case 154:
-
-    { 
+  case 155: /* ann_non_array_expr: set_literal  */
+        { 
             (yyval.arg) = (yyvsp[0].setLit); 
         }
-
     break;
 
-  case 155:
-
-    { 
-            vector<int> as;
+  case 156: /* ann_non_array_expr: ID  */
+        { 
+            const vector<int>* as;
             ParserState* pp = static_cast<ParserState*>(parm);
-            if (pp->intvararrays.get((yyvsp[0].sValue), as)) {
-                AST::Array *ia = new AST::Array(as.size());
-                for (int i = as.size(); i--;)
-                    ia->a[i] = new AST::IntVar(as[i]);
+            if ((as = pp->intvararrays.find((yyvsp[0].sValue)))) {
+                AST::Array *ia = new AST::Array(as->size());
+                for (int i = as->size(); i--;)
+                    ia->a[i] = new AST::IntVar((*as)[i]);
                 (yyval.arg) = ia;
-            } else if (pp->boolvararrays.get((yyvsp[0].sValue), as)) {
-                AST::Array *ia = new AST::Array(as.size());
-                for (int i = as.size(); i--;)
-                    ia->a[i] = new AST::BoolVar(as[i]);
+            } else if ((as = pp->boolvararrays.find((yyvsp[0].sValue)))) {
+                AST::Array *ia = new AST::Array(as->size());
+                for (int i = as->size(); i--;)
+                    ia->a[i] = new AST::BoolVar((*as)[i]);
                 (yyval.arg) = ia;
-            } else if (pp->setvararrays.get((yyvsp[0].sValue), as)) {
-                AST::Array *ia = new AST::Array(as.size());
-                for (int i = as.size(); i--;)
-                    ia->a[i] = new AST::SetVar(as[i]);
+            } else if ((as = pp->setvararrays.find((yyvsp[0].sValue)))) {
+                AST::Array *ia = new AST::Array(as->size());
+                for (int i = as->size(); i--;)
+                    ia->a[i] = new AST::SetVar((*as)[i]);
                 (yyval.arg) = ia;
             } else {
-                std::vector<int> is;
+                const std::vector<int>* is;
                 int ival = 0;
                 bool bval = false;
-                if (pp->intvalarrays.get((yyvsp[0].sValue), is)) {
-                    AST::Array *v = new AST::Array(is.size());
-                    for (int i = is.size(); i--;)
-                        v->a[i] = new AST::IntLit(is[i]);
+                if ((is = pp->intvalarrays.find((yyvsp[0].sValue)))) {
+                    AST::Array *v = new AST::Array(is->size());
+                    for (int i = is->size(); i--;)
+                        v->a[i] = new AST::IntLit((*is)[i]);
                     (yyval.arg) = v;
-                } else if (pp->boolvalarrays.get((yyvsp[0].sValue), is)) {
-                    AST::Array *v = new AST::Array(is.size());
-                    for (int i = is.size(); i--;)
-                        v->a[i] = new AST::BoolLit(is[i]);
+                } else if ((is = pp->boolvalarrays.find((yyvsp[0].sValue)))) {
+                    AST::Array *v = new AST::Array(is->size());
+                    for (int i = is->size(); i--;)
+                        v->a[i] = new AST::BoolLit((*is)[i]);
                     (yyval.arg) = v;
                 } else if (pp->intvals.get((yyvsp[0].sValue), ival)) {
                     (yyval.arg) = new AST::IntLit(ival);
@@ -3486,14 +3432,11 @@ yyreduce:
                     (yyval.arg) = getVarRefArg(pp,(yyvsp[0].sValue),true);
                 }
             }
-            free((yyvsp[0].sValue));
         }
-
     break;
 
-  case 156:
-
-    { 
+  case 157: /* ann_non_array_expr: ID '[' ann_non_array_expr ']'  */
+        { 
             ParserState* pp = static_cast<ParserState*>(parm);
             int i = -1;
             yyassert(pp, (yyvsp[-1].arg)->isInt(i), "Non-integer array index.");
@@ -3501,18 +3444,13 @@ yyreduce:
                 (yyval.arg) = getArrayElement(static_cast<ParserState*>(parm),(yyvsp[-3].sValue),i);
             else
                 (yyval.arg) = new AST::IntLit(0); // keep things consistent
-            free((yyvsp[-3].sValue));
         }
-
     break;
 
-  case 157:
-
-    {
+  case 158: /* ann_non_array_expr: STRING_LIT  */
+        {
             (yyval.arg) = new AST::String((yyvsp[0].sValue));
-            free((yyvsp[0].sValue));
         }
-
     break;
 
 
@@ -3530,25 +3468,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -3559,50 +3495,44 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (parm, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (parm, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -3631,12 +3561,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -3653,13 +3582,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -3673,7 +3603,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, parm);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, parm);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -3685,7 +3615,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3696,26 +3626,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (parm, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -3731,16 +3665,15 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, parm);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, parm);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
+
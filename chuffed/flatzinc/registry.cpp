@@ -590,6 +590,14 @@ namespace FlatZinc {
 			inverse(x, y, ce[1]->getInt(), ce[3]->getInt(), ann2icl(ann));
 		}
 
+		void p_global_cardinality_low_up(const ConExpr& ce, AST::Node* ann) {
+			vec<IntVar*> x; arg2intvarargs(x, ce[0]);
+			vec<int> cover; arg2intargs(cover, ce[1]);
+			vec<int> lb; arg2intargs(lb, ce[2]);
+			vec<int> ub; arg2intargs(ub, ce[3]);
+			global_cardinality(x, cover, lb, ub);
+		}
+
 		void p_table_int(const ConExpr& ce, AST::Node* ann) {
 			vec<IntVar*> x; arg2intvarargs(x, ce[0]);
 			vec<int> tuples; arg2intargs(tuples, ce[1]);
@@ -604,6 +612,8 @@ namespace FlatZinc {
 			}
 			if (ann && (ann->hasAtom("mdd") || ann->hasCall("mdd")))
 				mdd_table(x, ts, getMDDOpts(ann));
+			else if (ann && ann->hasAtom("compact_table"))
+				table_CT(x, ts);
       else
 				table(x, ts);
 		}
@@ -1104,6 +1114,7 @@ namespace FlatZinc {
 
 				registry().add("all_different_int", &p_all_different_int);
 				registry().add("inverse_offsets", &p_inverse_offsets);
+				registry().add("chuffed_global_cardinality_low_up", &p_global_cardinality_low_up);
 				registry().add("table_int", &p_table_int);
 				registry().add("regular", &p_regular);
 				registry().add("cost_regular", &p_cost_regular);
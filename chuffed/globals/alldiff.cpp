@@ -20,13 +20,13 @@ public:
 		new_fixed.reserve(sz);
 		for (int i = 0; i < sz; i++) x[i].attach(this, i, EVENT_F);
 		if (range < sz) TL_FAIL();
-		if (range == sz && so.alldiff_cheat) {
+		if (range == sz && so().alldiff_cheat) {
 			for (int i = 0; i < sz; i++) x[i].getVar()->specialiseToEL();
 			// Add clauses [a_1 = i] \/ [a_2 = i] \/ ... \/ [a_n = i]
 			for (int i = 0; i < range; i++) {
 				vec<Lit> ps(sz);
 				for (int j = 0; j < sz; j++) ps[j] = x[j].getLit(i, 1);
-				sat.addClause(ps);
+				sat().addClause(ps);
 			}
 		}
 	}
@@ -43,7 +43,7 @@ public:
 			int b = x[a].getVal();
  //fprintf(stderr, "var %d == %d:\n", a, b);
 			Clause* r = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				r = Reason_new(2);
 				(*r)[1] = x[a].getValLit();
 			}
@@ -217,7 +217,7 @@ public:
 			if (h[minrank] > minrank) {
 				Clause* r = NULL;
 				int hall_max = bounds[w = pathmax(h, h[minrank])];
-				if (so.lazy) {
+				if (so().lazy) {
 					int hall_min = bounds[minrank];
 					// here both k and hall_min are decreasing, stop when k catches up
 					for (int k = w; bounds[k] > hall_min; --k)
@@ -280,7 +280,7 @@ public:
 			if (h[maxrank] < maxrank) {
 				Clause* r = NULL;
 				int hall_min = bounds[w = pathmin(h, h[maxrank])];
-			if (so.lazy) {
+			if (so().lazy) {
 					int hall_max = bounds[maxrank];
 					// here both k and hall_max are increasing, stop when k catches up
 					for (int k = w; bounds[k] < hall_max; ++k)
@@ -482,7 +482,7 @@ public:
 	bool prune(int node, int i) {
  //fprintf(stderr, "prune var %d val %d\n", node, i);
 		Clause* r = NULL;
-		if (so.lazy) {
+		if (so().lazy) {
 			int vars = 0;
 			int vals = 0;
 			int min_val = INT_MAX;
@@ -604,7 +604,7 @@ void all_different(vec<IntVar*>& x, ConLevel cl) {
 		for (int i = 0; i < x.size(); i++) u.push(IntView<>(x[i],1,-min));
 		if (min == 0) new AllDiffBounds<0>(u, range);
 		else          new AllDiffBounds<4>(u, range);
-		if (!so.alldiff_stage)
+		if (!so().alldiff_stage)
 			return;
 	}
 	else if (cl == CL_DOM) {
@@ -612,7 +612,7 @@ void all_different(vec<IntVar*>& x, ConLevel cl) {
 		for (int i = 0; i < x.size(); i++) u.push(IntView<>(x[i],1,-min));
 		if (min == 0) new AllDiffDomain<0>(u, range);
 		else          new AllDiffDomain<4>(u, range);
-		if (!so.alldiff_stage)
+		if (!so().alldiff_stage)
 			return;
 	}
 	vec<IntView<> > u;
@@ -632,14 +632,14 @@ void all_different_offset(vec<int>& a, vec<IntVar*>& x, ConLevel cl) {
 		vec<IntView<> > u;
 		for (int i = 0; i < x.size(); i++) u.push(IntView<>(x[i],1,a[i]-min));
 		new AllDiffBounds<4>(u, range);
-		if (!so.alldiff_stage)
+		if (!so().alldiff_stage)
 			return;
 	}
 	else if (cl == CL_DOM) {
 		vec<IntView<> > u;
 		for (int i = 0; i < x.size(); i++) u.push(IntView<>(x[i],1,a[i]-min));
 		new AllDiffDomain<4>(u, range);
-		if (!so.alldiff_stage)
+		if (!so().alldiff_stage)
 			return;
 	}
 	vec<IntView<> > u;
@@ -675,8 +675,8 @@ void inverse(vec<IntVar*>& x, vec<IntVar*>& y, int o1, int o2, ConLevel cl) {
 	for (int i = 0; i < y.size(); i++) y[i]->specialiseToEL();
 	for (int i = 0; i < x.size(); i++) {
 		for (int j = 0; j < y.size(); j++) {
-			sat.addClause(x[i]->getLit(o1 + j, 0), y[j]->getLit(o2 + i, 1));
-			sat.addClause(x[i]->getLit(o1 + j, 1), y[j]->getLit(o2 + i, 0));
+			sat().addClause(x[i]->getLit(o1 + j, 0), y[j]->getLit(o2 + i, 1));
+			sat().addClause(x[i]->getLit(o1 + j, 1), y[j]->getLit(o2 + i, 0));
 		}
 	}
 }
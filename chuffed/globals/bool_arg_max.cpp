@@ -25,7 +25,7 @@ public:
     for (int i=0; i<ol-offset; i++) {
       if (x[i].setValNotR(false)) {
         Clause *r = NULL;
-        if (so.lazy) {
+        if (so().lazy) {
           r = Reason_new(2);
           (*r)[1] = y.getFMinLit(ol);
         }
@@ -37,7 +37,7 @@ public:
       int yl = y.getVal()-offset;
       if (x[yl].setValNotR(true)) {
         Clause *r = NULL;
-        if (so.lazy) {
+        if (so().lazy) {
           r = Reason_new(2);
           (*r)[1] = y.getValLit();
         }
@@ -66,7 +66,7 @@ public:
     }
     for (int i=0; i<toFix.size(); i++) {
       Clause *r = NULL;
-      if (so.lazy) {
+      if (so().lazy) {
         r = Reason_new(2);
         (*r)[1] = x[toFix[i]];
       }
@@ -75,7 +75,7 @@ public:
     
     if (y.setMinNotR(l+offset)) {
       Clause *r = NULL;
-      if (so.lazy) {
+      if (so().lazy) {
         r = Reason_new(l+1);
         for (int i = 0; i < l; i++) (*r)[i+1] = x[i];
       }
@@ -83,7 +83,7 @@ public:
     }
     if (y.setMaxNotR(u+offset)) {
       Clause *r = NULL;
-      if (so.lazy) {
+      if (so().lazy) {
         r = Reason_new(2);
         (*r)[1] = ~x[u];
       }
@@ -94,7 +94,7 @@ public:
       int yl = y.getVal()-offset;
       if (x[yl].setValNotR(true)) {
         Clause *r = NULL;
-        if (so.lazy) {
+        if (so().lazy) {
           r = Reason_new(2);
           (*r)[1] = y.getValLit();
         }
@@ -105,7 +105,7 @@ public:
     for (int i=ol-offset; i<nl-offset; i++) {
       if (x[i].setValNotR(false)) {
         Clause *r = NULL;
-        if (so.lazy) {
+        if (so().lazy) {
           r = Reason_new(2);
           (*r)[1] = y.getFMinLit(nl);
         }
@@ -52,18 +52,17 @@ public:
     int *lengthChain;
 
     Circuit(vec<IntView<U> > _x):
-        useCheck(so.circuitalg < 4),
-        usePrevent(so.circuitalg >= 2 && so.circuitalg < 4),
-        useScc(so.circuitalg >= 3),
-        pruneRoot(so.sccoptions >= 3),
+        useCheck(so().circuitalg < 4),
+        usePrevent(so().circuitalg >= 2 && so().circuitalg < 4),
+        useScc(so().circuitalg >= 3),
+        pruneRoot(so().sccoptions >= 3),
         pruneSkip(true),
         fixReq(true),
-        generaliseScc(so.sccoptions == 2 || so.sccoptions == 4),
+        generaliseScc(so().sccoptions == 2 || so().sccoptions == 4),
         size(_x.size()), 
         x(_x.release())
     {   
             
-        srand(so.rnd_seed);
         priority = 5;
         new_fixed.reserve(size);
         prev.reserve(size);
@@ -133,8 +132,8 @@ public:
          if(lengthChain[j0] > 0)
          {
             Clause* r = NULL;
-            if (so.lazy) {
-                if(so.prevexpl == 1)
+            if (so().lazy) {
+                if(so().prevexpl == 1)
                 {
                     r = Reason_new(lengthChain[j0]);
                     int j = j0;
@@ -209,7 +208,7 @@ public:
     
     void addEqLits(Clause *r)
     {
-        if(so.rootSelection == 5 || so.rootSelection == 6)
+        if(so().rootSelection == 5 || so().rootSelection == 6)
         {
             for(int i = 0; i < preRoot.size(); i++)
                 (*r)[i+1] = x[preRoot[i]].getValLit();
@@ -281,7 +280,7 @@ public:
                     for(int i = 0; i < outside.size(); i++)
                         fprintf(stderr, "node %d with index %d\n", outside[i], index[outside[i]]);        */
                     Clause *r = NULL;
-                    if(so.lazy)
+                    if(so().lazy)
                     {
                         r = Reason_new(inside.size() * outside.size()+1+preRoot.size());
                         addEqLits(r);
@@ -323,7 +322,7 @@ public:
                     // should be collected within the propagator class.
                     //engine.prunedSkip++;
                     Clause *r = NULL;
-                    if(so.lazy)
+                    if(so().lazy)
                     {
                         // The reason is that no node in an earlier subtree can
                         // reach the prev or later subtrees, and no node
@@ -356,7 +355,7 @@ public:
             // should be collected within the propagator class.
             //engine.multipleSCC++;
             Clause *r = NULL;
-            if(so.lazy)
+            if(so().lazy)
             {
                 // The reason is that no node in the subtree rooted by this node (including this one) 
                 // reaches a node outside that subtree.  
@@ -424,7 +423,7 @@ public:
         root = -1;
         int len;
         int chosenChain;
-        switch(so.rootSelection)
+        switch(so().rootSelection)
         {
             case 1: // first non-fixed
                 for(int i = 0; i < size; i++)
@@ -436,7 +435,7 @@ public:
                 break;
             case 2: // random non-fixed
                 // has to be one of the chain ends
-                chosenChain = (int) ( ((double)chainEnds.size()) * rand() / (RAND_MAX + 1.0) );
+                chosenChain = engine().randInt(chainEnds.size());
                 //fprintf(stderr, "chose %d\n", chosenChain);
                 root = chainEnds[chosenChain];
                 //fprintf(stderr, "root is %d\n", root);
@@ -497,7 +496,7 @@ public:
                 root = 0;
                 break;
             case 8: // random (even if fixed)
-                root = (int) ( ((double)size) * rand() / (RAND_MAX + 1.0) );
+                root = engine().randInt(size);
                 break;
             case 9: // largest domain
                 len = x[0].size();
@@ -522,7 +521,7 @@ public:
         
         vec<int> thisSubtree;
         
-        if(so.lazy)
+        if(so().lazy)
         {
             thisSubtree.reserve(size);
             prev.clear();
@@ -536,7 +535,7 @@ public:
         index[root] = 0; // first node visited
         lowlink[root] = 0;
         nodesSeen = 1; // only seen root node
-        if(so.rootSelection == 5 || so.rootSelection == 6)
+        if(so().rootSelection == 5 || so().rootSelection == 6)
         {
             preRoot.clear();
             while(x[rootEnd].isFixed())
@@ -571,7 +570,7 @@ public:
                 }
             
                 // Find the nodes in the subtree we just explored and the ones still to be explored
-                if(so.lazy)
+                if(so().lazy)
                 {
                     thisSubtree.clear();
                     later.clear();
@@ -590,7 +589,7 @@ public:
                     // XXX [AS] Commented following line, because propagator related statistics
                     // should be collected within the propagator class.
                     //engine.nobackedge++;
-                    if(so.lazy)
+                    if(so().lazy)
                     {
                         // If prev is empty then this is the first subtree, 
 			// and we just need to say that the nodes in this
@@ -655,7 +654,7 @@ public:
                     // should be collected within the propagator class.
                     //engine.fixedBackedge++;
                     Clause *r = NULL;
-                    if(so.lazy)
+                    if(so().lazy)
                     {
                         // If this is the first subtree, the reason we're setting this link is that 
                         // there is no other link between nodes of this subtree to nodes outside the subtree including the root
@@ -711,7 +710,7 @@ public:
                 }
 
                 // When a new subtree has been explored, update the prev, earlier and later vectors (only necessary if explaining)
-                if(so.lazy)
+                if(so().lazy)
                 {
                     for(int i = 0; i < prev.size(); i++) earlier.push(prev[i]);
                     prev.clear();
@@ -732,7 +731,7 @@ public:
             //engine.disconnected++;
             Clause* r = NULL;
                 
-            if (so.lazy) {
+            if (so().lazy) {
                 // need to say that each seen node doesn't reach any non-seen node
                 // first find the seen and not-seen nodes
                 vec<int> seen;
@@ -764,7 +763,7 @@ public:
         {    
             // Build the reason if neccessary (it will be the same for all of the pruned edges)
             Clause* r = NULL;
-            if(so.lazy)
+            if(so().lazy)
             {
                 // First find the nodes in the last subtree and those in the earlier ones
                 vec<int> lastSubtree;
@@ -837,7 +836,7 @@ public:
         }
         if(useScc)
         {
-            if(so.rootSelection == 10)
+            if(so().rootSelection == 10)
             {
                 // try all roots
                 for(int root = 0; root < size; root++)
@@ -892,7 +891,7 @@ public:
                 // update the score
                 int level;
                 double act;
-                switch(so.checkfailure)
+                switch(so().checkfailure)
                 {
                     case 1: break; // first (no score required)
                     case 2: break; // smallest cycle
@@ -901,27 +900,27 @@ public:
                     case 5: //cycle with highest ave level, 
                         // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                         // Maybe it shoud be replaced by sat.getLevel(.)?
-                        level = sat.trailpos[var(x[nextVar].getValLit())];
+                        level = sat().trailpos[var(x[nextVar].getValLit())];
                         //level = sat.getLevel(var(x[nextVar].getValLit()));
                         thisScore += level;
                         break;
                     case 6: //cycle with lowest ave activity, 
                     case 7: //cycle with highest ave activity
-                        act = sat.activity[var(x[nextVar].getValLit())];
+                        act = sat().activity[var(x[nextVar].getValLit())];
                         thisScore += act;
                         break;
                     case 8: break; // last (no score required)
                     case 9: // highest min level, so need to calculate min level
                         // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                         // Maybe it shoud be replaced by sat.getLevel(.)?
-                        level = sat.trailpos[var(x[nextVar].getValLit())];
+                        level = sat().trailpos[var(x[nextVar].getValLit())];
                         //level = sat.getLevel(var(x[nextVar].getValLit()));
                         if(thisScore > level || noScoreYet) thisScore = level;
                         break;
                     case 10: // lowest max level, so need to calculate max level
                         // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                         // Maybe it shoud be replaced by sat.getLevel(.)?
-                        level = sat.trailpos[var(x[nextVar].getValLit())];
+                        level = sat().trailpos[var(x[nextVar].getValLit())];
                         //level = sat.getLevel(var(x[nextVar].getValLit()));
                         if(thisScore < level || noScoreYet) thisScore = level;
                         break;
@@ -943,7 +942,7 @@ public:
             else if(thisIsCycle)
             {
                 // calculate the score for this cycle (we keep the highest)
-                switch(so.checkfailure)
+                switch(so().checkfailure)
                 {
                     case 1: break; // first cycle (no score required)
                     case 2: thisScore = -1*thisCycle.size(); break; // smallest cycle
@@ -958,12 +957,12 @@ public:
                     case 10: thisScore = -1*thisScore; // lowest max level 
                 } 
                 //fprintf(stderr, "this score is %f\n", thisScore);
-                if(!foundSmallCycle || so.checkfailure == 1 || so.checkfailure == 8 || thisScore > bestScore)
+                if(!foundSmallCycle || so().checkfailure == 1 || so().checkfailure == 8 || thisScore > bestScore)
                 {
                     foundSmallCycle = true;
                     bestScore = thisScore;
                     thisCycle.copyTo(bestCycle);
-                    if(so.checkfailure == 1)
+                    if(so().checkfailure == 1)
                         break;
                 }
             }
@@ -971,7 +970,7 @@ public:
         
         // If we found at least one cycle, report failure
         // if we're not explaining we'll already return false which is fine
-        if(foundSmallCycle && so.lazy)
+        if(foundSmallCycle && so().lazy)
         {
             Clause* r = NULL;
             vec<int> notInCycle;
@@ -980,7 +979,7 @@ public:
                
             // create the reason clause
             int chainLength = bestCycle.size();
-            if(so.checkexpl == 1)
+            if(so().checkexpl == 1)
             {    
                     // equalities
                     r = Reason_new(chainLength);
@@ -989,7 +988,7 @@ public:
                         (*r)[j] = x[bestCycle[j-1]].getValLit();
                     result = x[bestCycle.last()].remVal(bestCycle[0], r);
             }
-            else if(so.checkexpl == 6)
+            else if(so().checkexpl == 6)
             {
                     // inside can't reach out but smaller
                     // find smallest and highest index anything inside the cycle is equal to
@@ -1055,13 +1054,13 @@ public:
 
                     r = Reason_new(bestCycle.size() * notInCycle.size());
                         
-                    if(so.checkexpl == 2) // inside can't reach out
+                    if(so().checkexpl == 2) // inside can't reach out
                         doOutsideIn = false;
-                    else if(so.checkexpl == 3) // outside can't reach in
+                    else if(so().checkexpl == 3) // outside can't reach in
                         doOutsideIn = true;
-                    else if(so.checkexpl == 4) // smaller group can't reach bigger group
+                    else if(so().checkexpl == 4) // smaller group can't reach bigger group
                         doOutsideIn = notInCycle.size() < bestCycle.size();
-                    else if(so.checkexpl == 5) // bigger group can't reach smaller group
+                    else if(so().checkexpl == 5) // bigger group can't reach smaller group
                         doOutsideIn = bestCycle.size() < notInCycle.size();
                     else fprintf(stderr, "Unknown check explanation type\n");
                             
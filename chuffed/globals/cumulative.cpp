@@ -1,7 +1,6 @@
 #include <chuffed/core/propagator.h>
 #include <list>
 #include <queue>
-#include <set>
 #include <iostream>
 
 using namespace std;
@@ -90,21 +89,25 @@ class CumulativeProp : public Propagator {
 	};
 
 	// Resource profile of the resource
+	// The tasks of a profile part are those whose compulsory part covers it.
+	// There are no_tasks of them, and their begin change points all come
+	// before change point change_end, where the part ends.
 	struct ProfilePart {
 		CUMU_INT begin;
 		CUMU_INT end;
 		CUMU_INT level;
-		set<CUMU_INT> tasks;
-		ProfilePart(CUMU_INT b, CUMU_INT e, CUMU_INT l, CUMU_INT t)
-		: begin(b), end(e), level(l) { tasks.insert(t); };
-		ProfilePart() : begin(0), end(0), level(0) {}
+		int change_end;
+		int no_tasks;
+		ProfilePart() : begin(0), end(0), level(0), change_end(0), no_tasks(0) {}
 	};
 
 	enum ProfileChange { PROFINC, PROFDEC };
 	struct ProfileChangePt {
 		CUMU_INT time;
 		ProfileChange change;
-		ProfileChangePt(CUMU_INT t, ProfileChange c) : time(t), change(c) {}
+		CUMU_INT task;
+		ProfileChangePt(CUMU_INT t, ProfileChange c, CUMU_INT i) : time(t), change(c), task(i) {}
+		ProfileChangePt() : time(INT_MAX), change(PROFINC), task(0) {}
 	};
 
 	Tint last_unfixed;
@@ -146,6 +149,17 @@ public:
 	int * new_lct;
 	int tt_profile_size;
 	struct ProfilePart * tt_profile;
+	// Compulsory parts [tt_comp_begin[i], tt_comp_end[i]) of the tasks, INT_MAX
+	// if none, and their change points sorted in chronological order. Change
+	// point 2 * i + c of task i, c = 0 for the begin and 1 for the end, is at
+	// position tt_change_pos[2 * i + c]. Both persist between calls, as only
+	// the unfixed tasks need updating.
+	int * tt_comp_begin;
+	int * tt_comp_end;
+	struct ProfileChangePt * tt_changes;
+	int * tt_change_pos;
+	int tt_change_moves;	// Positions moved while updating, -1 if a full sort is due
+	int * tt_part_tasks;	// Tasks of the profile part being explained
 
 	// Inline functions
 	struct SortEstAsc {
@@ -193,6 +207,21 @@ public:
 		// Allocation of the memory
 		tt_profile = new ProfilePart[2 * start.size()];
 		tt_profile_size = 0;
+		tt_comp_begin = new int[start.size()];
+		tt_comp_end = new int[start.size()];
+		tt_changes = new ProfileChangePt[2 * start.size()];
+		tt_change_pos = new int[2 * start.size()];
+		tt_part_tasks = new int[start.size()];
+		for (int i = 0; i < start.size(); i++) {
+			tt_comp_begin[i] = INT_MAX;
+			tt_comp_end[i] = INT_MAX;
+			// Ends before begins at equal times
+			tt_changes[i] = ProfileChangePt(INT_MAX, PROFDEC, i);
+			tt_change_pos[2 * i + 1] = i;
+			tt_changes[start.size() + i] = ProfileChangePt(INT_MAX, PROFINC, i);
+			tt_change_pos[2 * i] = start.size() + i;
+		}
+		tt_change_moves = 0;
 		// XXX Check for successful memory allocation
 		if (ttef_check || ttef_filt) {
 			task_id_est  = (int *) malloc(start.size() * sizeof(int));
@@ -211,6 +240,9 @@ public:
 			task_id_est  = NULL;
 			task_id_lct  = NULL;
 			tt_after_est = NULL;
+			tt_after_lct = NULL;
+			new_est = NULL;
+			new_lct = NULL;
 		}
 		
 		// Priority of the propagator
@@ -234,6 +266,21 @@ public:
 		}
 		last_unfixed = start.size() - 1;
 	}
+
+	~CumulativeProp() {
+		delete[] tt_profile;
+		delete[] tt_comp_begin;
+		delete[] tt_comp_end;
+		delete[] tt_changes;
+		delete[] tt_change_pos;
+		delete[] tt_part_tasks;
+		free(task_id_est);
+		free(task_id_lct);
+		free(tt_after_est);
+		free(tt_after_lct);
+		free(new_est);
+		free(new_lct);
+	}
 	
     // Statistics
 	void printStats() {
@@ -314,6 +361,8 @@ public:
 		for (int ii = new_unfixed; ii >= 0; ii--) {
 			int i = task_id[ii];
 			if ((CUMU_PT_ISFIXED(start[i]) && CUMU_PT_ISFIXED(dur[i]) && CUMU_PT_ISFIXED(usage[i])) || max_dur(i) <= 0 || max_usage(i) <= 0) {
+				// Final update of the compulsory part
+				update_comp_part(i);
 				// Swaping the id's
 				task_id[ii] = task_id[new_unfixed];
 				task_id[new_unfixed] = i;
@@ -406,42 +455,73 @@ public:
 	// and propagator
 	CUMU_BOOL
 	time_table_propagation(CUMU_ARR_INT & task) {
-		list<ProfileChangePt> changes;
-		list<CUMU_INT> comp_task;
-		//int size_profile = 0;
-
-#if CUMUVERB>10
-		fprintf(stderr, "\tCompulsory Parts ...\n");
-#endif
-		get_compulsory_parts2(changes, comp_task, task, 0, task.size());
-		// Proceed if there are compulsory parts
-		if (!changes.empty()) {
-#if CUMUVERB>1
-			fprintf(stderr, "\tSorting (size %d)...\n", (int) changes.size());
-#endif
-			// Sorting the start and end points of all the profile
-			changes.sort(compare_ProfileChangePt);
-#if CUMUVERB>1
-			fprintf(stderr, "\tSorting (size %d)...\n", (int) changes.size());
-#endif
-			// Counting the number of different profiles
-			tt_profile_size = count_profile(changes);
-#if CUMUVERB>1
-			fprintf(stderr, "\t#profile parts = %d\n", tt_profile_size);
-#endif
-#if CUMUVERB>1
-			fprintf(stderr, "\tProfile Parts ...\n");
+		// Updating the compulsory parts of the unfixed tasks
+		for (int ii = 0; ii <= last_unfixed; ii++) {
+			update_comp_part(task[ii]);
+		}
+		if (tt_change_moves < 0) {
+			sort_changes();
+		}
+		tt_change_moves = 0;
+		// Sweeping over the change points to create the profile parts
+		tt_profile_size = 0;
+		int i_max_usage = 0;
+		int active = 0;
+		CUMU_INT level = 0;
+		for (int k = 0; k < 2 * start.size() && tt_changes[k].time < INT_MAX; k++) {
+			ProfileChangePt & pt = tt_changes[k];
+			if (active > 0 && tt_changes[k - 1].time < pt.time) {
+				ProfilePart & part = tt_profile[tt_profile_size];
+				part.begin = tt_changes[k - 1].time;
+				part.end = pt.time;
+				part.level = level;
+				part.change_end = k;
+				part.no_tasks = active;
+				// Checking if the profile part is the part with the maximal level
+				if (part.level > tt_profile[i_max_usage].level) {
+					i_max_usage = tt_profile_size;
+				}
+				tt_profile_size++;
+				// Time-table consistency check
+				if (part.level > max_limit()) {
+#if CUMUVERB > 20
+					fprintf(stderr, "\t\t\tResource overload (%d > %d) in profile part %d\n", part.level, max_limit(), tt_profile_size - 1);
 #endif
-			// Creating the different profile parts
-			create_profile(changes);
-			int i_max_usage = 0;
+                    // Increment the inconsistency counter
+                    nb_tt_incons++;
+
+					// The resource is overloaded in this part
+					vec<Lit> expl;
+					if (so().lazy) {
+						CUMU_INT lift_usage = part.level - max_limit() - 1;
+						CUMU_INT begin1, end1;
+						// TODO Different choices to pick the interval
+						// Pointwise explanation
+						begin1 = part.begin + ((part.end - part.begin) / 2);
+						end1 = begin1 + 1;
+						// Generation of the explanation
+						analyse_limit_and_tasks(
+							expl, part, lift_usage, begin1, end1
+						);
+					}
+					// Submitting of the conflict explanation
+					submit_conflict_explanation(expl);
+					return false;
+				}
+			}
+			if (pt.change == PROFINC) {
+				active++;
+				level += min_usage(pt.task);
+			} else {
+				active--;
+				level -= min_usage(pt.task);
+			}
+		}
 #if CUMUVERB>1
-			fprintf(stderr, "\tFilling of Profile Parts ...\n");
+		fprintf(stderr, "\t#profile parts = %d\n", tt_profile_size);
 #endif
-			// Filling the profile parts with tasks
-			if (!fill_in_profile_parts(tt_profile, tt_profile_size, comp_task, i_max_usage)) {
-				return false;
-			}
+		// Proceed if there are compulsory parts
+		if (tt_profile_size > 0) {
 #if CUMUVERB>10
 			fprintf(stderr, "\tFiltering Resource Limit ...\n");
 #endif
@@ -465,182 +545,71 @@ public:
 		return true;
 	}
 
-	void
-	get_compulsory_parts2(
-		list<ProfileChangePt> &changes, list<CUMU_INT> &comp_task, CUMU_ARR_INT & task, 
-		CUMU_INT i_start, CUMU_INT i_end
-	);
-
-	// Sets for each profile part its begin and end time in chronological order
-	// Runtime complexity: O(n)
+	// Sets the compulsory part of task i from its current bounds
 	//
 	void
-	create_profile(list<ProfileChangePt> &changes) {
-		list<ProfileChangePt>::iterator iter = changes.begin();
-		int cur_profile = 0;
-		int cur_time = iter->time;
-		ProfileChange cur_change = iter->change;
-		int no_starts = 1;
-		for (; iter != changes.end(); iter++) {
-			if (iter->time > cur_time && no_starts > 1) {
-#if CUMUVERB>20
-				fprintf(stderr, "Set times for profile part %d = [%d, %d)\n", cur_profile, cur_time, iter->time);
-				fprintf(stderr, "\t%p; %p; %d\n", tt_profile, this, start.size());
-#endif
-				set_times_for_profile(cur_profile, cur_time, iter->time);
-				cur_profile++;
-			}
-			no_starts += (iter->change == PROFINC ? 1 : -1);
-			cur_change = iter->change;
-			cur_time = iter->time;
+	update_comp_part(CUMU_INT i) {
+		CUMU_INT begin = INT_MAX;
+		CUMU_INT end = INT_MAX;
+		if (min_dur(i) > 0 && min_usage(i) > 0 && lst(i) < ect(i)) {
+			begin = lst(i);
+			end = ect(i);
 		}
-	}
-	
-	inline void
-	set_times_for_profile(int i, CUMU_INT begin, CUMU_INT end) {
-		tt_profile[i].begin = begin;
-		tt_profile[i].end = end;
-		tt_profile[i].level = 0;
-		//fprintf(stderr, "blxxx %d\n", (int) tt_profile[i].tasks.size());
-		tt_profile[i].tasks.clear();
-	}
-
-	// Filling the profile parts with compulsory parts and checking for a resource
-	// overload
-	CUMU_BOOL
-	fill_in_profile_parts(ProfilePart * profile, int size, list<CUMU_INT> comp_task, int & i_max_usage) {
-		list<CUMU_INT>::iterator iter;
-		int i = 0;
-		CUMU_INT lst_i, ect_i;
-		
-#if CUMUVERB>2
-		fprintf(stderr, "\t\tstart filling profiles (size %d)\n", size);
-#endif
-		for (iter = comp_task.begin(); iter != comp_task.end(); iter++) {
-#if CUMUVERB>2
-			fprintf(stderr, "\t\tcomp part = %d\n", *iter);
-#endif
-			lst_i = lst(*iter);
-			ect_i = ect(*iter);
-#if CUMUVERB>2
-			fprintf(stderr, "\t\tFinding first profile part\n");
-#endif
-			// Find first profile
-			i = find_first_profile(profile, 0, size - 1, lst_i);
-#if CUMUVERB>2
-			fprintf(stderr, "\t\tAdding comp parts of level %d\n", min_usage(*iter));
-#endif
-			// Add compulsory part to the profile
-			while (i < size && profile[i].begin < ect_i) {
-#if CUMUVERB>2
-				fprintf(stderr, "\t\t\tAdding comp parts in profile part %d\n", i);
-#endif
-				profile[i].level += min_usage(*iter);
-				profile[i].tasks.insert(*iter);
-				// Checking if the profile part i is the part with the maximal level
-				//
-				if (profile[i].level > profile[i_max_usage].level) {
-					i_max_usage = i;
-				}
-				// Time-table consistency check
-				//
-				if (profile[i].level > max_limit()) {
-#if CUMUVERB > 20
-					fprintf(stderr, "\t\t\tResource overload (%d > %d) in profile part %d\n", profile[i].level, max_limit(), i);
-#endif
-                    // Increment the inconsistency counter
-                    nb_tt_incons++;
-
-					// The resource is overloaded in this part
-					vec<Lit> expl;
-					if (so.lazy) {
-						CUMU_INT lift_usage = profile[i].level - max_limit() - 1;
-						CUMU_INT begin1, end1;
-						// TODO Different choices to pick the interval
-						// Pointwise explanation
-						begin1 = profile[i].begin + ((profile[i].end - profile[i].begin) / 2);
-						end1 = begin1 + 1;
-						// Generation of the explanation
-						analyse_limit_and_tasks(
-							expl, profile[i].tasks, lift_usage, begin1, end1
-						);
-					}
-					// Submitting of the conflict explanation
-					submit_conflict_explanation(expl);
-#if CUMUVERB > 20
-					fprintf(stderr, "\t\tend filling (conflict)\n");
-#endif
-					return false;
-				}
-				i++;
-			}
+		if (begin != tt_comp_begin[i]) {
+			tt_comp_begin[i] = begin;
+			move_change(2 * i, begin);
+		}
+		if (end != tt_comp_end[i]) {
+			tt_comp_end[i] = end;
+			move_change(2 * i + 1, end);
 		}
-#if CUMUVERB>2
-		fprintf(stderr, "\t\tend filling (successful)\n");
-#endif
-		return true;
 	}
 
-	// Finds the profile part that begins at the time unit "lst"
-	// Complexity: O(log(high - low + 1))
+	// Moves a change point to its new time, keeping the others in order. The
+	// moves are counted, and once they exceed a few passes over the change
+	// points a full sort takes over.
+	// Runtime complexity: O(distance moved)
 	//
-	int
-	find_first_profile(ProfilePart * profile, int low, int high, CUMU_INT lst) {
-		int median = 0;
-		while (profile[low].begin != lst) {
-			median = low + (high - low + 1) / 2;
-			if (profile[median].begin > lst) {
-				high = median;
-			} else {
-				low = median;
-			}
+	void
+	move_change(int c, CUMU_INT time) {
+		int k = tt_change_pos[c];
+		tt_changes[k].time = time;
+		if (tt_change_moves < 0) {
+			return;
 		}
-		return low;
+		ProfileChangePt pt = tt_changes[k];
+		const int k_old = k;
+		for (; k > 0 && compare_ProfileChangePt(pt, tt_changes[k - 1]); k--) {
+			set_change(k, tt_changes[k - 1]);
+		}
+		for (; k < 2 * start.size() - 1 && compare_ProfileChangePt(tt_changes[k + 1], pt); k++) {
+			set_change(k, tt_changes[k + 1]);
+		}
+		set_change(k, pt);
+		tt_change_moves += abs(k - k_old);
+		if (tt_change_moves > 8 * start.size()) {
+			tt_change_moves = -1;
+		}
+	}
+
+	inline void
+	set_change(int k, const ProfileChangePt & pt) {
+		tt_changes[k] = pt;
+		tt_change_pos[2 * pt.task + (pt.change == PROFDEC ? 1 : 0)] = k;
 	}
 
-	// Counting the number of profiles
+	// Runtime complexity: O(n log n)
 	//
-	int
-	count_profile(list<ProfileChangePt> &changes) {
-		list<ProfileChangePt>::iterator iter = changes.begin();
-		int cur_time = iter->time;
-		int next_time;
-		ProfileChange cur_change = iter->change;
-		int no_starts = ( iter->change == PROFINC ? 1 : 0 );
-		int no_profile = no_starts;
-		iter++;
-
-#if CUMUVERB>2
-		fprintf( stderr, "\t\t\ttime = %d; change = %d; no_starts = %d; no_profile = %d;\n", cur_time, cur_change, no_starts, no_profile);
-#endif
-		for (; iter != changes.end(); iter++) {
-			if (iter->change == PROFINC) {
-				if (cur_time < iter->time || cur_change == PROFDEC) {
-					no_profile++;
-				}
-				no_starts++;
-			} else {
-				// ASSUMPTION
-				// - iter->change = PROFDEC
-				no_starts--;
-				next_time = iter->time;
-				iter++;
-				if (iter != changes.end() && no_starts > 0 && iter->time > next_time) {
-					no_profile++;
-				}
-				iter--;
-			}
-			cur_time = iter->time;
-			cur_change = iter->change;
-#if CUMUVERB>2
-			fprintf( stderr, "\t\t\ttime = %d; change = %d; no_starts = %d; no_profile = %d;\n", cur_time, cur_change, no_starts, no_profile);
-#endif
+	void
+	sort_changes() {
+		sort(tt_changes, tt_changes + 2 * start.size(), compare_ProfileChangePt);
+		for (int k = 0; k < 2 * start.size(); k++) {
+			set_change(k, tt_changes[k]);
 		}
-		return no_profile;
 	}
 
 	static bool
-	compare_ProfileChangePt(ProfileChangePt & pt1, ProfileChangePt & pt2) {
+	compare_ProfileChangePt(const ProfileChangePt & pt1, const ProfileChangePt & pt2) {
 		if (pt1.time == pt2.time && pt1.change == PROFDEC && pt2.change == PROFINC) return true;
 		return pt1.time < pt2.time;
 	}
@@ -674,9 +643,9 @@ public:
 	// Explanation is created for the time interval [begin, end), i.e., exluding end.
 	//
 	void
-	analyse_limit_and_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end);
+	analyse_limit_and_tasks(vec<Lit> & expl, ProfilePart & part, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end);
 	void
-	analyse_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end);
+	analyse_tasks(vec<Lit> & expl, ProfilePart & part, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end);
 	void
 	submit_conflict_explanation(vec<Lit> & expl);
 	Clause *
@@ -755,40 +724,6 @@ public:
 	}
 };
 
-/****
- * Functions related to the Time-Table Consistency Check and Propagation
- ****/
-
-void
-CumulativeProp::get_compulsory_parts2(
-	list<ProfileChangePt> &changes, list<CUMU_INT> &comp_task, CUMU_ARR_INT & task, CUMU_INT i_start, CUMU_INT i_end
-) {
-	CUMU_INT i;
-#if CUMUVERB>2
-	fprintf(stderr, "\tstart get_compulsory_part from %d to %d\n", i_start, i_end);
-#endif
-	for (i = i_start; i < i_end; i++) {
-#if CUMUVERB>2
-		fprintf(stderr, "\t\ti = %d; task[i] = %d\n", i, task[i]);
-#endif
-		// Check whether the task creates a compulsory part
-		if (min_dur(task[i]) > 0 && min_usage(task[i]) > 0 && lst(task[i]) < ect(task[i])) {
-#if CUMUVERB>2
-			fprintf(stderr, "\t\ttask[i] = %d, comp part [%d, %d)\n", task[i], lst(task[i]), ect(task[i]));
-#endif
-			// Add task to the list
-			comp_task.push_back(task[i]);
-			// Add time points to change lists
-			changes.push_back( ProfileChangePt(lst(task[i]), PROFINC) );
-			changes.push_back( ProfileChangePt(ect(task[i]), PROFDEC) );
-		}
-	}
-#if CUMUVERB>2
-	fprintf(stderr, "\tend get_compulsory_part\n");
-#endif
-}
-
-
 /***************************************************************************************
  * Function for time-table filtering on the lower bound of the resource limit variable *
  ***************************************************************************************/
@@ -798,14 +733,14 @@ CumulativeProp::filter_limit(ProfilePart * profile, int & i) {
 	if (min_limit() < profile[i].level) {
 		Clause * reason = NULL;
         nb_tt_filt++;
-		if (so.lazy) {
+		if (so().lazy) {
 			// Lower bound can be updated
 			// XXX Determining what time period is the best
 			int expl_begin = profile[i].begin + ((profile[i].end - profile[i].begin - 1)/2);
 			int expl_end = expl_begin + 1;
 			vec<Lit> expl;
 			// Get the negated literals for the tasks in the profile
-			analyse_tasks(expl, profile[i].tasks, 0, expl_begin, expl_end);
+			analyse_tasks(expl, profile[i], 0, expl_begin, expl_end);
 			// Transform literals to a clause
 			reason = get_reason_for_update(expl);
 		}
@@ -898,7 +833,7 @@ CumulativeProp::time_table_filtering_lb(ProfilePart profile[], int low, int high
 #endif
 			int expl_end = profile[i].end;
 			Clause * reason = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				// XXX Assumption for the remaining if-statement
 				//   No compulsory part of task in profile[i]!
 				int lift_usage = profile[i].level + min_usage(task) - max_limit() - 1;
@@ -919,7 +854,7 @@ CumulativeProp::time_table_filtering_lb(ProfilePart profile[], int low, int high
                 if (min_usage0(task) < min_usage(task)) 
                     expl.push(getNegGeqLit(usage[task], min_usage(task)));
 				// Get the negated literals for the tasks in the profile and the resource limit
-				analyse_limit_and_tasks(expl, profile[i].tasks, lift_usage, expl_begin, expl_end);
+				analyse_limit_and_tasks(expl, profile[i], lift_usage, expl_begin, expl_end);
 #if CUMUVERB>1
 				fprintf(stderr, " -> start[%d] => %d\n", task, expl_end);
 #endif
@@ -971,7 +906,7 @@ CumulativeProp::time_table_filtering_ub(ProfilePart profile[], int low, int high
 			}
 			int expl_begin = profile[i].begin;
 			Clause * reason = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				// ASSUMPTION for the remaining if-statement
 				// - No compulsory part of task in profile[i]
 				int lift_usage = profile[i].level + min_usage(task) - max_limit() - 1;
@@ -989,7 +924,7 @@ CumulativeProp::time_table_filtering_ub(ProfilePart profile[], int low, int high
                 if (min_usage0(task) < min_usage(task)) 
                     expl.push(getNegGeqLit(usage[task], min_usage(task)));
 				// Get the negated literals for the tasks in the profile and the resource limit
-				analyse_limit_and_tasks(expl, profile[i].tasks, lift_usage, expl_begin, expl_end);
+				analyse_limit_and_tasks(expl, profile[i], lift_usage, expl_begin, expl_end);
 				// Transform literals to a clause
 				reason = get_reason_for_update(expl);
 			}
@@ -1034,7 +969,7 @@ CumulativeProp::tt_optional_task_propagation() {
                 // Tasks cannot be performed on this resource
 
                 Clause * reason = NULL;
-                if (so.lazy) {
+                if (so().lazy) {
                     // Explanation for the propagation required
 				    vec<Lit> expl;
 
@@ -1059,7 +994,7 @@ CumulativeProp::tt_optional_task_propagation() {
                         expl.push(getNegGeqLit(usage[i], min_usage(i)));
 
 				    // Get the negated literals for the tasks in the profile and the resource limit
-				    analyse_limit_and_tasks(expl, tt_profile[index].tasks, lift_usage, expl_begin, expl_end);
+				    analyse_limit_and_tasks(expl, tt_profile[index], lift_usage, expl_begin, expl_end);
 				    // Transform literals to a clause
 				    reason = get_reason_for_update(expl);
                 }
@@ -1155,7 +1090,7 @@ CumulativeProp::find_first_profile_for_ub(ProfilePart profile[], int low, int hi
  ************************************************************************/
 
 void
-CumulativeProp::analyse_limit_and_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end) {
+CumulativeProp::analyse_limit_and_tasks(vec<Lit> & expl, ProfilePart & part, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end) {
 	CUMU_INT diff_limit = max_limit0() - max_limit();
 	if (diff_limit > 0) {
 		// Lifting of limit variable if possible
@@ -1171,47 +1106,58 @@ CumulativeProp::analyse_limit_and_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks,
 			expl.push(getNegLeqLit(limit, max_limit() + lift_usage));
 		}
 	}
-	analyse_tasks(expl, tasks, lift_usage, begin, end);
+	analyse_tasks(expl, part, lift_usage, begin, end);
 }
 
 void
-CumulativeProp::analyse_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end) {
-	set<CUMU_INT>::iterator iter;
-	for (iter = tasks.begin(); iter != tasks.end(); iter++) {
+CumulativeProp::analyse_tasks(vec<Lit> & expl, ProfilePart & part, CUMU_INT lift_usage, CUMU_INT begin, CUMU_INT end) {
+	// Collecting the tasks of the profile part, whose compulsory parts begin
+	// before it and end after it, by going back from its end
+	int no_tasks = 0;
+	for (int k = part.change_end - 1; no_tasks < part.no_tasks; k--) {
+		const CUMU_INT i = tt_changes[k].task;
+		if (tt_changes[k].change == PROFINC && tt_change_pos[2 * i + 1] >= part.change_end) {
+			tt_part_tasks[no_tasks++] = i;
+		}
+	}
+	// The tasks are lifted in the order of their indices
+	sort(tt_part_tasks, tt_part_tasks + no_tasks);
+	for (int ii = 0; ii < no_tasks; ii++) {
+		const CUMU_INT i = tt_part_tasks[ii];
 #if CUMUVERB > 10
-		fprintf(stderr, "\ns[%d] in [%d..%d]\n", *iter, start[*iter]->getMin(), start[*iter]->getMax());
+		fprintf(stderr, "\ns[%d] in [%d..%d]\n", i, start[i]->getMin(), start[i]->getMax());
 #endif
-		if (min_usage(*iter) <= lift_usage) {
+		if (min_usage(i) <= lift_usage) {
 			// Task is not relevant for the resource overload
-			lift_usage -= min_usage(*iter);
+			lift_usage -= min_usage(i);
 		} else {
 			// Task is relevant for the resource overload
-			if (min_start0(*iter) + min_dur(*iter) <= end) {
+			if (min_start0(i) + min_dur(i) <= end) {
 				// Lower bound of the start time variable matters
-				// Get explanation for [[start[*iter] >= end - min_dur(*iter)]]
+				// Get explanation for [[start[i] >= end - min_dur(i)]]
 #if CUMUVERB > 10
-				fprintf(stderr, "/\\ start[%d] => %d ", *iter, end - min_dur(*iter));
+				fprintf(stderr, "/\\ start[%d] => %d ", i, end - min_dur(i));
 #endif
-				expl.push(getNegGeqLit(start[*iter], end - min_dur(*iter)));
+				expl.push(getNegGeqLit(start[i], end - min_dur(i)));
 			}
-			if (begin < max_start0(*iter)) {
+			if (begin < max_start0(i)) {
 				// Upper bound of the start time variable matters
-				// Get explanation for [[start[*iter] <= begin]]
+				// Get explanation for [[start[i] <= begin]]
 #if CUMUVERB > 10
-				fprintf(stderr, "/\\ start[%d] <= %d ", *iter, begin);
+				fprintf(stderr, "/\\ start[%d] <= %d ", i, begin);
 #endif
-				expl.push(getNegLeqLit(start[*iter], begin));
+				expl.push(getNegLeqLit(start[i], begin));
 			}
-            // Get the negated literal for [[dur[*iter] >= min_dur(*iter)]]
-            if (min_dur0(*iter) < min_dur(*iter)) 
-                expl.push(getNegGeqLit(dur[*iter], min_dur(*iter)));
-            // Get the negated literal for [[usage[*iter] >= min_usage(*iter)]]
-            const CUMU_INT usage_diff = min_usage(*iter) - min_usage0(*iter);
+            // Get the negated literal for [[dur[i] >= min_dur(i)]]
+            if (min_dur0(i) < min_dur(i)) 
+                expl.push(getNegGeqLit(dur[i], min_dur(i)));
+            // Get the negated literal for [[usage[i] >= min_usage(i)]]
+            const CUMU_INT usage_diff = min_usage(i) - min_usage0(i);
             if (usage_diff > 0) { 
                 if (usage_diff <= lift_usage)
                     lift_usage -= usage_diff;
                 else
-                    expl.push(getNegGeqLit(usage[*iter], min_usage(*iter)));
+                    expl.push(getNegGeqLit(usage[i], min_usage(i)));
             }
 		}
 	}
@@ -1220,12 +1166,12 @@ CumulativeProp::analyse_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks, CUMU_INT l
 void
 CumulativeProp::submit_conflict_explanation(vec<Lit> & expl) {
 	Clause * reason = NULL;
-	if (so.lazy) {
+	if (so().lazy) {
 		reason = Reason_new(expl.size());
 		int i = 0;
 		for (; i < expl.size(); i++) { (*reason)[i] = expl[i]; }
 	}
-	sat.confl = reason;
+	sat().confl = reason;
 }
 
 Clause *
@@ -1252,7 +1198,7 @@ void cumulative(vec<IntVar*>& s, vec<int>& d, vec<int>& r, int limit, std::list<
 	// - s, d, and r contain the same number of elements
 	
     // Option switch
-    if (so.cumu_global) {
+    if (so().cumu_global) {
         vec<IntVar*> s_new, d_new, r_new;
 		IntVar * vlimit = newIntVar(limit, limit);
         int r_sum = 0;
@@ -1449,7 +1395,7 @@ CumulativeProp::ttef_consistency_check(
 		vec<Lit> expl;
         // Increment the inconsistency counter
         nb_ttef_incons++;
-		if (so.lazy) {
+		if (so().lazy) {
 			list<TaskDur> tasks_tw;
 			list<TaskDur> tasks_cp;
 			int en_req1 = 0;
@@ -1628,7 +1574,7 @@ CumulativeProp::ttef_bounds_propagation_lb(
 		vec<Lit> expl;
         // Increment the inconsistency counter
         nb_ttef_incons++;
-		if (so.lazy) {
+		if (so().lazy) {
 			list<TaskDur> tasks_tw;
 			list<TaskDur> tasks_cp;
 			int en_req1 = 0;
@@ -1773,7 +1719,7 @@ CumulativeProp::ttef_bounds_propagation_ub(
 		vec<Lit> expl;
         // Increment the inconsistency counter
         nb_ttef_incons++;
-		if (so.lazy) {
+		if (so().lazy) {
 			list<TaskDur> tasks_tw;
 			list<TaskDur> tasks_cp;
 			int en_req1 = 0;
@@ -1807,7 +1753,7 @@ CumulativeProp::ttef_update_bounds(
 		if (queue_update.front().is_lb_update) {
 			// Lower bound update
 			if (new_est[task] == bound) {
-				if (so.lazy) {
+				if (so().lazy) {
 					vec<Lit> expl;
 					list<TaskDur> tasks_tw;
 					list<TaskDur> tasks_cp;
@@ -1870,7 +1816,7 @@ CumulativeProp::ttef_update_bounds(
 		} else {
 			// Upper bound update
 			if (new_lct[task] == bound) {
-				if (so.lazy) {
+				if (so().lazy) {
 					vec<Lit> expl;
 					list<TaskDur> tasks_tw;
 					list<TaskDur> tasks_cp;
@@ -928,7 +928,7 @@ public:
 
 					// The resource is overloaded in this part
 					vec<Lit> expl;
-					if (so.lazy) {
+					if (so().lazy) {
 						CUMU_INT lift_usage = profile[i].level - max_limit() - 1;
 						CUMU_INT begin1, end1;
 						// TODO Different choices to pick the interval
@@ -1137,7 +1137,7 @@ CumulativeCalProp::filter_limit(ProfilePart * profile, int & i) {
 	if (min_limit() < profile[i].level) {
 		Clause * reason = NULL;
         nb_tt_filt++;
-		if (so.lazy) {
+		if (so().lazy) {
 			// Lower bound can be updated
 			// XXX Determining what time period is the best
 			int expl_begin = profile[i].begin + ((profile[i].end - profile[i].begin - 1)/2);
@@ -1237,7 +1237,7 @@ CumulativeCalProp::time_table_filtering_lb(ProfilePart profile[], int low, int h
 #endif
 			int expl_end = profile[i].end;
 			Clause * reason = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				// XXX Assumption for the remaining if-statement
 				//   No compulsory part of task in profile[i]!
 				int lift_usage = profile[i].level + min_usage(task) - max_limit() - 1;
@@ -1318,7 +1318,7 @@ CumulativeCalProp::time_table_filtering_ub(ProfilePart profile[], int low, int h
 
 			int expl_begin = profile[i].begin;
 			Clause * reason = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				// ASSUMPTION for the remaining if-statement
 				// - No compulsory part of task in profile[i]
 				int lift_usage = profile[i].level + min_usage(task) - max_limit() - 1;
@@ -1510,12 +1510,12 @@ CumulativeCalProp::analyse_tasks(vec<Lit> & expl, set<CUMU_INT> & tasks, CUMU_IN
 void
 CumulativeCalProp::submit_conflict_explanation(vec<Lit> & expl) {
 	Clause * reason = NULL;
-	if (so.lazy) {
+	if (so().lazy) {
 		reason = Reason_new(expl.size());
 		int i = 0;
 		for (; i < expl.size(); i++) { (*reason)[i] = expl[i]; }
 	}
-	sat.confl = reason;
+	sat().confl = reason;
 }
 
 Clause *
@@ -1747,7 +1747,7 @@ CumulativeCalProp::ttef_consistency_check(
 		vec<Lit> expl;
         // Increment the inconsistency counter
         nb_ttef_incons++;
-		if (so.lazy) {
+		if (so().lazy) {
 #if CUMUVERB > 0
 		fprintf(stderr, "Entering TTEF Inconsistent\n");
 #endif
@@ -1995,7 +1995,7 @@ CumulativeCalProp::ttef_bounds_propagation_lb(
 		vec<Lit> expl;
         // Increment the inconsistency counter
         nb_ttef_incons++;
-		if (so.lazy) {
+		if (so().lazy) {
 			list<TaskDur> tasks_tw;
 			list<TaskDur> tasks_cp;
 			int en_req1 = 0;
@@ -2203,7 +2203,7 @@ CumulativeCalProp::ttef_bounds_propagation_ub(
 		vec<Lit> expl;
         // Increment the inconsistency counter
         nb_ttef_incons++;
-		if (so.lazy) {
+		if (so().lazy) {
 			list<TaskDur> tasks_tw;
 			list<TaskDur> tasks_cp;
 			int en_req1 = 0;
@@ -2606,7 +2606,7 @@ CumulativeCalProp::ttef_update_bounds(
 		if (queue_update.front().is_lb_update) {
 			// Lower bound update
 			if (new_est[task] == bound) {
-				if (so.lazy) {
+				if (so().lazy) {
 					vec<Lit> expl;
 					ttef_explanation_for_update_lb(shift_in, begin, end, task, bound, expl);
 					reason = get_reason_for_update(expl);
@@ -2626,7 +2626,7 @@ CumulativeCalProp::ttef_update_bounds(
 		} else {
 			// Upper bound update
 			if (new_lct[task] == bound) {
-				if (so.lazy) {
+				if (so().lazy) {
 					vec<Lit> expl;
 					ttef_explanation_for_update_ub(shift_in, begin, end, task, bound, expl);
 					reason = get_reason_for_update(expl);
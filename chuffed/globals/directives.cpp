@@ -1,7 +1,7 @@
 #include <chuffed/core/propagator.h>
 
 void output_var(Branching *v) {
-	engine.outputs.push(v);
+	engine().outputs.push(v);
 }
 
 void output_vars(vec<Branching*>& v) {
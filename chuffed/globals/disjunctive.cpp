@@ -4,6 +4,25 @@
 
 using namespace std;
 
+// Sorts the task order by comp. The order is kept between calls and the
+// bounds change little in between, so insertion sort is near linear; it
+// gives way to a full sort when the order has moved too far.
+template <class Comp>
+static void resort(int *order, int n, Comp comp) {
+	int moves = 0;
+	for (int i = 1; i < n; i++) {
+		int t = order[i];
+		int j = i;
+		for ( ; j > 0 && comp(t, order[j-1]); j--) order[j] = order[j-1];
+		order[j] = t;
+		moves += i - j;
+		if (moves > 8 * n) {
+			sort(order, order + n, comp);
+			return;
+		}
+	}
+}
+
 // propagates bounds given precedences
 class DisjunctiveBP : public Propagator {
 
@@ -44,7 +63,7 @@ public:
 
 	Reason createReason(int var, int est) {
 		if (!trailed_pinfo_sz) {
-			engine.trail.push(TrailElem(&p_info._size(), 4));
+			engine().trail.push(TrailElem(&p_info._size(), 4));
 			trailed_pinfo_sz = true;
 		}
 		p_info.push(Pinfo(var, est));
@@ -66,7 +85,7 @@ public:
 				b += dur[j];
 			}
 			if (x[i]->setMinNotR(b)) {
-				if (engine.decisionLevel() == 0) {
+				if (engine().decisionLevel() == 0) {
 					fprintf(stderr, "%% prop_id = %d, var_id = %d, i = %d, b = %d\n", prop_id, x[i]->var_id, i, b);
 				}
 				if (!x[i]->setMin(b, createReason(i, e))) return false;
@@ -114,7 +133,7 @@ public:
 		}
 //		fprintf(stderr, "\n");
 //		fprintf(stderr, "lb = %d, inf_lb = %d\n", lb, (sat.c_info[var(p)].v>>2)+1);
-		assert(lb > sat.c_info[var(p)].val);
+		assert(lb > sat().c_info[var(p)].val);
 
 /*
 		for (int i = 0; i < x.size(); i++) {
@@ -127,9 +146,7 @@ public:
 */
 
 
-		Clause *expl = Clause_new(ps);
-		expl->temp_expl = 1;
-		sat.rtrail.last().push(expl);
+		Clause *expl = Reason_new(ps);
 
 		if (DISJ_DEBUG) fprintf(stderr, "BP explain: length %d\n", expl->size());
 
@@ -175,6 +192,10 @@ public:
 	int *ests;                                        // task no. sorted according to est in ascending order
 	int *lets;                                        // task no. sorted according to let in descending order
 
+	// Intermediate state
+	vec<bool> in;                                     // tasks of the set an inference is explained by
+	vec<Lit> ps;
+
 
 	// Inline functions
 
@@ -206,8 +227,11 @@ public:
 	} sort_let_dsc;
 
 
-	DisjunctiveEF(vec<IntVar*>& _x, vec<int>& _dur) : x(_x), dur(_dur),
-		sort_est_asc(this), sort_est_dsc(this), sort_let_asc(this), sort_let_dsc(this) {
+	Heap<SortLetAsc> pqueue;                          // tasks available in the pre-emptive schedule
+
+	DisjunctiveEF(vec<IntVar*>& _x, vec<int>& _dur) : x(_x), dur(_dur), in(x.size()),
+		sort_est_asc(this), sort_est_dsc(this), sort_let_asc(this), sort_let_dsc(this),
+		pqueue(sort_let_asc) {
 		// set priority
 		priority = 3;
 
@@ -274,7 +298,7 @@ public:
 
 	Reason createReason(int ps_i, int var, int let) {
 		if (!trailed_pinfo_sz) {
-			engine.trail.push(TrailElem(&p_info._size(), 4));
+			engine().trail.push(TrailElem(&p_info._size(), 4));
 			trailed_pinfo_sz = true;
 		}
 		p_info.push(Pinfo(ps_i, var, let));
@@ -294,7 +318,7 @@ public:
 		int next_lb = 0;
 		int lets_comp = x.size();
 
-		Heap<SortLetAsc> pqueue(sort_let_asc);
+		pqueue.clear();
 
 //		fprintf(stderr, "Forming schedule\n");
 
@@ -376,8 +400,6 @@ public:
 
 	void explainFailure(int task, int ps_i) {
 		// find set which forced the precedence
-	  //		bool in[x.size()];
-		bool* in = new bool[x.size()];
 		int set_est = est(task);
 /*
 		for (int i = 0; i < x.size(); i++) {
@@ -416,7 +438,7 @@ public:
 		fprintf(stderr, "\n");
 */
 		// create explanation
-		vec<Lit> ps;
+		ps.clear();
 
 		// can lift!
 		for (int i = 0; i < x.size(); i++) {
@@ -434,13 +456,10 @@ public:
 		}
 */
 
-		Clause *expl = Clause_new(ps);
-		expl->temp_expl = 1;
-		sat.rtrail.last().push(expl);
-		sat.confl = expl;
+		Clause *expl = Reason_new(ps);
+		sat().confl = expl;
 
 		if (DISJ_DEBUG) fprintf(stderr, "EF fail: length %d\n", expl->size());
-		delete[] in;
 
 	}
 
@@ -448,12 +467,12 @@ public:
 		trailed_pinfo_sz = false;
 
 		// sort vars based on est and let
-		sort(ests, ests + x.size(), sort_est_asc);
-		sort(lets, lets + x.size(), sort_let_dsc);
+		resort(ests, x.size(), sort_est_asc);
+		resort(lets, x.size(), sort_let_dsc);
 
 //		if (!findBasicPrecedences()) return false;
-		if (so.disj_edge_find && !doEdgeFinding()) return false;
-		if (so.disj_set_bp && !bp->propagate()) return false;
+		if (so().disj_edge_find && !doEdgeFinding()) return false;
+		if (so().disj_set_bp && !bp->propagate()) return false;
 
 		return true;
 	}
@@ -464,8 +483,6 @@ public:
 		if (pi.expl != NULL) return pi.expl;
 
 		// find set which forced the precedence
-		//		bool in[x.size()];
-		bool* in = new bool[x.size()];
 		int ps_i = pi.ps_i;
 		int set_est = ps_times[ps_i];
 
@@ -519,7 +536,8 @@ public:
 
 
 		// create explanation
-		vec<Lit> ps(1);
+		ps.clear();
+		ps.push();
 
 		// can lift!
 		ps.push(x[pi.var]->getMinLit());
@@ -538,23 +556,504 @@ public:
 		}
 */
 
-		Clause *expl = Clause_new(ps);
-		expl->temp_expl = 1;
-		sat.rtrail.last().push(expl);
+		Clause *expl = Reason_new(ps);
 
 		pi.expl = expl;
 
 		if (DISJ_DEBUG) fprintf(stderr, "EF explain: length %d\n", expl->size());
 
-		delete[] in;
+		return expl;
+	}
+
+
+};
+
+
+// Theta-Lambda tree over tasks placed at the leaves in order of est (Vilim).
+// Theta is the set of white tasks, Lambda the set of gray ones.
+class ThetaLambdaTree {
+	static const int NEG = INT_MIN / 4;
+
+	struct Node {
+		int sum_p;                                     // processing time of Theta
+		int ect;                                       // earliest completion time of Theta
+		int sum_p_bar;                                 // processing time of Theta and at most one gray task
+		int ect_bar;                                   // earliest completion time of Theta and at most one gray task
+		int resp_p;                                    // gray task responsible for sum_p_bar, or -1
+		int resp_ect;                                  // gray task responsible for ect_bar, or -1
+	};
+
+	int leaves;
+	vec<Node> nodes;
+
+	void combine(int n) {
+		Node& l = nodes[2*n];
+		Node& r = nodes[2*n+1];
+		Node& t = nodes[n];
+		t.sum_p = l.sum_p + r.sum_p;
+		t.ect = max(r.ect, l.ect + r.sum_p);
+		if (l.sum_p_bar + r.sum_p >= l.sum_p + r.sum_p_bar) {
+			t.sum_p_bar = l.sum_p_bar + r.sum_p;
+			t.resp_p = l.resp_p;
+		} else {
+			t.sum_p_bar = l.sum_p + r.sum_p_bar;
+			t.resp_p = r.resp_p;
+		}
+		t.ect_bar = r.ect_bar;
+		t.resp_ect = r.resp_ect;
+		if (l.ect + r.sum_p_bar > t.ect_bar) {
+			t.ect_bar = l.ect + r.sum_p_bar;
+			t.resp_ect = r.resp_p;
+		}
+		if (l.ect_bar + r.sum_p > t.ect_bar) {
+			t.ect_bar = l.ect_bar + r.sum_p;
+			t.resp_ect = l.resp_ect;
+		}
+	}
+
+public:
+	ThetaLambdaTree(int n) : leaves(1) {
+		while (leaves < n) leaves *= 2;
+		nodes.growTo(2 * leaves);
+		for (int i = 0; i < leaves; i++) setEmpty(i);
+		build();
+	}
+
+	// Leaf setters, followed by update() for the leaf or build() for the tree
+	void setWhite(int pos, int est, int p) {
+		Node& n = nodes[leaves + pos];
+		n.sum_p = n.sum_p_bar = p;
+		n.ect = n.ect_bar = est + p;
+		n.resp_p = n.resp_ect = -1;
+	}
+	void setGray(int pos, int est, int p, int task) {
+		Node& n = nodes[leaves + pos];
+		n.sum_p = 0;
+		n.ect = NEG;
+		n.sum_p_bar = p;
+		n.ect_bar = est + p;
+		n.resp_p = n.resp_ect = task;
+	}
+	void setEmpty(int pos) {
+		Node& n = nodes[leaves + pos];
+		n.sum_p = n.sum_p_bar = 0;
+		n.ect = n.ect_bar = NEG;
+		n.resp_p = n.resp_ect = -1;
+	}
+
+	void update(int pos) { for (int n = (leaves + pos) / 2; n >= 1; n /= 2) combine(n); }
+	void build() { for (int n = leaves - 1; n >= 1; n--) combine(n); }
+
+	int ect() const { return nodes[1].ect; }
+	int ectBar() const { return nodes[1].ect_bar; }
+	int respEct() const { return nodes[1].resp_ect; }
+};
+
+// Bounds propagation on the start times with Theta-Lambda trees (Vilim):
+// overload checking, detectable precedences, not-last and edge finding in
+// O(n log n). Every rule is run on the tasks as they are and mirrored in
+// time, which gives the upper bound rules and not-first. No precedence
+// literals are made; an inference is explained from the time window it used,
+// by every task now inside the window, which covers the tasks used then.
+class DisjunctiveTL : public Propagator {
+	enum Rule { DP, EF, NL };
+
+	// structure to store propagation info for lazy explanation
+	struct Pinfo {
+		int rule;
+		bool mirror;                                   // made on the tasks mirrored in time
+		int task;                                      // task whose bound changed
+		int bound;                                     // new est (DP, EF) or lct (NL) of the task
+		int lct;                                       // lct of the set which forced the bound (EF)
+		Pinfo(int r, bool m, int t, int b, int l) : rule(r), mirror(m), task(t), bound(b), lct(l) {}
+	};
+
+	bool trailed_pinfo_sz;
+
+public:
+	// constant data
+	vec<IntVar*> x;                                   // start times
+	vec<int> dur;                                     // durations of tasks
+
+	// Persistent non-trailed state, task orders for each view
+	vec<int> by_est[2], by_lct[2], by_lst[2], by_ect[2];
+
+	vec<Pinfo> p_info;                                // memory for propagation info
+
+	// Intermediate state, bounds in the current view
+	bool mirror;
+	vec<int> est, lct, lst, ect;
+	vec<int> new_est, new_lct;
+	vec<int> est_rule, est_lct;
+	vec<int> pos;                                     // leaf of each task
+	vec<bool> in_tree;
+	ThetaLambdaTree tree;
+	vec<int> cand;
+	vec<int> lo;                                      // lower bounds in an explanation
+	vec<Lit> ps;
+
+	struct SortBy {
+		vec<int>& key;
+		bool operator() (int i, int j) { return key[i] < key[j]; }
+		SortBy(vec<int>& k) : key(k) {}
+	};
+
+	struct SortEstDsc {
+		DisjunctiveTL *p;
+		bool operator() (int i, int j) { return p->est[i] > p->est[j]; }
+		SortEstDsc(DisjunctiveTL *_p) : p(_p) {}
+	} sort_est_dsc;
+
+	DisjunctiveTL(vec<IntVar*>& _x, vec<int>& _dur) : x(_x), dur(_dur),
+		est(x.size()), lct(x.size()), lst(x.size()), ect(x.size()),
+		new_est(x.size()), new_lct(x.size()), est_rule(x.size()), est_lct(x.size()),
+		pos(x.size()), in_tree(x.size()), tree(x.size()), lo(x.size()), sort_est_dsc(this) {
+		// set priority
+		priority = 3;
+
+		for (int v = 0; v < 2; v++) {
+			for (int i = 0; i < x.size(); i++) {
+				by_est[v].push(i);
+				by_lct[v].push(i);
+				by_lst[v].push(i);
+				by_ect[v].push(i);
+			}
+		}
+
+		// attach to var events
+		for (int i = 0; i < x.size(); i++) x[i]->attach(this, i, EVENT_LU);
+	}
+
+	// Bounds of the tasks, mirrored in time if m
+	void setView(bool m) {
+		mirror = m;
+		for (int i = 0; i < x.size(); i++) {
+			if (mirror) {
+				est[i] = -(x[i]->getMax() + dur[i]);
+				lct[i] = -x[i]->getMin();
+			} else {
+				est[i] = x[i]->getMin();
+				lct[i] = x[i]->getMax() + dur[i];
+			}
+			lst[i] = lct[i] - dur[i];
+			ect[i] = est[i] + dur[i];
+		}
+	}
+
+	// False literals of [s >= v] and [s <= v] for the start s of task i in the view
+	static Lit negGeq(IntVar *v, int val) {
+		return (v->getType() == INT_VAR_LL ? v->getMinLit() : v->getLit(val - 1, 3));
+	}
+	static Lit negLeq(IntVar *v, int val) {
+		return (v->getType() == INT_VAR_LL ? v->getMaxLit() : v->getLit(val + 1, 2));
+	}
+	Lit viewGeq(int i, int v) { return mirror ? negLeq(x[i], -v - dur[i]) : negGeq(x[i], v); }
+	Lit viewLeq(int i, int v) { return mirror ? negGeq(x[i], -v - dur[i]) : negLeq(x[i], v); }
+
+	Reason createReason(int rule, int task, int bound, int set_lct) {
+		if (!trailed_pinfo_sz) {
+			engine().trail.push(TrailElem(&p_info._size(), 4));
+			trailed_pinfo_sz = true;
+		}
+		p_info.push(Pinfo(rule, mirror, task, bound, set_lct));
+		return Reason(prop_id, p_info.size()-1);
+	}
+
+	bool propagate() {
+		trailed_pinfo_sz = false;
+
+		for (bool changed = true; changed; ) {
+			changed = false;
+			if (!propagateView(false, changed)) return false;
+			if (!propagateView(true, changed)) return false;
+		}
+
+		return true;
+	}
+
+	bool propagateView(bool m, bool& changed) {
+		setView(m);
+		int v = mirror;
+		resort((int*) by_est[v], x.size(), SortBy(est));
+		resort((int*) by_lct[v], x.size(), SortBy(lct));
+		resort((int*) by_lst[v], x.size(), SortBy(lst));
+		resort((int*) by_ect[v], x.size(), SortBy(ect));
+		for (int r = 0; r < x.size(); r++) pos[by_est[v][r]] = r;
+
+		for (int i = 0; i < x.size(); i++) {
+			new_est[i] = est[i];
+			new_lct[i] = lct[i];
+		}
+
+		if (!edgeFinding()) return false;
+		detectablePrecedences();
+		notLast();
+
+		for (int i = 0; i < x.size(); i++) {
+			if (new_est[i] > est[i]) {
+				// [s_i >= new_est] in the view
+				int b = new_est[i];
+				bool real_min = !mirror;
+				int val = mirror ? -b - dur[i] : b;
+				if (real_min ? x[i]->setMinNotR(val) : x[i]->setMaxNotR(val)) {
+					Reason r = NULL;
+					if (so().lazy) r = createReason(est_rule[i], i, b, est_lct[i]);
+					if (real_min ? !x[i]->setMin(val, r) : !x[i]->setMax(val, r)) return false;
+					changed = true;
+				}
+			}
+			if (new_lct[i] < lct[i]) {
+				// [s_i <= new_lct - dur] in the view
+				int b = new_lct[i];
+				bool real_min = mirror;
+				int val = mirror ? -b : b - dur[i];
+				if (real_min ? x[i]->setMinNotR(val) : x[i]->setMaxNotR(val)) {
+					Reason r = NULL;
+					if (so().lazy) r = createReason(NL, i, b, 0);
+					if (real_min ? !x[i]->setMin(val, r) : !x[i]->setMax(val, r)) return false;
+					changed = true;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Overload checking and edge finding, Theta losing tasks by descending lct
+	bool edgeFinding() {
+		int *order = by_est[mirror];
+		for (int r = 0; r < x.size(); r++) tree.setWhite(r, est[order[r]], dur[order[r]]);
+		tree.build();
+
+		int *lcts = by_lct[mirror];
+		for (int q = x.size() - 1; q >= 0; q--) {
+			int j = lcts[q];
+			int set_lct = lct[j];
+			if (tree.ect() > set_lct) {
+				explainOverload(set_lct);
+				return false;
+			}
+			while (tree.ectBar() > set_lct) {
+				// The gray task must come after all of Theta
+				int i = tree.respEct();
+				if (i < 0) break;
+				if (tree.ect() > new_est[i]) {
+					new_est[i] = tree.ect();
+					est_rule[i] = EF;
+					est_lct[i] = set_lct;
+				}
+				tree.setEmpty(pos[i]);
+				tree.update(pos[i]);
+			}
+			tree.setGray(pos[j], est[j], dur[j], j);
+			tree.update(pos[j]);
+		}
+
+		return true;
+	}
+
+	// Task i comes after each task j with lst(j) < ect(i)
+	void detectablePrecedences() {
+		for (int r = 0; r < x.size(); r++) tree.setEmpty(r);
+		tree.build();
+		for (int i = 0; i < x.size(); i++) in_tree[i] = false;
+
+		int *lsts = by_lst[mirror];
+		int *ects = by_ect[mirror];
+		int k = 0;
+		for (int q = 0; q < x.size(); q++) {
+			int i = ects[q];
+			for ( ; k < x.size() && ect[i] > lst[lsts[k]]; k++) {
+				int j = lsts[k];
+				tree.setWhite(pos[j], est[j], dur[j]);
+				tree.update(pos[j]);
+				in_tree[j] = true;
+			}
+			if (in_tree[i]) {
+				tree.setEmpty(pos[i]);
+				tree.update(pos[i]);
+			}
+			if (tree.ect() > new_est[i]) {
+				new_est[i] = tree.ect();
+				est_rule[i] = DP;
+			}
+			if (in_tree[i]) {
+				tree.setWhite(pos[i], est[i], dur[i]);
+				tree.update(pos[i]);
+			}
+		}
+	}
+
+	// Task i cannot come after every task j with lst(j) < lct(i), so it ends
+	// by the last of their starts
+	void notLast() {
+		for (int r = 0; r < x.size(); r++) tree.setEmpty(r);
+		tree.build();
+		for (int i = 0; i < x.size(); i++) in_tree[i] = false;
+
+		int *lsts = by_lst[mirror];
+		int *lcts = by_lct[mirror];
+		int k = 0, last = -1, prev = -1;
+		for (int q = 0; q < x.size(); q++) {
+			int i = lcts[q];
+			for ( ; k < x.size() && lct[i] > lst[lsts[k]]; k++) {
+				int j = lsts[k];
+				tree.setWhite(pos[j], est[j], dur[j]);
+				tree.update(pos[j]);
+				in_tree[j] = true;
+				prev = last;
+				last = j;
+			}
+			if (in_tree[i]) {
+				tree.setEmpty(pos[i]);
+				tree.update(pos[i]);
+			}
+			int m = (last == i ? prev : last);
+			if (m >= 0 && tree.ect() > lst[i] && lst[m] < new_lct[i]) new_lct[i] = lst[m];
+			if (in_tree[i]) {
+				tree.setWhite(pos[i], est[i], dur[i]);
+				tree.update(pos[i]);
+			}
+		}
+	}
+
+	// Takes the candidate tasks by descending est until the ones taken,
+	// starting at their least est, end after the given time. Returns how many
+	// were taken and their total duration in p.
+	int takeUntilEnd(int time, int& p) {
+		sort((int*) cand, (int*) cand + cand.size(), sort_est_dsc);
+		int k = 0;
+		p = 0;
+		while (k < cand.size()) {
+			p += dur[cand[k++]];
+			if (est[cand[k-1]] + p > time) break;
+		}
+		assert(est[cand[k-1]] + p > time);
+		return k;
+	}
+
+	void explainOverload(int set_lct) {
+		if (!so().lazy) return;
+		cand.clear();
+		for (int j = 0; j < x.size(); j++) {
+			if (lct[j] <= set_lct) cand.push(j);
+		}
+		int p;
+		int k = takeUntilEnd(set_lct, p);
+
+		// can lift!
+		ps.clear();
+		for (int q = 0; q < k; q++) {
+			int j = cand[q];
+			ps.push(viewGeq(j, set_lct - p + 1));
+			ps.push(viewLeq(j, set_lct - dur[j]));
+		}
+		sat().confl = Reason_new(ps);
+
+		if (DISJ_DEBUG) fprintf(stderr, "TL fail: length %d\n", sat().confl->size());
+	}
+
+	Clause* explain(Lit p, int inf_id) {
+		Pinfo& pi = p_info[inf_id];
+		setView(pi.mirror);
+
+		ps.clear();
+		ps.push();
+		switch (pi.rule) {
+			case EF: explainEdgeFinding(pi.task, pi.bound, pi.lct); break;
+			case DP: explainPrecedences(pi.task, pi.bound); break;
+			case NL: explainNotLast(pi.task, pi.bound); break;
+			default: NEVER;
+		}
+
+		Clause *expl = Reason_new(ps);
+
+		if (DISJ_DEBUG) fprintf(stderr, "TL explain: length %d\n", expl->size());
 
 		return expl;
 	}
 
+	// Task i ends after set_lct as it overloads the window with the tasks
+	// inside it, so it follows all of them, which take until bound
+	void explainEdgeFinding(int i, int bound, int set_lct) {
+		cand.clear();
+		for (int j = 0; j < x.size(); j++) {
+			if (j != i && lct[j] <= set_lct) cand.push(j);
+		}
+		sort((int*) cand, (int*) cand + cand.size(), sort_est_dsc);
+
+		// tasks which overload the window with i
+		int k = 0, p = dur[i];
+		while (min(est[i], k ? est[cand[k-1]] : INT_MAX) + p <= set_lct) {
+			assert(k < cand.size());
+			p += dur[cand[k++]];
+		}
+		int ov_est = set_lct - p + 1;
+
+		// tasks which take until bound
+		int b = 0, bp = 0;
+		do {
+			bp += dur[cand[b++]];
+		} while (b < cand.size() && est[cand[b-1]] + bp < bound);
+		assert(est[cand[b-1]] + bp >= bound);
+		int b_est = bound - bp;
+
+		// can lift!
+		ps.push(viewGeq(i, ov_est));
+		for (int q = 0; q < max(k, b); q++) {
+			int j = cand[q];
+			int l = INT_MIN;
+			if (q < k) l = ov_est;
+			if (q < b) l = max(l, b_est);
+			ps.push(viewGeq(j, l));
+			ps.push(viewLeq(j, set_lct - dur[j]));
+		}
+	}
+
+	// Tasks starting before i ends come before it and take until bound
+	void explainPrecedences(int i, int bound) {
+		cand.clear();
+		for (int j = 0; j < x.size(); j++) {
+			if (j != i && lst[j] < ect[i]) cand.push(j);
+		}
+		int p;
+		int k = takeUntilEnd(bound - 1, p);
+		int max_lst = INT_MIN;
+		for (int q = 0; q < k; q++) max_lst = max(max_lst, lst[cand[q]]);
+
+		// can lift!
+		ps.push(viewGeq(i, max_lst - dur[i] + 1));
+		for (int q = 0; q < k; q++) {
+			int j = cand[q];
+			ps.push(viewGeq(j, bound - p));
+			ps.push(viewLeq(j, max_lst));
+		}
+	}
+
+	// Tasks starting by bound - dur[i] end after i has to start, so i comes
+	// before one of them
+	void explainNotLast(int i, int bound) {
+		int max_lst = bound;
+		cand.clear();
+		for (int j = 0; j < x.size(); j++) {
+			if (j != i && lst[j] <= max_lst) cand.push(j);
+		}
+		int p;
+		int k = takeUntilEnd(lst[i], p);
+		int set_est = est[cand[k-1]];
+
+		ps.push(viewLeq(i, set_est + p - 1));
+		for (int q = 0; q < k; q++) {
+			int j = cand[q];
+			ps.push(viewGeq(j, set_est));
+			ps.push(viewLeq(j, max_lst));
+		}
+	}
 
 };
 
 
 void disjunctive(vec<IntVar*>& x, vec<int>& dur) {
-	new DisjunctiveEF(x, dur);
+	if (so().disj_theta_lambda) new DisjunctiveTL(x, dur);
+	else new DisjunctiveEF(x, dur);
 }
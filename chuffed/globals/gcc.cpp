@@ -0,0 +1,370 @@
+#include <chuffed/core/propagator.h>
+
+// Global cardinality with fixed bounds:
+// lb[k] <= #{i | x[i] = cover[k]} <= ub[k] for all k, other values are free
+//
+// The upper bounds are propagated to domain consistency with a flow in which
+// every variable is assigned to one of its values, cover value k taking at
+// most ub[k] variables and the values outside the cover, lumped into a single
+// node, any number. As in AllDiffDomain, a value is pruned from a variable
+// when its strongly connected component in the residual graph is full and
+// cannot pass a variable on: the variables of the component then have no
+// other values and use up all of its capacity. The lower bounds are propagated
+// by counting, a value that only lb[k] variables can take being forced on them.
+
+class GlobalCardinality : public Propagator, public Checker {
+	struct Node {
+		int index;
+		int scc;                    // root of the SCC, -1 while stacked
+		int next;                   // stack, then list of the SCC members
+		bool mark;
+		bool leak;                  // reaches a value with spare capacity
+	};
+
+public:
+	int const sz;
+	int const nv;                   // cover values, value node nv stands for the rest
+	IntVar** const x;
+	int* const cover;
+	int* const lb;
+	int* const ub;
+
+	// Cover index of each value in [vmin, vmin + val_index.size())
+	int vmin;
+	vec<int> val_index;
+
+	// Persistent state, the flow is kept and repaired between calls
+	vec<int> match;                 // value node a var is assigned to, or -1
+	vec<int> load;                  // vars assigned to each value node
+	vec<int> cap;
+	vec<int> first;                 // vars assigned to each value node as linked lists
+	vec<int> link;
+
+	// Intermediate state
+	vec<int> poss;                  // vars that can take each cover value
+	vec<int> fixed;                 // vars fixed to each cover value
+	vec<bool> other;                // var can take a value outside the cover
+	vec<int> queue;
+	vec<int> val_from;              // var an augmenting search reached the value node from
+	vec<bool> var_seen;
+	vec<Node> nodes;                // var nodes, then value nodes
+	vec<Clause*> scc_expl;
+	vec<bool> in_set;
+	int index;
+	int stack;
+	vec<Lit> ps;
+
+	GlobalCardinality(vec<IntVar*>& _x, vec<int>& _cover, vec<int>& _lb, vec<int>& _ub) :
+		sz(_x.size()), nv(_cover.size()), x(_x.release()),
+		cover(_cover.release()), lb(_lb.release()), ub(_ub.release())
+	{
+		priority = 4;
+
+		// Grown rather than sized in the initialisers, growTo skips a
+		// negative size where the constructors would pass it to malloc
+		match.growTo(sz, -1); link.growTo(sz, -1);
+		other.growTo(sz); var_seen.growTo(sz);
+		poss.growTo(nv); fixed.growTo(nv);
+		load.growTo(nv + 1, 0); cap.growTo(nv + 1); first.growTo(nv + 1, -1);
+		val_from.growTo(nv + 1); in_set.growTo(nv + 1, false);
+		nodes.growTo(sz + nv + 1); scc_expl.growTo(sz + nv + 1);
+
+		int lb_sum = 0;
+		vmin = INT_MAX;
+		int vmax = INT_MIN;
+		for (int k = 0; k < nv; k++) {
+			if (lb[k] > ub[k]) TL_FAIL();
+			lb_sum += lb[k];
+			cap[k] = std::min(ub[k], sz);
+			vmin = std::min(vmin, cover[k]);
+			vmax = std::max(vmax, cover[k]);
+		}
+		if (lb_sum > sz) TL_FAIL();
+		cap[nv] = sz;
+		if (nv > 0) val_index.growTo(vmax + 1 - vmin, -1);
+		for (int k = 0; k < nv; k++) val_index[cover[k] - vmin] = k;
+
+		for (int i = 0; i < sz; i++) x[i]->attach(this, i, EVENT_C);
+	}
+
+	int valIndex(int v) const {
+		v -= vmin;
+		return (v < 0 || v >= val_index.size()) ? -1 : val_index[v];
+	}
+
+	bool canTake(int i, int k) const {
+		return k < nv ? x[i]->indomain(cover[k]) : other[i];
+	}
+
+	// Move var i to value node k, -1 to leave it unassigned
+	void assign(int i, int k) {
+		int old = match[i];
+		if (old >= 0) {
+			int *j = &first[old];
+			while (*j != i) j = &link[*j];
+			*j = link[i];
+			load[old]--;
+		}
+		match[i] = k;
+		if (k >= 0) {
+			link[i] = first[k];
+			first[k] = i;
+			load[k]++;
+		}
+	}
+
+	bool propagate() {
+		for (bool changed = true; changed; ) {
+			changed = false;
+			if (!propagateLower(changed)) return false;
+			if (!changed && !propagateUpper(changed)) return false;
+		}
+		return true;
+	}
+
+	bool propagateLower(bool& changed) {
+		for (int k = 0; k < nv; k++) poss[k] = fixed[k] = 0;
+		for (int i = 0; i < sz; i++) {
+			IntVar *v = x[i];
+			other[i] = false;
+			if (v->getMax() - v->getMin() < nv) {
+				for (IntVar::iterator it = v->begin(); it != v->end(); ++it) {
+					int k = valIndex(*it);
+					if (k < 0) other[i] = true;
+					else poss[k]++;
+				}
+			} else {
+				int in_cover = 0;
+				for (int k = 0; k < nv; k++) {
+					if (v->indomain(cover[k])) { poss[k]++; in_cover++; }
+				}
+				other[i] = in_cover < v->size();
+			}
+			if (v->isFixed()) {
+				int k = valIndex(v->getVal());
+				if (k >= 0) fixed[k]++;
+			}
+		}
+
+		for (int k = 0; k < nv; k++) {
+			if (poss[k] > lb[k] || fixed[k] == lb[k]) continue;
+			int val = cover[k];
+			if (poss[k] < lb[k]) {
+				// Too few vars are left for the value
+				ps.clear();
+				for (int i = 0; i < sz; i++) {
+					if (!x[i]->indomain(val)) ps.push(x[i]->getLit(val, 1));
+				}
+				sat().confl = Reason_new(ps);
+				return false;
+			}
+			for (int i = 0; i < sz; i++) {
+				if (!x[i]->indomain(val) || x[i]->isFixed()) continue;
+				Reason r = NULL;
+				if (so().lazy) r = Reason(prop_id, k);
+				if (!x[i]->setVal(val, r)) return false;
+				changed = true;
+			}
+		}
+
+		return true;
+	}
+
+	bool propagateUpper(bool& changed) {
+		// Repair the flow
+		for (int i = 0; i < sz; i++) {
+			if (match[i] >= 0 && !canTake(i, match[i])) assign(i, -1);
+		}
+		for (int i = 0; i < sz; i++) {
+			if (match[i] < 0 && !augment(i)) return false;
+		}
+
+		index = 0;
+		stack = -1;
+		for (int n = 0; n < nodes.size(); n++) {
+			nodes[n].mark = false;
+			scc_expl[n] = NULL;
+		}
+		for (int i = 0; i < sz; i++) {
+			if (!nodes[i].mark && !tarjan(i, changed)) return false;
+		}
+
+		return true;
+	}
+
+	// Breadth first search for a value node with spare capacity
+	bool augment(int r) {
+		for (int k = 0; k <= nv; k++) val_from[k] = -1;
+		for (int i = 0; i < sz; i++) var_seen[i] = false;
+		queue.clear();
+		queue.push(r);
+		var_seen[r] = true;
+		for (int q = 0; q < queue.size(); q++) {
+			int i = queue[q];
+			for (int k = 0; k <= nv; k++) {
+				if (k == match[i] || val_from[k] >= 0 || !canTake(i, k)) continue;
+				val_from[k] = i;
+				if (load[k] < cap[k]) {
+					// Shift the vars along the path
+					while (true) {
+						int prev = match[i];
+						assign(i, k);
+						if (prev < 0) break;
+						k = prev;
+						i = val_from[k];
+					}
+					return true;
+				}
+				for (int j = first[k]; j >= 0; j = link[j]) {
+					if (var_seen[j]) continue;
+					var_seen[j] = true;
+					queue.push(j);
+				}
+			}
+		}
+
+		// The vars searched have more members than their values have room for
+		ps.clear();
+		for (int k = 0; k < nv; k++) in_set[k] = val_from[k] >= 0;
+		for (int q = 0; q < queue.size(); q++) explainDomain(queue[q]);
+		for (int k = 0; k < nv; k++) in_set[k] = false;
+		sat().confl = Reason_new(ps);
+		return false;
+	}
+
+	bool tarjan(int n, bool& changed) {
+		int index_save = index++;
+		nodes[n].mark = true;
+		nodes[n].index = index_save;
+		nodes[n].next = stack;
+		stack = n;
+		nodes[n].scc = -1;
+		nodes[n].leak = false;
+
+		if (n < sz) {
+			// Var node, edges to the values it can take
+			for (int k = 0; k <= nv; k++) {
+				if (!canTake(n, k)) continue;
+				int w = sz + k;
+				if (!nodes[w].mark && !tarjan(w, changed)) return false;
+				if (nodes[w].scc < 0) {
+					nodes[n].index = std::min(nodes[n].index, nodes[w].index);
+				} else if (!nodes[w].leak) {
+					if (!prune(n, k)) return false;
+					changed = true;
+					continue;
+				}
+				nodes[n].leak |= nodes[w].leak;
+			}
+		} else {
+			// Value node, edges to the vars assigned to it
+			int k = n - sz;
+			if (k == nv || load[k] < cap[k]) nodes[n].leak = true;
+			for (int j = first[k]; j >= 0; j = link[j]) {
+				if (!nodes[j].mark && !tarjan(j, changed)) return false;
+				if (nodes[j].scc < 0) nodes[n].index = std::min(nodes[n].index, nodes[j].index);
+				nodes[n].leak |= nodes[j].leak;
+			}
+		}
+
+		if (nodes[n].index >= index_save) {
+			// n is the root of an SCC
+			bool leak = nodes[n].leak;
+			int scc = stack;
+			stack = nodes[n].next;
+			nodes[n].next = -1;
+			for (int i = scc; i >= 0; i = nodes[i].next) {
+				nodes[i].leak = leak;
+				nodes[i].scc = scc;
+			}
+		}
+		return true;
+	}
+
+	bool prune(int i, int k) {
+		Clause* r = NULL;
+		if (so().lazy) {
+			int scc = nodes[sz + k].scc;
+			if (scc_expl[scc] == NULL) {
+				// The vars of the SCC have no values outside it
+				ps.clear();
+				ps.push();
+				for (int n = scc; n >= 0; n = nodes[n].next) {
+					if (n >= sz) in_set[n - sz] = true;
+				}
+				for (int n = scc; n >= 0; n = nodes[n].next) {
+					if (n < sz) explainDomain(n);
+				}
+				for (int n = scc; n >= 0; n = nodes[n].next) {
+					if (n >= sz) in_set[n - sz] = false;
+				}
+				scc_expl[scc] = Reason_new(ps);
+			}
+			r = scc_expl[scc];
+		}
+		return x[i]->remVal(cover[k], r);
+	}
+
+	// Push the false literals saying that x[i] takes a value outside in_set
+	void explainDomain(int i) {
+		IntVar *v = x[i];
+		if (v->isFixed()) {
+			ps.push(v->getValLit());
+			return;
+		}
+		ps.push(v->getMinLit());
+		ps.push(v->getMaxLit());
+		for (int u = v->getMin() + 1; u < v->getMax(); u++) {
+			int k = valIndex(u);
+			if (k < 0 || !in_set[k]) ps.push(v->getLit(u, 1));
+		}
+	}
+
+	void clearPropState() {
+		in_queue = false;
+	}
+
+	// The vars that can still take cover[inf_id] are too few to leave any out
+	Clause* explain(Lit p, int inf_id) {
+		int val = cover[inf_id];
+		ps.clear();
+		ps.push();
+		for (int i = 0; i < sz; i++) {
+			if (!x[i]->indomain(val)) ps.push(x[i]->getLit(val, 1));
+		}
+		return Reason_new(ps);
+	}
+
+	bool check() {
+		vec<int> occ(nv, 0);
+		for (int i = 0; i < sz; i++) {
+			int k = valIndex(x[i]->getShadowVal());
+			if (k >= 0) occ[k]++;
+		}
+		for (int k = 0; k < nv; k++) {
+			if (occ[k] < lb[k] || occ[k] > ub[k]) return false;
+		}
+		return true;
+	}
+
+};
+
+void global_cardinality(vec<IntVar*>& x, vec<int>& cover, vec<int>& lb, vec<int>& ub) {
+	// Merge repeated cover values
+	vec<int> c, l, u;
+	for (int k = 0; k < cover.size(); k++) {
+		int j = 0;
+		while (j < c.size() && c[j] != cover[k]) j++;
+		if (j == c.size()) {
+			c.push(cover[k]);
+			l.push(lb[k]);
+			u.push(ub[k]);
+		} else {
+			l[j] = std::max(l[j], lb[k]);
+			u[j] = std::min(u[j], ub[k]);
+		}
+	}
+	for (int i = 0; i < x.size(); i++) x[i]->specialiseToEL();
+	vec<IntVar*> y(x);
+	new GlobalCardinality(y, c, l, u);
+}
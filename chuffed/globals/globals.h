@@ -50,9 +50,14 @@ void maximum(vec<IntVar*>& x, IntVar* y);
 
 void bool_arg_max(vec<BoolView>& x, int offset, IntVar* y);
 
+// gcc.c
+
+void global_cardinality(vec<IntVar*>& x, vec<int>& cover, vec<int>& lb, vec<int>& ub);
+
 // table.c
 
 void table(vec<IntVar*>& x, vec<vec<int> >& t);
+void table_CT(vec<IntVar*>& x, vec<vec<int> >& t);
 
 // regular.c
 
@@ -49,7 +49,7 @@ void bool_linear_decomp(vec<BoolView>& x, IntRelType t, int k)
   if(k == 0)
   {
     for(int ii = 0; ii < x.size(); ii++)
-      sat.enqueue(~x[ii]);
+      sat().enqueue(~x[ii]);
     return;
   }
   if(k >= x.size())
@@ -72,7 +72,7 @@ void bool_linear_decomp(vec<BoolView>& x, IntRelType t, int k)
   vec<Lit> out;
   sorter(k, vs, out, SRT_CARDNET, SRT_HALF);
   assert(out.size() > k);
-  sat.enqueue(~out[k]);
+  sat().enqueue(~out[k]);
 #endif
 }
 
@@ -110,8 +110,8 @@ void bool_linear_decomp(vec<BoolView>& x, IntRelType t, IntVar* kv)
   assert(k < terminals.size());
   for(int ii = 1; ii <= k; ii++)
   {
-    sat.addClause(vs[ii-1],~terminals[ii]);
-    sat.addClause(~vs[ii-1],terminals[ii]);
+    sat().addClause(vs[ii-1],~terminals[ii]);
+    sat().addClause(~vs[ii-1],terminals[ii]);
   }
 #endif
 }
@@ -122,7 +122,7 @@ static void bool_linear_leq(vec<Lit>& terminals, vec<Lit>& xs, int k)
   if(k == 0)
   {
     for(int ii = 0; ii < xs.size(); ii++)
-      sat.enqueue(~xs[ii]);
+      sat().enqueue(~xs[ii]);
     return;
   }
   if(k >= xs.size())
@@ -134,7 +134,7 @@ static void bool_linear_leq(vec<Lit>& terminals, vec<Lit>& xs, int k)
     vec<Lit> cl;
     for(int ii = 0; ii < xs.size(); ii++)
       cl.push(~xs[ii]);
-    sat.addClause(cl);
+    sat().addClause(cl);
     return;
   }
 
@@ -144,7 +144,7 @@ static void bool_linear_leq(vec<Lit>& terminals, vec<Lit>& xs, int k)
   // Should add stuff for nodes that are locked T.  
   Lit r = _bool_linear_leq(elts, vs, terminals, xs, k, 0, 0);
   assert(r != lit_True);
-  sat.enqueue(r);
+  sat().enqueue(r);
 }
 
 // {elts,vs} is the cache of known nodes.
@@ -181,19 +181,19 @@ static Lit _bool_linear_leq(SparseSet<>& elts, vec<Lit>& vs, vec<Lit>& terminals
     assert(low != high);
     
     // Actually going to need to introduce a node variable.
-    ret = Lit(sat.newVar(),1);
+    ret = Lit(sat().newVar(),1);
     
     // Introduce the clauses.
     if(low != lit_True)
     {
-      sat.addClause(low, ~ret);
+      sat().addClause(low, ~ret);
     }
 
     vec<Lit> cl;
     cl.push(high);
     cl.push(~xs[vv]);
     cl.push(~ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
   }
 
   elts.insert(vv*(k+1) + cc);
@@ -209,7 +209,7 @@ static void bool_linear_leq_std(vec<Lit>& terminals, vec<Lit>& xs, int k)
   if(k == 0)
   {
     for(int ii = 0; ii < xs.size(); ii++)
-      sat.enqueue(~xs[ii]);
+      sat().enqueue(~xs[ii]);
     return;
   }
 #if 0
@@ -222,7 +222,7 @@ static void bool_linear_leq_std(vec<Lit>& terminals, vec<Lit>& xs, int k)
     vec<Lit> cl;
     for(int ii = 0; ii < xs.size(); ii++)
       cl.push(~xs[ii]);
-    sat.addClause(cl);
+    sat().addClause(cl);
     return;
   }
 #endif
@@ -233,7 +233,7 @@ static void bool_linear_leq_std(vec<Lit>& terminals, vec<Lit>& xs, int k)
   // Should add stuff for nodes that are locked T.  
   Lit r = _bool_linear_leq_std(elts, vs, terminals, xs, k, 0, 0);
   assert(r != lit_True);
-  sat.enqueue(r);
+  sat().enqueue(r);
 }
 
 // We're currently constructing the function for sum_{i \in 0..vv} xs[i] = cc.
@@ -270,7 +270,7 @@ static Lit _bool_linear_leq_std(SparseSet<>& elts, vec<Lit>& vs, vec<Lit>& termi
     assert(low != high);
     
     // Actually going to need to introduce a node variable.
-    ret = Lit(sat.newVar(),1);
+    ret = Lit(sat().newVar(),1);
     
     // Introduce the clauses.
 #if 0
@@ -278,48 +278,48 @@ static Lit _bool_linear_leq_std(SparseSet<>& elts, vec<Lit>& vs, vec<Lit>& termi
     cl.push(~xs[vv]);
     cl.push(~high);
     cl.push(ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
     cl.clear();
     cl.push(xs[vv]);
     cl.push(~low);
     cl.push(ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
     cl.clear();
     cl.push(~xs[vv]);
     cl.push(high);
     cl.push(~ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
     cl.clear();
     cl.push(xs[vv]);
     cl.push(low);
     cl.push(~ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
     cl.clear();
     cl.push(~high);
     cl.push(~low);
     cl.push(ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
     cl.clear();
     cl.push(high);
     cl.push(low);
     cl.push(~ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 #else
     if(low != lit_True)
     {
-      sat.addClause(low, ~ret);
+      sat().addClause(low, ~ret);
     }
 
     vec<Lit> cl;
     cl.push(high);
     cl.push(~xs[vv]);
     cl.push(~ret);
-    sat.addClause(cl);
+    sat().addClause(cl);
 #endif
   }
 
@@ -62,7 +62,7 @@ public:
 			}
 			if (y.setMinNotR(m)) {
 				Clause *r = NULL;
-				if (so.lazy) {
+				if (so().lazy) {
 					r = Reason_new(sz+1);
 					// Finesse lower bounds
 					// Add reason ![y <= m-1] \/ [x_1 <= m-1] \/ ... \/ [x_n <= m-1] 
@@ -75,7 +75,7 @@ public:
 			// make b_i greater than or equal to min(a)
 			m = y.getMin();
 			Clause *r = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				r = Reason_new(2);
 				(*r)[1] = y.getMinLit();
 			}				
@@ -52,13 +52,13 @@ public:
     SubCircuit(vec<IntView<U> > _x): 
         size(_x.size()), 
         x(_x.release()),
-        check(so.circuitalg <=3),
-        prevent(so.circuitalg >= 2 && so.circuitalg <=3),
-        scc(so.circuitalg >= 3),
-        pruneRoot(so.sccoptions >= 3),
+        check(so().circuitalg <=3),
+        prevent(so().circuitalg >= 2 && so().circuitalg <=3),
+        scc(so().circuitalg >= 3),
+        pruneRoot(so().sccoptions >= 3),
         pruneSkip(true),
         fixReq(true),
-        pruneWithin(so.sccoptions == 2 || so.sccoptions == 4),
+        pruneWithin(so().sccoptions == 2 || so().sccoptions == 4),
         defaultRoot(0)
     {      
         
@@ -125,7 +125,7 @@ public:
         // 5-start other chain, 1-first valid, 2-last, 3-high level, 4-low level
         // The start of another chain is valid as the justification because that will be a 
         // var outside this chain that is fixed to value not its own index
-        if(so.preventevidence == 5 && chain_start.size() < 2)
+        if(so().preventevidence == 5 && chain_start.size() < 2)
             return true;
             
         for(int chainNumber = 0; chainNumber < chain_start.size(); chainNumber++)
@@ -134,7 +134,7 @@ public:
             // (for now vars which can't take their index as a value, later we
             // will remove the ones in this chain)
             vec<int> evidenceOptions;
-            if(so.preventevidence == 5)
+            if(so().preventevidence == 5)
             {
                 // if this is the first chain, use the 
                 // start of the second, otherwise use the start of the first
@@ -156,26 +156,26 @@ public:
             int startVar = chain_start[chainNumber];
             int chainLength = 1;
             int endVar = startVar;
-            if(so.preventevidence != 5)
+            if(so().preventevidence != 5)
                 evidenceOptions.remove(startVar);
             while(x[endVar].isFixed())
             {
                 chainLength++;
                 endVar = x[endVar].getVal();
-                if(so.preventevidence != 5)
+                if(so().preventevidence != 5)
                     evidenceOptions.remove(endVar);
             }
             
             if(x[endVar].remValNotR(startVar) && evidenceOptions.size() > 0)
             {
                 Clause* r = NULL;
-                if(so.lazy)
+                if(so().lazy)
                 {
-                    int evidenceVar = chooseEvidenceVar(evidenceOptions, so.preventevidence);
+                    int evidenceVar = chooseEvidenceVar(evidenceOptions, so().preventevidence);
                     
-                    if(so.preventevidence != 5)
+                    if(so().preventevidence != 5)
                         evidenceOptions.remove(startVar);
-                    if(so.prevexpl == 1)
+                    if(so().prevexpl == 1)
                     {
                         r = Reason_new(chainLength + 1);
                         int v = startVar;
@@ -235,7 +235,7 @@ public:
         // now choose one using our selection method
         if(varsIn.size() > 0)
         {
-            int chosen = chooseEvidenceVar(varsIn, so.sccevidence);
+            int chosen = chooseEvidenceVar(varsIn, so().sccevidence);
             assert(!x[chosen].indomain(chosen));
             bool found = false;
             for(int i = 0; i < potentialVarIndices.size(); i++)
@@ -326,7 +326,7 @@ public:
                     if(evidenceOut != lit_True)
                     {            
                         Clause *r = NULL;
-                        if(so.lazy)
+                        if(so().lazy)
                         {
                             r = Reason_new(inside.size() * outside.size() + 2);
                             (*r)[1] = evidenceOut;
@@ -337,7 +337,7 @@ public:
                     if(evidenceIn != lit_True)
                     {
                         Clause *r = NULL;
-                        if(so.lazy)
+                        if(so().lazy)
                         {
                             r = Reason_new(inside.size() * outside.size() + 2);
                             (*r)[1] = evidenceIn;
@@ -374,7 +374,7 @@ public:
                         // should be collected within the propagator class.
                                 //engine.prunedSkip++;
                                 Clause *r = NULL;
-                                if(so.lazy)
+                                if(so().lazy)
                                 {
                                 // The reason is that no node in an earlier 
 				// subtree can reach the prev or later subtrees,
@@ -427,7 +427,7 @@ public:
             if(evidenceInside != lit_True)
             {
                 Clause *r = NULL;
-                if(so.lazy)
+                if(so().lazy)
                 {    
                     r = Reason_new(inside.size() * outside.size()+2);
                     (*r)[1] = evidenceInside;
@@ -470,7 +470,7 @@ public:
             return -1;
         int root = options[0];
         int dom = 0;
-        switch(so.rootSelection)
+        switch(so().rootSelection)
         {
             case 1: // first non-fixed
                 for(int i = 0; i < size; i++)
@@ -485,12 +485,12 @@ public:
                     if(x[i].isFixed())
                         options.remove(i);
                 if(options.size() > 0)
-                    root = options[(int) ( ((double)options.size()) * rand() / (RAND_MAX + 1.0) )];
+                    root = options[engine().randInt(options.size())];
                 break;
             case 7: // first (even if fixed) - this is the default
                 break;
             case 8: // random (even if fixed)
-                root = options[ (int) ( ((double)options.size()) * rand() / (RAND_MAX + 1.0) )];
+                root = options[engine().randInt(options.size())];
                 break;
             case 9: // largest domain
                 dom = x[root].size();
@@ -579,7 +579,7 @@ public:
                         // XXX [AS] Commented following line, because propagator related statistics
                         // should be collected within the propagator class.
                         //engine.nobackedge++;
-                        if(so.lazy)
+                        if(so().lazy)
                         {
                             // If prev is empty then this is the first subtree, 
 			    // and we just need to say that 
@@ -643,7 +643,7 @@ public:
                         // should be collected within the propagator class.
                         //engine.fixedBackedge++;
                         Clause *r = NULL;
-                        if(so.lazy)
+                        if(so().lazy)
                         {
                             // If this is the first subtree, the reason we're setting this link is that 
                             // there is no other link between nodes of this subtree to nodes outside the subtree including the root
@@ -730,7 +730,7 @@ public:
                 //engine.disconnected++;
                 Clause* r = NULL;
                 
-                if (so.lazy) {
+                if (so().lazy) {
                     // need to say that each seen node doesn't reach any non-seen node
                     r = Reason_new(nodesSeen * numNotSeen+2);
                     (*r)[1] = evidenceSeen;
@@ -776,7 +776,7 @@ public:
             {
                 // Build the reason if neccessary (it will be the same for all of the pruned edges)
                 Clause* r = NULL;
-                if(so.lazy)
+                if(so().lazy)
                 {
                     // Reason should state that no var in an earlier sub tree reaches a var
                     // in the last subtree or outside
@@ -863,7 +863,7 @@ public:
                 Clause* r = NULL;
                 vec<int> notInCycle;
                 bool doOutsideIn = false;
-                if (so.lazy) {
+                if (so().lazy) {
                   /*  r = Reason_new(chainLength + 1);
                     int v = startVar;
                     for(int j = 1 ; j <= chainLength; j++)
@@ -871,7 +871,7 @@ public:
                         (*r)[j] = x[v].getValLit();
                         v = x[v].getVal();
                     }*/
-                    if(so.checkexpl == 1)
+                    if(so().checkexpl == 1)
                     {
                         // equalities
                         r = Reason_new(chainLength+1);
@@ -900,16 +900,16 @@ public:
                         r = Reason_new(inCycle.size() * notInCycle.size() + 2);
                         // the first literal is an evidence literal from inside the circuit
                         // choose the one from the highest level?
-                        int chosenVar = chooseEvidenceVar(inCycle, so.checkevidence);
+                        int chosenVar = chooseEvidenceVar(inCycle, so().checkevidence);
                         (*r)[1] = x[chosenVar].getLit(chosenVar, 1); // xi == i (is false)
                         
-                        if(so.checkexpl == 2) // inside can't reach out
+                        if(so().checkexpl == 2) // inside can't reach out
                             doOutsideIn = false;
-                        else if(so.checkexpl == 3) // outside can't reach in
+                        else if(so().checkexpl == 3) // outside can't reach in
                             doOutsideIn = true;
-                        else if(so.checkexpl == 4) // smaller group can't reach bigger group
+                        else if(so().checkexpl == 4) // smaller group can't reach bigger group
                             doOutsideIn = notInCycle.size() < inCycle.size();
-                        else if(so.checkexpl == 5) // bigger group can't reach smaller group
+                        else if(so().checkexpl == 5) // bigger group can't reach smaller group
                             doOutsideIn = inCycle.size() < notInCycle.size();
                         else fprintf(stderr, "Unknown check explanation type\n");
                             
@@ -942,7 +942,7 @@ public:
                 // now do the failing one(s) if there are any
                 if(failIndices.size() > 0)
                 {
-                    int chosenIndex = chooseEvidenceVar(failIndices, so.checkevidence);
+                    int chosenIndex = chooseEvidenceVar(failIndices, so().checkevidence);
                     if(x[chosenIndex].setVal(chosenIndex, r))
                     {
                         fprintf(stderr,"unexpected success\n");
@@ -1016,14 +1016,14 @@ public:
             // highest level
             // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
             // Maybe it shoud be replaced by sat.getLevel(.)?
-            int highestLevel = sat.trailpos[var(x[options[0]].getLit(options[0],1))];
+            int highestLevel = sat().trailpos[var(x[options[0]].getLit(options[0],1))];
             //int highestLevel = sat.getLevel(var(x[options[0]].getLit(options[0],1)));
             int bestVar = options[0];
             for(int i = 0; i < options.size(); i++)
             {
                 // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                 // Maybe it shoud be replaced by sat.getLevel(.)?
-                if(sat.trailpos[var(x[options[0]].getLit(options[0],1))] != sat.trailpos[var(x[options[0]].getLit(options[0],0))])
+                if(sat().trailpos[var(x[options[0]].getLit(options[0],1))] != sat().trailpos[var(x[options[0]].getLit(options[0],0))])
                 //if(sat.getLevel(var(x[options[0]].getLit(options[0],1))) != sat.getLevel(var(x[options[0]].getLit(options[0],0))))
                     fprintf(stderr, "not same\n");
                  int v = options[i];
@@ -1031,12 +1031,12 @@ public:
                  int satvar = var(p);
                 // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                 // Maybe it shoud be replaced by sat.getLevel(.)?
-	            if(sat.trailpos[satvar] > highestLevel)
+	            if(sat().trailpos[satvar] > highestLevel)
 	            //if(sat.getLevel(satvar) > highestLevel)
 	            {
                     // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                     // Maybe it shoud be replaced by sat.getLevel(.)?
-	                highestLevel = sat.trailpos[satvar];
+	                highestLevel = sat().trailpos[satvar];
 	                //highestLevel = sat.getLevel(satvar);
 	                bestVar = v;
 	            }
@@ -1048,7 +1048,7 @@ public:
             // lowest level
             // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
             // Maybe it shoud be replaced by sat.getLevel(.)?
-            int lowestLevel = sat.trailpos[var(x[options[0]].getLit(options[0],1))];
+            int lowestLevel = sat().trailpos[var(x[options[0]].getLit(options[0],1))];
             //int lowestLevel = sat.getLevel(var(x[options[0]].getLit(options[0],1)));
             int bestVar = options[0];
             for(int i = 0; i < options.size(); i++)
@@ -1058,14 +1058,14 @@ public:
                  int satvar = var(p);
                  // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                  // Maybe it shoud be replaced by sat.getLevel(.)?
-	             if(sat.trailpos[satvar] < lowestLevel)
+	             if(sat().trailpos[satvar] < lowestLevel)
 	             //if(sat.getLevel(satvar) < lowestLevel)
 	             {
                      // XXX [AS] Replaced 'sat.level' by 'sat.trailpos', because it was replaced in rev. 441
                      // Maybe it shoud be replaced by sat.getLevel(.)?
-	                 lowestLevel = sat.trailpos[satvar];
+	                 lowestLevel = sat().trailpos[satvar];
 	                 //lowestLevel = sat.getLevel(satvar);
-	                 if(lowestLevel == 0 && (sat.value(p) != l_False)) fprintf(stderr, "level 0 not fixed\n");
+	                 if(lowestLevel == 0 && (sat().value(p) != l_False)) fprintf(stderr, "level 0 not fixed\n");
 	                 bestVar = v;
 	             }
             }
@@ -1074,7 +1074,7 @@ public:
         else if(selectionMethod == 6)
         {
             //fprintf(stderr, "random\n");
-            int bestIndex = (int) ( ((double)options.size()) * rand() / (RAND_MAX + 1.0) );
+            int bestIndex = engine().randInt(options.size());
             return options[bestIndex];
         }
         else
@@ -1092,7 +1092,7 @@ public:
             return false;
         if(scc)
         {
-            if(so.rootSelection == 10)
+            if(so().rootSelection == 10)
             {
                 // try all roots not fixed in self-cycles
                 int numTried = 0;
@@ -18,12 +18,12 @@ class TableChecker : public Checker {
 void table_GAC(vec<IntVar*>& x, vec<vec<int> >& t) {
 	assert(x.size() >= 2);
 	for (int i = 0; i < x.size(); i++) x[i]->specialiseToEL();
-	int base_lit = 2*sat.nVars();
+	int base_lit = 2*sat().nVars();
 	if (x.size() != 2) {
 		for (int i = 0; i < t.size(); i++) {
-			sat.newVar();
+			sat().newVar();
 			for (int j = 0; j < x.size(); j++) {
-				sat.addClause(toLit(base_lit+2*i), x[j]->getLit(t[i][j], 1));
+				sat().addClause(toLit(base_lit+2*i), x[j]->getLit(t[i][j], 1));
 			}
 		}
 	}
@@ -53,11 +53,264 @@ void table_GAC(vec<IntVar*>& x, vec<vec<int> >& t) {
 			assert(i+sup_off <= x[w]->getMax());
 			sup[i].push(x[w]->getLit(i+sup_off, 0));
 			Lit p = sup[i][0]; sup[i][0] = sup[i].last(); sup[i].last() = p;
-			sat.addClause(sup[i]);
+			sat().addClause(sup[i]);
 		}
 	}
 }
 
+// Compact-Table: the tuples still valid are kept in a trailed sparse bitset.
+// When variables change, it is intersected with the supports of the values
+// they lost, or reset to the supports of the values they kept if those are
+// fewer. A value is pruned once none of its supports is valid.
+
+class CompactTable : public Propagator {
+	int const n;
+	vec<IntVar*> x;
+	int nt;                       // number of tuples
+	int nw;                       // number of words in a tuple bitset
+	vec<int> tuples;              // n values per tuple
+
+	// Values which appear in some tuple are numbered from 0
+	vec<int> val_min;
+	vec<vec<int> > val_id;        // value number of x[i] = v at [i][v-val_min[i]], or -1
+	vec<int> id_var;
+	vec<int> id_val;
+	vec<uint64_t> supports;       // nw words for each value number
+	vec<int> residue;             // word where a support was last found
+
+	// Persistent state
+	vec<uint64_t> valid;          // tuples still valid
+	vec<int> index;               // words of valid, non-empty ones in index[0..limit)
+	Tint limit;
+	vec<vec<int> > dom;           // values of x[i] in dom[i][0..dom_size[i]) as last seen
+	vec<Tint> dom_size;
+
+	// Intermediate state
+	vec<int> modified;
+	vec<bool> is_modified;
+	vec<uint64_t> mask;
+
+	// Explanation state
+	vec<char> expl_min;
+	vec<char> expl_max;
+	vec<char> expl_val;
+	vec<int> expl_used;
+
+	int valId(int i, int v) const { return val_id[i][v-val_min[i]]; }
+	uint64_t* support(int id) { return &supports[id*nw]; }
+
+public:
+	CompactTable(vec<IntVar*>& _x, vec<vec<int> >& t) : n(_x.size()), limit(0) {
+		priority = 2;
+		for (int i = 0; i < n; i++) {
+			x.push(_x[i]);
+			x[i]->specialiseToEL();
+		}
+
+		// Tuples outside the domains can never be used
+		for (int k = 0; k < t.size(); k++) {
+			bool ok = true;
+			for (int i = 0; ok && i < n; i++) ok = x[i]->indomain(t[k][i]);
+			if (!ok) continue;
+			for (int i = 0; i < n; i++) tuples.push(t[k][i]);
+		}
+		nt = n ? tuples.size() / n : 0;
+		if (nt == 0) TL_FAIL();
+		nw = (nt + 63) / 64;
+
+		for (int i = 0; i < n; i++) {
+			val_min.push(x[i]->getMin());
+			val_id.push();
+			val_id.last().growTo(x[i]->getMax()-x[i]->getMin()+1, -1);
+		}
+		for (int k = 0; k < nt; k++) {
+			for (int i = 0; i < n; i++) {
+				int& id = val_id[i][tuples[k*n+i]-val_min[i]];
+				if (id != -1) continue;
+				id = id_var.size();
+				id_var.push(i);
+				id_val.push(tuples[k*n+i]);
+			}
+		}
+		supports.growTo(id_var.size()*nw, 0);
+		for (int k = 0; k < nt; k++) {
+			for (int i = 0; i < n; i++) {
+				support(valId(i, tuples[k*n+i]))[k/64] |= (uint64_t) 1 << (k%64);
+			}
+		}
+		for (int id = 0; id < id_var.size(); id++) {
+			int w = 0;
+			while (!support(id)[w]) w++;
+			residue.push(w);
+		}
+
+		// Values without supports are removed for good
+		for (int i = 0; i < n; i++) {
+			dom.push();
+			vec<int> unsupported;
+			for (IntVar::iterator it = x[i]->begin(); it != x[i]->end(); ++it) {
+				if (valId(i, *it) == -1) unsupported.push(*it);
+				else dom[i].push(*it);
+			}
+			for (int j = 0; j < unsupported.size(); j++) int_rel(x[i], IRT_NE, unsupported[j]);
+			dom_size.push(Tint(dom[i].size()));
+		}
+
+		valid.growTo(nw, ~(uint64_t) 0);
+		if (nt % 64) valid[nw-1] = ((uint64_t) 1 << (nt % 64)) - 1;
+		for (int w = 0; w < nw; w++) index.push(w);
+		limit.v = nw;
+
+		is_modified.growTo(n, false);
+		mask.growTo(nw, 0);
+		expl_min.growTo(n, false);
+		expl_max.growTo(n, false);
+		expl_val.growTo(id_var.size(), false);
+
+		for (int i = 0; i < n; i++) x[i]->attach(this, i, EVENT_C);
+	}
+
+	void wakeup(int i, int c) {
+		if (!is_modified[i]) {
+			is_modified[i] = true;
+			modified.push(i);
+		}
+		pushInQueue();
+	}
+
+	// valid &= mask, or valid &= ~mask
+	void intersect(bool negate) {
+		int l = limit;
+		for (int i = l; i--; ) {
+			int w = index[i];
+			uint64_t v = valid[w] & (negate ? ~mask[w] : mask[w]);
+			if (v == valid[w]) continue;
+			trailChange(valid[w], v);
+			if (v == 0) {
+				index[i] = index[--l];
+				index[l] = w;
+			}
+		}
+		if (l != limit) limit = l;
+	}
+
+	// Remove the tuples made invalid by the values x[i] lost
+	void update(int i) {
+		vec<int>& d = dom[i];
+		int old_size = dom_size[i];
+		int size = old_size;
+		for (int j = 0; j < size; ) {
+			if (x[i]->indomain(d[j])) j++;
+			else { size--; int v = d[j]; d[j] = d[size]; d[size] = v; }
+		}
+		if (size == old_size) return;
+		dom_size[i] = size;
+
+		// Use whichever of the lost and kept values are fewer
+		bool lost = old_size - size < size;
+		int lo = lost ? size : 0;
+		int hi = lost ? old_size : size;
+		for (int k = 0; k < limit; k++) mask[index[k]] = 0;
+		for (int j = lo; j < hi; j++) {
+			uint64_t *s = support(valId(i, d[j]));
+			for (int k = 0; k < limit; k++) mask[index[k]] |= s[index[k]];
+		}
+		intersect(lost);
+	}
+
+	bool propagate() {
+		for (int k = 0; k < modified.size(); k++) update(modified[k]);
+
+		// A lone changed variable keeps the supports of its values
+		int skip = modified.size() == 1 ? modified[0] : -1;
+
+		for (int i = 0; i < n; i++) {
+			if (i == skip) continue;
+			vec<int>& d = dom[i];
+			for (int j = 0; j < dom_size[i]; j++) {
+				int v = d[j];
+				if (!x[i]->indomain(v)) continue;
+				int id = valId(i, v);
+				uint64_t *s = support(id);
+				if (valid[residue[id]] & s[residue[id]]) continue;
+				bool supported = false;
+				for (int k = 0; k < limit; k++) {
+					int w = index[k];
+					if (valid[w] & s[w]) {
+						residue[id] = w;
+						supported = true;
+						break;
+					}
+				}
+				if (supported) continue;
+				Reason r = NULL;
+				if (so().lazy) r = Reason(prop_id, id);
+				if (!x[i]->remVal(v, r)) return false;
+			}
+		}
+
+		return true;
+	}
+
+	void clearPropState() {
+		in_queue = false;
+		for (int k = 0; k < modified.size(); k++) is_modified[modified[k]] = false;
+		modified.clear();
+	}
+
+	// The supports of x[i] = v are all invalid. Each was killed by a value
+	// of another variable, named by a bound literal if it is out of bounds.
+	Clause* explain(Lit p, int inf_id) {
+		int i = id_var[inf_id];
+		vec<Lit> ps;
+		ps.push();
+		uint64_t *s = support(inf_id);
+		for (int w = 0; w < nw; w++) {
+			for (uint64_t b = s[w]; b; b &= b - 1) {
+				int *t = &tuples[(w*64 + lowestBit(b)) * n];
+				int killer = -1;
+				bool covered = false;
+				for (int j = 0; !covered && j < n; j++) {
+					if (j == i) continue;
+					if (t[j] < x[j]->getMin()) covered = expl_min[j], killer = j;
+					else if (t[j] > x[j]->getMax()) covered = expl_max[j], killer = j;
+					else if (!x[j]->indomain(t[j])) {
+						covered = expl_val[valId(j, t[j])];
+						if (killer == -1) killer = j;
+					}
+				}
+				if (covered) continue;
+				assert(killer != -1);
+				int v = t[killer];
+				IntVar *y = x[killer];
+				if (v < y->getMin()) {
+					expl_min[killer] = true;
+					ps.push(y->getMinLit());
+				} else if (v > y->getMax()) {
+					expl_max[killer] = true;
+					ps.push(y->getMaxLit());
+				} else {
+					int id = valId(killer, v);
+					expl_val[id] = true;
+					expl_used.push(id);
+					ps.push(y->getLit(v, 1));
+				}
+			}
+		}
+		for (int j = 0; j < n; j++) expl_min[j] = expl_max[j] = false;
+		for (int k = 0; k < expl_used.size(); k++) expl_val[expl_used[k]] = false;
+		expl_used.clear();
+		return Reason_new(ps);
+	}
+
+};
+
+void table_CT(vec<IntVar*>& x, vec<vec<int> >& t) {
+	assert(x.size() >= 1);
+	new CompactTable(x, t);
+}
+
 void table(vec<IntVar*>& x, vec<vec<int> >& t) {
-	table_GAC(x, t);
+	if (so().table_ct) table_CT(x, t);
+	else table_GAC(x, t);
 }
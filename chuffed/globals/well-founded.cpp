@@ -23,7 +23,7 @@ public:
 		for (int i = 0; i < b.size(); i++) body[i] = b[i];
 	}
 
-	inline bool isFalse() { return sat.value(body_lit) == l_False; }
+	inline bool isFalse() { return sat().value(body_lit) == l_False; }
 
 };
 
@@ -264,7 +264,7 @@ public:
 			} else {
 				array_bool_and(raw_posb[i], raw_negb[i], raw_bl[i]);
 			}
-			if (so.well_founded) raw_bl[i].attach(this, rules.size(), EVENT_U);
+			if (so().well_founded) raw_bl[i].attach(this, rules.size(), EVENT_U);
 
 			vec<int> b;
 			for (int j = 0; j < raw_posb[i].size(); j++) {
@@ -355,7 +355,7 @@ public:
 			printf("\n");
 		}
 
-		if (so.well_founded) pushInQueue();
+		if (so().well_founded) pushInQueue();
 
 	}
 
@@ -390,7 +390,7 @@ public:
 			}
 		}
 
-		if (DEBUG) printf("Decision level: %d\n", engine.decisionLevel());
+		if (DEBUG) printf("Decision level: %d\n", engine().decisionLevel());
 
 		if (DEBUG) printf("No support: ");
 		if (DEBUG) for (int i = 0; i < no_support.size(); i++) {
@@ -522,7 +522,7 @@ public:
 			if (DEBUG) printf("making %d false\n", h);
 			if (ADD_CLAUSES) {
 				ps[0] = ~lits[h];
-				sat.addClause(*Clause_new(ps, false), false);
+				sat().addClause(*Clause_new(ps, false), false);
 			}
 			assert(!BoolView(lits[h]).isFalse());
 			if (!BoolView(lits[h]).setVal(0, expl)) return false;
@@ -532,7 +532,7 @@ public:
 		if (DEBUG) printf("reawaken\n");
 
 		// reawaken, this is not quite correct
-		engine.p_queue[priority].push(this);
+		requestStage(priority);
 
 		return true;
 	}
@@ -562,7 +562,7 @@ public:
 	void clearPropState() {
 		in_queue = false;
 		dead_rules.clear();
-		if (sat.confl) {
+		if (sat().confl) {
 			for (int i = 0; i < no_support.size(); i++) {
 				for ( ; pufhead[i] < no_support[i].size(); pufhead[i]++) {
 					no_support_bool[no_support[i][pufhead[i]]] = false;
@@ -576,7 +576,7 @@ public:
 
 };
 
-vec<WellFounded> wf_props;
+thread_local vec<WellFounded> wf_props;
 
 void add_inductive_rule(BoolView hl, vec<BoolView>& posb, vec<BoolView>& negb, int wf_id) {
 	wf_props.growTo(wf_id);
@@ -4,7 +4,7 @@
 
 #define LDSB_DEBUG 0
 
-LDSB ldsb;
+THREAD_LOCAL LDSB *ldsb;
 
 //-------
 
@@ -12,8 +12,8 @@ class Symmetry {
 public:
 	int sym_id;
 
-	Symmetry() : sym_id(ldsb.symmetries.size()) {
-		ldsb.symmetries.push(this);
+	Symmetry() : sym_id(ldsb->symmetries.size()) {
+		ldsb->symmetries.push(this);
 	}
 
 	virtual void init() = 0;
@@ -25,7 +25,7 @@ public:
 		vec<Lit> ps(r->size());
 		for (int i = 1; i < r->size(); i++) {
 			ps[i] = getSymLit((*r)[i], r1, r2);
-			if (sat.value(ps[i]) != l_False) return NULL;
+			if (sat().value(ps[i]) != l_False) return NULL;
 		}
 		ps[0] = getSymLit((*r)[0], r1, r2);
 		return Clause_new(ps, true);
@@ -37,12 +37,12 @@ public:
 
 void LDSB::init() {
 	ldsb_time = duration::zero();
-	for (int i = 0; i < engine.vars.size(); i++) lookupTable.push();
+	for (int i = 0; i < engine().vars.size(); i++) lookupTable.push();
 	for (int i = 0; i < symmetries.size(); i++) symmetries[i]->init();
 }
 
 void LDSB::processDec(Lit p) {
-	int var_id = sat.c_info[var(p)].cons_id;
+	int var_id = sat().c_info[var(p)].cons_id;
 	if (var_id == -1) NOT_SUPPORTED;
 
 	vec<pair<int,int> >& syms = lookupTable[var_id];
@@ -64,7 +64,7 @@ bool LDSB::processImpl(Clause *c) {
 //	for (int k = 0; k < 1; k++) {
 		Lit p = (*sym_learnts[k])[0];
 
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (var_id == -1) {
 			if (LDSB_DEBUG) printf("Implication ignored\n");
 			continue;
@@ -95,15 +95,18 @@ bool LDSB::processImpl(Clause *c) {
 }
 
 void LDSB::addLearntClause(Clause& c, int sym_id) {
-	sym_learnts.push(&c);
+	Clause *r = &c;
+	if (sym_id != -1) {
+		c.activity() = 1;
+		if (c.size() >= 2) {
+			if (!so().learn || (so().bin_clause_opt && c.size() == 2)) sat().rtrail.last().push(&c);
+			if (so().learn) r = sat().addClause(c, so().one_watch);
+		}
+	}
+	sym_learnts.push(r);
 	sl_origin.push(sym_id);
 	if (sym_id == -1) return;
-	c.activity() = 1;
-	if (c.size() >= 2) {
-		if (so.learn) sat.addClause(c, so.one_watch);
-		if (!so.learn || c.size() == 2) sat.rtrail.last().push(&c);
-	}
-	sat.enqueue(c[0], &c);
+	sat().enqueue((*r)[0], r);
 }
 
 
@@ -129,8 +132,8 @@ public:
 
 	void init() {
 		for (int i = 0; i < n; i++) {
-			assert(engine.vars[vars[i]]->getType() == INT_VAR_EL);
-			ldsb.lookupTable[vars[i]].push(pair<int,int>(sym_id, i));
+			assert(engine().vars[vars[i]]->getType() == INT_VAR_EL);
+			ldsb->lookupTable[vars[i]].push(pair<int,int>(sym_id, i));
 		}
 	}
 
@@ -141,23 +144,23 @@ public:
 	}
 
 	bool processImpl(Clause *r, int pos) {
-		if (!so.ldsbta && !active[pos]) return true;
+		if (!so().ldsbta && !active[pos]) return true;
 
 		Lit p = (*r)[0];
 
 		for (int i = 0; i < n; i++) {
-			if (!so.ldsbta && !active[i]) continue;
+			if (!so().ldsbta && !active[i]) continue;
 			if (i == pos) continue;
 			Lit q = getSymLit(p, vars[pos], vars[i]);
-			lbool b = sat.value(q);
+			lbool b = sat().value(q);
 			if (b == l_True) continue;
 			if (b == l_False) {
 				// can fail here!
 				Clause *c = getSymClause(r, vars[pos], vars[i]);
 				if (!c) { if (LDSB_DEBUG) printf("Skip VarSym Failure\n"); continue; }
 				c->temp_expl = 1;
-				sat.rtrail.last().push(c);
-				sat.confl = c;
+				sat().rtrail.last().push(c);
+				sat().confl = c;
 				if (LDSB_DEBUG) printf("VarSym Failure\n");
 				return false;
 			}
@@ -169,25 +172,25 @@ public:
 			if (LDSB_DEBUG) printf("Extra VarSym implication\n");
 			assert((*s)[0] == q);
 //			if (!active[pos] || !active[i]) printf("Extra!\n");
-			ldsb.addLearntClause(*s, sym_id);
+			ldsb->addLearntClause(*s, sym_id);
 		}
 
 		return true;
 	}
 
 	Lit getSymLit(Lit p, int a, int b) {
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		Lit q = p;
 		// Not very safe!!!!
 		if (var_id == a) {
-			int base_a = ((IntVarEL*) engine.vars[a])->getBaseVLit();
-			int base_b = ((IntVarEL*) engine.vars[b])->getBaseVLit();
+			int base_a = ((IntVarEL*) engine().vars[a])->getBaseVLit();
+			int base_b = ((IntVarEL*) engine().vars[b])->getBaseVLit();
 			q = toLit(toInt(p) - base_a + base_b);
 //			assert(sat.c_info[var(q)].cons_id == b);
 		}
 		if (var_id == b) {
-			int base_a = ((IntVarEL*) engine.vars[a])->getBaseVLit();
-			int base_b = ((IntVarEL*) engine.vars[b])->getBaseVLit();
+			int base_a = ((IntVarEL*) engine().vars[a])->getBaseVLit();
+			int base_b = ((IntVarEL*) engine().vars[b])->getBaseVLit();
 			q = toLit(toInt(p) - base_b + base_a);
 //			assert(sat.c_info[var(q)].cons_id == a);
 		}
@@ -227,11 +230,11 @@ public:
 	}
 
 	void init() {
-		which_vars = (bool*) malloc(engine.vars.size() * sizeof(bool));
-		for (int i = 0; i < engine.vars.size(); i++) which_vars[i] = false;
+		which_vars = (bool*) malloc(engine().vars.size() * sizeof(bool));
+		for (int i = 0; i < engine().vars.size(); i++) which_vars[i] = false;
 		for (int i = 0; i < n; i++) {
-			assert(engine.vars[vars[i]]->getType() == INT_VAR_EL);
-			ldsb.lookupTable[vars[i]].push(pair<int,int>(sym_id, i));
+			assert(engine().vars[vars[i]]->getType() == INT_VAR_EL);
+			ldsb->lookupTable[vars[i]].push(pair<int,int>(sym_id, i));
 			which_vars[vars[i]] = true;
 		}
 	}
@@ -239,7 +242,7 @@ public:
 	void processDec(Lit p, int pos) {
 		int v = getLitVal(p);
 		if (v == not_a_val) NOT_SUPPORTED;
-		assert(engine.vars[sat.c_info[var(p)].cons_id]->getVal() == v);
+		assert(engine().vars[sat().c_info[var(p)].cons_id]->getVal() == v);
 		if (v < min || v > max) return;
 		if (active[v-min]) {
 			active[v-min] = 0;
@@ -253,24 +256,24 @@ public:
 		int v = getLitVal(p);
 		assert(v != not_a_val);
 		if (v < min || v > max) { if (LDSB_DEBUG) printf("Skip PValSym oor\n"); return true; }
-		if (!so.ldsbta && !active[v-min]) return true;
+		if (!so().ldsbta && !active[v-min]) return true;
 
 //		Clause *rc = cleanClause(r);
 		Clause *rc = r;
 
 		for (int i = min; i <= max; i++) {
-			if (!so.ldsbta && !active[i-min]) continue;
+			if (!so().ldsbta && !active[i-min]) continue;
 			if (i == v) continue;
 	//		printf("try %d\n", i);
 			Lit q = getSymLit(p, v, i);
-			lbool b = sat.value(q);
+			lbool b = sat().value(q);
 			if (b == l_True) continue;
 			if (b == l_False) {
 				Clause *c = getSymClause(rc, v, i);
 				if (!c) { if (LDSB_DEBUG) printf("Skip ValSym Failure\n"); continue; }
 				c->temp_expl = 1;
-				sat.rtrail.last().push(c);
-				sat.confl = c;
+				sat().rtrail.last().push(c);
+				sat().confl = c;
 				if (LDSB_DEBUG) printf("ValSym Failure\n");
 //				free(rc);
 				return false;
@@ -280,10 +283,10 @@ public:
 				if (LDSB_DEBUG) printf("Skip ValSym implication");
 				continue;
 			}
-			if (LDSB_DEBUG) printf("Level %d, Extra ValSym implication %d -> %d\n", engine.decisionLevel(), v, i);
+			if (LDSB_DEBUG) printf("Level %d, Extra ValSym implication %d -> %d\n", engine().decisionLevel(), v, i);
 			assert((*s)[0] == q);
 //			if (!active[v-min] || !active[i-min]) printf("Extra!\n");
-			ldsb.addLearntClause(*s, sym_id);
+			ldsb->addLearntClause(*s, sym_id);
 		}
 
 //		free(rc);
@@ -298,7 +301,7 @@ public:
 		Clause& c = *r;
 
 		for (int i = 1; i < c.size(); i++) {
-			int var_id = sat.c_info[var(c[i])].cons_id;
+			int var_id = sat().c_info[var(c[i])].cons_id;
 			// Not in sym, ignore
 			if (var_id == -1 || !which_vars[var_id]) {
 				ps.push(c[i]);
@@ -312,9 +315,9 @@ public:
 				continue;
 			}
 			// Not ok, must be bounds lit
-			if (sat.c_info[var(c[i])].val_type) {
-				IntVarEL *var = (IntVarEL*) engine.vars[var_id];
-				int v = (toInt(c[i]) - ((IntVarEL*) engine.vars[var_id])->getBaseBLit());
+			if (sat().c_info[var(c[i])].val_type) {
+				IntVarEL *var = (IntVarEL*) engine().vars[var_id];
+				int v = (toInt(c[i]) - ((IntVarEL*) engine().vars[var_id])->getBaseBLit());
 				if (v % 2 == 1) {
 					v /= 2;
 					// lit means <= v, and is false
@@ -335,14 +338,14 @@ public:
 
 		Clause *cc = Clause_new(ps);
 
-		printf("Before clean: "); sat.printClause(*r);
-		printf("After clean: "); sat.printClause(*cc);
+		printf("Before clean: "); sat().printClause(*r);
+		printf("After clean: "); sat().printClause(*cc);
 
 		return cc;
 	}
 
 	Lit getSymLit(Lit p, int a, int b) {
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (!which_vars[var_id]) return p;
 		int v = getLitVal(p);
 		if (v == not_a_val) NOT_SUPPORTED;
@@ -361,10 +364,10 @@ public:
 	}
 
 	int getLitVal(Lit p) {
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (var_id == -1) return not_a_val;
-		if (sat.c_info[var(p)].val_type) return not_a_val;
-		return (toInt(p) - ((IntVarEL*) engine.vars[var_id])->getBaseVLit())/2;
+		if (sat().c_info[var(p)].val_type) return not_a_val;
+		return (toInt(p) - ((IntVarEL*) engine().vars[var_id])->getBaseVLit())/2;
 	}
 
 };
@@ -399,11 +402,11 @@ public:
 	}
 
 	void init() {
-		for (int i = 0; i < engine.vars.size(); i++) occ.push();
+		for (int i = 0; i < engine().vars.size(); i++) occ.push();
 		for (int i = 0; i < n; i++) {
 			for (int j = 0; j < m; j++) {
 				assert(vars[i][j]->getType() == INT_VAR_EL);
-				ldsb.lookupTable[vars[i][j]->var_id].push(pair<int,int>(sym_id, i*m+j));
+				ldsb->lookupTable[vars[i][j]->var_id].push(pair<int,int>(sym_id, i*m+j));
 				occ[vars[i][j]->var_id].push(i*m+j);
 			}
 		}
@@ -421,7 +424,7 @@ public:
 	bool processImpl(Clause *r, int pos) {
 		Lit p = (*r)[0];
 
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (var_id == -1) return true;
 
 	//	printf("processing var %d implication\n", sat.c_info[var(p)].cons_id);
@@ -431,16 +434,16 @@ public:
 			for (int r2 = 0; r2 < n; r2++) {
 				if (r1 == r2) continue;
 				Lit q = getSymLit(p, r1, r2);
-				lbool b = sat.value(q);
+				lbool b = sat().value(q);
 				if (b == l_True) continue;
-				if (!so.ldsbta && !rowMatch(r1, r2)) continue;
+				if (!so().ldsbta && !rowMatch(r1, r2)) continue;
 				if (b == l_False) {
 					// can fail here!
 					Clause *c = getSymClause(r, r1, r2);
 					if (!c) { if (LDSB_DEBUG) printf("Skip VarSeqSym Failure\n"); continue; }
 					c->temp_expl = 1;
-					sat.rtrail.last().push(c);
-					sat.confl = c;
+					sat().rtrail.last().push(c);
+					sat().confl = c;
 					if (LDSB_DEBUG) printf("VarSeqSym Failure\n");
 					return false;
 				}
@@ -452,7 +455,7 @@ public:
 				if (LDSB_DEBUG) printf("Extra VarSeqSym implication\n");
 				assert((*s)[0] == q);
 //				if (!rowMatch(r1, r2)) printf("Extra!\n");
-				ldsb.addLearntClause(*s, sym_id);
+				ldsb->addLearntClause(*s, sym_id);
 			}
 		}
 
@@ -483,7 +486,7 @@ public:
 	}
 
 	Lit getSymLit(Lit p, int r1, int r2) {
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (var_id == -1) return p;
 		if (occ[var_id].size() == 0) return p;
 
@@ -552,11 +555,11 @@ public:
 	}
 
 	void init() {
-		which_vars = (bool*) malloc(engine.vars.size() * sizeof(bool));
-		for (int i = 0; i < engine.vars.size(); i++) which_vars[i] = false;
+		which_vars = (bool*) malloc(engine().vars.size() * sizeof(bool));
+		for (int i = 0; i < engine().vars.size(); i++) which_vars[i] = false;
 		for (int i = 0; i < vars.size(); i++) {
 			assert(vars[i]->getType() == INT_VAR_EL);
-			ldsb.lookupTable[vars[i]->var_id].push(pair<int,int>(sym_id, i));
+			ldsb->lookupTable[vars[i]->var_id].push(pair<int,int>(sym_id, i));
 			which_vars[vars[i]->var_id] = true;
 		}
 	}
@@ -564,7 +567,7 @@ public:
 	void processDec(Lit p, int pos) {
 		int v = getLitVal(p);
 		if (v == not_a_val) NOT_SUPPORTED;
-		assert(engine.vars[sat.c_info[var(p)].cons_id]->getVal() == v);
+		assert(engine().vars[sat().c_info[var(p)].cons_id]->getVal() == v);
 		if (v < min || v > max) return;
 		for (int i = 0; i < occ[v-min].size(); i++) {
 			int p = occ[v-min][i];
@@ -583,20 +586,20 @@ public:
 
 		for (int k = 0; k < occ[v-min].size(); k++) {
 			int r1 = occ[v-min][k]/m;
-			if (!so.ldsbta && !active[r1]) continue;
+			if (!so().ldsbta && !active[r1]) continue;
 
 			for (int r2 = 0; r2 < n; r2++) {
-				if (!so.ldsbta && !active[r2]) continue;
+				if (!so().ldsbta && !active[r2]) continue;
 				if (r1 == r2) continue;
 				Lit q = getSymLit(p, r1, r2);
-				lbool b = sat.value(q);
+				lbool b = sat().value(q);
 				if (b == l_True) continue;
 				if (b == l_False) {
 					Clause *c = getSymClause(rc, r1, r2);
 					if (!c) { if (LDSB_DEBUG) printf("Skip ValSeqSym Failure\n"); continue; }
 					c->temp_expl = 1;
-					sat.rtrail.last().push(c);
-					sat.confl = c;
+					sat().rtrail.last().push(c);
+					sat().confl = c;
 					if (LDSB_DEBUG) printf("ValSeqSym Failure\n");
 					free(rc);
 					return false;
@@ -608,7 +611,7 @@ public:
 				}
 		//		printf("Level %d, Extra ValSeqSym implication %d -> %d\n", engine.decisionLevel(), v, i);
 				assert((*s)[0] == q);
-				ldsb.addLearntClause(*s, sym_id);
+				ldsb->addLearntClause(*s, sym_id);
 			}
 
 		}
@@ -625,7 +628,7 @@ public:
 		Clause& c = *r;
 
 		for (int i = 1; i < c.size(); i++) {
-			int var_id = sat.c_info[var(c[i])].cons_id;
+			int var_id = sat().c_info[var(c[i])].cons_id;
 			// Not in sym, ignore
 			if (var_id == -1 || !which_vars[var_id]) {
 				ps.push(c[i]);
@@ -639,9 +642,9 @@ public:
 				continue;
 			}
 			// Not ok, must be bounds lit
-			if (sat.c_info[var(c[i])].val_type) {
-				IntVarEL *var = (IntVarEL*) engine.vars[var_id];
-				int v = (toInt(c[i]) - ((IntVarEL*) engine.vars[var_id])->getBaseBLit());
+			if (sat().c_info[var(c[i])].val_type) {
+				IntVarEL *var = (IntVarEL*) engine().vars[var_id];
+				int v = (toInt(c[i]) - ((IntVarEL*) engine().vars[var_id])->getBaseBLit());
 				if (v % 2 == 1) {
 					v /= 2;
 					// lit means <= v, and is false
@@ -664,7 +667,7 @@ public:
 	}
 
 	Lit getSymLit(Lit p, int r1, int r2) {
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (!which_vars[var_id]) return p;
 		int v = getLitVal(p);
 		if (v == not_a_val) NOT_SUPPORTED;
@@ -684,10 +687,10 @@ public:
 	}
 
 	int getLitVal(Lit p) {
-		int var_id = sat.c_info[var(p)].cons_id;
+		int var_id = sat().c_info[var(p)].cons_id;
 		if (var_id == -1) return not_a_val;
-		if (sat.c_info[var(p)].val_type) return not_a_val;
-		return (toInt(p) - ((IntVarEL*) engine.vars[var_id])->getBaseVLit())/2;
+		if (sat().c_info[var(p)].val_type) return not_a_val;
+		return (toInt(p) - ((IntVarEL*) engine().vars[var_id])->getBaseVLit())/2;
 	}
 
 };
@@ -34,6 +34,6 @@ void val_sym_ldsb(vec<IntVar*>& x, int l, int u);
 void var_seq_sym_ldsb(int n, int m, vec<IntVar*>& x);
 void val_seq_sym_ldsb(int n, int m, vec<IntVar*>& x, vec<int>& a);
 
-extern LDSB ldsb;
+extern THREAD_LOCAL LDSB *ldsb;
 
 #endif
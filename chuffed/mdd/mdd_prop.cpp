@@ -115,8 +115,8 @@ struct ValLimAsc {
   ValLimAsc(const TrailedSet& _ord) : ord(_ord) { }
 };
 
-vec<int> kfa;
-vec<int> kfb;
+thread_local vec<int> kfa;
+thread_local vec<int> kfb;
 
 
 void MDDCompile(MDDTable& t, _MDD root,
@@ -1113,7 +1113,7 @@ bool MDDProp<U>::fullProp(void)
 
     if( !(res&1) )
     {
-        if( so.lazy )
+        if( so().lazy )
         {
             // Need to assign sat.confl
             vec<int> expl;
@@ -1130,7 +1130,7 @@ bool MDDProp<U>::fullProp(void)
 #endif
             }
 
-            sat.confl = r;
+            sat().confl = r;
         }
 
         return false;
@@ -1145,7 +1145,7 @@ bool MDDProp<U>::fullProp(void)
         {
 //            Clause* r = NULL;
             Reason r = Reason(prop_id,val);
-            if (so.lazy) {
+            if (so().lazy) {
 #if 0
                vec<int> expl;
                genReason(expl, inferences[i]);
@@ -1382,7 +1382,7 @@ bool MDDProp<U>::propagate()
     if( !nodes[0].count_in )
 #endif
     {
-        if( so.lazy )
+        if( so().lazy )
         {
             // Decay activity.
             decayActivity();
@@ -1400,7 +1400,7 @@ bool MDDProp<U>::propagate()
                     : intvars[val_entries[-1*expl[i] - 2].var].getLit(val_entries[-1*expl[i] - 2].val,0);
             }
 
-            sat.confl = r;
+            sat().confl = r;
         }
 
         return false;
@@ -1631,7 +1631,7 @@ found:
         {
 //            Clause* r = NULL;
             Reason r = Reason(prop_id,inferences[i]);
-            if (so.lazy) {
+            if (so().lazy) {
 #if 0
                vec<int> expl;
                genReason(expl, inferences[i]);
@@ -1992,25 +1992,25 @@ void mdd_decomp_dc(vec<IntVar*> xs, MDDTable& t, _MDD root)
   // Compute the decomposition.
   vec<Lit> nodevars;
   for(int ni = 0; ni < nodes.size(); ni++)
-    nodevars.push(Lit(sat.newVar(), 1));
+    nodevars.push(Lit(sat().newVar(), 1));
 
   vec<Lit> edgevars;
   for(int ei = 0; ei < edges.size(); ei++)
-    edgevars.push(Lit(sat.newVar(), 1));
+    edgevars.push(Lit(sat().newVar(), 1));
 
   // Edge constraints
   for(int ei = 0; ei < edges.size(); ei++)
   {
     inc_edge& e(edges[ei]);
     // ~dest -> ~e
-    sat.addClause(nodevars[e.end], ~edgevars[ei]);
+    sat().addClause(nodevars[e.end], ~edgevars[ei]);
 
     // ~val -> ~e
     Lit vlit = xs[vals[e.val].var]->getLit(vals[e.val].val, 1);
-    sat.addClause(vlit, ~edgevars[ei]);
+    sat().addClause(vlit, ~edgevars[ei]);
 
     // ~parent -> ~e
-    sat.addClause(nodevars[e.begin], ~edgevars[ei]);
+    sat().addClause(nodevars[e.begin], ~edgevars[ei]);
   }
 
   // Node constraints
@@ -2028,13 +2028,13 @@ void mdd_decomp_dc(vec<IntVar*> xs, MDDTable& t, _MDD root)
         int pedge = node_edges[pi]; 
         cl.push(edgevars[pedge]);
       }
-      sat.addClause(cl);
+      sat().addClause(cl);
     } else {
       // If there are no incoming nodes, it must be the root.
       assert(ni == 1);
       vec<Lit> cl;
       cl.push(nodevars[ni]);
-      sat.addClause(cl);
+      sat().addClause(cl);
     }
 
     // (~c_0, ~c_1, ...) -> ~n
@@ -2047,13 +2047,13 @@ void mdd_decomp_dc(vec<IntVar*> xs, MDDTable& t, _MDD root)
         int cedge = node_edges[ci]; 
         cl.push(edgevars[cedge]);
       }
-      sat.addClause(cl);
+      sat().addClause(cl);
     } else {
       // Must be the T terminal.
       assert(ni == 0);
       vec<Lit> cl;
       cl.push(nodevars[ni]);
-      sat.addClause(cl);
+      sat().addClause(cl);
     }
   }
 
@@ -2071,12 +2071,12 @@ void mdd_decomp_dc(vec<IntVar*> xs, MDDTable& t, _MDD root)
         int cedge = val_edges[ci]; 
         cl.push(edgevars[cedge]);
       }
-      sat.addClause(cl);
+      sat().addClause(cl);
     } else {
       // Value is already false.
       vec<Lit> cl;
       cl.push(~vlit);
-      sat.addClause(cl);
+      sat().addClause(cl);
     }
   }
 }
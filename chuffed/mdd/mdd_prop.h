@@ -157,8 +157,7 @@ public:
 
           Clause* c = Clause_new(ps, true);
           c->learnt = true;
-				  sat.addClause(*c);
-          return c;
+          return sat().addClause(*c);
         } else {
           Clause* r = Reason_new(expl.size());
           for(int k = 1; k < expl.size(); k++)
@@ -173,6 +172,11 @@ public:
         in_queue = false;
     }
 
+    void memUsage(MemUsage& mu) {
+        mu.mdd += intvars.bytes() + boolvars.bytes() + val_entries.bytes() + nodes.bytes()
+                + val_edges.bytes() + node_edges.bytes() + edges.bytes() + activity.bytes();
+    }
+
 private:
     void clear_val(Value v);
     void kill_dom(unsigned int, inc_edge* e, vec<int>& kfa, vec<int>& kfb);
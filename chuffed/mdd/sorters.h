@@ -16,20 +16,20 @@ struct FullCmp {
     cl.push(~c);
     cl.push(a);
     cl.push(b);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
-    sat.addClause(c, ~a);
-    sat.addClause(c, ~b);
+    sat().addClause(c, ~a);
+    sat().addClause(c, ~b);
 
     // (d <-> a /\ b)
     cl.clear();
     cl.push(d);
     cl.push(~a);
     cl.push(~b);
-    sat.addClause(cl);
+    sat().addClause(cl);
 
-    sat.addClause(~d,a);
-    sat.addClause(~d,b);
+    sat().addClause(~d,a);
+    sat().addClause(~d,b);
   }
 };
 
@@ -37,14 +37,14 @@ struct HalfCmp {
   static void cmp(Lit a, Lit b, Lit c, Lit d)
   {
     // (c <-> a \/ b)
-    sat.addClause(c, ~a);
-    sat.addClause(c, ~b);
+    sat().addClause(c, ~a);
+    sat().addClause(c, ~b);
 
     vec<Lit> cl;
     cl.push(d);
     cl.push(~a);
     cl.push(~b);
-    sat.addClause(cl);
+    sat().addClause(cl);
   }
 };
 
@@ -62,8 +62,8 @@ static void PWSplit(vec<Lit>& as, vec<Lit>& bs, vec<Lit>& cs)
 
   for(int ii = 0; ii < as.size(); ii += 2)
   {
-    Lit b(Lit(sat.newVar(),1));
-    Lit c(Lit(sat.newVar(),1));
+    Lit b(Lit(sat().newVar(),1));
+    Lit c(Lit(sat().newVar(),1));
 
     CMP::cmp(as[ii], as[ii+1], b, c);
 
@@ -83,8 +83,8 @@ static void PWSplit_mid(vec<Lit>& as, vec<Lit>& bs, vec<Lit>& cs)
   int mid = as.size()/2;
   for(int ii = 0; ii < mid; ii++)
   {
-    Lit b(Lit(sat.newVar(),1));
-    Lit c(Lit(sat.newVar(),1));
+    Lit b(Lit(sat().newVar(),1));
+    Lit c(Lit(sat().newVar(),1));
 
     CMP::cmp(as[ii], as[mid + ii], b, c);
 
@@ -134,8 +134,8 @@ static void PWMerge(int max, vec<Lit>& as, vec<Lit>& bs, vec<Lit>& os)
     os.push(ds[0]);
     for(int ii = 0; ii < as.size()-1; ii++)
     {
-      Lit oa(Lit(sat.newVar(),1));
-      Lit ob(Lit(sat.newVar(),1));
+      Lit oa(Lit(sat().newVar(),1));
+      Lit ob(Lit(sat().newVar(),1));
       CMP::cmp(es[ii], ds[ii+1], oa, ob);
 
       os.push(oa);
@@ -187,8 +187,8 @@ static void OEMerge(int max, vec<Lit>& as, vec<Lit>& bs, vec<Lit>& os)
   
   if(as.size() == 1)
   {
-    Lit oa(Lit(sat.newVar(),1));
-    Lit ob(Lit(sat.newVar(),1));
+    Lit oa(Lit(sat().newVar(),1));
+    Lit ob(Lit(sat().newVar(),1));
     CMP::cmp(as[0],bs[0],oa,ob);
 
     os.push(oa);
@@ -223,8 +223,8 @@ static void OEMerge(int max, vec<Lit>& as, vec<Lit>& bs, vec<Lit>& os)
     os.push(ds[0]);
     for(int ii = 0; ii < as.size()-1; ii++)
     {
-      Lit oa(Lit(sat.newVar(),1));
-      Lit ob(Lit(sat.newVar(),1));
+      Lit oa(Lit(sat().newVar(),1));
+      Lit ob(Lit(sat().newVar(),1));
       CMP::cmp(es[ii], ds[ii+1], oa, ob);
 
       os.push(oa);
@@ -290,6 +290,20 @@ void WMDDProp::compact()
 #endif
 }
 
+static long long disjBytes(Disj *d) {
+  return d ? sizeof(Disj) + (d->sz - 1) * sizeof(EdgeID) : 0;
+}
+
+void WMDDProp::memUsage(MemUsage& mu)
+{
+  mu.mdd += intvars.bytes() + varinfo.bytes() + boolvars.bytes() + vals.bytes() + nodes.bytes()
+          + in_base.bytes() + out_base.bytes() + edges.bytes();
+  for(int vi = 0; vi < vals.size(); vi++)
+    mu.mdd += disjBytes(vals[vi].edges);
+  for(int ni = 0; ni < nodes.size(); ni++)
+    mu.mdd += disjBytes(nodes[ni].in) + disjBytes(nodes[ni].out);
+}
+
 bool WMDDProp::propagate()
 {
 #ifdef FULL_PROP
@@ -300,7 +314,7 @@ bool WMDDProp::propagate()
   bool ret = incProp();
 #endif
 
-  if(sat.decisionLevel() == 0 && ret)
+  if(sat().decisionLevel() == 0 && ret)
     compact();
 
   return ret;
@@ -367,14 +381,14 @@ bool WMDDProp::fullProp(void)
     for(qidx = 0; qidx < stateQ.size(); qidx++)
       nodes[stateQ[qidx]].status = 0;
 
-    if( so.lazy )
+    if( so().lazy )
     {
       // Generate an explanation.
       for(int vv = 0; vv < vals.size(); vv++)
         vals[vv].status = 0;
 
       Clause* r = explainConflict();
-      sat.confl = r;
+      sat().confl = r;
     }
     return false;
   }
@@ -743,11 +757,11 @@ bool WMDDProp::incProp(void)
     // earlier
     if(nodes[root].out_pathC > maxC)
     {
-      if( so.lazy )
+      if( so().lazy )
       {
         // Generate an explanation.
         Clause* r = explainConflict();
-        sat.confl = r;
+        sat().confl = r;
       }
       return false;
     }
@@ -783,11 +797,11 @@ bool WMDDProp::incProp(void)
   int minC = nodes[T].in_pathC;
   if(minC > maxC)
   {
-    if( so.lazy )
+    if( so().lazy )
     {
       // Generate an explanation.
       Clause* r = explainConflict();
-      sat.confl = r;
+      sat().confl = r;
     }
     return false;
   }
@@ -1541,8 +1555,7 @@ Clause* WMDDProp::explain(Lit p, int inf)
     expln[0] = p;
     Clause* c = Clause_new(expln, true);
     c->learnt = true;
-    sat.addClause(*c);
-    return c;
+    return sat().addClause(*c);
   } else {
     Clause* r = Reason_new(expln.size());
     for( int ii = 1; ii < expln.size(); ii++ )
@@ -1647,8 +1660,7 @@ Clause* WMDDProp::incExplain(Lit p, int var, int val)
     expln[0] = p;
     Clause* c = Clause_new(expln, true);
     c->learnt = true;
-    sat.addClause(*c);
-    return c;  
+    return sat().addClause(*c);
   } else {
     Clause* r = Reason_new(expln.size());
     for( int ii = 0; ii < expln.size(); ii++ )
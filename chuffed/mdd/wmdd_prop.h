@@ -162,6 +162,8 @@ public:
     in_queue = false;
   }
 
+  void memUsage(MemUsage& mu);
+
 protected:
   // ===========================
   // Rewinding methods
@@ -9,7 +9,7 @@
 #define ULEVEL_LIMIT 3
 #define LLEVEL_LIMIT 3
 
-MIP *mip;
+THREAD_LOCAL MIP *mip;
 
 //-----
 // Main propagator methods
@@ -17,6 +17,7 @@ MIP *mip;
 MIP::MIP() : level_lb(-1), level_ub(-1), status(0), simplex_time(duration::zero()) {
 //	priority = 3;
 	priority = 0;
+	simplex = new Simplex();
 }
 
 void MIP::addConstraint(vec<int>& a, vec<IntVar*>& x, long double lb, long double ub) {
@@ -42,15 +43,15 @@ void MIP::addConstraint(vec<int>& a, vec<IntVar*>& x, long double lb, long doubl
 }
 
 void MIP::init() {
-	if (engine.opt_var == NULL) {
+	if (engine().opt_var == NULL) {
 		printf("Not an optimization problem, turning off MIP\n");
-		so.mip = false;
+		so().mip = false;
 		return;
 	}
 
-	var_set.erase(engine.opt_var);
-	var_map.insert(pair<IntVar*,int>(engine.opt_var, 0));
-	vars.push(engine.opt_var);
+	var_set.erase(engine().opt_var);
+	var_map.insert(pair<IntVar*,int>(engine().opt_var, 0));
+	vars.push(engine().opt_var);
 
 	for (set<IntVar*>::iterator it = var_set.begin(); it != var_set.end(); it++) {
 		IntVar* v = *it;
@@ -62,7 +63,7 @@ void MIP::init() {
 	RL.growTo(vars.size());
 	place.growTo(vars.size());
 
-	simplex.init();
+	simplex->init();
 
 }
 
@@ -97,7 +98,7 @@ bool MIP::propagate() {
 		return false;
 	}
 
-	engine.last_prop = this;
+	engine().last_prop = this;
 
 	return true;
 }
@@ -118,13 +119,13 @@ void MIP::btToLevel(int level) {
 	if (RESTORE_ROOT && level == 0) {
 		bctrail.resize(bctrail_lim[0]);
 		bctrail_lim.resize(0);
-		simplex.loadState(simplex.root);
+		simplex->loadState(simplex->root);
 		return;
 	}
   for (int i = bctrail.size(); i-- > bctrail_lim[level]; ) {
 		BoundChange& bc = bctrail[i];
-		if (bc.w == simplex.shift[bc.v]) {
-			simplex.boundChange(bc.v, -bc.d);
+		if (bc.w == simplex->shift[bc.v]) {
+			simplex->boundChange(bc.v, -bc.d);
 		}
 	}
   bctrail.resize(bctrail_lim[level]);
@@ -143,30 +144,27 @@ void MIP::btToLevel(int level) {
 void MIP::unboundedFailure() {
 //	NOT_SUPPORTED;
 //	if (MIP_DEBUG) 
-//		simplex.unboundedDebug();
+//		simplex->unboundedDebug();
 
-	assert(simplex.row[0] == 0);
+	assert(simplex->row[0] == 0);
 
 	vec<Lit> ps;
 	for (int i = 1; i < vars.size(); i++) {
-		ps.push(simplex.shift[i] == 0 ? vars[i]->getMinLit() : vars[i]->getMaxLit());
+		ps.push(simplex->shift[i] == 0 ? vars[i]->getMinLit() : vars[i]->getMaxLit());
 	}
-	Clause *m_r = Clause_new(ps);
-	m_r->temp_expl = 1;
-	sat.rtrail.last().push(m_r);
-	sat.confl = m_r;
+	sat().confl = Reason_new(ps);
 }
 
 bool MIP::propagateAllBounds() {
 
-//	simplex.checkBasis();
-//	simplex.recalculateRHS();
-//	simplex.checkObjective();
-//	simplex.checkObjective2();
+//	simplex->checkBasis();
+//	simplex->recalculateRHS();
+//	simplex->checkObjective();
+//	simplex->checkObjective2();
 
 
 	for (int i = 1; i < vars.size(); i++) {
-		RL[i] = simplex.obj[i];
+		RL[i] = simplex->obj[i];
 //		printf("%.3f ", RL[i]);
 	}
 //	printf("level = %d\n", decisionLevel());
@@ -176,9 +174,9 @@ bool MIP::propagateAllBounds() {
 
 	ps.clear();
 
-	if (so.lazy) {
+	if (so().lazy) {
 		place[0] = 0;
-		ps.push(engine.opt_type == OPT_MIN ? vars[0]->getMaxLit() : vars[0]->getMinLit());
+		ps.push(engine().opt_type == OPT_MIN ? vars[0]->getMaxLit() : vars[0]->getMinLit());
 		for (int i = 1; i < vars.size(); i++) {
 			place[i] = ps.size();
 			if (RL[i] > 0) ps.push(vars[i]->getMinLit());
@@ -188,9 +186,9 @@ bool MIP::propagateAllBounds() {
 
 	// Propagate bounds on all vars
 
-//	fprintf(stderr, "objVarBound() = %.3Lf, optimum = %.3Lf\n", objVarBound(), simplex.optimum()); 
+//	fprintf(stderr, "objVarBound() = %.3Lf, optimum = %.3Lf\n", objVarBound(), simplex->optimum()); 
 
-	long double slack = objVarBound() - simplex.optimum(); // can this be sharpend?
+	long double slack = objVarBound() - simplex->optimum(); // can this be sharpend?
 
 
 	if (slack < 0) {
@@ -201,13 +199,13 @@ bool MIP::propagateAllBounds() {
 //		printf("\n");
 	}
 
-	if (engine.opt_type == OPT_MIN && !propagateBound<1>(0, slack)) return false;
-	if (engine.opt_type == OPT_MAX && !propagateBound<0>(0, slack)) return false;
+	if (engine().opt_type == OPT_MIN && !propagateBound<1>(0, slack)) return false;
+	if (engine().opt_type == OPT_MAX && !propagateBound<0>(0, slack)) return false;
 
 	if (RC_BOUNDS) for (int i = 1; i < vars.size(); i++) {
 		if (RL[i] == 0) continue;
-		if (simplex.shift[i] == 0 && !propagateBound<0>(i, slack/RL[i])) return false;
-		if (simplex.shift[i] == 1 && !propagateBound<1>(i, -slack/RL[i])) return false;
+		if (simplex->shift[i] == 0 && !propagateBound<0>(i, slack/RL[i])) return false;
+		if (simplex->shift[i] == 1 && !propagateBound<1>(i, -slack/RL[i])) return false;
 	}
 
 	if (rc) {
@@ -228,11 +226,9 @@ bool MIP::propagateBound(int i, long double s) {
 //	fprintf(stderr, "%.3Lf %lld %lld %lld\n", s, v.getMin(), v.getMax(), max);
 	if (v.setMaxNotR(max)) {
 		Clause *m_r = NULL;
-		if (so.lazy) {
-			m_r = Clause_new(ps);
+		if (so().lazy) {
+			m_r = Reason_new(ps);
 			(*m_r)[place[i]] = (*m_r)[0];
-			m_r->temp_expl = 1;
-			sat.rtrail.last().push(m_r);
 		}
 		if (!v.setMax(max, m_r)) return false;
 	}
@@ -240,24 +236,24 @@ bool MIP::propagateBound(int i, long double s) {
 }
 
 long double MIP::objVarBound() {
-	return engine.opt_type == OPT_MIN ? vars[0]->getMax() : -vars[0]->getMin();
+	return engine().opt_type == OPT_MIN ? vars[0]->getMax() : -vars[0]->getMin();
 }
 
 long double MIP::getRC(IntVar* v) {
 	int r = var_map.find(v)->second;
 	if (!(0 <= r && r < vars.size())) printf("%d %d\n", r, vars.size());
 	assert(0 <= r && r < vars.size());
-	if (simplex.ctor[r] == -1) {
-		simplex.reduced_costs[r] = simplex.obj[r];
+	if (simplex->ctor[r] == -1) {
+		simplex->reduced_costs[r] = simplex->obj[r];
 	}
-	if (simplex.reduced_costs[r] >= 0) {
+	if (simplex->reduced_costs[r] >= 0) {
 		v->preferred_val = PV_MIN;
-		if (RAND_RC) return simplex.reduced_costs[r] * myrand(so.rnd_seed) / MYRAND_MAX;
-		return simplex.reduced_costs[r];
+		if (RAND_RC) return simplex->reduced_costs[r] * myrand(so().rnd_seed) / MYRAND_MAX;
+		return simplex->reduced_costs[r];
 	} else {
 		v->preferred_val = PV_MAX;
-		if (RAND_RC) return -simplex.reduced_costs[r] * myrand(so.rnd_seed) / MYRAND_MAX;
-		return -simplex.reduced_costs[r];
+		if (RAND_RC) return -simplex->reduced_costs[r] * myrand(so().rnd_seed) / MYRAND_MAX;
+		return -simplex->reduced_costs[r];
 	}
 }
 
@@ -269,26 +265,26 @@ void MIP::updateBounds() {
 		assert(0 < v && v < vars.size());
 		int min = vars[v]->getMin();
 		int max = vars[v]->getMax();
-		if (min != simplex.lb[v]) {
-			assert(min > simplex.lb[v]);
+		if (min != simplex->lb[v]) {
+			assert(min > simplex->lb[v]);
 //			fprintf(stderr, "var %d lb changed to %d\n", v, min);
-			bctrail.push(BoundChange(v, 0, min-simplex.lb[v]));
-			if (simplex.shift[v] == 0) simplex.boundChange(v, min-simplex.lb[v]);
-			simplex.lb[v] = min;
+			bctrail.push(BoundChange(v, 0, min-simplex->lb[v]));
+			if (simplex->shift[v] == 0) simplex->boundChange(v, min-simplex->lb[v]);
+			simplex->lb[v] = min;
 		}
-		if (max != simplex.ub[v]) {
-			assert(max < simplex.ub[v]);
+		if (max != simplex->ub[v]) {
+			assert(max < simplex->ub[v]);
 //			fprintf(stderr, "var %d ub changed to %d\n", v, max);
-			bctrail.push(BoundChange(v, 1, max-simplex.ub[v]));
-			if (simplex.shift[v] == 1) simplex.boundChange(v, max-simplex.ub[v]);
-			simplex.ub[v] = max;
+			bctrail.push(BoundChange(v, 1, max-simplex->ub[v]));
+			if (simplex->shift[v] == 1) simplex->boundChange(v, max-simplex->ub[v]);
+			simplex->ub[v] = max;
 		}
 	}
 	new_bc.clear();
 }
 
 int MIP::getLimit() {
-  if (so.verbosity >= 2)
+  if (so().verbosity >= 2)
     fprintf(stderr, "l = %d\n", decisionLevel());
 	if (decisionLevel() == 0) return 100000;
 	if (level_lb <= decisionLevel() && decisionLevel() <= level_ub) return 100;
@@ -301,29 +297,34 @@ int MIP::doSimplex() {
 	int steps = 0;
 	int limit = getLimit();
 	for ( ; steps < limit; steps++) {
-		if ((r = simplex.simplex()) != SIMPLEX_IN_PROGRESS) break;
+		if ((r = simplex->simplex()) != SIMPLEX_IN_PROGRESS) break;
 //		if (i == limit-1) printf("limit exceeded\n");
 //		if (i%10 == 0) printf("Optimum = %.3f, ", optimum());
 	}
-	simplex.calcObjBound();
+	simplex->calcObjBound();
 
 //	if (MIP_DEBUG) {
-		int bound = (int) ceil((double) simplex.optimum());
-		if (engine.opt_type == OPT_MAX) bound = -bound;
-		if (steps && so.verbosity >= 2) fprintf(stderr, "level = %d, %d simplex steps, status = %d, bound = %d\n", decisionLevel(), steps, r, bound);
+		int bound = (int) ceil((double) simplex->optimum());
+		if (engine().opt_type == OPT_MAX) bound = -bound;
+		if (steps && so().verbosity >= 2) fprintf(stderr, "level = %d, %d simplex steps, status = %d, bound = %d\n", decisionLevel(), steps, r, bound);
 //		fprintf(stderr, "%d simplex steps, status = %d, bound = %d\n", steps, r, bound);
 //		fprintf(stderr, "%d %d\n", bound, engine.opt_type == OPT_MIN ? vars[0]->getMin() : -vars[0]->getMax());
 //	}
 //		exit(0);
 
 
-	if (decisionLevel() == 0) simplex.saveState(simplex.root);
+	if (decisionLevel() == 0) simplex->saveState(simplex->root);
 
 	return r;
 }
 
+void MIP::memUsage(MemUsage& mu) {
+	if (!so().mip) return;
+	mu.mip += simplex->memUsage() + bctrail.bytes() + bctrail_lim.bytes() + RL.bytes();
+}
+
 void MIP::printStats() {
-	printf("%%%%%%mzn-stat: simplex=%lld\n", simplex.simplexs);
-	printf("%%%%%%mzn-stat: refactors=%lld\n", simplex.refactors);
+	printf("%%%%%%mzn-stat: simplex=%lld\n", simplex->simplexs);
+	printf("%%%%%%mzn-stat: refactors=%lld\n", simplex->refactors);
 }
 
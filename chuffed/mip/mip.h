@@ -71,6 +71,7 @@ public:
 	void setObjective(int val) {}
 	long double getRC(IntVar* v);
 	void printStats();
+	void memUsage(MemUsage& mu);
 
 	// Main propagator methods
 	
@@ -94,6 +95,6 @@ public:
 
 };
 
-extern MIP *mip;
+extern THREAD_LOCAL MIP *mip;
 
 #endif
@@ -9,12 +9,29 @@
 // Ax <= b
 // x >= 0
 
-Simplex simplex;
+THREAD_LOCAL Simplex *simplex;
 
 Simplex::Simplex() : L_cols_zeros(0), U_diag_units(0),
 	recalc_time(0), simplexs(0), refactors(0),
 	sort_col_ratio(ratio), sort_col_nz(AV_nz) {}
 
+// Bytes allocated by init() and held by the LU factors
+long long Simplex::memUsage() {
+	long long b = 0;
+	b += (long long) (2*A_size + m) * sizeof(IndexVal) + (2*m + n) * sizeof(IndexVal*);
+	b += 2 * ((long long) m * m * sizeof(long double) + m * sizeof(long double*));
+	b += (long long) (6*m + 3*(n+m)) * sizeof(long double);
+	b += (long long) (4*m + 3*(n+m) + 1) * sizeof(int) + 2*(n+m) * sizeof(Tint);
+	b += m * sizeof(float) + n * sizeof(double);
+	vec<vec<IndexVal> >* lists[4] = { &L_cols, &L_rows, &U_cols, &U_rows };
+	for (int k = 0; k < 4; k++) {
+		b += lists[k]->bytes();
+		for (int i = 0; i < lists[k]->size(); i++) b += (*lists[k])[i].bytes();
+	}
+	for (int i = 0; i < REFACTOR_FREQ+10; i++) b += sizeof(LUFactor) + lu_factors[i].vals.bytes();
+	return b;
+}
+
 void Simplex::init() {
 	m = mip->ineqs.size();
 	n = mip->vars.size();
@@ -24,7 +41,7 @@ void Simplex::init() {
 		A_size += mip->ineqs[i].a.size();
 	}
 
-  if (so.verbosity >= 2) {
+  if (so().verbosity >= 2) {
     fprintf(stderr, "Number of vars = %d\n", n);
     fprintf(stderr, "Number of cons = %d\n", m);
     fprintf(stderr, "Number of coeffs = %d\n", A_size);
@@ -124,7 +141,7 @@ void Simplex::init() {
 			int c = mip->var_map.find(li.x[j])->second;
 			assert(0 <= c && c < n);
 			long double v = (li.lb_notR ? -li.a[j] : li.a[j]);
-			if (c == 0 && engine.opt_type == OPT_MAX) v = -v;
+			if (c == 0 && engine().opt_type == OPT_MAX) v = -v;
 			*cur_A++ = IndexVal(c, v);
 			temp_A[c].push(IndexVal(i, v));
 //			fprintf(stderr, "%d:%.0Lf ", c, v);
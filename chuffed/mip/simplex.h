@@ -160,6 +160,8 @@ public:
 	void saveState(SimplexState& s);
 	void loadState(SimplexState& s);
 
+	long long memUsage();
+
 	// Debug methods
 
 	void printObjective();
@@ -183,7 +185,7 @@ public:
 
 };
 
-extern Simplex simplex;
+extern THREAD_LOCAL Simplex *simplex;
 
 
 inline void Simplex::checkZero13(long double& a) {
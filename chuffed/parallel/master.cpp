@@ -25,15 +25,15 @@ Master::Master() :
 
 void Master::initMPI() {
 	MPI_Init(NULL, NULL);
-  MPI_Comm_size(MPI_COMM_WORLD, &so.num_threads);
-  MPI_Comm_rank(MPI_COMM_WORLD, &so.thread_no);
+  MPI_Comm_size(MPI_COMM_WORLD, &so().num_threads);
+  MPI_Comm_rank(MPI_COMM_WORLD, &so().thread_no);
 
-	so.num_threads--;
-	so.thread_no--;
+	so().num_threads--;
+	so().thread_no--;
 
 //	printf("num_threads = %d, thread_no = %d\n", so.num_threads, so.thread_no);
 
-	if (so.num_threads > MAX_SLAVES) ERROR("Maximum number of slaves (%d) exceeded!\n", MAX_SLAVES);
+	if (so().num_threads > MAX_SLAVES) ERROR("Maximum number of slaves (%d) exceeded!\n", MAX_SLAVES);
 }
 
 void Master::finalizeMPI() {
@@ -44,7 +44,7 @@ void Master::solve() {
 
 //	fprintf(stderr, "Start master solve\n");
 
-	num_threads = so.num_threads;
+	num_threads = so().num_threads;
 	job_start_time.growTo(num_threads, DONT_DISTURB);
 	cur_job.growTo(num_threads, NULL);
 	lhead.growTo(num_threads, 0);
@@ -57,7 +57,7 @@ void Master::solve() {
 
 //	fprintf(stderr, "Start master loop\n");
 	// Search:
-	while (status == RES_UNK && time(NULL) < so.time_out) {
+	while (status == RES_UNK && time(NULL) < so().time_out) {
 
 		while (num_free_slaves > 0 && job_queue.size() > 0) sendJob();
 
@@ -208,10 +208,10 @@ void Master::receiveLearnts(Report& r, int thread_no, int message_length) {
 	for (int i = 0; i < r.num_learnts; i++) {
 		assert(sc->size > 0);
 		if (sc->size == 1) {
-			sat.convertToClause(*sc);
-			Lit x = sat.out_learnt[0];
-			if (sat.value(x) == l_False) { status = RES_GUN; return; }
-			if (sat.value(x) == l_Undef) { sat.enqueue(x); }
+			sat().convertToClause(*sc);
+			Lit x = sat().out_learnt[0];
+			if (sat().value(x) == l_False) { status = RES_GUN; return; }
+			if (sat().value(x) == l_Undef) { sat().enqueue(x); }
 		}
 		shared++;
 		shared_len += sc->size;
@@ -237,7 +237,7 @@ void Master::sendJob() {
 
 	profile_start();
 
-	int thread_no = rand()%(num_threads);
+	int thread_no = engine().randInt(num_threads);
 	while (job_start_time[thread_no] != NOT_WORKING) thread_no = (thread_no+1)%num_threads;
 
 	num_free_slaves--;
@@ -323,14 +323,14 @@ void Master::receiveJobs() {
 
 	assert(message_length <= TEMP_SC_LEN);
 
-	memcpy(sat.temp_sc, message + 1, (message_length-1) * sizeof(int));
-	assert(cur_job[thread_no]->size + message[0] == sat.temp_sc->size);
+	memcpy(sat().temp_sc, message + 1, (message_length-1) * sizeof(int));
+	assert(cur_job[thread_no]->size + message[0] == sat().temp_sc->size);
 	free(cur_job[thread_no]);
-	cur_job[thread_no] = sat.temp_sc->copy();
+	cur_job[thread_no] = sat().temp_sc->copy();
 	for (int i = 0; i < message[0]; i++) {
-		sat.temp_sc->negateLast();
-		job_queue.push(sat.temp_sc->copy());
-		sat.temp_sc->pop();
+		sat().temp_sc->negateLast();
+		job_queue.push(sat().temp_sc->copy());
+		sat().temp_sc->pop();
 	}
 
 	free(message);
@@ -343,9 +343,9 @@ void Master::receiveJobs() {
 
 void Master::collectStats() {
 	int64_t dummy = 0;
-	MPI_Reduce(&dummy, &engine.conflicts, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce(&dummy, &engine.propagations, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce(&dummy, &engine.opt_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&dummy, &engine().conflicts, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&dummy, &engine().propagations, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&dummy, &engine().opt_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
 }
 
 void Master::printStats() {
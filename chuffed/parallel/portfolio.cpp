@@ -0,0 +1,310 @@
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chuffed/core/options.h>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/sat.h>
+#include <chuffed/core/solver.h>
+#include <chuffed/vars/int-var.h>
+#include <chuffed/mip/mip.h>
+#include <chuffed/parallel/portfolio.h>
+
+#define QUEUE_LOG_SIZE 16
+
+Portfolio portfolio;
+
+//-----
+// ClauseQueue
+
+ClauseQueue::ClauseQueue(int log_size) : buf(1 << log_size), mask((1 << log_size) - 1), head(0), tail(0) {}
+
+bool ClauseQueue::push(vec<int>& c) {
+	unsigned int t = tail.load(std::memory_order_relaxed);
+	unsigned int h = head.load(std::memory_order_acquire);
+	if ((unsigned int) c.size() + 1 > buf.size() - (t - h)) return false;
+	buf[t++ & mask] = c.size();
+	for (int i = 0; i < c.size(); i++) buf[t++ & mask] = c[i];
+	tail.store(t, std::memory_order_release);
+	return true;
+}
+
+bool ClauseQueue::pop(vec<int>& c) {
+	unsigned int h = head.load(std::memory_order_relaxed);
+	if (h == tail.load(std::memory_order_acquire)) return false;
+	int sz = buf[h++ & mask];
+	c.clear();
+	for (int i = 0; i < sz; i++) c.push(buf[h++ & mask]);
+	head.store(h, std::memory_order_release);
+	return true;
+}
+
+//-----
+// PortfolioThread
+
+PortfolioThread::PortfolioThread(int t) :
+		thread_no(t)
+	, solver(NULL)
+	, status(RES_UNK)
+	, signature(-1)
+	, bound_version(0)
+	, exported(0)
+	, imported(0)
+{}
+
+//-----
+// Portfolio
+
+Portfolio::Portfolio() :
+		running(false)
+	, num_threads(1)
+	, finished(false)
+	, bound_version(0)
+	, best(0)
+	, winner(-1)
+	, solutions(0)
+{}
+
+// Options of thread t > 0. Thread 0 always runs the options given by the user.
+void Portfolio::diversify(Options& o, int t) {
+	o.rnd_seed += t;
+	o.restart_type_override = false;
+	o.restart_scale_override = false;
+	o.restart_base_override = false;
+	switch (t % 4) {
+		case 1:                             // Activity-based search
+			o.vsids = true;
+			o.restart_type = LUBY;
+			o.restart_scale = 100;
+			break;
+		case 2:                             // Alternate user and activity-based search
+			o.toggle_vsids = true;
+			o.restart_type = CHUFFED_DEFAULT;
+			o.restart_scale = 100;
+			break;
+		case 3:                             // Activity-based search, other polarity
+			o.vsids = true;
+			o.sat_polarity = 2;
+			o.restart_type = GEOMETRIC;
+			o.restart_scale = 100;
+			o.restart_base = 1.5;
+			break;
+		default:                            // User search with random tie-breaking
+			o.branch_random = true;
+			o.restart_type = LUBY;
+			o.restart_scale = 250;
+			break;
+	}
+}
+
+void Portfolio::work(int t, std::function<Problem*()> build, const std::string& problemLabel) {
+	PortfolioThread& w = *threads[t];
+
+	w.solver->bind();
+	engine().setOutputStream(w.out);
+
+	Problem *p = build();
+
+	engine().solve(p, problemLabel);
+	w.status = engine().status;
+
+	if (w.status != RES_UNK) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (winner == -1) winner = t;
+		finished = true;
+	}
+}
+
+void Portfolio::solve(std::function<Problem*()> build, const std::string& problemLabel) {
+	num_threads = so().num_threads;
+	if (so().rnd_seed == 0) so().rnd_seed = time(0);
+
+	for (int i = 0; i < num_threads; i++) {
+		threads.push(new PortfolioThread(i));
+		PortfolioThread& w = *threads.last();
+		Options o(so());
+		o.thread_no = i;
+		o.learnt_stats = false;
+		o.learnt_stats_nogood = false;
+		if (i > 0) {
+			diversify(o, i);
+			o.use_profiler = false;
+			o.print_nodes = false;
+			o.print_variable_list = false;
+		}
+		w.solver = new Solver(o);
+	}
+	for (int i = 0; i < num_threads*num_threads; i++) {
+		queues.push(i / num_threads == i % num_threads ? NULL : new ClauseQueue(QUEUE_LOG_SIZE));
+	}
+
+	running = true;
+	std::vector<std::thread> ts;
+	for (int i = 0; i < num_threads; i++) {
+		ts.push_back(std::thread(&Portfolio::work, this, i, build, problemLabel));
+	}
+	for (unsigned int i = 0; i < ts.size(); i++) ts[i].join();
+	running = false;
+
+	std::cout << best_output;
+	if (winner != -1 && (threads[winner]->status == RES_GUN || threads[winner]->status == RES_LUN)) {
+		if (solutions > 0) std::cout << "==========\n";
+		else std::cout << "=====UNSATISFIABLE=====\n";
+	}
+	if (winner == -1 && so().time_out > duration(0)) std::cout << "% Time limit exceeded!\n";
+	std::cout.flush();
+
+	if (so().verbosity >= 1) printStats();
+}
+
+// Called at every node of a worker's search. Returns RES_SEA to continue.
+RESULT Portfolio::sync() {
+	if (finished.load(std::memory_order_relaxed)) return RES_UNK;
+	PortfolioThread& w = *threads[so().thread_no];
+
+	if (w.signature == -1) w.signature = (long long) engine().vars.size() << 32 | sat().orig_cutoff;
+
+	unsigned int v = bound_version.load(std::memory_order_acquire);
+	if (engine().opt_var && v != w.bound_version) {
+		w.bound_version = v;
+		int b = best.load(std::memory_order_relaxed);
+		if (engine().solutions == 0 || (engine().opt_type ? b > engine().best_sol : b < engine().best_sol)) {
+			// Same as Engine::constrain, with somebody else's solution
+			engine().best_sol = b;
+			sat().btToLevel(0);
+			Lit p = engine().opt_type ? engine().opt_var->getLit(b+1, 2) : engine().opt_var->getLit(b-1, 3);
+			engine().assumptions.clear();
+			engine().assumptions.push(toInt(p));
+			if (so().mip) mip->setObjective(b);
+		}
+	}
+
+	if (engine().decisionLevel() == 0 && !importClauses()) return RES_GUN;
+
+	return RES_SEA;
+}
+
+// Called after a worker has printed a solution into its own stream. Returns
+// false if the search is over and the solution must be discarded.
+bool Portfolio::publishSolution() {
+	PortfolioThread& w = *threads[so().thread_no];
+	std::lock_guard<std::mutex> lock(mutex);
+	if (finished) return false;
+	std::string sol = w.out.str();
+	w.out.str("");
+
+	if (engine().opt_var) {
+		int val = engine().opt_var->getVal();
+		if (solutions > 0 && !(engine().opt_type ? val > best : val < best)) return true;
+		best = val;
+		bound_version++;
+	} else {
+		// Another thread may have found it first
+		if (so().nof_solutions != 1 && !published.insert(sol).second) return true;
+		if (solutions + 1 == so().nof_solutions) {
+			winner = so().thread_no;
+			finished = true;
+		}
+	}
+	solutions++;
+
+	if (engine().opt_var && so().nof_solutions != 0 && !so().intermediate) {
+		best_output = sol;
+	} else {
+		std::cout << sol;
+		std::cout.flush();
+	}
+	return true;
+}
+
+//-----
+// Clause sharing
+//
+// Literals of variables that existed when the search started are numbered
+// the same in all threads. Lazily created bound literals are sent as
+// (var_id, value) pairs, other literals created during search are not shared.
+
+void Portfolio::exportClause(Clause& c) {
+	PortfolioThread& w = *threads[so().thread_no];
+	vec<int>& e = w.encoded;
+	e.clear();
+	for (int i = 0; i < c.size(); i++) {
+		int v = var(c[i]);
+		if (v < sat().orig_cutoff) {
+			e.push(toInt(c[i]));
+		} else {
+			ChannelInfo& ci = sat().c_info[v];
+			if (ci.cons_type != 1 || ci.val_type != 1) return;
+			e.push(-1 - (int) (2*ci.cons_id + sign(c[i])));
+			e.push(ci.val);
+		}
+	}
+	for (int i = 0; i < num_threads; i++) {
+		if (i != so().thread_no) queue(so().thread_no, i).push(e);
+	}
+	w.exported++;
+}
+
+bool Portfolio::importClauses() {
+	PortfolioThread& w = *threads[so().thread_no];
+	for (int i = 0; i < num_threads; i++) {
+		if (i == so().thread_no || threads[i]->signature != w.signature) continue;
+		while (queue(i, so().thread_no).pop(w.encoded)) {
+			if (!addSharedClause(w.encoded)) return false;
+			w.imported++;
+		}
+	}
+	return true;
+}
+
+// Add a clause from another thread at the root. Returns false on failure.
+bool Portfolio::addSharedClause(vec<int>& e) {
+	PortfolioThread& w = *threads[so().thread_no];
+	assert(engine().decisionLevel() == 0);
+	vec<Lit>& ps = w.lits;
+	ps.clear();
+	for (int i = 0; i < e.size(); i++) {
+		Lit p;
+		if (e[i] >= 0) {
+			p = toLit(e[i]);
+		} else {
+			int x = -1 - e[i];
+			IntVar *v = engine().vars[x >> 1];
+			int val = e[++i];
+			p = (x & 1) ? v->getLit(val+1, 2) : v->getLit(val, 3);
+		}
+		if (sat().value(p) == l_True) return true;
+		if (sat().value(p) == l_Undef) ps.push(p);
+	}
+	if (ps.size() == 0) return false;
+	if (ps.size() == 1) {
+		sat().enqueue(ps[0]);
+		return true;
+	}
+	Clause *c = Clause_new(ps, true);
+	c->activity() = sat().cla_inc;
+	c->rawActivity() = 0;
+	c->clauseID() = -1;
+	sat().addClause(*c, false);
+	return true;
+}
+
+void Portfolio::printStats() {
+	PortfolioThread& w = *threads[winner == -1 ? 0 : winner];
+	Solver *prev = solver_ptr;
+	w.solver->bind();
+	so().thread_no = -1;
+	if (engine().opt_var && solutions > 0) engine().best_sol = best;
+	engine().printStats();
+	prev->bind();
+
+	long long exported = 0, imported = 0;
+	for (int i = 0; i < num_threads; i++) {
+		exported += threads[i]->exported;
+		imported += threads[i]->imported;
+	}
+	printf("%%%%%%mzn-stat: threads=%d\n", num_threads);
+	printf("%%%%%%mzn-stat: winningThread=%d\n", winner);
+	printf("%%%%%%mzn-stat: sharedClauses=%lld\n", exported);
+	printf("%%%%%%mzn-stat: importedClauses=%lld\n", imported);
+}
@@ -0,0 +1,109 @@
+#ifndef portfolio_h
+#define portfolio_h
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/sat-types.h>
+
+// Shared memory portfolio search (-p <n>).
+//
+// Each thread builds its own copy of the problem in its own Solver instance
+// and searches it with diversified options. Short
+// learnt clauses and objective bounds are exchanged between the threads, and
+// the first thread to finish the search ends it for all of them.
+//
+// When several solutions of a satisfaction problem are asked for, every
+// thread enumerates them and each one is printed by the first thread to
+// find it. A thread's learnt clauses may exclude the solutions it has found,
+// which is sound for the others because those solutions have been printed.
+
+class Clause;
+class Options;
+class Solver;
+
+//-----
+// Single producer, single consumer ring of encoded clauses. Clauses that do
+// not fit are dropped, the producer never waits.
+
+class ClauseQueue {
+	vec<int> buf;
+	unsigned int mask;
+	std::atomic<unsigned int> head;         // Next position to read
+	std::atomic<unsigned int> tail;         // Next position to write
+
+public:
+	ClauseQueue(int log_size);
+
+	bool push(vec<int>& c);
+	bool pop(vec<int>& c);
+};
+
+//-----
+
+class PortfolioThread {
+public:
+	int thread_no;
+
+	Solver *solver;                         // Instance searched by this thread
+
+	RESULT status;
+	std::stringstream out;                  // Solutions are printed here first
+	std::atomic<long long> signature;       // Problem size after init, -1 before
+	unsigned int bound_version;             // Last objective bound adopted
+
+	// Scratch space for clause exchange
+	vec<int> encoded;
+	vec<Lit> lits;
+
+	// Stats
+	long long exported, imported;
+
+	PortfolioThread(int t);
+};
+
+class Portfolio {
+public:
+	bool running;                           // Worker threads are searching
+	int num_threads;
+
+	vec<PortfolioThread*> threads;
+	vec<ClauseQueue*> queues;               // queues[from*num_threads+to]
+
+	// Shared search state
+	std::atomic<bool> finished;
+	std::atomic<unsigned int> bound_version;
+	std::atomic<int> best;                  // Best objective value found
+	std::mutex mutex;                       // Protects the state below and std::cout
+	int winner;
+	long long solutions;
+	std::string best_output;
+	std::set<std::string> published;        // Solutions printed when enumerating
+
+	Portfolio();
+
+	// Build the problem in each thread and search until one thread finishes
+	void solve(std::function<Problem*()> build, const std::string& problemLabel = "chuffed");
+
+	// Called from the search of a worker thread
+	RESULT sync();
+	bool publishSolution();
+	void exportClause(Clause& c);
+
+	void printStats();
+
+private:
+	void work(int t, std::function<Problem*()> build, const std::string& problemLabel);
+	void diversify(Options& o, int t);
+	bool importClauses();
+	bool addSharedClause(vec<int>& e);
+	ClauseQueue& queue(int from, int to) { return *queues[from*num_threads+to]; }
+};
+
+extern Portfolio portfolio;
+
+#endif
@@ -21,11 +21,11 @@ Slave::Slave() :
 
 void Slave::solve() {
 
-	thread_no = so.thread_no;
+	thread_no = so().thread_no;
 
-	srand(thread_no+1);
+	engine().rng.seed(thread_no+1);
 
-	checks = rand()%int(report_freq/check_freq);
+	checks = engine().randInt(int(report_freq/check_freq));
 
 	MPI_Buffer_attach(malloc(MPI_BUFFER_SIZE), MPI_BUFFER_SIZE);
 
@@ -35,7 +35,7 @@ void Slave::solve() {
 	while (receiveJob()) {
 		real_time -= wallClockTime();
 //		cpu_time -= cpuTime();
-		status = engine.search();
+		status = engine().search();
 		real_time += wallClockTime();
 //		cpu_time += cpuTime();
 		sendReport();
@@ -63,7 +63,7 @@ bool Slave::receiveJob() {
 
 	assert(message_length <= TEMP_SC_LEN);
 
-	MPI_Recv((int*) sat.temp_sc, message_length, MPI_INT, 0, JOB_TAG, MPI_COMM_WORLD, &s);
+	MPI_Recv((int*) sat().temp_sc, message_length, MPI_INT, 0, JOB_TAG, MPI_COMM_WORLD, &s);
 
 	profile_end("receive job", message_length);
 
@@ -71,16 +71,16 @@ bool Slave::receiveJob() {
 
 //	for (int i = 0; i < message_length; i++) fprintf(stderr, "%d ", message[i]); fprintf(stderr, "\n");
 
-	sat.convertToClause(*sat.temp_sc);
-	for (int i = 0; i < engine.assumptions.size(); i++) {
-		sat.decVarUse(engine.assumptions[i]/2);
+	sat().convertToClause(*sat().temp_sc);
+	for (int i = 0; i < engine().assumptions.size(); i++) {
+		sat().decVarUse(engine().assumptions[i]/2);
 	}
-	engine.assumptions.clear();
-	for (int i = 0; i < sat.out_learnt.size(); i++) {
-		engine.assumptions.push(toInt(sat.out_learnt[i]));
-		sat.incVarUse(engine.assumptions.last()/2);
+	engine().assumptions.clear();
+	for (int i = 0; i < sat().out_learnt.size(); i++) {
+		engine().assumptions.push(toInt(sat().out_learnt[i]));
+		sat().incVarUse(engine().assumptions.last()/2);
 	}
-	sat.btToLevel(0);
+	sat().btToLevel(0);
 	status = RES_SEA;
 
 //	fprintf(stderr, "%d: Assumptions received: ", thread_no);
@@ -93,7 +93,7 @@ bool Slave::receiveJob() {
 }
 
 bool Slave::checkMessages() {
-	if (engine.decisionLevel() <= engine.assumptions.size()) return false;
+	if (engine().decisionLevel() <= engine().assumptions.size()) return false;
 
 	double t = wallClockTime();
 
@@ -157,7 +157,7 @@ void Slave::sendReport() {
 	report_message.clear();
 	report_message.growTo(sizeof(Report)/sizeof(int),0);
 
-	sat.updateShareParam();
+	sat().updateShareParam();
 
 }
 
@@ -170,25 +170,25 @@ void Slave::splitJob() {
 
 	MPI_Recv(&num_splits, 1, MPI_INT, 0, STEAL_TAG, MPI_COMM_WORLD, &s);
 
-	int max_splits = engine.decisionLevel() - engine.assumptions.size() - 1;
+	int max_splits = engine().decisionLevel() - engine().assumptions.size() - 1;
 	if (num_splits > max_splits) num_splits = max_splits;
 	if (num_splits < 0) num_splits = 0;
 
 	if (FULL_DEBUG) fprintf(stderr, "%d: Splitting %d jobs\n", thread_no, num_splits);
 
 	for (int i = 0; i < num_splits; i++) {
-		engine.assumptions.push(toInt(sat.decLit(engine.assumptions.size()+1)));
-		sat.incVarUse(engine.assumptions.last()/2);
+		engine().assumptions.push(toInt(sat().decLit(engine().assumptions.size()+1)));
+		sat().incVarUse(engine().assumptions.last()/2);
 	}
-	assert(num_splits == 0 || engine.decisionLevel() > engine.assumptions.size());
+	assert(num_splits == 0 || engine().decisionLevel() > engine().assumptions.size());
 
 	vec<Lit> ps;
-	for (int i = 0; i < engine.assumptions.size(); i++) ps.push(toLit(engine.assumptions[i]));
+	for (int i = 0; i < engine().assumptions.size(); i++) ps.push(toLit(engine().assumptions[i]));
 	Clause *c = Clause_new(ps);
-	sat.convertToSClause(*c);
+	sat().convertToSClause(*c);
 	free(c);
 	message.push(num_splits);
-	sat.temp_sc->pushInVec(message);
+	sat().temp_sc->pushInVec(message);
 
 	MPI_Bsend((int*) message, message.size(), MPI_INT, 0, SPLIT_TAG, MPI_COMM_WORLD);
 
@@ -198,7 +198,7 @@ void Slave::splitJob() {
 }
 
 void Slave::receiveLearnts() {
-	if (PAR_DEBUG) fprintf(stderr, "%d: Adding foreign clauses, current level = %d\n", thread_no, sat.decisionLevel());
+	if (PAR_DEBUG) fprintf(stderr, "%d: Adding foreign clauses, current level = %d\n", thread_no, sat().decisionLevel());
 
 	profile_start();
 
@@ -216,23 +216,23 @@ void Slave::receiveLearnts() {
 
 	SClause *sc = (SClause*) r.data;
 	for (int i = 0; i < r.num_learnts; i++) {
-		sat.convertToClause(*sc);
+		sat().convertToClause(*sc);
 		if (sc->size == 1) {
-			Lit x = sat.out_learnt[0];
-			if (sat.value(x) != l_True || sat.level[var(x)] != 0) {
-				sat.btToLevel(0);
-				if (sat.value(x) == l_False) assert(false);
-				sat.enqueue(x);
+			Lit x = sat().out_learnt[0];
+			if (sat().value(x) != l_True || sat().level[var(x)] != 0) {
+				sat().btToLevel(0);
+				if (sat().value(x) == l_False) assert(false);
+				sat().enqueue(x);
 			}
 		} else {
-			sat.addLearnt();
+			sat().addLearnt();
 		}
 		sc = sc->getNext();
 	}
 
 	profile_end("processing learnts", message_length);
 
-	if (PAR_DEBUG) fprintf(stderr, "%d: Added foreign clauses, new level = %d\n", thread_no, sat.decisionLevel());
+	if (PAR_DEBUG) fprintf(stderr, "%d: Added foreign clauses, new level = %d\n", thread_no, sat().decisionLevel());
 
 	free(message);
 
@@ -242,11 +242,11 @@ void SAT::convertToSClause(Clause& c) {
 	assert(c.size() <= TEMP_SC_LEN/2);
 	temp_sc->size = c.size();
 	temp_sc->extra = 0;
-	temp_sc->source = so.thread_no;
+	temp_sc->source = so().thread_no;
 	int j = 0;
 	for (int i = 0; i < c.size(); i++) {
 		int vid = c_info[var(c[i])].vid;
-		if (vid != -1 && engine.vars[vid]->getType() == INT_VAR_LL) {
+		if (vid != -1 && engine().vars[vid]->getType() == INT_VAR_LL) {
 			temp_sc->data[j++] = 0x8000000 + vid;
 			temp_sc->data[j++] = c_info[var(c[i])].v ^ sign(c[i]);
 			temp_sc->extra++;
@@ -261,7 +261,7 @@ void SAT::convertToClause(SClause& sc) {
 	int *pt = sc.data;
 	for (int i = 0; i < sc.size; i++) {
 		if (0x8000000 & *pt) {
-			IntVar *v = engine.vars[0x7ffffff & *pt];
+			IntVar *v = engine().vars[0x7ffffff & *pt];
 			assert(v->getType() == INT_VAR_LL);
 			Lit p = ((IntVarLL*) v)->createLit(pt[1]);
 			out_learnt.push(p);
@@ -283,7 +283,7 @@ void SAT::addLearnt() {
 	if (j == c.size()) {
 		int hlevel = level[var(c[0])]; j = 0;
 		for (int k = 1; k < c.size(); k++) if (level[var(c[k])] > hlevel) {hlevel = level[var(c[k])]; j = k;}
-		if (hlevel == 0) { engine.status = RES_GUN; return; }
+		if (hlevel == 0) { engine().status = RES_GUN; return; }
 		btToLevel(hlevel-1);
 		assert(value(c[j]) == l_Undef);
 	}
@@ -308,7 +308,7 @@ void SAT::addLearnt() {
 	Clause *r = Clause_new(c, true);
 	r->activity()  = cla_inc;
 
-	addClause(*r, so.one_watch);
+	r = addClause(*r, so().one_watch);
 
 //	if (r->size() <= 2) sat.rtrail.push(r);
 
@@ -318,9 +318,9 @@ void SAT::addLearnt() {
 
 
 void Slave::sendStats() {
-	MPI_Reduce(&engine.conflicts, NULL, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce(&engine.propagations, NULL, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce(&engine.opt_time, NULL, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&engine().conflicts, NULL, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&engine().propagations, NULL, 1, MPI_LONG_LONG_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&engine().opt_time, NULL, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
 
 	if (PROFILING) fprintf(stderr, "%d: Real time spent searching = %f\n", thread_no, real_time);
 	if (PROFILING) fprintf(stderr, "%d: CPU time spent searching = %f\n", thread_no, cpu_time);
@@ -330,8 +330,8 @@ void Slave::sendStats() {
 // Minor methods
 
 void Slave::shareClause(Clause& c) {
-	sat.convertToSClause(c);
-	sat.temp_sc->pushInVec(report_message);
+	sat().convertToSClause(c);
+	sat().temp_sc->pushInVec(report_message);
 	((Report*) (int*) report_message)->num_learnts++;
 }
 
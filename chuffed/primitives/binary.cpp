@@ -201,8 +201,8 @@ struct IRR {
 		x(_x), t(_t), c(_c), r(_r) {}
 };
 
-vec<IRR> ircs;
-vec<IRR> ihrcs;
+thread_local vec<IRR> ircs;
+thread_local vec<IRR> ihrcs;
 
 
 //-----
@@ -355,7 +355,7 @@ void int_rel_reif_real(IntVar* x, IntRelType t, int c, BoolView r) {
 		TL_SET(x, remVal, c); return;
 	}
 	if (x->getType() == INT_VAR) {
-		assert(!so.lazy);
+		assert(!so().lazy);
 		IntVar* v = getConstant(c);
 		int_rel_reif(x, t, v, r);
 		return;
@@ -380,7 +380,7 @@ void int_rel_half_reif_real(IntVar* x, IntRelType t, int c, BoolView r) {
 		TL_SET(x, remVal, c); return;
 	}
 	if (x->getType() == INT_VAR) {
-		assert(!so.lazy);
+		assert(!so().lazy);
 		IntVar* v = getConstant(c);
 		int_rel_half_reif(x, t, v, r);
 		return;
@@ -390,8 +390,8 @@ void int_rel_half_reif_real(IntVar* x, IntRelType t, int c, BoolView r) {
 		case IRT_EQ: bool_rel(b2, BRT_OR, ~r); bool_rel(b1, BRT_OR, ~r); break;
 		case IRT_NE:
 		{
-			vec<Lit> ps1; ps1.push(~b1); ps1.push(~b2); ps1.push(~r); sat.addClause(ps1);
-			vec<Lit> ps2; ps2.push(b1); ps2.push(b2); ps2.push(~r); sat.addClause(ps2);
+			vec<Lit> ps1; ps1.push(~b1); ps1.push(~b2); ps1.push(~r); sat().addClause(ps1);
+			vec<Lit> ps2; ps2.push(b1); ps2.push(b2); ps2.push(~r); sat().addClause(ps2);
 		}
 		break;
 		case IRT_LE: bool_rel(b2, BRT_OR, ~r); break;
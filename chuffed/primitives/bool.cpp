@@ -30,7 +30,7 @@ void bool_rel(BoolView x, BoolRelType t, BoolView y, BoolView z) {
 					}
 					ps.push(v[m].getLit(p));
 				}
-				if (l >= 2) sat.addClause(ps);
+				if (l >= 2) sat().addClause(ps);
 				u |= flags;
 			}
 		}
@@ -44,7 +44,7 @@ void bool_clause(vec<BoolView>& x, vec<BoolView>& y) {
 	vec<Lit> ps;
 	for (int i = 0; i < x.size(); i++) ps.push(x[i]);
 	for (int i = 0; i < y.size(); i++) ps.push(~y[i]);
-	sat.addClause(ps);
+	sat().addClause(ps);
 }
 
 // \/ x_i
@@ -60,14 +60,14 @@ void bool_clause(vec<BoolView>& x) {
 // n+1 clauses
 
 void array_bool_or(vec<BoolView>& x, vec<BoolView>& y, BoolView z) {
-	for (int i = 0; i < x.size(); i++) sat.addClause(~x[i], z);
-	for (int i = 0; i < y.size(); i++) sat.addClause(y[i], z);
+	for (int i = 0; i < x.size(); i++) sat().addClause(~x[i], z);
+	for (int i = 0; i < y.size(); i++) sat().addClause(y[i], z);
 	// Add clause !c \/ a_i \/ !b_i
 	vec<Lit> ps;
 	ps.push(~z);
 	for (int i = 0; i < x.size(); i++) ps.push(x[i]);
 	for (int i = 0; i < y.size(); i++) ps.push(~y[i]);
-	sat.addClause(ps);
+	sat().addClause(ps);
 }
 
 void array_bool_or(vec<BoolView>& x, BoolView z) {
@@ -1,13 +1,22 @@
+#include <algorithm>
 #include <map>
 #include <chuffed/core/propagator.h>
 
 // y = a[x-offset]
 
 void array_bool_element(IntVar* _x, vec<bool>& a, BoolView y, int offset)	{
+	if (so().element_native_size && a.size() >= so().element_native_size) {
+		IntVar *v = newIntVar(0, 1);
+		bool2int(y, v);
+		vec<int> b;
+		for (int i = 0; i < a.size(); i++) b.push(a[i]);
+		array_int_element(_x, b, v, offset);
+		return;
+	}
 	_x->specialiseToEL();
 	IntView<4> x(_x, 1, -offset);
 	for (int i = 0; i < a.size(); i++) {
-		sat.addClause(y = a[i], x != i);
+		sat().addClause(y = a[i], x != i);
 	}
 	// Add clause [y != x[i]] \/ [x = i_1] \/ ... \/ [x = i_m]
 	vec<Lit> ps1;
@@ -18,18 +27,228 @@ void array_bool_element(IntVar* _x, vec<bool>& a, BoolView y, int offset)	{
 		if (a[i]) ps2.push(x = i);
 		else      ps1.push(x = i);
 	}
-	sat.addClause(ps1);
-	sat.addClause(ps2);
+	sat().addClause(ps1);
+	sat().addClause(ps2);
 }
 
 //-----
 
+// y = a[x], a constant
+//
+// Domain consistent where the domains can have holes, bounds consistent on
+// vars with lazy literals. Each value of a keeps the position where a support
+// was last found, and its removal from y is explained lazily by the positions
+// holding it. Neither var needs eager literals.
+//
+// The values still in y and supported form a trailed sparse set, so holes are
+// only looked for among them, and bounds are only moved from where they are.
+
+class IntElemConst : public Propagator {
+	enum { Y_VAL, Y_MIN, Y_MAX, X_MIN, X_MAX };
+
+	IntView<0> const y;
+	IntView<4> const x;
+	vec<int> a;
+
+	// Distinct values of a in increasing order, each with its positions
+	vec<int> vals;
+	vec<int> pos_start;           // positions of vals[k] are pos[pos_start[k]..pos_start[k+1])
+	vec<int> pos;
+	vec<int> residue;             // position where a support of vals[k] was last found
+
+	// Persistent state
+	vec<int> live;                // values in y and supported in live[0..n_live)
+	Tint n_live;
+
+	// Explanation state
+	vec<Lit> ps;
+
+	static bool hasHoles(IntVar *v) { return v->getType() != INT_VAR_LL && v->vals; }
+
+	// First value number k with vals[k] >= v
+	int valLB(int64_t v) {
+		return std::lower_bound((int*) vals, (int*) vals + vals.size(), v) - (int*) vals;
+	}
+
+	int valId(int64_t v) {
+		int k = valLB(v);
+		return k < vals.size() && vals[k] == v ? k : -1;
+	}
+
+	bool supported(int k) {
+		if (x.indomain(residue[k])) return true;
+		for (int j = pos_start[k]; j < pos_start[k+1]; j++) {
+			if (x.indomain(pos[j])) {
+				residue[k] = pos[j];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Reason reason(int kind, int k) {
+		if (!so().lazy) return Reason();
+		return Reason(prop_id, (k << 3) | kind);
+	}
+
+	// Literal false because y lost v
+	Lit yLit(int v) {
+		if (v < y.getMin()) return y.getMinLit();
+		if (v > y.getMax()) return y.getMaxLit();
+		return y.getLit(v, 1);
+	}
+
+	// Reasons for the positions of vals[k] all being gone from x
+	void explainVal(int k, bool& got_min, bool& got_max) {
+		for (int j = pos_start[k]; j < pos_start[k+1]; j++) {
+			int i = pos[j];
+			if (i < x.getMin()) {
+				if (!got_min) { got_min = true; ps.push(x.getMinLit()); }
+			} else if (i > x.getMax()) {
+				if (!got_max) { got_max = true; ps.push(x.getMaxLit()); }
+			} else ps.push(x.getLit(i, 1));
+		}
+	}
+
+public:
+
+	IntElemConst(IntView<0> _y, IntView<4> _x, vec<int>& _a) : y(_y), x(_x), a(_a) {
+		priority = 1;
+		vec<int> order(a.size());
+		for (int i = 0; i < a.size(); i++) order[i] = i;
+		std::stable_sort((int*) order, (int*) order + order.size(), [&](int i, int j) { return a[i] < a[j]; });
+		for (int j = 0; j < order.size(); j++) {
+			int i = order[j];
+			if (j == 0 || a[i] != vals.last()) {
+				vals.push(a[i]);
+				pos_start.push(j);
+				residue.push(i);
+			}
+			pos.push(i);
+		}
+		pos_start.push(pos.size());
+		for (int k = 0; k < vals.size(); k++) live.push(k);
+		n_live = vals.size();
+
+		// Values of y outside a never come back
+		if (hasHoles(y.var)) {
+			for (IntVar::iterator it = y.var->begin(); it != y.var->end(); ) {
+				int v = *it++;
+				if (valId(v) < 0 && !y.remVal(v)) TL_FAIL();
+			}
+		}
+
+		x.attach(this, 0, EVENT_C);
+		y.attach(this, 1, EVENT_C);
+	}
+
+	bool propagate() {
+		bool x_holes = hasHoles(x.var);
+		bool y_holes = hasHoles(y.var);
+
+		// Values y has lost take their positions out of x, and values without a
+		// position left in x are taken out of y. Bounds are left to the scans
+		// below.
+		if (x_holes || y_holes) {
+			int n = n_live;
+			for (int j = n-1; j >= 0; j--) {
+				int k = live[j];
+				if (y.indomain(vals[k])) {
+					if (supported(k)) continue;
+					if (y_holes && !y.remVal(vals[k], reason(Y_VAL, k))) return false;
+				} else if (x_holes) {
+					Reason r = so().lazy ? Reason(yLit(vals[k])) : Reason();
+					for (int l = pos_start[k]; l < pos_start[k+1]; l++) {
+						if (x.indomain(pos[l]) && !x.remVal(pos[l], r)) return false;
+					}
+				}
+				live[j] = live[--n];
+				live[n] = k;
+			}
+			if (n < n_live) n_live = n;
+		}
+
+		// Positions at the bounds of x whose value y has lost
+		int lo = x.getMin();
+		while (lo <= x.getMax() && !y.indomain(a[lo])) lo++;
+		if (x.setMinNotR(lo) && !x.setMin(lo, reason(X_MIN, lo))) return false;
+		int hi = x.getMax();
+		while (hi >= x.getMin() && !y.indomain(a[hi])) hi--;
+		if (x.setMaxNotR(hi) && !x.setMax(hi, reason(X_MAX, hi+1))) return false;
+
+		// Values at the bounds of y without a position left in x
+		int k = valLB(y.getMin());
+		while (k < vals.size() && vals[k] <= y.getMax() && !supported(k)) k++;
+		if (k == vals.size() || vals[k] > y.getMax()) {
+			if (!y.setMin(y.getMax()+1, reason(Y_MIN, vals.size()))) return false;
+		} else if (y.setMinNotR(vals[k]) && !y.setMin(vals[k], reason(Y_MIN, k))) return false;
+		// The new minimum is supported, so the scan stops there at the latest
+		k = valLB(y.getMax()+1) - 1;
+		while (!supported(k)) k--;
+		if (y.setMaxNotR(vals[k]) && !y.setMax(vals[k], reason(Y_MAX, k))) return false;
+
+		return true;
+	}
+
+	// The state is as it was when p was inferred
+	Clause* explain(Lit p, int inf_id) {
+		int kind = inf_id & 7;
+		int k = inf_id >> 3;
+		bool got_min = false, got_max = false;
+		ps.clear();
+		ps.push();
+		switch (kind) {
+			case Y_VAL:
+				explainVal(k, got_min, got_max);
+				break;
+			case Y_MIN: {
+				// The values from the old minimum up to vals[k] have no support
+				ps.push(y.getMinLit());
+				int64_t m = k < vals.size() ? vals[k] : y.getMax()+1;
+				for (int j = valLB(y.getMin()); j < vals.size() && vals[j] < m; j++) explainVal(j, got_min, got_max);
+				if (m > y.getMax()) ps.push(y.getMaxLit());
+				break;
+			}
+			case Y_MAX: {
+				ps.push(y.getMaxLit());
+				for (int j = k+1; j < vals.size() && vals[j] <= y.getMax(); j++) explainVal(j, got_min, got_max);
+				break;
+			}
+			case X_MIN:
+				// The positions from the old minimum up to k hold values y lost
+				ps.push(x.getMinLit());
+				for (int i = x.getMin(); i < k; i++) ps.push(yLit(a[i]));
+				break;
+			case X_MAX:
+				ps.push(x.getMaxLit());
+				for (int i = k; i <= x.getMax(); i++) ps.push(yLit(a[i]));
+				break;
+			default: NEVER;
+		}
+		return Reason_new(ps);
+	}
+
+};
+
 // y = a[x-offset]
 
 void array_int_element(IntVar* _x, vec<int>& a, IntVar* _y, int offset) {
  	TL_SET(_x, setMin, offset);
 	TL_SET(_x, setMax, a.size()-1+offset);
 
+	if (so().element_native_size && a.size() >= so().element_native_size) {
+		int mn = INT_MAX, mx = INT_MIN;
+		for (int i = 0; i < a.size(); i++) {
+			if (!_x->indomain(i+offset)) continue;
+			mn = std::min(mn, a[i]);
+			mx = std::max(mx, a[i]);
+		}
+		TL_SET(_y, setMin, mn);
+		TL_SET(_y, setMax, mx);
+		new IntElemConst(IntView<>(_y), IntView<4>(_x, 1, -offset), a);
+		return;
+	}
+
 	vec<int> z;
 	for (int i = _x->getMin()-offset; i <= _x->getMax()-offset; i++) {
 		if (!_x->indomain(i+offset)) continue;
@@ -44,7 +263,7 @@ void array_int_element(IntVar* _x, vec<int>& a, IntVar* _y, int offset) {
 	IntView<4> x(_x, 1, -offset);
 
 	for (int i = 0; i < a.size(); i++) {
-		sat.addClause(y = a[i], x != i);
+		sat().addClause(y = a[i], x != i);
 	}
 
 	std::map<int,int> val_to_pss;
@@ -66,7 +285,7 @@ void array_int_element(IntVar* _x, vec<int>& a, IntVar* _y, int offset) {
 		if (x.indomain(i)) pss[index].push(x = i);
 	}
 	for (int i = 0; i < pss.size(); i++) {
-		sat.addClause(pss[i]);
+		sat().addClause(pss[i]);
 	}
 }
 
@@ -85,22 +304,22 @@ void array_var_bool_element(IntVar* _x, vec<BoolView>& a, BoolView y, int offset
 	ps1[0] = ~y;
 	ps2[0] = y;
 	for (int i = 0; i < a.size(); i++) {
-		BoolView c_i(Lit(sat.newVar(),1));
-		BoolView d_i(Lit(sat.newVar(),1));
-		sat.addClause(~c_i, x = i);
-		sat.addClause(~c_i, a[i]);
-		sat.addClause(~d_i, x = i);
-		sat.addClause(~d_i, ~a[i]);
+		BoolView c_i(Lit(sat().newVar(),1));
+		BoolView d_i(Lit(sat().newVar(),1));
+		sat().addClause(~c_i, x = i);
+		sat().addClause(~c_i, a[i]);
+		sat().addClause(~d_i, x = i);
+		sat().addClause(~d_i, ~a[i]);
 		vec<Lit> ps3(3), ps4(3);
 		ps3[0] = y; ps3[1] = ~a[i]; ps3[2] = (x != i);
-		sat.addClause(ps3);
+		sat().addClause(ps3);
 		ps4[0] = ~y; ps4[1] = a[i]; ps4[2] = (x != i);
-		sat.addClause(ps4);
+		sat().addClause(ps4);
 		ps1[i+1] = c_i;
 		ps2[i+1] = d_i;
 	}
-	sat.addClause(ps1);
-	sat.addClause(ps2);
+	sat().addClause(ps1);
+	sat().addClause(ps2);
 }
 
 //-----
@@ -190,7 +409,7 @@ public:
 			min_support = best;
 			if (y.setMinNotR(new_m)) {
 				Clause *r = NULL;
-				if (so.lazy) {
+				if (so().lazy) {
 					r = Reason_new(a.size()+1);
 					// Finesse lower bounds
 					for (int i = 0; i < a.size(); i++) {
@@ -218,7 +437,7 @@ public:
 			max_support = best;
 			if (y.setMaxNotR(new_m)) {
 				Clause *r = NULL;
-				if (so.lazy) {
+				if (so().lazy) {
 					r = Reason_new(a.size()+1);
 					// Finesse upper bounds
 					for (int i = 0; i < a.size(); i++) {
@@ -308,7 +527,7 @@ public:
 			if (f == num_support[v]) {
 				// v has no support, remove from y
 				Clause* r = NULL;
-				if (so.lazy) {
+				if (so().lazy) {
 					r = Reason_new(x.getMax() + 4 - x.getMin());
 					(*r)[1] = x.getMinLit();
 					(*r)[2] = x.getMaxLit();
@@ -353,7 +572,7 @@ public:
 			setDom(f, setMax, y.getMax(), y.getMaxLit(), x.getValLit());
 			for (typename IntView<W>::iterator i = a[v].begin(); i != a[v].end(); ) {
 				int w = *i++;
-				if (!y.indomain(w) && !a[v].remVal(w, so.lazy ? Reason(~y.getLit(w, 0), ~x.getLit(v, 1)) : Reason()))
+				if (!y.indomain(w) && !a[v].remVal(w, so().lazy ? Reason(~y.getLit(w, 0), ~x.getLit(v, 1)) : Reason()))
 					return false;
 			}
 		}
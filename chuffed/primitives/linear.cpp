@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <chuffed/core/propagator.h>
 #include <chuffed/mip/mip.h>
 
@@ -13,17 +14,114 @@ class LinearGE : public Propagator {
 	BoolView r;
 
 	// persistent data
-	int fix;
-	int fix_x;
-	int fix_y;
-	int64_t fix_sum;
+	vec<Tint64_t> term_max;     // max of each term as last seen, by original index
+	Tint64_t max_sum;           // sum of term_max - c
+	vec<int> shared;            // original indices of vars occurring with both signs
+	vec<bool> repeated;         // whether the var of each term occurs in another term too
+
+	// How far term k has moved from its initial bound, in units of the sum
+	struct Gap {
+		int64_t g; int k;
+		bool operator < (const Gap& o) const { return g < o.g || (g == o.g && k < o.k); }
+	};
+
+	// intermediate state
 	vec<Lit> ps;
+	vec<Gap> gaps;
+
+	// Terms are numbered x[0..], then y[0..]
+	int64_t termMax(int k) const { return k < x.size() ? x[k].getMax() : y[k-x.size()].getMax(); }
+	int termA(int k) const { return k < x.size() ? x[k].a : y[k-x.size()].a; }
+	Lit termMaxLit(int k) const { return k < x.size() ? x[k].getMaxLit() : y[k-x.size()].getMaxLit(); }
+	Lit termFMaxLit(int k, int64_t m) const {
+		return k < x.size() ? x[k].getFMaxLit(m) : y[k-x.size()].getFMaxLit(m);
+	}
+	int64_t origMax(int i) const { return pos[i] >= 0 ? x[pos[i]].getMax() : y[-pos[i]-1].getMax(); }
+
+	void updateMax(int i) {
+		int64_t m = origMax(i);
+		if (m != term_max[i]) {
+			max_sum += m - term_max[i];
+			term_max[i] = m;
+		}
+	}
+
+	// Smallest multiple of a that is >= v
+	static int64_t roundUp(int64_t v, int a) {
+		int64_t k = v % a;
+		return k > 0 ? v + a - k : v - k;
+	}
+
+	// Reason for the terms other than skip being at most their current maxima,
+	// where their sum may grow by slack and still justify the inference.
+	// Terms are dropped, cheapest first, while the slack allows it, and what is
+	// left lifts the next bound pointwise. Without lifting, every term that
+	// has moved is kept at its current max.
+	Clause* liftedReason(int skip, int64_t slack) {
+		assert(slack >= 0);
+		if (!so().linear_lift) slack = 0;
+		ps.clear();
+		ps.push(lit_True);
+		if (R && skip >= 0) ps.push(r.getValLit());
+		gaps.clear();
+		for (int i = 0; i < x.size(); i++) {
+			IntVar *v = x[i].var;
+			if (v->max == v->max0 || i == skip) continue;
+			if (slack == 0) ps.push(x[i].getMaxLit());
+			else gaps.push(Gap{(int64_t) x[i].a * (v->max0 - v->max), i});
+		}
+		for (int i = 0; i < y.size(); i++) {
+			IntVar *v = y[i].var;
+			if (v->min == v->min0 || x.size()+i == skip) continue;
+			if (slack == 0) ps.push(y[i].getMaxLit());
+			else gaps.push(Gap{(int64_t) y[i].a * (v->min - v->min0), x.size()+i});
+		}
+		if (gaps.size() > 0) {
+			std::sort((Gap*) gaps, (Gap*) gaps + gaps.size());
+			int i = 0;
+			while (i < gaps.size() && gaps[i].g <= slack) slack -= gaps[i++].g;
+			if (i < gaps.size()) {
+				int k = gaps[i].k;
+				int a = termA(k);
+				int64_t m = termMax(k) + slack / a * a;
+				ps.push(m > termMax(k) ? termFMaxLit(k, m) : termMaxLit(k));
+				for (i++; i < gaps.size(); i++) ps.push(termMaxLit(gaps[i].k));
+			}
+		}
+		return Reason_new(ps);
+	}
+
+	// Reason for term k >= its max - ms. When ms < 0 only the failing bound
+	// max+1 is set, so the reason need not cover more than that.
+	Clause* termReason(int k, int64_t ms) {
+		int64_t m = termMax(k);
+		int64_t bound = m - ms;
+		if (bound > m) bound = m+1;
+		int a = termA(k);
+		return liftedReason(k, m - ms - (roundUp(bound, a) - a + 1));
+	}
 
+	// Reasons are made eagerly for literals that conflict analysis cannot
+	// explain lazily, and for repeated vars: their reason mentions the var
+	// itself, and analysis skips literals sharing a lazy reason with the one
+	// just explained, which would drop the weaker bound it relies on.
+	template <class V>
+	bool setTermMin(V& v, int k, int64_t ms) {
+		int64_t bound = v.getMax()-ms;
+		if (!v.setMinNotR(bound)) return true;
+		if (bound > v.getMax()) bound = v.getMax()+1;
+		Reason expl;
+		if (so().lazy) {
+			if (repeated[k] || !sat().flags[var(v.getMinLit())].learnable) expl = termReason(k, ms);
+			else expl = Reason(prop_id, k);
+		}
+		return v.setMin(bound, expl);
+	}
 
 public:
 
 	LinearGE(vec<int>& a, vec<IntVar*>& _x, int _c, BoolView _r = bv_true) :
-		pos(_x.size()), c(_c), r(_r), fix(0), fix_x(0), fix_y(0), fix_sum(-c), ps(R+_x.size()) {
+		pos(_x.size()), c(_c), r(_r), term_max(_x.size()), max_sum(-c) {
 		priority = 2;
 
 		for (int i = 0; i < _x.size(); i++) {
@@ -31,99 +129,69 @@ public:
 			if (a[i] > 0) {
 				pos[i] = x.size();
 				x.push(IntView<2*S>(_x[i], a[i]));
-				_x[i]->attach(this, i, EVENT_U);
 			} else {
 				pos[i] = -y.size()-1;
 				y.push(IntView<2*S+1>(_x[i], -a[i]));
-				_x[i]->attach(this, i, EVENT_L);
 			}
 		}
+		repeated.growTo(_x.size(), false);
+		for (int i = 0; i < _x.size(); i++) {
+			term_max[i].v = origMax(i);
+			max_sum.v += term_max[i].v;
+			for (int j = 0; j < _x.size(); j++) {
+				if (j == i || _x[j] != _x[i]) continue;
+				repeated[pos[i] >= 0 ? pos[i] : x.size()-pos[i]-1] = true;
+				if ((a[j] > 0) != (a[i] > 0)) { shared.push(i); break; }
+			}
+		}
+		for (int i = 0; i < _x.size(); i++) {
+			_x[i]->attach(this, i, a[i] > 0 ? EVENT_U : EVENT_L);
+		}
 		if (R) r.attach(this, _x.size(), EVENT_L);
 
 	}
 
-
 	void wakeup(int i, int c) {
+		if (i < pos.size()) updateMax(i);
 		if (!R || !r.isFalse()) pushInQueue();
 	}
 
 	bool propagate() {
 		if (R && r.isFalse()) return true;
 
-		int64_t max_sum = fix_sum;
-
-		for (int i = fix_x; i < x.size(); i++) max_sum += x[i].getMax();
-		for (int i = fix_y; i < y.size(); i++) max_sum += y[i].getMax();
-
-//		if (R && max_sum < 0) setDom2(r, setVal, 0, x.size()+y.size());
+		int64_t ms = max_sum;
 
-		if (R && max_sum < 0) {
+		if (R && ms < 0) {
 			int64_t v = 0;
 			if (r.setValNotR(v)) {
 				Reason expl;
-				if (so.lazy) {
-					for (int j = 0; j < x.size(); j++) ps[j+1] = x[j].getMaxLit();
-					for (int j = 0; j < y.size(); j++) ps[j+1+x.size()] = y[j].getMaxLit();
-					expl = Reason_new(ps);
+				if (so().lazy) {
+					if (!sat().flags[var(r.getLit(true))].learnable) expl = liftedReason(-1, -ms-1);
+					else expl = Reason(prop_id, x.size()+y.size());
 				}
 				if (!r.setVal(v, expl)) return false;
 			}
 		}
 
-
-
-
 		if (R && !r.isTrue()) return true;
 
-//		for (int i = fix_x; i < x.size(); i++) {
-//			setDom2(x[i], setMin, x[i].getMax()-max_sum, i);
-//		}
-
-//		for (int i = fix_y; i < y.size(); i++) {
-//			setDom2(y[i], setMin, y[i].getMax()-max_sum, x.size()+i);
-//		}
-
-		for (int i = fix_x; i < x.size(); i++) {
-			int64_t v = x[i].getMax()-max_sum;
-			if (x[i].setMinNotR(v)) {
-				Reason expl;
-				if (so.lazy) {
-					if (R && r.isFixed()) ps[0] = r.getValLit();
-					for (int j = 0; j < x.size(); j++) ps[j+R] = x[j].getMaxLit();
-					for (int j = 0; j < y.size(); j++) ps[j+R+x.size()] = y[j].getMaxLit();
-					ps[R+i] = ps[0];
-					expl = Reason_new(ps);
-				}
-				if (!x[i].setMin(v, expl)) return false;
-			}
-
+		for (int i = 0; i < x.size(); i++) {
+			if (!setTermMin(x[i], i, ms)) return false;
 		}
-
-		for (int i = fix_y; i < y.size(); i++) {
-			int64_t v = y[i].getMax()-max_sum;
-			if (y[i].setMinNotR(v)) {
-				Reason expl;
-				if (so.lazy) {
-					if (R && r.isFixed()) ps[0] = r.getValLit();
-					for (int j = 0; j < x.size(); j++) ps[j+R] = x[j].getMaxLit();
-					for (int j = 0; j < y.size(); j++) ps[j+R+x.size()] = y[j].getMaxLit();
-					ps[R+x.size()+i] = ps[0];
-					expl = Reason_new(ps);
-				}
-				if (!y[i].setMin(v, expl)) return false;
-			}
+		for (int i = 0; i < y.size(); i++) {
+			if (!setTermMin(y[i], x.size()+i, ms)) return false;
 		}
 
+		// Raising the min of a var lowers the max of its negated occurrence
+		for (int j = 0; j < shared.size(); j++) updateMax(shared[j]);
+
 		return true;
 	}
 
 	Clause* explain(Lit p, int inf_id) {
-        if (inf_id == x.size()+y.size()) inf_id = -1;
-		if (R && r.isFixed()) ps[0] = r.getValLit();
-		for (int i = 0; i < x.size(); i++) ps[i+R] = x[i].getMaxLit();
-		for (int i = 0; i < y.size(); i++) ps[i+R+x.size()] = y[i].getMaxLit();
-		ps[R+inf_id] = ps[0];
-		return Reason_new(ps);
+		int64_t ms = max_sum;
+		if (inf_id == x.size()+y.size()) return liftedReason(-1, -ms-1);
+		return termReason(inf_id, ms);
 	}
 
 };
@@ -186,7 +254,7 @@ public:
 		if (num_unfixed == 0) {
 			if (sum_fixed == 0) {
 				Clause *m_r = NULL;
-				if (so.lazy) {
+				if (so().lazy) {
 					m_r = Reason_new(sz+1);
 					for (int i = 0; i < sz; i++) (*m_r)[i+1] = x[i].getValLit();
 				}
@@ -207,7 +275,7 @@ public:
 		if ((k < sp && x[k].remValNotR(-sum_fixed)) ||
 				(k >= sp && y[k].remValNotR(-sum_fixed))) {
 			Clause *m_r = NULL;
-			if (so.lazy) {
+			if (so().lazy) {
 				m_r = Reason_new(sz+R);
 				for (int i = 0; i < k; i++) (*m_r)[i+1] = x[i].getValLit();
 				for (int i = k+1; i < sz; i++) (*m_r)[i] = x[i].getValLit();
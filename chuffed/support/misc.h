@@ -11,14 +11,28 @@
 #include <windows.h>
 #else
 #include <sys/time.h>
+#include <sys/resource.h>
 #include <unistd.h>
 #endif
 
 #include <stdint.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 #include <chuffed/support/vec.h>
 
 extern uint64_t bit[65];
 
+// Storage class for the per-thread solver instance pointers (engine_ptr,
+// sat_ptr, so_ptr, ...). These are read on every propagation, so they use the compiler
+// extension rather than thread_local, which would add an initialisation
+// check to each access from another translation unit.
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 #define low(s) ((int) (s))
 #define high(s) ((int) ((s) >> 32))
 #define inSet(i,s) (bit[(i)] & (s))
@@ -49,7 +63,11 @@ template <> struct STATIC_ASSERTION_FAILURE<true> { enum { value = 1 }; };
   typedef static_assert_test<sizeof(STATIC_ASSERTION_FAILURE<(bool) (expr)>)> \
 	BOOST_JOIN(boost_static_assert_typedef_, __LINE__)
 
-#define TL_FAIL() do { printf("=====UNSATISFIABLE=====\n"); printf("%% Top level failure!\n"); exit(0); } while (0)
+// Failure at the top level while the model is built or initialised. It is
+// recorded in the engine, which then reports the model as unsatisfiable
+// without searching. The caller carries on, and must leave things consistent.
+void topLevelFailure();
+#define TL_FAIL() topLevelFailure()
 
 //------
 
@@ -59,7 +77,7 @@ static inline unsigned int myrand(int& rseed) {
 	return (rseed = (long long) 1103515245 * rseed + 12345);
 }
 
-#define irand(n) ((int) floor(myrand(so.rnd_seed) / MYRAND_MAX * n))
+#define irand(n) ((int) floor(myrand(so().rnd_seed) / MYRAND_MAX * n))
 
 //------
 
@@ -78,22 +96,51 @@ static inline int bitcount(T s) {
 	return c;
 }
 
+// Index of the lowest set bit, s must be non-zero
+static inline int lowestBit(uint64_t s) {
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward64(&i, s);
+	return (int) i;
+#else
+	return __builtin_ctzll(s);
+#endif
+}
+
 static int mylog2 (int val) {
 	int ret = -1;
 	while (val != 0) { val >>= 1; ret++; }
 	return ret;
 }
 
+// Peak resident set size in Mb
 static double memUsed() {
-  return 0;
-	/* char name[256]; */
-	/* sprintf(name, "/proc/%d/statm", getpid()); */
-	/* FILE* in = fopen(name, "rb"); */
-	/* if (in == NULL) return 0; */
-	/* int value; */
-	/* rassert(fscanf(in, "%d", &value) == 1); */
-	/* fclose(in); */
-	/* return (double) value * getpagesize() / 1048576; */
+#ifdef WIN32
+	return 0;
+#else
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#ifdef __APPLE__
+	return (double) ru.ru_maxrss / 1048576;
+#else
+	return (double) ru.ru_maxrss / 1024;
+#endif
+#endif
+}
+
+// Current resident set size in Mb, the peak where it cannot be read
+static double memResident() {
+#if defined(__linux__)
+	FILE *f = fopen("/proc/self/statm", "r");
+	if (f == NULL) return memUsed();
+	long size, resident;
+	int n = fscanf(f, "%ld %ld", &size, &resident);
+	fclose(f);
+	if (n != 2) return memUsed();
+	return (double) resident * sysconf(_SC_PAGESIZE) / 1048576;
+#else
+	return memUsed();
+#endif
 }
 
 template <class T>
@@ -40,6 +40,7 @@ public:
   int      size     (void) const     { return sz; }
 	int&     _size    ()               { return sz; }
 	int      capacity (void) const     { return cap; }
+	long long bytes   (void) const     { return (long long) cap * sizeof(T); }
 	void     resize   (int nelems)     { assert(nelems <= sz); for (int i = nelems; i < sz; i++) data[i].~T(); sz = nelems; } 
 	void     shrink   (int nelems)     { assert(nelems <= sz); resize(sz-nelems); } 
   void     pop      (void)           { data[--sz].~T(); }
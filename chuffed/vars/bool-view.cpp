@@ -3,7 +3,11 @@
 
 void BoolView::attach(Propagator *p, int pos, int eflags) {
 	WatchElem we(p->prop_id, pos);
-	if (eflags & EVENT_L) sat.watches[2*v+s].push(we);
-	if (eflags & EVENT_U) sat.watches[2*v+(1-s)].push(we);
+	if (eflags & EVENT_L) sat().watches[2*v+s].push(we);
+	if (eflags & EVENT_U) sat().watches[2*v+(1-s)].push(we);
 }
 
+void BoolView::setHintVal(bool x) {
+	engine().hint_polarity.push(Lit(v, sat().polarity[v]));
+	setPreferredVal(x ? PV_MAX : PV_MIN);
+}
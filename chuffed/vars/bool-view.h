@@ -25,10 +25,13 @@ public:
         void setSign(bool sign) { s = sign; }
 
 	void setPreferredVal(PreferredVal p) {
-		if (p == PV_MIN || p == PV_SPLIT_MIN) sat.polarity[v] = s^1;
-		if (p == PV_MAX || p == PV_SPLIT_MAX) sat.polarity[v] = s;
+		if (p == PV_MIN || p == PV_SPLIT_MIN) sat().polarity[v] = s^1;
+		if (p == PV_MAX || p == PV_SPLIT_MAX) sat().polarity[v] = s;
 	}
 
+	// Branch on x first until Engine::clearWarmStart
+	void setHintVal(bool x);
+
 	void attach(Propagator *p, int pos, int eflags);
 	void detach(Propagator *p, int pos, int eflags);
 
@@ -36,36 +39,36 @@ public:
 
 	VarType getType() { return BOOL_VAR; }
 
-	bool isFixed() const { return sat.assigns[v]; }
-	bool isTrue()  const { return sat.assigns[v] == 1-2*s; }
-	bool isFalse() const { return sat.assigns[v] == -1+2*s; }
-	int  getVal()  const { assert(isFixed()); return (sat.assigns[v]+1)/2 ^ s; }
+	bool isFixed() const { return sat().assigns[v]; }
+	bool isTrue()  const { return sat().assigns[v] == 1-2*s; }
+	bool isFalse() const { return sat().assigns[v] == -1+2*s; }
+	int  getVal()  const { assert(isFixed()); return (sat().assigns[v]+1)/2 ^ s; }
 
 	// Lit for explanations:
 
-	Lit getValLit() const { assert(isFixed()); return Lit(v, (sat.assigns[v]+1)/2); }
+	Lit getValLit() const { assert(isFixed()); return Lit(v, (sat().assigns[v]+1)/2); }
 	Lit getLit(bool sign) const { return Lit(v, sign ^ s ^ 1); }
 
 	// For Branching:
 
 	bool finished() { return isFixed(); }
 	double getScore(VarBranch vb) { NOT_SUPPORTED; }
-	DecInfo* branch() { return new DecInfo(NULL, 2*v+(sat.polarity[v])); }
+	DecInfo branch() { return DecInfo(NULL, 2*v+(sat().polarity[v])); }
 
 	// Change domains:
 
-	bool setValNotR(bool x) const { return sat.assigns[v] != (x^s)*2-1; }
+	bool setValNotR(bool x) const { return sat().assigns[v] != (x^s)*2-1; }
 
 	bool setVal(bool x, Reason r = NULL) {
 		assert(setValNotR(x));
-		sat.cEnqueue(getLit(x), r);
-		return (sat.confl == NULL);
+		sat().cEnqueue(getLit(x), r);
+		return (sat().confl == NULL);
 	}
 
 	bool setVal2(bool x, Reason r = NULL) {
 		assert(setValNotR(x));
-		sat.enqueue(getLit(x), r.pt);
-		return (sat.confl == NULL);
+		sat().enqueue(getLit(x), r.pt);
+		return (sat().confl == NULL);
 	}
 
 	operator Lit () const { return getLit(true); }
@@ -73,15 +76,15 @@ public:
 	bool operator == (BoolView o) const { return v == o.v && s == o.s; }
 
         void setLearnable(bool learnable) {
-            sat.flags[v].setLearnable(learnable);
+            sat().flags[v].setLearnable(learnable);
         }
 
         void setDecidable(bool decidable) {
-            sat.flags[v].setDecidable(decidable);
+            sat().flags[v].setDecidable(decidable);
         }
 
         void setUIPable(bool UIPable) {
-            sat.flags[v].setUIPable(UIPable);
+            sat().flags[v].setUIPable(UIPable);
         }
 };
 
@@ -89,7 +92,7 @@ const BoolView bv_true(lit_True);
 const BoolView bv_false(lit_False);
 
 inline BoolView newBoolVar(int min = 0, int max = 1) {
-        int varNumber = sat.newVar();
+        int varNumber = sat().newVar();
 	BoolView v(Lit(varNumber,0));
 	if (min == 1) v.setVal(1);
 	if (max == 0) v.setVal(0);
@@ -1,12 +1,12 @@
 #include <algorithm>
 #include <chuffed/vars/int-var.h>
 #include <chuffed/core/sat.h>
+#include <chuffed/core/solver.h>
 
 #include <iostream>
 #include <map>
 #include <sstream>
 
-extern std::map<IntVar*, std::string> intVarString;
 
 IntVarEL::IntVarEL(const IntVar& other) :
 		IntVar(other)
@@ -28,37 +28,37 @@ IntVarEL::IntVarEL(const IntVar& other) :
             setBDecidable(false);
         }
 
-        if (so.debug) {
-          std::cerr << "created integer variable " << intVarString[(IntVar*)(&other)] << "\n";
-          if (intVarString[(IntVar*)(&other)] == "")
+        if (so().debug) {
+          std::cerr << "created integer variable " << intVarString()[(IntVar*)(&other)] << "\n";
+          if (intVarString()[(IntVar*)(&other)] == "")
               abort();
         }
 
         for (int v = lit_min ; v <= lit_max ; v++) {
           std::string label;
           std::stringstream ss;
-          ss << intVarString[(IntVar*)(&other)];
+          ss << intVarString()[(IntVar*)(&other)];
           std::stringstream ssv;
           ssv << v;
           std::string val = ssv.str();
           label = ss.str(); label.append("!="); label.append(val);
-          litString.insert(std::pair<int,std::string>(base_vlit+2*v, label));
+          litString().insert(std::pair<int,std::string>(base_vlit+2*v, label));
           label = ss.str(); label.append("=="); label.append(val);
-          litString.insert(std::pair<int,std::string>(base_vlit+2*v+1, label));
+          litString().insert(std::pair<int,std::string>(base_vlit+2*v+1, label));
           label = ss.str(); label.append(">="); label.append(val);
-          litString.insert(std::pair<int,std::string>(base_blit+2*v, label));
+          litString().insert(std::pair<int,std::string>(base_blit+2*v, label));
           label = ss.str(); label.append("<="); label.append(val);
-          litString.insert(std::pair<int,std::string>(base_blit+2*v+1, label));
+          litString().insert(std::pair<int,std::string>(base_blit+2*v+1, label));
         }
         // The extra <= min-1 and >= max+1 bounds literals (both
         // obviously false).
         std::string label;
         std::stringstream ss;
-        ss << intVarString[(IntVar*)(&other)] << "<=" << (lit_min-1);
-        litString.insert(std::pair<int,std::string>(base_blit+2*(lit_min-1)+1, ss.str()));
+        ss << intVarString()[(IntVar*)(&other)] << "<=" << (lit_min-1);
+        litString().insert(std::pair<int,std::string>(base_blit+2*(lit_min-1)+1, ss.str()));
         ss.str("");
-        ss << intVarString[(IntVar*)(&other)] << ">=" << (lit_max+1);
-        litString.insert(std::pair<int,std::string>(base_blit+2*(lit_max+1), ss.str()));
+        ss << intVarString()[(IntVar*)(&other)] << ">=" << (lit_max+1);
+        litString().insert(std::pair<int,std::string>(base_blit+2*(lit_max+1), ss.str()));
 }
 
 // lit_min is the smallest value for which we can get a literal for
@@ -94,12 +94,12 @@ void IntVarEL::initVLits() {
 	if (base_vlit != INT_MIN) return;
 	initVals();
 	if (lit_min == INT_MIN) { lit_min = min; lit_max = max; }
-	base_vlit = 2*(sat.nVars()-lit_min);
-	sat.newVar(lit_max-lit_min+1, ChannelInfo(var_id, 1, 0, lit_min));
+	base_vlit = 2*(sat().nVars()-lit_min);
+	sat().newVar(lit_max-lit_min+1, ChannelInfo(var_id, 1, 0, lit_min));
 	for (int i = lit_min; i <= lit_max; i++) {
-		if (!indomain(i)) sat.cEnqueue(getNELit(i), NULL);
+		if (!indomain(i)) sat().cEnqueue(getNELit(i), NULL);
 	}
-	if (isFixed()) sat.cEnqueue(getEQLit(min), NULL);
+	if (isFixed()) sat().cEnqueue(getEQLit(min), NULL);
 }
 
 // Bounds literals are arranged similarly to the value/equality
@@ -130,39 +130,39 @@ void IntVarEL::initVLits() {
 void IntVarEL::initBLits() {
 	if (base_blit != INT_MIN) return;
 	if (lit_min == INT_MIN) { lit_min = min; lit_max = max; }
-	base_blit = 2*(sat.nVars()-lit_min)+1;
-	sat.newVar(lit_max-lit_min+2, ChannelInfo(var_id, 1, 1, lit_min-1));
+	base_blit = 2*(sat().nVars()-lit_min)+1;
+	sat().newVar(lit_max-lit_min+2, ChannelInfo(var_id, 1, 1, lit_min-1));
 	for (int i = lit_min; i <= min; i++) {
-          sat.cEnqueue(getGELit(i), NULL);
+          sat().cEnqueue(getGELit(i), NULL);
         }
 	for (int i = max; i <= lit_max; i++) {
-          sat.cEnqueue(getLELit(i), NULL);
+          sat().cEnqueue(getLELit(i), NULL);
         }
 }
 
 void IntVarEL::setVLearnable(bool b) {
 	for (int i = lit_min; i <= lit_max; i++) {
-		sat.flags[base_vlit/2+i].setLearnable(b);
-		sat.flags[base_vlit/2+i].setUIPable(b);
+		sat().flags[base_vlit/2+i].setLearnable(b);
+		sat().flags[base_vlit/2+i].setUIPable(b);
 	}
 }
 
 void IntVarEL::setBLearnable(bool b) {
 	for (int i = lit_min; i <= lit_max+1; i++) {
-		sat.flags[(base_blit-1)/2+i].setLearnable(b);
-		sat.flags[(base_blit-1)/2+i].setUIPable(b);
+		sat().flags[(base_blit-1)/2+i].setLearnable(b);
+		sat().flags[(base_blit-1)/2+i].setUIPable(b);
 	}
 }
 
 void IntVarEL::setVDecidable(bool b) {
 	for (int i = lit_min; i <= lit_max; i++) {
-		sat.flags[base_vlit/2+i].setDecidable(b);
+		sat().flags[base_vlit/2+i].setDecidable(b);
 	}
 }
 
 void IntVarEL::setBDecidable(bool b) {
 	for (int i = lit_min; i <= lit_max+1; i++) {
-		sat.flags[(base_blit-1)/2+i].setDecidable(b);
+		sat().flags[(base_blit-1)/2+i].setDecidable(b);
 	}
 }
 
@@ -186,11 +186,11 @@ inline void IntVarEL::channelMin(int v) {
 	// Set [x != v-1] to [x != min] using [x != i] \/ ![x >= v]
 	Reason r(~getGELit(v));
 	for (int i = v-1; i > min; i--) {
-		sat.cEnqueue(getGELit(i), r);
-		if (vals[i]) sat.cEnqueue(getNELit(i), r);
+		sat().cEnqueue(getGELit(i), r);
+		if (vals[i]) sat().cEnqueue(getNELit(i), r);
 	}
 	assert(vals[min]);
-	sat.cEnqueue(getNELit(min), r);
+	sat().cEnqueue(getNELit(min), r);
 }
 
 // Use when you've just set [x <= v]
@@ -199,11 +199,11 @@ inline void IntVarEL::channelMax(int v) {
 	// Set [x != v+1] to [x != max] to using ![x = i] \/ ![x <= v]
 	Reason r(~getLELit(v));
 	for (int i = v+1; i < max; i++) {
-		sat.cEnqueue(getLELit(i), r);
-		if (vals[i]) sat.cEnqueue(getNELit(i), r);
+		sat().cEnqueue(getLELit(i), r);
+		if (vals[i]) sat().cEnqueue(getNELit(i), r);
 	}
 	assert(vals[max]);
-	sat.cEnqueue(getNELit(max), r);
+	sat().cEnqueue(getNELit(max), r);
 }
 
 // Use when you've just set [x = v]
@@ -211,12 +211,12 @@ inline void IntVarEL::channelFix(int v) {
 	Reason r(getNELit(v));
 	if (min < v) {
 		// Set [x >= v] using [x >= v] \/ ![x = v]
-		sat.cEnqueue(getGELit(v), r);
+		sat().cEnqueue(getGELit(v), r);
 		channelMin(v);
 	}
 	if (max > v) {
 		// Set [x <= v] using [x <= v] \/ ![x = v]
-		sat.cEnqueue(getLELit(v), r);
+		sat().cEnqueue(getLELit(v), r);
 		channelMax(v);
 	}
 }
@@ -226,7 +226,7 @@ inline void IntVarEL::updateMin(int v, int i) {
 	for (; v < i; ++v) {
 		// Set [x >= v+1] using [x >= v+1] \/ [x <= v-1] \/ [x = v]
 		Reason r(getLELit(v-1), getEQLit(v));
-		sat.cEnqueue(getGELit(v+1), r);
+		sat().cEnqueue(getGELit(v+1), r);
 	}
 	min = v; changes |= EVENT_C | EVENT_L;
 }
@@ -235,7 +235,7 @@ inline void IntVarEL::updateMax(int v, int i) {
 	for (; v > i; --v) {
 		// Set [x <= v-1] using [x <= v-1] \/ [x >= v+1] \/ [x = v]
 		Reason r(getGELit(v+1), getEQLit(v));
-		sat.cEnqueue(getLELit(v-1), r);
+		sat().cEnqueue(getLELit(v-1), r);
 	}
 	max = v; changes |= EVENT_C | EVENT_U;
 }
@@ -245,7 +245,7 @@ inline void IntVarEL::updateMin() {
 	while (!vals[v]) {
 		// Set [x >= v+1] using [x >= v+1] \/ [x <= v-1] \/ [x = v]
 		Reason r(getLELit(v-1), getEQLit(v));
-		sat.cEnqueue(getGELit(v+1), r);
+		sat().cEnqueue(getGELit(v+1), r);
 		v++;
 	}
 	if (v > min) { min = v; changes |= EVENT_L; }
@@ -256,7 +256,7 @@ inline void IntVarEL::updateMax() {
 	while (!vals[v]) {
 		// Set [x <= v-1] using [x <= v-1] \/ [x >= v+1] \/ [x = v]
 		Reason r(getGELit(v+1), getEQLit(v));
-		sat.cEnqueue(getLELit(v-1), r);
+		sat().cEnqueue(getLELit(v-1), r);
 		v--;
 	}
 	if (v < max) { max = v; changes |= EVENT_U; }
@@ -268,15 +268,15 @@ inline void IntVarEL::updateFixed() {
 		int v = min;
 		// Set [x = v] using [x = v] \/ [x <= v-1] \/ [x >= v+1]
 		Reason r(getLELit(v-1), getGELit(v+1));
-		sat.cEnqueue(getEQLit(v), r);
+		sat().cEnqueue(getEQLit(v), r);
 		changes |= EVENT_F;
 	}
 }
 
 bool IntVarEL::setMin(int64_t v, Reason r, bool channel) {
 	assert(setMinNotR(v));
-	if (channel) sat.cEnqueue(getLit(v, 2), r);
-	if (v > max) { assert(sat.confl); return false; }
+	if (channel) sat().cEnqueue(getLit(v, 2), r);
+	if (v > max) { assert(sat().confl); return false; }
 	channelMin(v);
 #if INT_DOMAIN_LIST
 	int i;
@@ -296,8 +296,8 @@ bool IntVarEL::setMin(int64_t v, Reason r, bool channel) {
 
 bool IntVarEL::setMax(int64_t v, Reason r, bool channel) {
 	assert(setMaxNotR(v));
-	if (channel) sat.cEnqueue(getLit(v, 3), r);
-	if (v < min) { assert(sat.confl); return false; }
+	if (channel) sat().cEnqueue(getLit(v, 3), r);
+	if (v < min) { assert(sat().confl); return false; }
 	channelMax(v);
 #if INT_DOMAIN_LIST
 	int i;
@@ -317,8 +317,8 @@ bool IntVarEL::setMax(int64_t v, Reason r, bool channel) {
 
 bool IntVarEL::setVal(int64_t v, Reason r, bool channel) {
 	assert(setValNotR(v));
-	if (channel) sat.cEnqueue(getLit(v, 1), r);
-	if (!indomain(v)) { assert(sat.confl); return false; }
+	if (channel) sat().cEnqueue(getLit(v, 1), r);
+	if (!indomain(v)) { assert(sat().confl); return false; }
 	changes |= EVENT_C | EVENT_F;
 	channelFix(v);
 	if (min < v) { min = v; changes |= EVENT_L; }
@@ -333,8 +333,8 @@ bool IntVarEL::setVal(int64_t v, Reason r, bool channel) {
 bool IntVarEL::remVal(int64_t v, Reason r, bool channel) {
 	assert(remValNotR(v));
 	assert(vals);
-	if (channel) sat.cEnqueue(getLit(v, 0), r);
-	if (isFixed()) { assert(sat.confl); return false; }
+	if (channel) sat().cEnqueue(getLit(v, 0), r);
+	if (isFixed()) { assert(sat().confl); return false; }
 #if INT_DOMAIN_LIST
 	if (v == min)
 		updateMin(min, vals_list[2*min+1]);
@@ -368,7 +368,7 @@ Lit IntVarEL::createSetLit(vec<Lit>& head) {
 
 	// process bounds lits first
 	for (int i = 0; i < head.size(); i++) {
-		ChannelInfo& ci = sat.c_info[var(head[i])];
+		ChannelInfo& ci = sat().c_info[var(head[i])];
 		if (ci.val_type == 0) continue;
 		int v = ci.val;
 		if (sign(head[i])) {
@@ -380,7 +380,7 @@ Lit IntVarEL::createSetLit(vec<Lit>& head) {
 
 	// process val lits
 	for (int i = 0; i < head.size(); i++) {
-		ChannelInfo& ci = sat.c_info[var(head[i])];
+		ChannelInfo& ci = sat().c_info[var(head[i])];
 		if (ci.val_type == 1) continue;
 		int v = ci.val;
 		if (sign(head[i])) {
@@ -418,22 +418,22 @@ Lit IntVarEL::createSetLit(vec<Lit>& head) {
 
 	// Create new lit that complements failure set
 
-	Lit q = Lit(sat.getLazyVar(ci_null), true);
-	sat.flags[var(q)].setUIPable(false);
-	sat.flags[var(q)].setLearnable(false);
+	Lit q = Lit(sat().getLazyVar(ci_null), true);
+	sat().flags[var(q)].setUIPable(false);
+	sat().flags[var(q)].setLearnable(false);
 
 	vec<Lit> ps(2);
 	ps[1] = ~q;
 
 	if (lower_bound == lit_min) {
 		// can use bounds lit for lower bound
-		sat.addClause(getGELit(holes[0]), ~q);
+		sat().addClause(getGELit(holes[0]), ~q);
 		lower_bound = holes[0];
 //		printf("GE: %d\n", holes[0]);
 	}
 	if (upper_bound == lit_max) {
 		// can use bounds lit for upper bound
-		sat.addClause(getLELit(holes.last()), ~q);
+		sat().addClause(getLELit(holes.last()), ~q);
 		upper_bound = holes.last();
 //		printf("LE: %d\n", holes.last());
 	}
@@ -441,7 +441,7 @@ Lit IntVarEL::createSetLit(vec<Lit>& head) {
 	for (int i = lower_bound; i <= upper_bound; i++) {
 		if (j < holes.size() && i == holes[j]) { j++; continue; }
 		ps[0] = getNELit(i);
-		sat.addClause(*Clause_new(ps), true);
+		sat().addClause(*Clause_new(ps), true);
 //		printf("NE: %d\n", i);
 	}
 
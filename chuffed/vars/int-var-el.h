@@ -52,8 +52,8 @@ public:
 	Lit getMinLit() const { return ~getGELit(min); }
 	Lit getMaxLit() const { return ~getLELit(max); }
 	Lit getValLit() const { assert(isFixed()); return ~getEQLit(min); }
-	Lit getFMinLit(int64_t v) { return ~getLit(so.finesse ? v : (int) min, 2); }
-	Lit getFMaxLit(int64_t v) { return ~getLit(so.finesse ? v : (int) max, 3); }
+	Lit getFMinLit(int64_t v) { return ~getLit(so().finesse ? v : (int) min, 2); }
+	Lit getFMaxLit(int64_t v) { return ~getLit(so().finesse ? v : (int) max, 3); }
 
 
 	bool setMin(int64_t v, Reason r = NULL, bool channel = true);
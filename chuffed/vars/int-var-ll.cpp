@@ -1,9 +1,9 @@
 #include <chuffed/vars/int-var.h>
 #include <chuffed/core/sat.h>
+#include <chuffed/core/solver.h>
 
 #include <iostream>
 
-extern std::map<IntVar*, std::string> intVarString;
 
 // val -> (val-1)/2
 
@@ -14,28 +14,33 @@ IntVarLL::IntVarLL(const IntVar& other) : IntVar(other), ld(2), li(0), hi(1) {
         // fixed (see updateFixed).  It's not learnable, so any
         // explanation will use the reason which includes the actual
         // bounds literals.
-	valLit = Lit(sat.nVars(), 1);
-	int v = sat.newVar(1, ChannelInfo(var_id, 1, 0, 0));
-	sat.flags[v].setDecidable(false);
-	sat.flags[v].setUIPable(false);
-	sat.flags[v].setLearnable(false);
-	if (isFixed()) sat.cEnqueue(valLit, NULL);
-
-        varLabel = intVarString[(IntVar*)(&other)];
+	valLit = Lit(sat().nVars(), 1);
+	int v = sat().newVar(1, ChannelInfo(var_id, 1, 0, 0));
+	sat().flags[v].setDecidable(false);
+	sat().flags[v].setUIPable(false);
+	sat().flags[v].setLearnable(false);
+	if (isFixed()) sat().cEnqueue(valLit, NULL);
+
+        varLabel = intVarString()[(IntVar*)(&other)];
         std::stringstream ss;
         ss << varLabel << "=fixed";
-        litString.insert(make_pair(toInt(valLit), ss.str()));
+        litString().insert(make_pair(toInt(valLit), ss.str()));
         ss.str("");
         ss << varLabel << "=notfixed";
-        litString.insert(make_pair(toInt(~valLit), ss.str()));
+        litString().insert(make_pair(toInt(~valLit), ss.str()));
 }
 
-DecInfo* IntVarLL::branch() {
+DecInfo IntVarLL::branch() {
+	// Close the bounds in on the hint
+	if (hint_val != INT_MIN && min <= hint_val && hint_val <= max) {
+		if (hint_val > min) return DecInfo(this, hint_val-1, 2);
+		return DecInfo(this, min, 3);
+	}
 	switch (preferred_val) {
-		case PV_MIN: return new DecInfo(this, min, 3);
-		case PV_MAX: return new DecInfo(this, max-1, 2);
-		case PV_SPLIT_MIN: return new DecInfo(this, min+(max-min-1)/2, 3);
-		case PV_SPLIT_MAX: return new DecInfo(this, min+(max-min  )/2, 2);
+		case PV_MIN: return DecInfo(this, min, 3);
+		case PV_MAX: return DecInfo(this, max-1, 2);
+		case PV_SPLIT_MIN: return DecInfo(this, min+(max-min-1)/2, 3);
+		case PV_SPLIT_MAX: return DecInfo(this, min+(max-min  )/2, 2);
 		default: NEVER;
 	}
 }
@@ -79,7 +84,7 @@ inline Lit IntVarLL::getGELit(int v) {
 #if DEBUG_VERBOSE
         std::cerr << "created new literal: " << mi << ": " << this << " >= " << v << "\n";
 #endif
-	ld[mi].var = sat.getLazyVar(ChannelInfo(var_id, 1, 1, v-1));
+	ld[mi].var = sat().getLazyVar(ChannelInfo(var_id, 1, 1, v-1));
 	ld[mi].val = v-1;
 	ld[mi].next = ni;
 	ld[mi].prev = ld[ni].prev;
@@ -88,10 +93,10 @@ inline Lit IntVarLL::getGELit(int v) {
 
         std::stringstream ss;
         ss << varLabel << ">=" << v;
-        litString.insert(make_pair(ld[mi].var*2+1, ss.str()));
+        litString().insert(make_pair(ld[mi].var*2+1, ss.str()));
         ss.str("");
         ss << varLabel << "<=" << v-1;
-        litString.insert(make_pair(ld[mi].var*2, ss.str()));
+        litString().insert(make_pair(ld[mi].var*2, ss.str()));
 
 	return Lit(ld[mi].var, 1);
 }
@@ -104,7 +109,7 @@ inline Lit IntVarLL::getLELit(int v) {
 	if (ld[ni].val == v) return Lit(ld[ni].var, 0);
 	// overshot, create new var and insert before ni
 	int mi = getLitNode();
-	ld[mi].var = sat.getLazyVar(ChannelInfo(var_id, 1, 1, v));
+	ld[mi].var = sat().getLazyVar(ChannelInfo(var_id, 1, 1, v));
 	ld[mi].val = v;
 	ld[mi].prev = ni;
 	ld[mi].next = ld[ni].next;
@@ -113,16 +118,16 @@ inline Lit IntVarLL::getLELit(int v) {
 
         std::stringstream ss;
         ss << varLabel << ">=" << v+1;
-        litString.insert(make_pair(ld[mi].var*2+1, ss.str()));
+        litString().insert(make_pair(ld[mi].var*2+1, ss.str()));
         ss.str("");
         ss << varLabel << "<=" << v;
-        litString.insert(make_pair(ld[mi].var*2, ss.str()));
+        litString().insert(make_pair(ld[mi].var*2, ss.str()));
 
         return Lit(ld[mi].var, 0);
 }
 
 Lit IntVarLL::getLit(int64_t v, int t) {
-	assert(engine.decisionLevel() == 0);
+	assert(engine().decisionLevel() == 0);
 	if (v < min) return toLit(1^(t&1));       // _, _, 1, 0
 	if (v > max) return toLit(t&1);           // _, _, 0, 1
 	switch (t) {
@@ -137,7 +142,7 @@ inline void IntVarLL::channelMin(int v, Lit p) {
 	Reason r(~p);
 	int ni;
 	for (ni = ld[li].next; ld[ni].val < v-1; ni = ld[ni].next) {
-		sat.cEnqueue(Lit(ld[ni].var, 1), r);
+		sat().cEnqueue(Lit(ld[ni].var, 1), r);
 	}
 	assert(ld[ni].val == v-1);
 	li = ni;
@@ -148,7 +153,7 @@ inline void IntVarLL::channelMax(int v, Lit p) {
 	Reason r(~p);
 	int ni;
 	for (ni = ld[hi].prev; ld[ni].val > v; ni = ld[ni].prev) {
-		sat.cEnqueue(Lit(ld[ni].var, 0), r);
+		sat().cEnqueue(Lit(ld[ni].var, 0), r);
 	}
 	assert(ld[ni].val == v);
 	hi = ni;
@@ -157,7 +162,7 @@ inline void IntVarLL::channelMax(int v, Lit p) {
 inline void IntVarLL::updateFixed() {
 	if (isFixed()) {
 		Reason r(getMinLit(), getMaxLit());
-		sat.cEnqueue(valLit, r);
+		sat().cEnqueue(valLit, r);
 		changes |= EVENT_F;
 	}
 }
@@ -170,8 +175,8 @@ bool IntVarLL::setMin(int64_t v, Reason r, bool channel) {
 		}
 	}
 	Lit p = getGELit(v);
-	if (channel) sat.cEnqueue(p, r);
-	if (v > max) { assert(sat.confl); return false; }
+	if (channel) sat().cEnqueue(p, r);
+	if (v > max) { assert(sat().confl); return false; }
 	channelMin(v, p);
 	min = v; changes |= EVENT_C | EVENT_L;
 	updateFixed();
@@ -187,8 +192,8 @@ bool IntVarLL::setMax(int64_t v, Reason r, bool channel) {
 		}
 	}
 	Lit p = getLELit(v);
-	if (channel) sat.cEnqueue(p, r);
-	if (v < min) { assert(sat.confl); return false; }
+	if (channel) sat().cEnqueue(p, r);
+	if (v < min) { assert(sat().confl); return false; }
 	channelMax(v, p);
 	max = v; changes |= EVENT_C | EVENT_U;
 	updateFixed();
@@ -206,7 +211,7 @@ bool IntVarLL::setVal(int64_t v, Reason r, bool channel) {
 
 bool IntVarLL::remVal(int64_t v, Reason r, bool channel) {
 	assert(channel);
-	if (!engine.finished_init) NEVER;
+	if (!engine().finished_init) NEVER;
 	return true;
 }
 
@@ -218,7 +223,7 @@ Lit IntVarLL::createLit(int _v) {
 	if (ld[ni].val == v) return Lit(ld[ni].var, s);
 	// overshot, create new var and insert before ni
 	int mi = getLitNode();
-	ld[mi].var = sat.getLazyVar(ChannelInfo(var_id, 1, 1, v));
+	ld[mi].var = sat().getLazyVar(ChannelInfo(var_id, 1, 1, v));
 	ld[mi].val = v;
 	ld[mi].prev = ni;
 	ld[mi].next = ld[ni].next;
@@ -230,19 +235,19 @@ Lit IntVarLL::createLit(int _v) {
 
 //	printf("created var %d, ", ld[mi].var);
 
-	if (sat.value(p) == l_True) {
+	if (sat().value(p) == l_True) {
 	  Clause* r = (Clause*) malloc(sizeof(Clause) + 2 * sizeof(Lit));
 		r->clearFlags(); r->temp_expl = 1; r->sz = 2; (*r)[1] = ~p;
-		int l = sat.getLevel(var(p));
-		sat.rtrail[l].push(r);
-		sat.aEnqueue(Lit(ld[mi].var, 1), r, l);
+		int l = sat().getLevel(var(p));
+		sat().rtrail[l].push(r);
+		sat().aEnqueue(Lit(ld[mi].var, 1), r, l);
 	}
-	if (sat.value(q) == l_True) {
+	if (sat().value(q) == l_True) {
 	  Clause* r = (Clause*) malloc(sizeof(Clause) + 2 * sizeof(Lit));
 		r->clearFlags(); r->temp_expl = 1; r->sz = 2; (*r)[1] = ~q;
-		int l = sat.getLevel(var(q));
-		sat.rtrail[l].push(r);
-		sat.aEnqueue(Lit(ld[mi].var, 0), r, l);
+		int l = sat().getLevel(var(q));
+		sat().rtrail[l].push(r);
+		sat().aEnqueue(Lit(ld[mi].var, 0), r, l);
 	}
 
 	return Lit(ld[mi].var, s);
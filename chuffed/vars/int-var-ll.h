@@ -28,7 +28,7 @@ public:
 
 	VarType getType() { return INT_VAR_LL; }
 
-	DecInfo* branch();
+	DecInfo branch();
 
 	int getLitNode();
 	void freeLazyVar(int val);
@@ -49,6 +49,11 @@ public:
 	bool remVal(int64_t v, Reason r = NULL, bool channel = true);
 
 	Lit createLit(int v);
+
+	void memUsage(MemUsage& mu) {
+		IntVar::memUsage(mu);
+		mu.lazy_lits += ld.bytes() + freelist.bytes();
+	}
 };
 
 #endif
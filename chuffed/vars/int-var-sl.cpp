@@ -1,8 +1,8 @@
 #include <chuffed/vars/int-var.h>
 #include <chuffed/core/sat.h>
 #include <chuffed/core/propagator.h>
+#include <chuffed/core/solver.h>
 
-extern std::map<IntVar*, std::string> intVarString;
 
 IntVarSL::IntVarSL(const IntVar& other, vec<int>& _values)
 	: IntVar(other), values(_values) {
@@ -11,15 +11,15 @@ IntVarSL::IntVarSL(const IntVar& other, vec<int>& _values)
 
 	// handle min, max and vals
 	int l = 0;
-	while (values[l] < min) if (++l == values.size()) TL_FAIL();
-	while (!vals[values[l]]) if (++l == values.size()) TL_FAIL();
+	while (values[l] < min) if (++l == values.size()) { TL_FAIL(); return; }
+	while (!vals[values[l]]) if (++l == values.size()) { TL_FAIL(); return; }
 	min = values[l];
 
 //	printf("l = %d\n", l);
 
 	int u = values.size()-1;
-	while (values[u] > max) if (u-- == 0) TL_FAIL();
-	while (!vals[values[u]]) if (u-- == 0) TL_FAIL();
+	while (values[u] > max) if (u-- == 0) { TL_FAIL(); return; }
+	while (!vals[values[u]]) if (u-- == 0) { TL_FAIL(); return; }
 	max = values[u];
 
 //	printf("u = %d\n", u);
@@ -38,18 +38,18 @@ IntVarSL::IntVarSL(const IntVar& other, vec<int>& _values)
 	// create the IntVarEL
 	IntVar *v = newIntVar(0, values.size()-1);
         // inherit the name from this SL
-        intVarString[v] = intVarString[this];
+        intVarString()[v] = intVarString()[this];
 	v->specialiseToEL();
 	el = (IntVarEL*) v;
 
 	// rechannel channel info
 	for (int i = 0; i < values.size(); i++) {
 		Lit p = el->getLit(i, 0);
-		sat.c_info[var(p)].cons_id = var_id;
+		sat().c_info[var(p)].cons_id = var_id;
 	}
 	for (int i = 0; i <= values.size(); i++) {
 		Lit p = el->getLit(i, 2);
-		sat.c_info[var(p)].cons_id = var_id;
+		sat().c_info[var(p)].cons_id = var_id;
 	}
 
 	// transfer pinfo to el
@@ -64,6 +64,12 @@ void IntVarSL::attach(Propagator *p, int pos, int eflags) {
 	else el->pinfo.push(PropInfo(p, pos, eflags));
 }
 
+// The activity is bumped on this var, but the domain changes are woken on el
+void IntVarSL::attachBranch(BranchGroup *g, int pos) {
+	binfo.push(BranchInfo(g, pos));
+	el->attachBranch(g, pos);
+}
+
 int IntVarSL::transform(int v, int type) {
 	int l = 0, u = values.size()-1, m;
 	while (true) {
@@ -121,8 +127,8 @@ bool IntVarSL::setVal(int64_t v, Reason r, bool channel) {
 	assert(setValNotR(v));
 	int u = transform(v, 2);
 	if (u == -1) {
-		if (channel) sat.cEnqueue(lit_False, r);
-		assert(sat.confl);
+		if (channel) sat().cEnqueue(lit_False, r);
+		assert(sat().confl);
 		return false;
 	}
 	if (!el->setVal(u, r, channel)) return false;
@@ -17,7 +17,11 @@ public:
 
 	IntVarSL(const IntVar& other, vec<int>& values);
 
+	// Values by index, the values of the literals of el
+	const vec<int>& getValues() const { return values; }
+
 	void attach(Propagator *p, int pos, int eflags);
+	void attachBranch(BranchGroup *g, int pos);
 
 	VarType getType() { return INT_VAR_SL; }
 
@@ -27,8 +31,8 @@ public:
 	Lit getMinLit() const { return el->getMinLit(); }
 	Lit getMaxLit() const { return el->getMaxLit(); }
 	Lit getValLit() const { return el->getValLit(); }
-	Lit getFMinLit(int64_t v) { return so.finesse ? ~el->getLit(transform(v, 0), 2) : el->getMinLit(); }
-	Lit getFMaxLit(int64_t v) { return so.finesse ? ~el->getLit(transform(v, 1), 3) : el->getMaxLit(); }
+	Lit getFMinLit(int64_t v) { return so().finesse ? ~el->getLit(transform(v, 0), 2) : el->getMinLit(); }
+	Lit getFMaxLit(int64_t v) { return so().finesse ? ~el->getLit(transform(v, 1), 3) : el->getMaxLit(); }
 
 	bool setMin(int64_t v, Reason r = NULL, bool channel = true);
 	bool setMax(int64_t v, Reason r = NULL, bool channel = true);
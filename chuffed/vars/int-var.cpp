@@ -1,5 +1,6 @@
 #include <map>
 #include <chuffed/vars/int-var.h>
+#include <chuffed/core/solver.h>
 #include <chuffed/mip/mip.h>
 #include <sstream>
 
@@ -11,12 +12,9 @@
 
 using namespace std;
 
-map<int,IntVar*> ic_map;
-
-extern std::map<IntVar*, std::string> intVarString;
 
 IntVar::IntVar(int _min, int _max) :
-		var_id(engine.vars.size())
+		var_id(engine().vars.size())
 	, min(_min)
 	, max(_max)
 	, min0(_min)
@@ -27,16 +25,26 @@ IntVar::IntVar(int _min, int _max) :
   , should_be_learnable(true)
   , should_be_decidable(true)
   , vals(NULL)
+  , vals_mem(NULL)
   , preferred_val(PV_MIN)
+  , hint_val(INT_MIN)
   , activity(0)
   , in_queue(false)
 {
 	assert(min_limit <= min && min <= max && max <= max_limit);
-	engine.vars.push(this);
+	engine().vars.push(this);
 	changes = EVENT_C | EVENT_L | EVENT_U;
 	if (isFixed()) changes |= EVENT_F;
 }
 
+IntVar::~IntVar() {
+	if (!vals_mem) return;
+	free(vals_mem);
+#if INT_DOMAIN_LIST
+	free(vals_list_mem);
+#endif
+}
+
 // Allocate enough memory to specialise IntVar later using the same memory block
 IntVar* newIntVar(int min, int max) {
 	size_t size = sizeof(IntVar);
@@ -49,16 +57,16 @@ IntVar* newIntVar(int min, int max) {
 }
 
 IntVar* getConstant(int v) {
-	map<int,IntVar*>::iterator it = ic_map.find(v);
-	if (it != ic_map.end()) return it->second;
+	map<int,IntVar*>::iterator it = solver_ptr->constants.find(v);
+	if (it != solver_ptr->constants.end()) return it->second;
 	IntVar *var = newIntVar(v,v);
 
         std::stringstream ss;
         ss << "constant_" << v;
-        intVarString[var] = ss.str();
+        intVarString()[var] = ss.str();
 
         var->specialiseToEL();
-	ic_map.insert(pair<int,IntVar*>(v, var));
+	solver_ptr->constants.insert(pair<int,IntVar*>(v, var));
 
         
 	return var;
@@ -95,6 +103,12 @@ void IntVar::specialiseToSL(vec<int>& values) {
 	}
 	v.resize(j);
 
+	// Without a value left, the var is not specialised
+	for (i = 0; i < v.size() && !indomain(v[i]); i++);
+	if (i == v.size()) {
+		TL_FAIL();
+		return;
+	}
 
 //	for (int i = 0; i < values.size(); i++) printf("%d ", values[i]);
 //	printf("\n");
@@ -115,12 +129,12 @@ void IntVar::initVals(bool optional) {
 		if (optional) return;
 		CHUFFED_ERROR("Cannot initialise vals in unbounded IntVar\n");
 	}
-	vals = (Tchar*) malloc((max-min+2) * sizeof(Tchar));
+	vals = (Tchar*) (vals_mem = malloc((max-min+2) * sizeof(Tchar)));
 	if (!vals) { perror("malloc()"); exit(1); }
 	memset(vals, 1, max-min+2);
 	if (!(vals -= min)) vals++;      // Hack to make vals != NULL whenever it's allocated
 #if INT_DOMAIN_LIST
-	vals_list = (Tint*) malloc(2*(max-min) * sizeof(Tint));
+	vals_list = (Tint*) (vals_list_mem = malloc(2*(max-min) * sizeof(Tint)));
 	if (!vals_list) { perror("malloc()"); exit(1); }
 	vals_list -= 2*min+1;
 	for (int i = min; i < max; ++i) {
@@ -131,27 +145,51 @@ void IntVar::initVals(bool optional) {
 #endif
 }
 
+void IntVar::memUsage(MemUsage& mu) {
+	mu.vars += sizeof(IntVar) + pinfo.bytes() + binfo.bytes();
+	if (vals) {
+		mu.vars += (long long) (max0 - min0 + 2) * sizeof(Tchar);
+#if INT_DOMAIN_LIST
+		mu.vars += (long long) 2 * (max0 - min0) * sizeof(Tint);
+#endif
+	}
+}
+
 void IntVar::attach(Propagator *p, int pos, int eflags) {
 	if (isFixed()) p->wakeup(pos, eflags);
 	else pinfo.push(PropInfo(p, pos, eflags));
 }
 
+void IntVar::attachBranch(BranchGroup *g, int pos) {
+	binfo.push(BranchInfo(g, pos));
+	// A var with no propagators is never queued, and would not report changes
+	if (pinfo.size() == 0) in_queue = false;
+}
+
 void IntVar::wakePropagators() {
 	for (int i = pinfo.size(); i--; ) {
 		PropInfo& pi = pinfo[i];
 		if ((pi.eflags & changes) == 0) continue;
 		if (pi.p->satisfied) continue;
-		if (pi.p == engine.last_prop) continue;
+		if (pi.p == engine().last_prop) continue;
+		if (so().prop_profile) engine().propProfile(pi.p->prop_id).wakeups++;
 		pi.p->wakeup(pi.pos, changes);
 	}
+	for (int i = 0; i < binfo.size(); i++) binfo[i].g->domainChanged(binfo[i].pos);
 	clearPropState();
 }
 
+// The score has changed other than by a domain change, e.g. activity
+void IntVar::scoreChanged() {
+	for (int i = 0; i < binfo.size(); i++) binfo[i].g->scoreChanged(binfo[i].pos);
+}
+
 int IntVar::simplifyWatches() {
 	int i, j;
 	for (i = j = 0; i < pinfo.size(); i++) {
 		if (!pinfo[i].p->satisfied) pinfo[j++] = pinfo[i];
 	}
+	if (j < pinfo.size()) scoreChanged();
 	pinfo.resize(j);
 	return j;
 }
@@ -183,50 +221,67 @@ double IntVar::getScore(VarBranch vb) {
 	}
 }
 
-DecInfo* IntVar::branch() {
+// The literals of an eagerly encoded var are also given the phase they have
+// when x = v, for VSIDS. Engine::clearWarmStart gives them back their own.
+void IntVar::setHintVal(int v) {
+	hint_val = v;
+	if (getType() != INT_VAR_EL && getType() != INT_VAR_SL) return;
+	for (iterator it = begin(); it != end(); ++it) {
+		Lit p = getLit(*it, 1);
+		engine().hint_polarity.push(Lit(var(p), sat().polarity[var(p)]));
+		sat().polarity[var(p)] = sign(p) ^ (*it != v);
+		p = getLit(*it, 2);
+		engine().hint_polarity.push(Lit(var(p), sat().polarity[var(p)]));
+		sat().polarity[var(p)] = sign(p) ^ (*it > v);
+	}
+}
+
+DecInfo IntVar::branch() {
+	if (hint_val != INT_MIN && indomain(hint_val)) return DecInfo(this, hint_val, 1);
+
 //	vec<int> possible;
 //	for (int i = min; i <= max; i++) if (indomain(i)) possible.push(i);
-//	return new DecInfo(this, possible[rand()%possible.size()], 1);
+//	return DecInfo(this, possible[rand()%possible.size()], 1);
 
 
 	switch (preferred_val) {
-		case PV_MIN       : return new DecInfo(this, min, 1);
-		case PV_MAX       : return new DecInfo(this, max, 1);
+		case PV_MIN       : return DecInfo(this, min, 1);
+		case PV_MAX       : return DecInfo(this, max, 1);
 #if INT_BRANCH_HOLES
 		// note slight inconsistency, if INT_BRANCH_HOLES=0 then we
 		// round down rather than up (vice versa for PV_SPLIT_MAX),
 		// should probably revisit this and make them consistent
 		case PV_SPLIT_MIN : {
 				if (!vals)
-					return new DecInfo(this, min + (max - min) / 2, 3);
+					return DecInfo(this, min + (max - min) / 2, 3);
 				int values = (size()- 1) / 2;
 				iterator j = begin();
 				for (int i = 0; i < values; ++i)
 					++j;
-				return new DecInfo(this, *j, 3);
+				return DecInfo(this, *j, 3);
 			}
 		case PV_SPLIT_MAX : {
 				if (!vals)
-					return new DecInfo(this, min + (max - min - 1) / 2, 2);
+					return DecInfo(this, min + (max - min - 1) / 2, 2);
 				int values = size() / 2;
 				iterator j = begin();
 				for (int i = 0; i < values; ++i)
 					++j;
-				return new DecInfo(this, *j, 2);
+				return DecInfo(this, *j, 2);
 			}
 		case PV_MEDIAN: {
 				if (!vals)
-					return new DecInfo(this, min + (max - min) / 2, 1);
+					return DecInfo(this, min + (max - min) / 2, 1);
 				int values = (size() - 1) / 2;
 				iterator j = begin();
 				for (int i = 0; i < values; ++i)
 					++j;
-				return new DecInfo(this, *j, 1);
+				return DecInfo(this, *j, 1);
 			}
 #else
-		case PV_SPLIT_MIN : return new DecInfo(this, min+(max-min-1)/2, 3);
-		case PV_SPLIT_MAX : return new DecInfo(this, min+(max-min  )/2, 2);
-		case PV_MEDIAN    : return new DecInfo(this, min+(max-min  )/2, 1);
+		case PV_SPLIT_MIN : return DecInfo(this, min+(max-min-1)/2, 3);
+		case PV_SPLIT_MAX : return DecInfo(this, min+(max-min  )/2, 2);
+		case PV_MEDIAN    : return DecInfo(this, min+(max-min  )/2, 1);
 #endif
 		default: NEVER;
 	}
@@ -324,7 +379,7 @@ bool IntVar::remVal(int64_t v, Reason r, bool channel) {
 	assert(remValNotR(v));
 	if (isFixed()) return false;
 	if (!vals) {
-		if (!engine.finished_init) NEVER;
+		if (!engine().finished_init) NEVER;
 		return true;
 	}
 #if INT_DOMAIN_LIST
@@ -356,7 +411,7 @@ bool IntVar::remVal(int64_t v, Reason r, bool channel) {
 // Assumes v is sorted
 bool IntVar::allowSet(vec<int>& v, Reason r, bool channel) {
   initVals();
-	if (!vals && !engine.finished_init) NOT_SUPPORTED;
+	if (!vals && !engine().finished_init) NOT_SUPPORTED;
 	int i = 0;
 	int m = min;
 	while (i < v.size() && v[i] < m) i++;
@@ -61,12 +61,15 @@ public:
         bool should_be_decidable;
 
 	Tchar *vals;
+	void *vals_mem;	// Blocks vals and vals_list point into
 #if INT_DOMAIN_LIST
 	Tint *vals_list;
+	void *vals_list_mem;
 	Tint vals_count;
 #endif
 
 	PreferredVal preferred_val;
+	int hint_val;	// Value branched on first while in the domain, INT_MIN if none
 
 	double activity;
 
@@ -86,6 +89,9 @@ public:
 	static const int max_limit = 500000000;
 	static const int min_limit = -500000000;
 
+	// Vars are made by newIntVar and freed by the engine, see Engine::~Engine
+	~IntVar();
+
 //--------------------------------------------------
 // Engine stuff
 
@@ -107,18 +113,34 @@ public:
 
 	virtual void attach(Propagator *p, int pos, int eflags);
 
+	struct BranchInfo {
+		BranchGroup *g;
+		int pos;        // what is var's position in the group
+
+		BranchInfo(BranchGroup *_g, int _pos) : g(_g), pos(_pos) {}
+	};
+
+	// Branch groups selecting incrementally among their vars
+	vec<BranchInfo> binfo;
+	virtual void attachBranch(BranchGroup *g, int pos);
+	void scoreChanged();
+
 	void pushInQueue();
 	void wakePropagators();
 	void clearPropState();
 	int simplifyWatches();
 
+	// Add the memory held by the var to the accounting
+	virtual void memUsage(MemUsage& mu);
+
 //--------------------------------------------------
 // Branching stuff
 
 	bool finished() { return isFixed(); }
 	double getScore(VarBranch vb);
 	void setPreferredVal(PreferredVal p) { preferred_val = p; }
-	DecInfo* branch();
+	void setHintVal(int v);
+	DecInfo branch();
 
 //--------------------------------------------------
 // Type specialisation
@@ -320,7 +342,7 @@ IntVar* getConstant(int v);
 inline void IntVar::pushInQueue() {
 	if (!in_queue) {
 		in_queue = true;
-		engine.v_queue.push(this);
+		engine().v_queue.push(this);
 	}
 }
 
@@ -254,7 +254,7 @@ public:
 	bool setVal(int64_t v, Reason r = NULL, bool channel = true) const {
 		if (type & 4) v -= b;
 		if (type & 2) {
-			if (v%a) { sat.cEnqueue(lit_False, r); return false; }
+			if (v%a) { sat().cEnqueue(lit_False, r); return false; }
 			v = v/a;
 		}
 		if (type & 1) v = -v;
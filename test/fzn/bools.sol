@@ -0,0 +1,4 @@
+b1 = true;
+b2 = true;
+b3 = true;
+b4 = true;
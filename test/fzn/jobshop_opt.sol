@@ -0,0 +1,34 @@
+% An optimal solution of jobshop.fzn
+obj = 48;
+s_0_0 = 23;
+s_0_1 = 33;
+s_0_2 = 43;
+s_0_3 = 46;
+s_1_0 = 0;
+s_1_1 = 37;
+s_1_2 = 42;
+s_1_3 = 44;
+s_2_0 = 18;
+s_2_1 = 28;
+s_2_2 = 33;
+s_2_3 = 47;
+s_3_0 = 20;
+s_3_1 = 23;
+s_3_2 = 28;
+s_3_3 = 41;
+s_4_0 = 11;
+s_4_1 = 19;
+s_4_2 = 37;
+s_4_3 = 41;
+s_5_0 = 4;
+s_5_1 = 9;
+s_5_2 = 34;
+s_5_3 = 44;
+s_6_0 = 6;
+s_6_1 = 15;
+s_6_2 = 23;
+s_6_3 = 30;
+s_7_0 = 1;
+s_7_1 = 6;
+s_7_2 = 10;
+s_7_3 = 18;
@@ -0,0 +1,9 @@
+% A solution of queens.fzn
+q0 = 5;
+q1 = 2;
+q2 = 6;
+q3 = 1;
+q4 = 7;
+q5 = 4;
+q6 = 8;
+q7 = 3;
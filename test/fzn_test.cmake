@@ -0,0 +1,127 @@
+# FlatZinc regression test, run by ctest or directly with
+#
+#   cmake -DFZN_CHUFFED=<fzn-chuffed> -DMODEL=<model.fzn> [options] -P test/fzn_test.cmake
+#
+# The model is solved with ARGS, and the test fails if the solver exits with
+# an error, or if the result differs from what is expected. Options:
+#
+#   ARGS        solver options of the checked run
+#   SETUP_ARGS  solver options of a run made first, whose result is not
+#               checked, e.g. to write a file the checked run reads
+#   SETUP_MODEL model of that run, relative to the directory of MODEL
+#               (default: MODEL)
+#   SOLUTIONS   expected number of solutions printed
+#   OBJECTIVE   expected objective value of the last solution
+#   STDOUT      regular expression the output must match, where . also
+#               matches the ends of lines (a ; would split the option)
+#   STDERR      regular expression the error output must match
+#   FILE        file the checked run must write
+#   FILE_MATCH  regular expression the content of FILE must match
+#   NO_STATS    run without -s, so the objective is not known
+#   REF_MODEL   model of a reference run, relative to the directory of MODEL
+#               (default: MODEL)
+#   REF_ARGS    solver options of a reference run; the number of solutions,
+#               the completeness and the objective must be the same as its
+#
+# Paths in the options may use @DIR@ for the directory of this script and
+# @OUT@ for the working directory of the test, named NAME (default: the
+# model's name).
+
+cmake_minimum_required(VERSION 3.1.0)
+
+if(NOT FZN_CHUFFED OR NOT MODEL)
+  message(FATAL_ERROR "FZN_CHUFFED and MODEL must be given")
+endif()
+get_filename_component(MODEL ${MODEL} ABSOLUTE)
+if(NOT REF_MODEL)
+  set(REF_MODEL ${MODEL})
+endif()
+get_filename_component(model_dir ${MODEL} DIRECTORY)
+get_filename_component(REF_MODEL ${REF_MODEL} ABSOLUTE BASE_DIR ${model_dir})
+if(NOT SETUP_MODEL)
+  set(SETUP_MODEL ${MODEL})
+endif()
+get_filename_component(SETUP_MODEL ${SETUP_MODEL} ABSOLUTE BASE_DIR ${model_dir})
+if(NOT NAME)
+  get_filename_component(NAME ${MODEL} NAME_WE)
+endif()
+set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/fzn_test/${NAME})
+# Nothing is left from an earlier run
+file(REMOVE_RECURSE ${out_dir})
+file(MAKE_DIRECTORY ${out_dir})
+
+# Solve model with the options opts, and set in the parent scope the number
+# of solutions, whether the search was complete and the last objective
+function(run_model prefix model opts)
+  string(REPLACE "@DIR@" "${CMAKE_CURRENT_LIST_DIR}" opts "${opts}")
+  string(REPLACE "@OUT@" "${out_dir}" opts "${opts}")
+  separate_arguments(words UNIX_COMMAND "${opts}")
+  if(NOT NO_STATS)
+    list(INSERT words 0 -s)
+  endif()
+  execute_process(COMMAND ${FZN_CHUFFED} ${words} ${model}
+    WORKING_DIRECTORY ${out_dir}
+    OUTPUT_VARIABLE out ERROR_VARIABLE err
+    RESULT_VARIABLE rc TIMEOUT 120)
+  if(NOT rc STREQUAL "0")
+    message(FATAL_ERROR "fzn-chuffed ${opts} ${model} failed (${rc}):\n${err}")
+  endif()
+  string(REGEX MATCHALL "(^|\n)----------" sols "${out}")
+  list(LENGTH sols n)
+  set(${prefix}_solutions ${n} PARENT_SCOPE)
+  set(complete no)
+  if(out MATCHES "(^|\n)(==========|=====UNSATISFIABLE=====)")
+    set(complete yes)
+  endif()
+  set(${prefix}_complete ${complete} PARENT_SCOPE)
+  # The statistic holds the objective of the last solution found
+  set(obj "")
+  if(out MATCHES "%%%mzn-stat: objective=([-0-9]+)")
+    set(obj ${CMAKE_MATCH_1})
+  endif()
+  set(${prefix}_objective "${obj}" PARENT_SCOPE)
+  set(${prefix}_out "${out}" PARENT_SCOPE)
+  set(${prefix}_err "${err}" PARENT_SCOPE)
+  message(STATUS "fzn-chuffed ${opts}: ${n} solutions, complete ${complete}, objective ${obj}")
+endfunction()
+
+if(DEFINED SETUP_ARGS)
+  run_model(setup ${SETUP_MODEL} "${SETUP_ARGS}")
+endif()
+run_model(test ${MODEL} "${ARGS}")
+
+set(errors "")
+if(DEFINED SOLUTIONS AND NOT test_solutions EQUAL SOLUTIONS)
+  set(errors "${errors}\n  ${test_solutions} solutions instead of ${SOLUTIONS}")
+endif()
+if(DEFINED OBJECTIVE AND NOT "${test_objective}" STREQUAL "${OBJECTIVE}")
+  set(errors "${errors}\n  objective ${test_objective} instead of ${OBJECTIVE}")
+endif()
+if(DEFINED STDOUT AND NOT test_out MATCHES "${STDOUT}")
+  set(errors "${errors}\n  output does not match ${STDOUT}:\n${test_out}")
+endif()
+if(DEFINED STDERR AND NOT test_err MATCHES "${STDERR}")
+  set(errors "${errors}\n  error output does not match ${STDERR}:\n${test_err}")
+endif()
+if(DEFINED FILE)
+  string(REPLACE "@OUT@" "${out_dir}" FILE "${FILE}")
+  if(NOT EXISTS ${FILE})
+    set(errors "${errors}\n  ${FILE} was not written")
+  elseif(DEFINED FILE_MATCH)
+    file(READ ${FILE} content)
+    if(NOT content MATCHES "${FILE_MATCH}")
+      set(errors "${errors}\n  ${FILE} does not match ${FILE_MATCH}:\n${content}")
+    endif()
+  endif()
+endif()
+if(DEFINED REF_ARGS)
+  run_model(ref ${REF_MODEL} "${REF_ARGS}")
+  foreach(r solutions complete objective)
+    if(NOT "${test_${r}}" STREQUAL "${ref_${r}}")
+      set(errors "${errors}\n  ${r} ${test_${r}} instead of ${ref_${r}} as by the reference run")
+    endif()
+  endforeach()
+endif()
+if(errors)
+  message(FATAL_ERROR "${MODEL}:${errors}")
+endif()
@@ -0,0 +1,108 @@
+// Builds and solves a model in one Solver, deletes it, then does the same in
+// a second one. The second solve must find the same solutions as the first,
+// and neither may leave anything behind in the default instance. A model
+// that fails while it is built must be reported as unsatisfiable, without
+// ending the process.
+
+#include <cstdio>
+#include <sstream>
+#include <chuffed/core/engine.h>
+#include <chuffed/core/options.h>
+#include <chuffed/core/propagator.h>
+#include <chuffed/core/solver.h>
+#include <chuffed/branching/branching.h>
+#include <chuffed/vars/modelling.h>
+
+class Queens : public Problem {
+public:
+	int const n;
+	vec<IntVar*> x;
+
+	Queens(int _n) : n(_n) {
+		createVars(x, n, 1, n);
+		vec<int> a, b;
+		for (int i = 0; i < n; i++) {
+			a.push(i);
+			b.push(-i);
+		}
+		all_different(x);
+		all_different_offset(a, x);
+		all_different_offset(b, x);
+		branch(x, VAR_SIZE_MIN, VAL_MIN);
+		output_vars(x);
+	}
+
+	void print(std::ostream& os) {
+		for (int i = 0; i < n; i++) os << x[i]->getVal() << " ";
+		os << "\n";
+	}
+};
+
+// x in 1..3 and x >= 5
+class TopLevelFailure : public Problem {
+public:
+	vec<IntVar*> x;
+
+	TopLevelFailure() {
+		createVars(x, 1, 1, 3);
+		int_rel(x[0], IRT_GE, 5);
+		branch(x, VAR_INORDER, VAL_MIN);
+		output_vars(x);
+	}
+
+	void print(std::ostream& os) { os << x[0]->getVal() << "\n"; }
+};
+
+// Solve a model failing at the top level in a new Solver, and delete it
+static bool solveTopLevelFailure() {
+	Options o(so());
+	o.verbosity = 0;
+	Solver *s = new Solver(o);
+	s->bind();
+
+	std::stringstream out;
+	engine().setOutputStream(out);
+	engine().solve(new TopLevelFailure());
+	bool ok = engine().tl_failed && engine().status == RES_GUN && engine().solutions == 0;
+	if (!ok) fprintf(stderr, "top level failure not reported as unsatisfiable\n");
+
+	main_solver.bind();
+	delete s;
+	return ok;
+}
+
+// Solve n-queens for all solutions in a new Solver, and delete it
+static bool solveQueens(int n, long long expected) {
+	Options o(so());
+	o.nof_solutions = 0;
+	o.verbosity = 0;
+	Solver *s = new Solver(o);
+	s->bind();
+
+	std::stringstream out;
+	engine().setOutputStream(out);
+	engine().solve(new Queens(n));
+	bool ok = engine().status == RES_GUN && engine().solutions == expected;
+	if (!ok) fprintf(stderr, "%d-queens: %lld solutions instead of %lld\n", n, (long long) engine().solutions, expected);
+
+	main_solver.bind();
+	delete s;
+	return ok;
+}
+
+int main(int argc, char** argv) {
+	int vars = engine().vars.size();
+	int props = engine().propagators.size();
+
+	bool ok = solveQueens(6, 4);
+	ok = solveQueens(6, 4) && ok;
+	ok = solveQueens(8, 92) && ok;
+	ok = solveTopLevelFailure() && ok;
+	ok = solveQueens(6, 4) && ok;
+
+	if (engine().vars.size() != vars || engine().propagators.size() != props) {
+		fprintf(stderr, "the default instance gained vars or propagators\n");
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}